@@ -0,0 +1,121 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_ALLOWEDCOLLISIONMATRIX_INL_H
+#define FCL_BROADPHASE_ALLOWEDCOLLISIONMATRIX_INL_H
+
+#include "fcl/broadphase/allowed_collision_matrix.h"
+
+#include <functional>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT AllowedCollisionMatrix<double>;
+
+extern template
+class FCL_EXPORT AllowedCollisionMatrix<float>;
+
+//==============================================================================
+template <typename S>
+void AllowedCollisionMatrix<S>::allow(
+    const CollisionObject<S>* o1, const CollisionObject<S>* o2)
+{
+  allowed_pairs.insert(makePair(o1, o2));
+}
+
+//==============================================================================
+template <typename S>
+void AllowedCollisionMatrix<S>::disallow(
+    const CollisionObject<S>* o1, const CollisionObject<S>* o2)
+{
+  allowed_pairs.erase(makePair(o1, o2));
+}
+
+//==============================================================================
+template <typename S>
+bool AllowedCollisionMatrix<S>::isAllowed(
+    const CollisionObject<S>* o1, const CollisionObject<S>* o2) const
+{
+  if(allowed_pairs.empty())
+    return false;
+
+  return allowed_pairs.find(makePair(o1, o2)) != allowed_pairs.end();
+}
+
+//==============================================================================
+template <typename S>
+void AllowedCollisionMatrix<S>::clear()
+{
+  allowed_pairs.clear();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t AllowedCollisionMatrix<S>::size() const
+{
+  return allowed_pairs.size();
+}
+
+//==============================================================================
+template <typename S>
+bool AllowedCollisionMatrix<S>::empty() const
+{
+  return allowed_pairs.empty();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t AllowedCollisionMatrix<S>::ObjectPairHash::operator()(
+    const ObjectPair& pair) const
+{
+  const std::size_t h1 = std::hash<const CollisionObject<S>*>()(pair.first);
+  const std::size_t h2 = std::hash<const CollisionObject<S>*>()(pair.second);
+  return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+//==============================================================================
+template <typename S>
+typename AllowedCollisionMatrix<S>::ObjectPair
+AllowedCollisionMatrix<S>::makePair(
+    const CollisionObject<S>* o1, const CollisionObject<S>* o2)
+{
+  return o1 < o2 ? ObjectPair(o1, o2) : ObjectPair(o2, o1);
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_ALLOWEDCOLLISIONMATRIX_H
+#define FCL_BROADPHASE_ALLOWEDCOLLISIONMATRIX_H
+
+#include <cstddef>
+#include <unordered_set>
+#include <utility>
+#include "fcl/narrowphase/collision_object.h"
+
+namespace fcl
+{
+
+/// @brief Pairs of objects allowed to collide, e.g. adjacent links of a
+/// robot. A broadphase manager given the matrix does not report these pairs
+/// to the collision callback. Pairs not in the matrix are filtered by the
+/// collision categories and masks of their objects alone.
+template <typename S>
+class FCL_EXPORT AllowedCollisionMatrix
+{
+public:
+
+  /// @brief Let o1 and o2 collide: the pair is no longer reported
+  void allow(const CollisionObject<S>* o1, const CollisionObject<S>* o2);
+
+  /// @brief Report the pair of o1 and o2 again
+  void disallow(const CollisionObject<S>* o1, const CollisionObject<S>* o2);
+
+  /// @brief Whether o1 and o2 are allowed to collide
+  bool isAllowed(const CollisionObject<S>* o1,
+                 const CollisionObject<S>* o2) const;
+
+  /// @brief Remove all the pairs
+  void clear();
+
+  /// @brief Number of pairs allowed to collide
+  std::size_t size() const;
+
+  bool empty() const;
+
+private:
+
+  using ObjectPair
+      = std::pair<const CollisionObject<S>*, const CollisionObject<S>*>;
+
+  struct ObjectPairHash
+  {
+    std::size_t operator()(const ObjectPair& pair) const;
+  };
+
+  /// @brief The pair with the lower address first
+  static ObjectPair makePair(const CollisionObject<S>* o1,
+                             const CollisionObject<S>* o2);
+
+  std::unordered_set<ObjectPair, ObjectPairHash> allowed_pairs;
+};
+
+using AllowedCollisionMatrixf = AllowedCollisionMatrix<float>;
+using AllowedCollisionMatrixd = AllowedCollisionMatrix<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/allowed_collision_matrix-inl.h"
+
+#endif
@@ -0,0 +1,840 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASELBVH_INL_H
+#define FCL_BROADPHASE_BROADPHASELBVH_INL_H
+
+#include "fcl/broadphase/broadphase_LBVH.h"
+
+#include <algorithm>
+#include <limits>
+#include "fcl/broadphase/detail/morton.h"
+#include "fcl/broadphase/detail/parallel_for.h"
+#include "fcl/broadphase/detail/radix_sort.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT LBVHCollisionManager<double>;
+
+extern template
+class FCL_EXPORT LBVHCollisionManager<float>;
+
+/// @cond IGNORE
+namespace detail
+{
+
+//==============================================================================
+inline int countLeadingZeros(uint64 x)
+{
+  if(x == 0)
+    return 64;
+
+  int n = 0;
+  if(!(x >> 32)) { n += 32; x <<= 32; }
+  if(!(x >> 48)) { n += 16; x <<= 16; }
+  if(!(x >> 56)) { n += 8; x <<= 8; }
+  if(!(x >> 60)) { n += 4; x <<= 4; }
+  if(!(x >> 62)) { n += 2; x <<= 2; }
+  if(!(x >> 63)) { n += 1; }
+  return n;
+}
+
+} // namespace detail
+/// @endcond
+
+//==============================================================================
+template <typename S>
+LBVHCollisionManager<S>::LBVHCollisionManager()
+  : num_threads(1),
+    hierarchy_view(this),
+    dirty(false),
+    visits_capacity(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::registerObjects(
+    const std::vector<CollisionObject<S>*>& other_objs)
+{
+  objs.reserve(objs.size() + other_objs.size());
+  aabbs.reserve(aabbs.size() + other_objs.size());
+  for(auto* obj : other_objs)
+    registerObject(obj);
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::registerObject(CollisionObject<S>* obj)
+{
+  if(!obj_index.emplace(obj, objs.size()).second)
+    return;
+
+  objs.push_back(obj);
+  aabbs.push_back(this->marginAABB(obj));
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
+{
+  auto it = obj_index.find(obj);
+  if(it == obj_index.end())
+    return;
+
+  const std::size_t index = it->second;
+  obj_index.erase(it);
+
+  // The last object takes the place of the removed one
+  objs[index] = objs.back();
+  aabbs[index] = aabbs.back();
+  objs.pop_back();
+  aabbs.pop_back();
+  if(index < objs.size())
+    obj_index[objs[index]] = index;
+
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::setup()
+{
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::update()
+{
+  const std::size_t n = objs.size();
+  forEachBlock(n, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+      aabbs[i] = this->marginAABB(objs[i]);
+  });
+
+  dirty = true;
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::update(CollisionObject<S>* updated_obj)
+{
+  auto it = obj_index.find(updated_obj);
+  if(it == obj_index.end())
+    return;
+
+  aabbs[it->second] = this->marginAABB(updated_obj);
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::update(
+    const std::vector<CollisionObject<S>*>& updated_objs)
+{
+  for(auto* obj : updated_objs)
+    update(obj);
+
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::clear()
+{
+  objs.clear();
+  obj_index.clear();
+  aabbs.clear();
+  codes.clear();
+  order.clear();
+  leaf_aabbs.clear();
+  leaf_parents.clear();
+  nodes.clear();
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::getObjects(
+    std::vector<CollisionObject<S>*>& objs) const
+{
+  objs = this->objs;
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::collide(
+    CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  collide_(obj, this->marginAABB(obj), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::distance(
+    CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  S min_dist = std::numeric_limits<S>::max();
+  distance_(obj, obj->getAABB(), 0, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::collide(
+    void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  // Each pair is found from its object that comes first in the sorted order
+  const std::size_t n = size();
+  const std::size_t num_chunks = std::min<std::size_t>(4 * num_threads,
+                                                       n / 1024);
+  if(num_threads <= 1 || num_chunks <= 1)
+  {
+    for(std::size_t k = 0; k < n; ++k)
+    {
+      CollisionObject<S>* obj = objs[order[k]];
+      auto report = [&](unsigned int m) -> bool
+      {
+        CollisionObject<S>* other = objs[order[m]];
+        return this->canCollide(obj, other) && callback(obj, other, cdata);
+      };
+      if(overlapping(leaf_aabbs[k], static_cast<unsigned int>(k + 1), report))
+        return;
+    }
+    return;
+  }
+
+  if(chunk_pairs.size() < num_chunks)
+    chunk_pairs.resize(num_chunks);
+
+  detail::parallelFor(num_threads, num_chunks, [&](std::size_t c)
+  {
+    auto& pairs = chunk_pairs[c];
+    pairs.clear();
+    const std::size_t end = n * (c + 1) / num_chunks;
+    for(std::size_t k = n * c / num_chunks; k < end; ++k)
+    {
+      const unsigned int first = static_cast<unsigned int>(k);
+      auto collect = [&](unsigned int m) -> bool
+      {
+        if(this->canCollide(objs[order[first]], objs[order[m]]))
+          pairs.emplace_back(first, m);
+        return false;
+      };
+      overlapping(leaf_aabbs[k], first + 1, collect);
+    }
+  });
+
+  // The callback is not assumed to be thread safe
+  for(std::size_t c = 0; c < num_chunks; ++c)
+  {
+    for(const auto& pair : chunk_pairs[c])
+    {
+      if(callback(objs[order[pair.first]], objs[order[pair.second]], cdata))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::distance(
+    void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  S min_dist = std::numeric_limits<S>::max();
+  for(std::size_t k = 0; k < size(); ++k)
+  {
+    if(distance_(objs[order[k]], leaf_aabbs[k],
+                 static_cast<unsigned int>(k + 1), cdata, callback, min_dist))
+      return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::collide(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<LBVHCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  // Query the larger manager with the objects of the smaller one, grown by
+  // the margin of the manager they belong to
+  if(this->size() < other_manager->size())
+  {
+    for(std::size_t i = 0; i < objs.size(); ++i)
+    {
+      if(other_manager->collide_(objs[i], aabbs[i], cdata, callback))
+        return;
+    }
+  }
+  else
+  {
+    for(std::size_t i = 0; i < other_manager->objs.size(); ++i)
+    {
+      if(collide_(other_manager->objs[i], other_manager->aabbs[i],
+                  cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::distance(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    DistanceCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<LBVHCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  if(this->size() < other_manager->size())
+  {
+    for(const auto& obj : objs)
+      if(other_manager->distance_(obj, obj->getAABB(), 0, cdata, callback, min_dist)) return;
+  }
+  else
+  {
+    for(const auto& obj : other_manager->objs)
+      if(distance_(obj, obj->getAABB(), 0, cdata, callback, min_dist)) return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool LBVHCollisionManager<S>::empty() const
+{
+  return objs.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t LBVHCollisionManager<S>::size() const
+{
+  return objs.size();
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::setNumThreads(unsigned int num_threads)
+{
+  this->num_threads = std::max(num_threads, 1u);
+}
+
+//==============================================================================
+template <typename S>
+unsigned int LBVHCollisionManager<S>::getNumThreads() const
+{
+  return num_threads;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t LBVHCollisionManager<S>::getTreeDepth() const
+{
+  build();
+
+  std::size_t max_depth = 0;
+  for(std::size_t k = 0; k < leaf_parents.size(); ++k)
+  {
+    std::size_t depth = 1;
+    for(unsigned int p = leaf_parents[k]; p != kNoParent; p = nodes[p].parent)
+      ++depth;
+    max_depth = std::max(max_depth, depth);
+  }
+
+  return max_depth;
+}
+
+//==============================================================================
+template <typename S>
+const detail::AABBHierarchyView<S>*
+LBVHCollisionManager<S>::getHierarchyView() const
+{
+  build();
+  return &hierarchy_view;
+}
+
+//==============================================================================
+template <typename S>
+LBVHCollisionManager<S>::HierarchyView::HierarchyView(
+    const LBVHCollisionManager* manager_)
+  : manager(manager_)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::HierarchyView::getRoots(
+    std::vector<ViewNode>& roots) const
+{
+  if(!manager->objs.empty())
+    roots.push_back(manager->nodes.empty() ? kLeafFlag : 0);
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& LBVHCollisionManager<S>::HierarchyView::getBV(
+    ViewNode node) const
+{
+  return manager->childBV(node);
+}
+
+//==============================================================================
+template <typename S>
+bool LBVHCollisionManager<S>::HierarchyView::isLeaf(ViewNode node) const
+{
+  return node & kLeafFlag;
+}
+
+//==============================================================================
+template <typename S>
+typename LBVHCollisionManager<S>::HierarchyView::ViewNode
+LBVHCollisionManager<S>::HierarchyView::getChild(ViewNode node, int i) const
+{
+  return manager->nodes[node].children[i];
+}
+
+//==============================================================================
+template <typename S>
+CollisionObject<S>* LBVHCollisionManager<S>::HierarchyView::getObject(
+    ViewNode leaf) const
+{
+  return manager->objs[manager->order[leaf & ~kLeafFlag]];
+}
+
+//==============================================================================
+template <typename S>
+std::size_t LBVHCollisionManager<S>::numBlocks(std::size_t count) const
+{
+  // A few blocks per thread keep the threads busy when some blocks take
+  // longer than others
+  return std::max<std::size_t>(
+      1, std::min<std::size_t>(4 * num_threads, count / 4096));
+}
+
+//==============================================================================
+template <typename S>
+template <typename Task>
+void LBVHCollisionManager<S>::forEachBlock(std::size_t count, Task task) const
+{
+  const std::size_t num_blocks = numBlocks(count);
+  detail::parallelFor(num_threads, num_blocks, [&](std::size_t c)
+  {
+    task(c, count * c / num_blocks, count * (c + 1) / num_blocks);
+  });
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::build() const
+{
+  if(!dirty)
+    return;
+
+  dirty = false;
+
+  const std::size_t n = objs.size();
+  if(n == 0)
+  {
+    codes.clear();
+    order.clear();
+    leaf_aabbs.clear();
+    leaf_parents.clear();
+    nodes.clear();
+    return;
+  }
+
+  sortObjects();
+
+  leaf_aabbs.resize(n);
+  leaf_parents.resize(n);
+  nodes.resize(n - 1);
+  forEachBlock(n, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t k = begin; k < end; ++k)
+      leaf_aabbs[k] = aabbs[order[k]];
+  });
+
+  if(n == 1)
+  {
+    leaf_parents[0] = kNoParent;
+    return;
+  }
+
+  // Every internal node is found independently of the others
+  forEachBlock(n - 1, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+      emitNode(static_cast<unsigned int>(i));
+  });
+  nodes[0].parent = kNoParent;
+
+  if(visits_capacity < n - 1)
+  {
+    visits.reset(new std::atomic<unsigned int>[n - 1]);
+    visits_capacity = n - 1;
+  }
+
+  forEachBlock(n - 1, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+      visits[i].store(0, std::memory_order_relaxed);
+  });
+
+  forEachBlock(n, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t k = begin; k < end; ++k)
+      mergeBounds(static_cast<unsigned int>(k));
+  });
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::sortObjects() const
+{
+  const std::size_t n = objs.size();
+
+  // The codes quantize the AABB centers within their bounds
+  const std::size_t num_blocks = numBlocks(n);
+  block_bounds.resize(num_blocks);
+  forEachBlock(n, [&](std::size_t c, std::size_t begin, std::size_t end)
+  {
+    AABB<S> bound(aabbs[begin].center());
+    for(std::size_t i = begin + 1; i < end; ++i)
+      bound += aabbs[i].center();
+    block_bounds[c] = bound;
+  });
+
+  AABB<S> bound = block_bounds[0];
+  for(std::size_t c = 1; c < num_blocks; ++c)
+    bound += block_bounds[c];
+
+  // Flat scenes would divide by a zero extent
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    if(!(bound.max_[axis] > bound.min_[axis]))
+      bound.max_[axis] = bound.min_[axis] + 1;
+  }
+
+  const detail::morton_functor<S, uint64> morton(bound);
+  codes.resize(n);
+  order.resize(n);
+  forEachBlock(n, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      codes[i] = morton(aabbs[i].center());
+      order[i] = static_cast<unsigned int>(i);
+    }
+  });
+
+  detail::radixSort(codes, order, code_buffer, order_buffer, num_threads);
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::emitNode(unsigned int i) const
+{
+  const int k = static_cast<int>(i);
+
+  // The range of the node extends from k in the direction of the neighbor
+  // sharing the longer prefix with it, over all the objects sharing a longer
+  // prefix with k than the other neighbor does
+  const int d = (commonPrefix(k, k + 1) > commonPrefix(k, k - 1)) ? 1 : -1;
+  const int min_prefix = commonPrefix(k, k - d);
+
+  int max_length = 2;
+  while(commonPrefix(k, k + max_length * d) > min_prefix)
+    max_length *= 2;
+
+  int length = 0;
+  for(int step = max_length / 2; step >= 1; step /= 2)
+  {
+    if(commonPrefix(k, k + (length + step) * d) > min_prefix)
+      length += step;
+  }
+  const int j = k + length * d;
+
+  // The range splits after the last object sharing with k a longer prefix
+  // than the whole range does
+  const int node_prefix = commonPrefix(k, j);
+  int split = 0;
+  int step = length;
+  do
+  {
+    step = (step + 1) / 2;
+    if(commonPrefix(k, k + (split + step) * d) > node_prefix)
+      split += step;
+  } while(step > 1);
+  const int gamma = k + split * d + std::min(d, 0);
+
+  Node& node = nodes[i];
+  node.first = static_cast<unsigned int>(std::min(k, j));
+  node.last = static_cast<unsigned int>(std::max(k, j));
+
+  const unsigned int left = static_cast<unsigned int>(gamma);
+  const unsigned int right = left + 1;
+  if(node.first == left)
+  {
+    node.children[0] = left | kLeafFlag;
+    leaf_parents[left] = i;
+  }
+  else
+  {
+    node.children[0] = left;
+    nodes[left].parent = i;
+  }
+
+  if(node.last == right)
+  {
+    node.children[1] = right | kLeafFlag;
+    leaf_parents[right] = i;
+  }
+  else
+  {
+    node.children[1] = right;
+    nodes[right].parent = i;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void LBVHCollisionManager<S>::mergeBounds(unsigned int k) const
+{
+  unsigned int p = leaf_parents[k];
+  while(p != kNoParent)
+  {
+    // The first child to get here leaves the node to the second one, which
+    // then sees the bounds of both
+    if(visits[p].fetch_add(1, std::memory_order_acq_rel) == 0)
+      return;
+
+    Node& node = nodes[p];
+    node.bv = childBV(node.children[0]) + childBV(node.children[1]);
+    p = node.parent;
+  }
+}
+
+//==============================================================================
+template <typename S>
+int LBVHCollisionManager<S>::commonPrefix(int i, int j) const
+{
+  if(j < 0 || j >= static_cast<int>(codes.size()))
+    return -1;
+
+  const uint64 diff = codes[i] ^ codes[j];
+  if(diff != 0)
+    return detail::countLeadingZeros(diff);
+
+  return 64 + detail::countLeadingZeros(static_cast<uint64>(i ^ j));
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& LBVHCollisionManager<S>::childBV(unsigned int child) const
+{
+  if(child & kLeafFlag)
+    return leaf_aabbs[child & ~kLeafFlag];
+
+  return nodes[child].bv;
+}
+
+//==============================================================================
+template <typename S>
+template <typename Visitor>
+bool LBVHCollisionManager<S>::overlapping(
+    const AABB<S>& query_aabb, unsigned int first_leaf, Visitor& visitor) const
+{
+  unsigned int stack[kMaxDepth];
+  std::size_t top = 0;
+  stack[top++] = nodes.empty() ? kLeafFlag : 0;
+
+  while(top > 0)
+  {
+    const unsigned int child = stack[--top];
+    if(child & kLeafFlag)
+    {
+      const unsigned int m = child & ~kLeafFlag;
+      if(m >= first_leaf && leaf_aabbs[m].overlap(query_aabb) && visitor(m))
+        return true;
+      continue;
+    }
+
+    const Node& node = nodes[child];
+    if(node.last < first_leaf || !node.bv.overlap(query_aabb))
+      continue;
+
+    // The first child is visited first, so the objects come in sorted order
+    stack[top++] = node.children[1];
+    stack[top++] = node.children[0];
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool LBVHCollisionManager<S>::collide_(
+    CollisionObject<S>* obj,
+    const AABB<S>& obj_aabb,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  auto report = [&](unsigned int m) -> bool
+  {
+    CollisionObject<S>* other = objs[order[m]];
+    return other != obj && this->canCollide(obj, other)
+        && callback(obj, other, cdata);
+  };
+
+  return overlapping(obj_aabb, 0, report);
+}
+
+//==============================================================================
+template <typename S>
+bool LBVHCollisionManager<S>::distance_(
+    CollisionObject<S>* obj,
+    const AABB<S>& obj_aabb,
+    unsigned int first_leaf,
+    void* cdata,
+    DistanceCallBack<S> callback,
+    S& min_dist) const
+{
+  unsigned int stack[kMaxDepth];
+  std::size_t top = 0;
+  stack[top++] = nodes.empty() ? kLeafFlag : 0;
+
+  while(top > 0)
+  {
+    const unsigned int child = stack[--top];
+    if(child & kLeafFlag)
+    {
+      const unsigned int m = child & ~kLeafFlag;
+      CollisionObject<S>* other = objs[order[m]];
+      if(m >= first_leaf && other != obj
+         && leaf_aabbs[m].distance(obj_aabb) < min_dist
+         && callback(other, obj, cdata, min_dist))
+        return true;
+      continue;
+    }
+
+    const Node& node = nodes[child];
+    if(node.last < first_leaf || node.bv.distance(obj_aabb) >= min_dist)
+      continue;
+
+    // Visit the closer child first, so that min_dist shrinks early
+    const unsigned int c0 = node.children[0];
+    const unsigned int c1 = node.children[1];
+    if(childBV(c0).distance(obj_aabb) <= childBV(c1).distance(obj_aabb))
+    {
+      stack[top++] = c1;
+      stack[top++] = c0;
+    }
+    else
+    {
+      stack[top++] = c0;
+      stack[top++] = c1;
+    }
+  }
+
+  return false;
+}
+
+} // namespace fcl
+
+#endif
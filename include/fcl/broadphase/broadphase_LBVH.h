@@ -0,0 +1,294 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASELBVH_H
+#define FCL_BROADPHASE_BROADPHASELBVH_H
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "fcl/math/bv/AABB.h"
+#include "fcl/broadphase/broadphase_collision_manager.h"
+
+namespace fcl
+{
+
+/// @brief Linear BVH collision manager, rebuilt from scratch at every update.
+///
+/// The tree is built the way GPU linear BVHs are (Karras, "Maximizing
+/// Parallelism in the Construction of BVHs, Octrees, and k-d Trees", 2012):
+/// the objects are radix sorted by the 60 bit Morton code of their AABB
+/// centers, and each of the n - 1 internal nodes finds on its own the range
+/// of sorted objects it covers and where that range splits, from the common
+/// prefixes of the codes. The node bounds are then merged bottom-up, each
+/// node by whichever of its children's threads arrives last. Every step runs
+/// in parallel (see setNumThreads()) and takes linear time, with no pointer
+/// chasing and no allocation once the scene has reached its size.
+///
+/// Unlike DynamicAABBTreeCollisionManager, whose tree is refitted and keeps
+/// its shape as objects move, the tree here never degrades, which pays off
+/// when most objects move every frame. Registering, unregistering and moving
+/// objects is cheap; the tree is rebuilt by update() or setup(), or lazily by
+/// the next query.
+///
+/// Self collision visits the tree once per object, looking only at the
+/// objects after it in the sorted order. With more than one thread, the
+/// candidate pairs are buffered and the callback is called from the calling
+/// thread, in the same order as in a sequential query.
+template <typename S>
+class FCL_EXPORT LBVHCollisionManager : public BroadPhaseCollisionManager<S>
+{
+public:
+
+  LBVHCollisionManager();
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(CollisionObject<S>* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<CollisionObject<S>*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging to the manager
+  void distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
+  void collide(void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager<S>* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager<S>* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  /// @brief use up to num_threads threads to build the tree and to find the
+  /// pairs of self collision; 1 (the default) does all the work in the
+  /// calling thread
+  void setNumThreads(unsigned int num_threads);
+
+  unsigned int getNumThreads() const;
+
+  /// @brief the number of nodes on the longest path from the root to an
+  /// object, 0 for an empty manager
+  std::size_t getTreeDepth() const;
+
+  /// @brief a view of the tree, rebuilt first if it is out of date
+  const detail::AABBHierarchyView<S>* getHierarchyView() const;
+
+protected:
+
+  /// @brief set on a child index that refers to a leaf, i.e. to a position
+  /// in the sorted objects, rather than to an internal node
+  static constexpr unsigned int kLeafFlag = 1u << 31;
+
+  /// @brief parent of the root
+  static constexpr unsigned int kNoParent = ~0u;
+
+  /// @brief the longest root to leaf path. Along a path, each node splits
+  /// its range at a longer common prefix of the 60 bit codes extended by
+  /// the 32 bit leaf positions, so no path has more than 92 internal nodes.
+  static constexpr std::size_t kMaxDepth = 96;
+
+  struct Node
+  {
+    AABB<S> bv;
+
+    /// @brief internal node index, or leaf position with kLeafFlag set
+    unsigned int children[2];
+
+    unsigned int parent;
+
+    /// @brief range of the sorted objects below the node
+    unsigned int first;
+    unsigned int last;
+  };
+
+  /// @brief view of the tree, whose nodes are the child indices of the
+  /// internal nodes
+  class HierarchyView : public detail::AABBHierarchyView<S>
+  {
+  public:
+
+    using ViewNode = typename detail::AABBHierarchyView<S>::Node;
+
+    explicit HierarchyView(const LBVHCollisionManager* manager_);
+
+    void getRoots(std::vector<ViewNode>& roots) const;
+
+    const AABB<S>& getBV(ViewNode node) const;
+
+    bool isLeaf(ViewNode node) const;
+
+    ViewNode getChild(ViewNode node, int i) const;
+
+    CollisionObject<S>* getObject(ViewNode leaf) const;
+
+  private:
+
+    const LBVHCollisionManager* manager;
+  };
+
+  /// @brief the number of blocks to split count items into, each large
+  /// enough to be worth a thread
+  std::size_t numBlocks(std::size_t count) const;
+
+  /// @brief call task(block, begin, end) for the numBlocks(count) blocks of
+  /// [0, count), spread over the threads
+  template <typename Task>
+  void forEachBlock(std::size_t count, Task task) const;
+
+  /// @brief rebuild the tree if objects were added, removed or moved
+  void build() const;
+
+  /// @brief compute the Morton code of every object and sort the objects
+  /// by code
+  void sortObjects() const;
+
+  /// @brief find the children and the range of internal node i
+  void emitNode(unsigned int i) const;
+
+  /// @brief merge the bounds of the internal nodes above leaf k whose other
+  /// subtree is done already
+  void mergeBounds(unsigned int k) const;
+
+  /// @brief length of the common prefix of the codes of the sorted objects
+  /// i and j, extended by their positions to tell equal codes apart; -1
+  /// when j is out of range
+  int commonPrefix(int i, int j) const;
+
+  /// @brief the bounding volume of a node or a leaf
+  const AABB<S>& childBV(unsigned int child) const;
+
+  /// @brief call visitor(m) for each sorted object m after first_leaf whose
+  /// AABB overlaps query_aabb, until the visitor returns true. Returns
+  /// whether it did.
+  template <typename Visitor>
+  bool overlapping(const AABB<S>& query_aabb, unsigned int first_leaf,
+                   Visitor& visitor) const;
+
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager, given the AABB to query with
+  bool collide_(CollisionObject<S>* obj, const AABB<S>& obj_aabb, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and the sorted
+  /// objects after first_leaf, given the AABB to prune with
+  bool distance_(CollisionObject<S>* obj, const AABB<S>& obj_aabb, unsigned int first_leaf, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief all objects in the scene
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief index of each object in objs
+  std::unordered_map<CollisionObject<S>*, std::size_t> obj_index;
+
+  /// @brief the AABB of each object grown by the security margin, as of its
+  /// last update
+  std::vector<AABB<S>> aabbs;
+
+  unsigned int num_threads;
+
+  HierarchyView hierarchy_view;
+
+  /// @brief whether the tree is out of date
+  mutable bool dirty;
+
+  /// @brief Morton code and index in objs of the objects in sorted order,
+  /// and scratch space of the sort
+  mutable std::vector<uint64> codes;
+  mutable std::vector<unsigned int> order;
+  mutable std::vector<uint64> code_buffer;
+  mutable std::vector<unsigned int> order_buffer;
+
+  /// @brief the AABBs of the objects in sorted order
+  mutable std::vector<AABB<S>> leaf_aabbs;
+
+  /// @brief parent node of each sorted object
+  mutable std::vector<unsigned int> leaf_parents;
+
+  /// @brief the internal nodes, the root first
+  mutable std::vector<Node> nodes;
+
+  /// @brief number of children of each internal node whose bounds are done
+  mutable std::unique_ptr<std::atomic<unsigned int>[]> visits;
+  mutable std::size_t visits_capacity;
+
+  /// @brief bounds of the AABB centers of each block of objects
+  mutable std::vector<AABB<S>> block_bounds;
+
+  /// @brief candidate pairs of self collision found by each chunk of sorted
+  /// objects
+  mutable std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+      chunk_pairs;
+};
+
+using LBVHCollisionManagerf = LBVHCollisionManager<float>;
+using LBVHCollisionManagerd = LBVHCollisionManager<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_LBVH-inl.h"
+
+#endif
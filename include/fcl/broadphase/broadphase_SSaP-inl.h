@@ -40,6 +40,10 @@
 
 #include "fcl/broadphase/broadphase_SSaP.h"
 
+#include <algorithm>
+#include <thread>
+#include "fcl/broadphase/detail/parallel_for.h"
+
 namespace fcl
 {
 
@@ -47,6 +51,9 @@ namespace fcl
 extern template
 class FCL_EXPORT SSaPCollisionManager<double>;
 
+extern template
+class FCL_EXPORT SSaPCollisionManager<float>;
+
 /** @brief Functor sorting objects according to the AABB<S> lower x bound */
 template <typename S>
 struct SortByXLow
@@ -146,7 +153,9 @@ void SSaPCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
 
 //==============================================================================
 template <typename S>
-SSaPCollisionManager<S>::SSaPCollisionManager() : setup_(false)
+SSaPCollisionManager<S>::SSaPCollisionManager()
+  : setup_(false),
+    num_threads(1)
 {
   // Do nothing
 }
@@ -167,13 +176,61 @@ void SSaPCollisionManager<S>::setup()
 {
   if(!setup_)
   {
-    std::sort(objs_x.begin(), objs_x.end(), SortByXLow<S>());
-    std::sort(objs_y.begin(), objs_y.end(), SortByYLow<S>());
-    std::sort(objs_z.begin(), objs_z.end(), SortByZLow<S>());
+    // The three axes are independent: sort two of them on their own threads
+    // when there is enough work for it
+    if(num_threads > 1 && size() >= 4096)
+    {
+      std::thread thread_y([this]() { sortAxis(objs_y, SortByYLow<S>()); });
+      std::thread thread_z;
+      if(num_threads > 2)
+        thread_z = std::thread([this]() { sortAxis(objs_z, SortByZLow<S>()); });
+      else
+        sortAxis(objs_z, SortByZLow<S>());
+      sortAxis(objs_x, SortByXLow<S>());
+      thread_y.join();
+      if(thread_z.joinable())
+        thread_z.join();
+    }
+    else
+    {
+      sortAxis(objs_x, SortByXLow<S>());
+      sortAxis(objs_y, SortByYLow<S>());
+      sortAxis(objs_z, SortByZLow<S>());
+    }
     setup_ = true;
   }
 }
 
+//==============================================================================
+template <typename S>
+template <typename Compare>
+void SSaPCollisionManager<S>::sortAxis(
+    std::vector<CollisionObject<S>*>& objs, Compare comp)
+{
+  // Objects that moved a little are only a few places away from their new
+  // position. Past a few moves per object, sorting from scratch is cheaper.
+  size_t max_moves = 8 * objs.size();
+  for(size_t i = 1; i < objs.size(); ++i)
+  {
+    CollisionObject<S>* obj = objs[i];
+    size_t j = i;
+    while(j > 0 && comp(obj, objs[j - 1]))
+    {
+      if(max_moves == 0)
+      {
+        objs[j] = obj;
+        std::sort(objs.begin(), objs.end(), comp);
+        return;
+      }
+      --max_moves;
+
+      objs[j] = objs[j - 1];
+      --j;
+    }
+    objs[j] = obj;
+  }
+}
+
 //==============================================================================
 template <typename S>
 void SSaPCollisionManager<S>::update()
@@ -205,11 +262,15 @@ template <typename S>
 bool SSaPCollisionManager<S>::checkColl(typename std::vector<CollisionObject<S>*>::const_iterator pos_start, typename std::vector<CollisionObject<S>*>::const_iterator pos_end,
                                      CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
 {
+  AABB<S> obj_aabb = obj->getAABB();
+  inflateBV(obj_aabb, this->security_margin);
+
   while(pos_start < pos_end)
   {
     if(*pos_start != obj) // no collision between the same object
     {
-      if((*pos_start)->getAABB().overlap(obj->getAABB()))
+      if((*pos_start)->getAABB().overlap(obj_aabb)
+         && this->canCollide(*pos_start, obj))
       {
         if(callback(*pos_start, obj, cdata))
           return true;
@@ -255,7 +316,7 @@ bool SSaPCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cdata, Col
 {
   static const unsigned int CUTOFF = 100;
 
-  DummyCollisionObject<S> dummyHigh(AABB<S>(obj->getAABB().max_));
+  DummyCollisionObject<S> dummyHigh(AABB<S>(obj->getAABB().max_ + Vector3<S>::Constant(this->security_margin)));
   bool coll_res = false;
 
   const auto pos_start1 = objs_x.begin();
@@ -448,57 +509,96 @@ size_t SSaPCollisionManager<S>::selectOptimalAxis(
 
 //==============================================================================
 template <typename S>
-void SSaPCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
+template <typename Visitor>
+bool SSaPCollisionManager<S>::sweep(
+    size_t axis, size_t begin, size_t end, Visitor& visitor) const
 {
-  if(size() == 0) return;
+  const size_t axis2 = (axis + 1 > 2) ? 0 : (axis + 1);
+  const size_t axis3 = (axis2 + 1 > 2) ? 0 : (axis2 + 1);
+  const S margin = this->security_margin;
+  const size_t n = sweep_aabbs.size();
 
-  typename std::vector<CollisionObject<S>*>::const_iterator pos, run_pos, pos_end;
-  size_t axis = selectOptimalAxis(objs_x, objs_y, objs_z,
-                                  pos, pos_end);
-  size_t axis2 = (axis + 1 > 2) ? 0 : (axis + 1);
-  size_t axis3 = (axis2 + 1 > 2) ? 0 : (axis2 + 1);
-
-  run_pos = pos;
-
-  while((run_pos < pos_end) && (pos < pos_end))
+  for(size_t k = begin; k < end; ++k)
   {
-    CollisionObject<S>* obj = *(pos++);
+    const AABB<S>& aabb = sweep_aabbs[k];
+    const S upper = aabb.max_[axis] + margin;
 
-    while(1)
+    // The objects after k in the order start after it: only those starting
+    // before it ends can overlap it, in this chunk or in the next ones
+    for(size_t m = k + 1; m < n && sweep_aabbs[m].min_[axis] <= upper; ++m)
     {
-      if((*run_pos)->getAABB().min_[axis] < obj->getAABB().min_[axis])
-      {
-        run_pos++;
-        if(run_pos == pos_end) break;
-        continue;
-      }
-      else
+      const AABB<S>& other = sweep_aabbs[m];
+      if((aabb.max_[axis2] + margin >= other.min_[axis2])
+         && (other.max_[axis2] + margin >= aabb.min_[axis2])
+         && (aabb.max_[axis3] + margin >= other.min_[axis3])
+         && (other.max_[axis3] + margin >= aabb.min_[axis3]))
       {
-        run_pos++;
-        break;
+        if(visitor(k, m))
+          return true;
       }
     }
+  }
 
-    if(run_pos < pos_end)
-    {
-      typename std::vector<CollisionObject<S>*>::const_iterator run_pos2 = run_pos;
+  return false;
+}
 
-      while((*run_pos2)->getAABB().min_[axis] <= obj->getAABB().max_[axis])
-      {
-        CollisionObject<S>* obj2 = *run_pos2;
-        run_pos2++;
+//==============================================================================
+template <typename S>
+void SSaPCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
 
-        if((obj->getAABB().max_[axis2] >= obj2->getAABB().min_[axis2]) && (obj2->getAABB().max_[axis2] >= obj->getAABB().min_[axis2]))
-        {
-          if((obj->getAABB().max_[axis3] >= obj2->getAABB().min_[axis3]) && (obj2->getAABB().max_[axis3] >= obj->getAABB().min_[axis3]))
-          {
-            if(callback(obj, obj2, cdata))
-              return;
-          }
-        }
+  typename std::vector<CollisionObject<S>*>::const_iterator pos, pos_end;
+  size_t axis = selectOptimalAxis(objs_x, objs_y, objs_z,
+                                  pos, pos_end);
 
-        if(run_pos2 == pos_end) break;
-      }
+  // Copy the AABBs in sweep order so that the sweep reads them in sequence
+  const size_t n = size();
+  sweep_aabbs.resize(n);
+  for(size_t k = 0; k < n; ++k)
+    sweep_aabbs[k] = pos[k]->getAABB();
+
+  // Chunks of at least a few thousand objects, a few per thread so that the
+  // threads stay busy when the density varies along the axis
+  const size_t num_chunks = std::min<size_t>(4 * num_threads, n / 2048);
+
+  if(num_threads <= 1 || num_chunks <= 1)
+  {
+    auto report = [&](size_t k, size_t m) -> bool
+    {
+      return this->canCollide(pos[k], pos[m])
+          && callback(pos[k], pos[m], cdata);
+    };
+    sweep(axis, 0, n, report);
+    return;
+  }
+
+  if(chunk_pairs.size() < num_chunks)
+    chunk_pairs.resize(num_chunks);
+
+  auto collectChunk = [&](size_t c)
+  {
+    auto& pairs = chunk_pairs[c];
+    pairs.clear();
+    auto collect = [&](size_t k, size_t m) -> bool
+    {
+      if(!this->canCollide(pos[k], pos[m]))
+        return false;
+      pairs.emplace_back(static_cast<unsigned int>(k),
+                         static_cast<unsigned int>(m));
+      return false;
+    };
+    sweep(axis, n * c / num_chunks, n * (c + 1) / num_chunks, collect);
+  };
+  detail::parallelFor(num_threads, num_chunks, collectChunk);
+
+  // The callback is not assumed to be thread safe
+  for(size_t c = 0; c < num_chunks; ++c)
+  {
+    for(const auto& pair : chunk_pairs[c])
+    {
+      if(callback(pos[pair.first], pos[pair.second], cdata))
+        return;
     }
   }
 }
@@ -524,7 +624,12 @@ void SSaPCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback
 template <typename S>
 void SSaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  SSaPCollisionManager* other_manager = static_cast<SSaPCollisionManager*>(other_manager_);
+  SSaPCollisionManager* other_manager = dynamic_cast<SSaPCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -552,7 +657,12 @@ void SSaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manag
 template <typename S>
 void SSaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  SSaPCollisionManager* other_manager = static_cast<SSaPCollisionManager*>(other_manager_);
+  SSaPCollisionManager* other_manager = dynamic_cast<SSaPCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -590,6 +700,20 @@ size_t SSaPCollisionManager<S>::size() const
   return objs_x.size();
 }
 
+//==============================================================================
+template <typename S>
+void SSaPCollisionManager<S>::setNumThreads(unsigned int num_threads)
+{
+  this->num_threads = std::max(num_threads, 1u);
+}
+
+//==============================================================================
+template <typename S>
+unsigned int SSaPCollisionManager<S>::getNumThreads() const
+{
+  return num_threads;
+}
+
 } // namespace fcl
 
 #endif
@@ -44,7 +44,18 @@
 namespace fcl
 {
 
-/// @brief Simple SAP collision manager 
+/// @brief Simple SAP collision manager
+///
+/// Self collision sweeps the objects sorted along one axis. With more than one
+/// thread (see setNumThreads()), the sorted objects are split into chunks that
+/// the threads take in turn; the sweep from an object may run past the end of
+/// its chunk into the next ones. The candidate pairs of each chunk are
+/// buffered, and the callback is called from the calling thread once the sweep
+/// is done, in the same order as a sequential sweep.
+///
+/// update() re-sorts the objects by insertion sort, which takes linear time
+/// when few of them moved, and sorts them from scratch if that takes too many
+/// moves.
 template <typename S>
 class FCL_EXPORT SSaPCollisionManager : public BroadPhaseCollisionManager<S>
 {
@@ -93,6 +104,13 @@ public:
   /// @brief the number of objects managed by the manager
   size_t size() const;
 
+  /// @brief use up to num_threads threads to sort the objects and to sweep
+  /// them for self collision; 1 (the default) does all the work in the
+  /// calling thread
+  void setNumThreads(unsigned int num_threads);
+
+  unsigned int getNumThreads() const;
+
 protected:
   /// @brief check collision between one object and a list of objects, return value is whether stop is possible
   bool checkColl(typename std::vector<CollisionObject<S>*>::const_iterator pos_start, typename std::vector<CollisionObject<S>*>::const_iterator pos_end,
@@ -113,6 +131,17 @@ protected:
       typename std::vector<CollisionObject<S>*>::const_iterator& it_beg,
       typename std::vector<CollisionObject<S>*>::const_iterator& it_end);
 
+  /// @brief sort objects along one axis, by insertion sort while they need
+  /// few moves and from scratch otherwise
+  template <typename Compare>
+  static void sortAxis(std::vector<CollisionObject<S>*>& objs, Compare comp);
+
+  /// @brief call visitor(k, m) for the pairs of sweep_aabbs whose AABBs
+  /// overlap, k being in [begin, end) and m > k. Stops and returns true as
+  /// soon as the visitor returns true.
+  template <typename Visitor>
+  bool sweep(size_t axis, size_t begin, size_t end, Visitor& visitor) const;
+
   /// @brief Objects sorted according to lower x value
   std::vector<CollisionObject<S>*> objs_x;
 
@@ -124,6 +153,16 @@ protected:
 
   /// @brief tag about whether the environment is maintained suitably (i.e., the objs_x, objs_y, objs_z are sorted correctly
   bool setup_;
+
+  unsigned int num_threads;
+
+  /// @brief AABBs of the objects in the order of the swept axis
+  mutable std::vector<AABB<S>> sweep_aabbs;
+
+  /// @brief candidate pairs found in each chunk of a parallel sweep, as
+  /// positions in the order of the swept axis
+  mutable std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+      chunk_pairs;
 };
 
 using SSaPCollisionManagerf = SSaPCollisionManager<float>;
@@ -47,25 +47,19 @@ namespace fcl
 extern template
 class FCL_EXPORT SaPCollisionManager<double>;
 
+extern template
+class FCL_EXPORT SaPCollisionManager<float>;
+
 //==============================================================================
 template <typename S>
 void SaPCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
 {
-  auto it = AABB_arr.begin();
-  for(auto end = AABB_arr.end(); it != end; ++it)
-  {
-    if((*it)->obj == obj)
-      break;
-  }
-
-  AABB_arr.erase(it);
-  obj_aabb_map.erase(obj);
-
+  const auto it = AABB_arr.find(obj);
   if(it == AABB_arr.end())
     return;
 
-  SaPAABB* curr = *it;
-  *it = nullptr;
+  SaPAABB* curr = it->second;
+  AABB_arr.erase(it);
 
   for(int coord = 0; coord < 3; ++coord)
   {
@@ -92,6 +86,8 @@ void SaPCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
   delete curr;
 
   overlap_pairs.remove_if(isUnregistered(obj));
+
+  updateVelist();
 }
 \
 //==============================================================================
@@ -130,15 +126,14 @@ void SaPCollisionManager<S>::registerObjects(const std::vector<CollisionObject<S
       sapaabb->obj = other_objs[i];
       sapaabb->lo = new EndPoint();
       sapaabb->hi = new EndPoint();
-      sapaabb->cached = other_objs[i]->getAABB();
+      sapaabb->cached = this->marginAABB(other_objs[i]);
       endpoints[2 * i] = sapaabb->lo;
       endpoints[2 * i + 1] = sapaabb->hi;
       sapaabb->lo->minmax = 0;
       sapaabb->hi->minmax = 1;
       sapaabb->lo->aabb = sapaabb;
       sapaabb->hi->aabb = sapaabb;
-      AABB_arr.push_back(sapaabb);
-      obj_aabb_map[other_objs[i]] = sapaabb;
+      AABB_arr.insert(other_objs[i], sapaabb);
     }
 
 
@@ -206,7 +201,7 @@ template <typename S>
 void SaPCollisionManager<S>::registerObject(CollisionObject<S>* obj)
 {
   SaPAABB* curr = new SaPAABB;
-  curr->cached = obj->getAABB();
+  curr->cached = this->marginAABB(obj);
   curr->obj = obj;
   curr->lo = new EndPoint;
   curr->lo->minmax = 0;
@@ -294,9 +289,7 @@ void SaPCollisionManager<S>::registerObject(CollisionObject<S>* obj)
     }
   }
 
-  AABB_arr.push_back(curr);
-
-  obj_aabb_map[obj] = curr;
+  AABB_arr.insert(obj, curr);
 
   updateVelist();
 }
@@ -321,16 +314,17 @@ void SaPCollisionManager<S>::setup()
 template <typename S>
 void SaPCollisionManager<S>::update_(SaPAABB* updated_aabb)
 {
-  if(updated_aabb->cached.equal(updated_aabb->obj->getAABB()))
+  const AABB<S> new_aabb = this->marginAABB(updated_aabb->obj);
+  if(updated_aabb->cached.equal(new_aabb))
     return;
 
   SaPAABB* current = updated_aabb;
 
-  Vector3<S> new_min = current->obj->getAABB().min_;
-  Vector3<S> new_max = current->obj->getAABB().max_;
+  Vector3<S> new_min = new_aabb.min_;
+  Vector3<S> new_max = new_aabb.max_;
 
   SaPAABB dummy;
-  dummy.cached = current->obj->getAABB();
+  dummy.cached = new_aabb;
 
   for(int coord = 0; coord < 3; ++coord)
   {
@@ -483,7 +477,9 @@ void SaPCollisionManager<S>::updateVelist()
 template <typename S>
 void SaPCollisionManager<S>::update(CollisionObject<S>* updated_obj)
 {
-  update_(obj_aabb_map[updated_obj]);
+  const auto it = AABB_arr.find(updated_obj);
+  if(it != AABB_arr.end())
+    update_(it->second);
 
   updateVelist();
 
@@ -495,7 +491,11 @@ template <typename S>
 void SaPCollisionManager<S>::update(const std::vector<CollisionObject<S>*>& updated_objs)
 {
   for(size_t i = 0; i < updated_objs.size(); ++i)
-    update_(obj_aabb_map[updated_objs[i]]);
+  {
+    const auto it = AABB_arr.find(updated_objs[i]);
+    if(it != AABB_arr.end())
+      update_(it->second);
+  }
 
   updateVelist();
 
@@ -508,7 +508,7 @@ void SaPCollisionManager<S>::update()
 {
   for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
   {
-    update_(*it);
+    update_(it->second);
   }
 
   updateVelist();
@@ -522,10 +522,9 @@ void SaPCollisionManager<S>::clear()
 {
   for(auto it = AABB_arr.begin(), end = AABB_arr.end(); it != end; ++it)
   {
-    delete (*it)->hi;
-    delete (*it)->lo;
-    delete *it;
-    *it = nullptr;
+    delete it->second->hi;
+    delete it->second->lo;
+    delete it->second;
   }
 
   AABB_arr.clear();
@@ -538,8 +537,6 @@ void SaPCollisionManager<S>::clear()
   velist[0].clear();
   velist[1].clear();
   velist[2].clear();
-
-  obj_aabb_map.clear();
 }
 
 //==============================================================================
@@ -550,7 +547,7 @@ void SaPCollisionManager<S>::getObjects(std::vector<CollisionObject<S>*>& objs)
   int i = 0;
   for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it, ++i)
   {
-    objs[i] = (*it)->obj;
+    objs[i] = it->first;
   }
 }
 
@@ -559,7 +556,7 @@ template <typename S>
 bool SaPCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
 {
   size_t axis = optimal_axis;
-  const AABB<S>& obj_aabb = obj->getAABB();
+  const AABB<S> obj_aabb = this->marginAABB(obj);
 
   S min_val = obj_aabb.min_[axis];
   //  S max_val = obj_aabb.max_[axis];
@@ -588,7 +585,8 @@ bool SaPCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cdata, Coll
     {
       if((pos->minmax == 0) && (pos->aabb->hi->getVal(axis) >= min_val))
       {
-        if(pos->aabb->cached.overlap(obj->getAABB()))
+        if(pos->aabb->cached.overlap(obj_aabb)
+           && this->canCollide(obj, pos->aabb->obj))
           if(callback(obj, pos->aabb->obj, cdata))
             return true;
       }
@@ -776,7 +774,7 @@ void SaPCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback)
     CollisionObject<S>* obj1 = it->obj1;
     CollisionObject<S>* obj2 = it->obj2;
 
-    if(callback(obj1, obj2, cdata))
+    if(this->canCollide(obj1, obj2) && callback(obj1, obj2, cdata))
       return;
   }
 }
@@ -794,7 +792,7 @@ void SaPCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback)
 
   for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
   {
-    if(distance_((*it)->obj, cdata, callback, min_dist))
+    if(distance_(it->first, cdata, callback, min_dist))
       break;
   }
 
@@ -806,7 +804,12 @@ void SaPCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback)
 template <typename S>
 void SaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  SaPCollisionManager* other_manager = static_cast<SaPCollisionManager*>(other_manager_);
+  SaPCollisionManager* other_manager = dynamic_cast<SaPCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -820,7 +823,7 @@ void SaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manage
   {
     for(auto it = AABB_arr.cbegin(); it != AABB_arr.cend(); ++it)
     {
-      if(other_manager->collide_((*it)->obj, cdata, callback))
+      if(other_manager->collide_(it->first, cdata, callback))
         return;
     }
   }
@@ -828,7 +831,7 @@ void SaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manage
   {
     for(auto it = other_manager->AABB_arr.cbegin(), end = other_manager->AABB_arr.cend(); it != end; ++it)
     {
-      if(collide_((*it)->obj, cdata, callback))
+      if(collide_(it->first, cdata, callback))
         return;
     }
   }
@@ -838,7 +841,12 @@ void SaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manage
 template <typename S>
 void SaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  SaPCollisionManager* other_manager = static_cast<SaPCollisionManager*>(other_manager_);
+  SaPCollisionManager* other_manager = dynamic_cast<SaPCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -854,7 +862,7 @@ void SaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manag
   {
     for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
     {
-      if(other_manager->distance_((*it)->obj, cdata, callback, min_dist))
+      if(other_manager->distance_(it->first, cdata, callback, min_dist))
         return;
     }
   }
@@ -862,7 +870,7 @@ void SaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manag
   {
     for(auto it = other_manager->AABB_arr.cbegin(), end = other_manager->AABB_arr.cend(); it != end; ++it)
     {
-      if(distance_((*it)->obj, cdata, callback, min_dist))
+      if(distance_(it->first, cdata, callback, min_dist))
         return;
     }
   }
@@ -38,10 +38,10 @@
 #ifndef FCL_BROAD_PHASE_SAP_H
 #define FCL_BROAD_PHASE_SAP_H
 
-#include <map>
 #include <list>
 
 #include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/proxy_table.h"
 
 namespace fcl
 {
@@ -134,16 +134,15 @@ protected:
   /// @brief vector version of elist, for acceleration
   std::vector<EndPoint*> velist[3];
 
-  /// @brief SAP interval list
-  std::list<SaPAABB*> AABB_arr;
+  /// @brief SAP intervals of the objects, found through the handles of the
+  /// objects
+  detail::ProxyTable<S, SaPAABB*> AABB_arr;
 
   /// @brief The pair of objects that should further check for collision
   std::list<SaPPair> overlap_pairs;
 
   size_t optimal_axis;
 
-  std::map<CollisionObject<S>*, SaPAABB*> obj_aabb_map;
-
   bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
 
   bool collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
@@ -0,0 +1,727 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASESAPARRAY_INL_H
+#define FCL_BROADPHASE_BROADPHASESAPARRAY_INL_H
+
+#include "fcl/broadphase/broadphase_SaP_array.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT SaPCollisionManager_Array<double>;
+
+extern template
+class FCL_EXPORT SaPCollisionManager_Array<float>;
+
+//==============================================================================
+template <typename S>
+SaPCollisionManager_Array<S>::SaPCollisionManager_Array()
+  : optimal_axis(0),
+    dirty(false),
+    needs_rebuild(false),
+    num_direct_rebuilds(0),
+    num_rebuilds(0)
+{
+  max_extent[0] = max_extent[1] = max_extent[2] = 0;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::registerObjects(
+    const std::vector<CollisionObject<S>*>& other_objs)
+{
+  const std::size_t old_size = objs.size();
+
+  objs.reserve(objs.size() + other_objs.size());
+  aabbs.reserve(aabbs.size() + other_objs.size());
+  for(auto* obj : other_objs)
+    registerObject(obj);
+
+  // Inserting many objects one by one costs more than sorting from scratch
+  if(objs.size() - old_size > old_size / 8)
+    needs_rebuild = true;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::registerObject(CollisionObject<S>* obj)
+{
+  if(!obj_index.emplace(obj, objs.size()).second)
+    return;
+
+  const unsigned int index = static_cast<unsigned int>(objs.size());
+  objs.push_back(obj);
+  aabbs.push_back(this->marginAABB(obj));
+
+  // The new end points go at the back, from where the next sort moves them
+  // into place
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    values[axis].push_back(aabbs.back().min_[axis]);
+    ids[axis].push_back(2 * index);
+    values[axis].push_back(aabbs.back().max_[axis]);
+    ids[axis].push_back(2 * index + 1);
+  }
+
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::unregisterObject(CollisionObject<S>* obj)
+{
+  auto it = obj_index.find(obj);
+  if(it == obj_index.end())
+    return;
+
+  const unsigned int index = static_cast<unsigned int>(it->second);
+  const unsigned int last = static_cast<unsigned int>(objs.size() - 1);
+  obj_index.erase(it);
+
+  // The last object takes the place of the removed one
+  objs[index] = objs[last];
+  aabbs[index] = aabbs[last];
+  objs.pop_back();
+  aabbs.pop_back();
+  if(index != last)
+    obj_index[objs[index]] = index;
+
+  if(needs_rebuild)
+    return;
+
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    std::size_t count = 0;
+    for(std::size_t p = 0; p < ids[axis].size(); ++p)
+    {
+      unsigned int id = ids[axis][p];
+      if((id >> 1) == index)
+        continue;
+      if((id >> 1) == last)
+        id = 2 * index + (id & 1);
+
+      values[axis][count] = values[axis][p];
+      ids[axis][count] = id;
+      ++count;
+    }
+    values[axis].resize(count);
+    ids[axis].resize(count);
+  }
+
+  // Drop the pairs of the removed object and renumber those of the moved one
+  std::vector<std::pair<unsigned int, unsigned int>> renumbered;
+  auto collect = [&](unsigned int a, unsigned int b) -> bool
+  {
+    if(a == index || b == index || a == last || b == last)
+      renumbered.emplace_back(a, b);
+    return false;
+  };
+  overlap_pairs.forEach(collect);
+
+  for(const auto& pair : renumbered)
+    overlap_pairs.erase(pair.first, pair.second);
+
+  for(const auto& pair : renumbered)
+  {
+    if(pair.first == index || pair.second == index)
+      continue;
+
+    overlap_pairs.insert(pair.first == last ? index : pair.first,
+                         pair.second == last ? index : pair.second);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::setup()
+{
+  sort();
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::update()
+{
+  for(std::size_t i = 0; i < objs.size(); ++i)
+    aabbs[i] = this->marginAABB(objs[i]);
+
+  dirty = true;
+  sort();
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::update(CollisionObject<S>* updated_obj)
+{
+  auto it = obj_index.find(updated_obj);
+  if(it == obj_index.end())
+    return;
+
+  aabbs[it->second] = this->marginAABB(updated_obj);
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::update(
+    const std::vector<CollisionObject<S>*>& updated_objs)
+{
+  for(auto* obj : updated_objs)
+    update(obj);
+
+  sort();
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::clear()
+{
+  objs.clear();
+  obj_index.clear();
+  aabbs.clear();
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    values[axis].clear();
+    ids[axis].clear();
+    max_extent[axis] = 0;
+  }
+  overlap_pairs.clear();
+  optimal_axis = 0;
+  dirty = false;
+  needs_rebuild = false;
+  num_direct_rebuilds = 0;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::getObjects(
+    std::vector<CollisionObject<S>*>& objs) const
+{
+  objs = this->objs;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::collide(
+    CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  sort();
+  collide_(obj, this->marginAABB(obj), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::distance(
+    CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  sort();
+  S min_dist = std::numeric_limits<S>::max();
+  distance_(obj, 0, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::collide(
+    void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  sort();
+
+  auto visitor = [&](unsigned int a, unsigned int b) -> bool
+  {
+    return this->canCollide(objs[a], objs[b])
+        && callback(objs[a], objs[b], cdata);
+  };
+  overlap_pairs.forEach(visitor);
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::distance(
+    void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  sort();
+
+  // Each pair is considered from its object of lower index only
+  S min_dist = std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    if(distance_(objs[i], i + 1, cdata, callback, min_dist))
+      return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::collide(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<SaPCollisionManager_Array<S>*>(
+      other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  sort();
+  other_manager->sort();
+
+  // Query the larger manager with the objects of the smaller one, grown by
+  // the margin of the manager they belong to
+  if(this->size() < other_manager->size())
+  {
+    for(std::size_t i = 0; i < objs.size(); ++i)
+    {
+      if(other_manager->collide_(objs[i], aabbs[i], cdata, callback))
+        return;
+    }
+  }
+  else
+  {
+    for(std::size_t i = 0; i < other_manager->objs.size(); ++i)
+    {
+      if(collide_(other_manager->objs[i], other_manager->aabbs[i],
+                  cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::distance(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    DistanceCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<SaPCollisionManager_Array<S>*>(
+      other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+
+  sort();
+  other_manager->sort();
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  if(this->size() < other_manager->size())
+  {
+    for(const auto& obj : objs)
+      if(other_manager->distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+  else
+  {
+    for(const auto& obj : other_manager->objs)
+      if(distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool SaPCollisionManager_Array<S>::empty() const
+{
+  return objs.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t SaPCollisionManager_Array<S>::size() const
+{
+  return objs.size();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t SaPCollisionManager_Array<S>::numOverlapPairs() const
+{
+  sort();
+
+  return overlap_pairs.size();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t SaPCollisionManager_Array<S>::numRebuilds() const
+{
+  return num_rebuilds;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::sort() const
+{
+  if(needs_rebuild)
+  {
+    rebuild();
+    return;
+  }
+
+  if(!dirty)
+    return;
+
+  // Motion that was too large once likely still is: sort from scratch the
+  // next few times rather than give up on insertion sort half way each time
+  if(num_direct_rebuilds > 0)
+  {
+    --num_direct_rebuilds;
+    rebuild();
+    return;
+  }
+
+  // Sorting from scratch and sweeping again costs about as much as fifty
+  // swaps per object
+  std::size_t max_swaps = 48 * objs.size();
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    refreshValues(axis);
+    if(!insertionSort(axis, max_swaps))
+    {
+      num_direct_rebuilds = 3;
+      rebuild();
+      return;
+    }
+  }
+
+  selectAxis();
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::rebuild() const
+{
+  const std::size_t n = objs.size();
+
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    // Lower end points first, so that the stable sort keeps them before the
+    // upper ones of equal value: touching AABBs overlap
+    keys.resize(2 * n);
+    values[axis].resize(2 * n);
+    ids[axis].resize(2 * n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      keys[i] = detail::SortableKey<S>::encode(aabbs[i].min_[axis]);
+      ids[axis][i] = static_cast<unsigned int>(2 * i);
+      keys[n + i] = detail::SortableKey<S>::encode(aabbs[i].max_[axis]);
+      ids[axis][n + i] = static_cast<unsigned int>(2 * i + 1);
+    }
+
+    detail::radixSort(keys, ids[axis], key_buffer, id_buffer);
+    refreshValues(axis);
+  }
+
+  selectAxis();
+
+  // Sweep along the chosen axis: each object, in the order of its lower end
+  // point, is tested against the following ones that start before it ends.
+  // The AABBs are copied in that order so the sweep reads them in sequence.
+  const std::size_t axis = optimal_axis;
+  overlap_pairs.clear();
+  order.clear();
+  sorted_aabbs.clear();
+  for(const auto id : ids[axis])
+  {
+    if(id & 1)
+      continue;
+
+    order.push_back(id >> 1);
+    sorted_aabbs.push_back(aabbs[id >> 1]);
+  }
+
+  const std::size_t axis1 = (axis + 1) % 3;
+  const std::size_t axis2 = (axis + 2) % 3;
+  for(std::size_t k = 0; k < n; ++k)
+  {
+    const AABB<S>& aabb = sorted_aabbs[k];
+    for(std::size_t m = k + 1;
+        m < n && sorted_aabbs[m].min_[axis] <= aabb.max_[axis]; ++m)
+    {
+      // Only the other two axes are left to test
+      const AABB<S>& other = sorted_aabbs[m];
+      if(other.min_[axis1] <= aabb.max_[axis1]
+         && aabb.min_[axis1] <= other.max_[axis1]
+         && other.min_[axis2] <= aabb.max_[axis2]
+         && aabb.min_[axis2] <= other.max_[axis2])
+        overlap_pairs.insert(order[k], order[m]);
+    }
+  }
+
+  ++num_rebuilds;
+  dirty = false;
+  needs_rebuild = false;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::refreshValues(std::size_t axis) const
+{
+  S extent = 0;
+  for(std::size_t p = 0; p < ids[axis].size(); ++p)
+  {
+    const AABB<S>& aabb = aabbs[ids[axis][p] >> 1];
+    if(ids[axis][p] & 1)
+    {
+      values[axis][p] = aabb.max_[axis];
+      extent = std::max(extent, aabb.max_[axis] - aabb.min_[axis]);
+    }
+    else
+    {
+      values[axis][p] = aabb.min_[axis];
+    }
+  }
+
+  max_extent[axis] = extent;
+}
+
+//==============================================================================
+template <typename S>
+bool SaPCollisionManager_Array<S>::insertionSort(
+    std::size_t axis, std::size_t& max_swaps) const
+{
+  std::vector<S>& v = values[axis];
+  std::vector<unsigned int>& id = ids[axis];
+
+  for(std::size_t p = 1; p < v.size(); ++p)
+  {
+    const S value = v[p];
+    const unsigned int moving = id[p];
+    const bool moving_upper = (moving & 1) != 0;
+
+    // Lower end points go before the upper ones of equal value
+    std::size_t q = p;
+    while(q > 0
+          && (value < v[q - 1]
+              || (value == v[q - 1] && !moving_upper && (id[q - 1] & 1))))
+    {
+      if(max_swaps == 0)
+        return false;
+      --max_swaps;
+
+      const unsigned int other = id[q - 1];
+      const bool other_upper = (other & 1) != 0;
+      if(!moving_upper && other_upper)
+      {
+        // A lower end point passing an upper one: the intervals start to
+        // overlap along this axis, and maybe along all of them
+        if(aabbs[moving >> 1].overlap(aabbs[other >> 1]))
+          overlap_pairs.insert(moving >> 1, other >> 1);
+      }
+      else if(moving_upper && !other_upper)
+      {
+        // An upper end point passing a lower one: the intervals separate
+        overlap_pairs.erase(moving >> 1, other >> 1);
+      }
+
+      v[q] = v[q - 1];
+      id[q] = other;
+      --q;
+    }
+
+    v[q] = value;
+    id[q] = moving;
+  }
+
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+void SaPCollisionManager_Array<S>::selectAxis() const
+{
+  if(objs.empty())
+    return;
+
+  S best_scale = -1;
+  for(std::size_t axis = 0; axis < 3; ++axis)
+  {
+    const S scale = values[axis].back() - values[axis].front();
+    if(scale > best_scale)
+    {
+      best_scale = scale;
+      optimal_axis = axis;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool SaPCollisionManager_Array<S>::collide_(
+    CollisionObject<S>* obj,
+    const AABB<S>& obj_aabb,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  const std::size_t axis = optimal_axis;
+  const std::vector<S>& v = values[axis];
+  const S min_val = obj_aabb.min_[axis];
+  const S max_val = obj_aabb.max_[axis];
+
+  // Lower end points of the overlapping intervals lie in
+  // [min_val - max_extent, max_val]
+  const auto begin = std::lower_bound(v.begin(), v.end(),
+                                      min_val - max_extent[axis]);
+  const auto end = std::upper_bound(begin, v.end(), max_val);
+
+  for(auto p = static_cast<std::size_t>(begin - v.begin()),
+      p_end = static_cast<std::size_t>(end - v.begin()); p < p_end; ++p)
+  {
+    const unsigned int id = ids[axis][p];
+    if(id & 1)
+      continue;
+
+    const unsigned int i = id >> 1;
+    if(aabbs[i].max_[axis] >= min_val && objs[i] != obj
+       && aabbs[i].overlap(obj_aabb)
+       && this->canCollide(obj, objs[i])
+       && callback(obj, objs[i], cdata))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool SaPCollisionManager_Array<S>::distance_(
+    CollisionObject<S>* obj,
+    std::size_t first_index,
+    void* cdata,
+    DistanceCallBack<S> callback,
+    S& min_dist) const
+{
+  const AABB<S>& obj_aabb = obj->getAABB();
+  const std::size_t axis = optimal_axis;
+  const std::vector<S>& v = values[axis];
+  const S scene_min = v.front();
+  const S scene_max = v.back();
+
+  // Without a bound on the distance yet, search windows of doubling size
+  // along the axis until one finds a candidate, then search once more with
+  // the distance found as the bound
+  bool bounded = min_dist < std::numeric_limits<S>::max();
+  S radius = min_dist;
+  if(!bounded)
+  {
+    radius = std::max(obj_aabb.min_[axis] - scene_max,
+                      scene_min - obj_aabb.max_[axis]);
+    radius = std::max(radius, (scene_max - scene_min) / objs.size());
+    radius = std::max(radius,
+                      (obj_aabb.max_ - obj_aabb.min_).maxCoeff() / 2);
+  }
+
+  while(true)
+  {
+    const S min_val = obj_aabb.min_[axis] - radius;
+    const S max_val = obj_aabb.max_[axis] + radius;
+    const bool last = (min_val <= scene_min && max_val >= scene_max)
+        || !(radius < std::numeric_limits<S>::max() / 2);
+
+    const auto begin = std::lower_bound(v.begin(), v.end(),
+                                        min_val - max_extent[axis]);
+    const auto end = std::upper_bound(begin, v.end(), max_val);
+
+    for(auto p = static_cast<std::size_t>(begin - v.begin()),
+        p_end = static_cast<std::size_t>(end - v.begin()); p < p_end; ++p)
+    {
+      const unsigned int id = ids[axis][p];
+      const unsigned int i = id >> 1;
+      if((id & 1) || i < first_index || objs[i] == obj
+         || aabbs[i].max_[axis] < min_val)
+        continue;
+
+      if(aabbs[i].distance(obj_aabb) < min_dist
+         && callback(objs[i], obj, cdata, min_dist))
+        return true;
+    }
+
+    if(bounded || last)
+      return false;
+
+    if(min_dist < std::numeric_limits<S>::max())
+    {
+      bounded = true;
+      radius = min_dist;
+    }
+    else
+    {
+      radius *= 2;
+    }
+  }
+}
+
+} // namespace fcl
+
+#endif
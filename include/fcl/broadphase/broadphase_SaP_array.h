@@ -0,0 +1,203 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASESAPARRAY_H
+#define FCL_BROADPHASE_BROADPHASESAPARRAY_H
+
+#include <unordered_map>
+#include <vector>
+#include "fcl/math/bv/AABB.h"
+#include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/pair_hash_set.h"
+#include "fcl/broadphase/detail/radix_sort.h"
+
+namespace fcl
+{
+
+/// @brief Rigorous SAP collision manager on contiguous arrays.
+///
+/// Same algorithm as SaPCollisionManager, but the end points of each axis are
+/// kept in two flat arrays (values and object ids) instead of linked lists,
+/// and the overlapping pairs in a hash set instead of a list. After objects
+/// move, the end points are re-sorted by insertion sort, which maintains the
+/// overlapping pairs from the swaps it makes and takes linear time for
+/// coherent motion. Once the swaps exceed the number of end points, the
+/// arrays are radix sorted from scratch and the pairs found again by one
+/// sweep.
+///
+/// update(obj) only refreshes the AABB of the object: the end points are
+/// re-sorted once by update(), setup() or the next query.
+template <typename S>
+class FCL_EXPORT SaPCollisionManager_Array
+    : public BroadPhaseCollisionManager<S>
+{
+public:
+
+  SaPCollisionManager_Array();
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(CollisionObject<S>* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<CollisionObject<S>*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging to the manager
+  void distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
+  void collide(void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager<S>* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager<S>* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  /// @brief the number of pairs whose AABBs overlap
+  std::size_t numOverlapPairs() const;
+
+  /// @brief the number of times the end points were sorted from scratch
+  std::size_t numRebuilds() const;
+
+protected:
+
+  using Key = typename detail::SortableKey<S>::Type;
+
+  /// @brief bring the end points and the overlapping pairs up to date
+  void sort() const;
+
+  /// @brief radix sort the end points and find the overlapping pairs again
+  void rebuild() const;
+
+  /// @brief reload the end point values of the axis from the cached AABBs
+  void refreshValues(std::size_t axis) const;
+
+  /// @brief insertion sort the end points of the axis, updating the
+  /// overlapping pairs. Gives up and returns false once more than
+  /// max_swaps swaps were made.
+  bool insertionSort(std::size_t axis, std::size_t& max_swaps) const;
+
+  /// @brief pick the axis along which the end points are most spread
+  void selectAxis() const;
+
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager, given the AABB to query with
+  bool collide_(CollisionObject<S>* obj, const AABB<S>& obj_aabb, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and the objects
+  /// of the manager whose index is at least first_index
+  bool distance_(CollisionObject<S>* obj, std::size_t first_index, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief all objects in the scene
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief index of each object in objs
+  std::unordered_map<CollisionObject<S>*, std::size_t> obj_index;
+
+  /// @brief the AABB of each object grown by the security margin, as of its
+  /// last update
+  std::vector<AABB<S>> aabbs;
+
+  /// @brief end points of each axis in sorted order: their value, and the
+  /// object index times two plus one for an upper end point
+  mutable std::vector<S> values[3];
+  mutable std::vector<unsigned int> ids[3];
+
+  /// @brief largest AABB extent along each axis
+  mutable S max_extent[3];
+
+  /// @brief pairs of object indices whose AABBs overlap
+  mutable detail::PairHashSet overlap_pairs;
+
+  mutable std::size_t optimal_axis;
+
+  /// @brief whether the end points are out of order, and whether they are
+  /// better sorted from scratch
+  mutable bool dirty;
+  mutable bool needs_rebuild;
+
+  /// @brief number of coming sorts that skip insertion sort
+  mutable unsigned int num_direct_rebuilds;
+
+  mutable std::size_t num_rebuilds;
+
+  /// @brief scratch space of the radix sort and of the sweep
+  mutable std::vector<Key> keys;
+  mutable std::vector<Key> key_buffer;
+  mutable std::vector<unsigned int> id_buffer;
+  mutable std::vector<unsigned int> order;
+  mutable std::vector<AABB<S>> sorted_aabbs;
+};
+
+using SaPCollisionManager_Arrayf = SaPCollisionManager_Array<float>;
+using SaPCollisionManager_Arrayd = SaPCollisionManager_Array<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_SaP_array-inl.h"
+
+#endif
@@ -48,6 +48,9 @@ namespace fcl {
 extern template
 class FCL_EXPORT NaiveCollisionManager<double>;
 
+extern template
+class FCL_EXPORT NaiveCollisionManager<float>;
+
 //==============================================================================
 template <typename S>
 NaiveCollisionManager<S>::NaiveCollisionManager()
@@ -113,7 +116,7 @@ void NaiveCollisionManager<S>::collide(CollisionObject<S>* obj, void* cdata, Col
 
   for(auto* obj2 : objs)
   {
-    if(callback(obj, obj2, cdata))
+    if(this->canCollide(obj, obj2) && callback(obj, obj2, cdata))
       return;
   }
 }
@@ -147,7 +150,8 @@ void NaiveCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callbac
     typename std::list<CollisionObject<S>*>::const_iterator it2 = it1; it2++;
     for(; it2 != end; ++it2)
     {
-      if((*it1)->getAABB().overlap((*it2)->getAABB()))
+      if(this->canCollide(*it1, *it2)
+         && this->marginAABB(*it1).overlap(this->marginAABB(*it2)))
       {
         if(callback(*it1, *it2, cdata))
           return;
@@ -181,7 +185,12 @@ void NaiveCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callbac
 template <typename S>
 void NaiveCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  NaiveCollisionManager* other_manager = static_cast<NaiveCollisionManager*>(other_manager_);
+  NaiveCollisionManager* other_manager = dynamic_cast<NaiveCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -195,7 +204,8 @@ void NaiveCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_mana
   {
     for(auto* obj2 : other_manager->objs)
     {
-      if(obj1->getAABB().overlap(obj2->getAABB()))
+      if(this->canCollide(obj1, obj2)
+         && this->marginAABB(obj1).overlap(other_manager->marginAABB(obj2)))
       {
         if(callback(obj1, obj2, cdata))
           return;
@@ -208,7 +218,12 @@ void NaiveCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_mana
 template <typename S>
 void NaiveCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  NaiveCollisionManager* other_manager = static_cast<NaiveCollisionManager*>(other_manager_);
+  NaiveCollisionManager* other_manager = dynamic_cast<NaiveCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -40,6 +40,7 @@
 
 #include "fcl/broadphase/broadphase_collision_manager.h"
 
+#include <limits>
 #include "fcl/common/unused.h"
 
 namespace fcl {
@@ -48,10 +49,123 @@ namespace fcl {
 extern template
 class FCL_EXPORT BroadPhaseCollisionManager<double>;
 
+extern template
+class FCL_EXPORT BroadPhaseCollisionManager<float>;
+
+namespace detail {
+namespace hierarchy_view {
+
+//==============================================================================
+template <typename S>
+bool collisionRecurse(
+    const BroadPhaseCollisionManager<S>& manager,
+    const AABBHierarchyView<S>& view1,
+    typename AABBHierarchyView<S>::Node root1,
+    const AABBHierarchyView<S>& view2,
+    typename AABBHierarchyView<S>::Node root2,
+    void* cdata,
+    CollisionCallBack<S> callback)
+{
+  if(!view1.canCollide(root1, view2, root2)) return false;
+
+  const AABB<S>& bv1 = view1.getBV(root1);
+  const AABB<S>& bv2 = view2.getBV(root2);
+  if(!bv1.overlap(bv2)) return false;
+
+  const bool leaf1 = view1.isLeaf(root1);
+  const bool leaf2 = view2.isLeaf(root2);
+  if(leaf1 && leaf2)
+  {
+    CollisionObject<S>* root1_obj = view1.getObject(root1);
+    CollisionObject<S>* root2_obj = view2.getObject(root2);
+    if(!manager.canCollide(root1_obj, root2_obj)) return false;
+    return callback(root1_obj, root2_obj, cdata);
+  }
+
+  if(leaf2 || (!leaf1 && (bv1.size() > bv2.size())))
+  {
+    if(collisionRecurse(manager, view1, view1.getChild(root1, 0), view2, root2, cdata, callback))
+      return true;
+    if(collisionRecurse(manager, view1, view1.getChild(root1, 1), view2, root2, cdata, callback))
+      return true;
+  }
+  else
+  {
+    if(collisionRecurse(manager, view1, root1, view2, view2.getChild(root2, 0), cdata, callback))
+      return true;
+    if(collisionRecurse(manager, view1, root1, view2, view2.getChild(root2, 1), cdata, callback))
+      return true;
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool distanceRecurse(
+    const AABBHierarchyView<S>& view1,
+    typename AABBHierarchyView<S>::Node root1,
+    const AABBHierarchyView<S>& view2,
+    typename AABBHierarchyView<S>::Node root2,
+    void* cdata,
+    DistanceCallBack<S> callback,
+    S& min_dist)
+{
+  const bool leaf1 = view1.isLeaf(root1);
+  const bool leaf2 = view2.isLeaf(root2);
+  if(leaf1 && leaf2)
+    return callback(view1.getObject(root1), view2.getObject(root2), cdata, min_dist);
+
+  const AABB<S>& bv1 = view1.getBV(root1);
+  const AABB<S>& bv2 = view2.getBV(root2);
+
+  // Visit the closer child first, and neither once farther than the closest
+  // pair found
+  typename AABBHierarchyView<S>::Node children[2];
+  S d[2];
+  const bool split1 = leaf2 || (!leaf1 && (bv1.size() > bv2.size()));
+  for(int i = 0; i < 2; ++i)
+  {
+    if(split1)
+    {
+      children[i] = view1.getChild(root1, i);
+      d[i] = bv2.distance(view1.getBV(children[i]));
+    }
+    else
+    {
+      children[i] = view2.getChild(root2, i);
+      d[i] = bv1.distance(view2.getBV(children[i]));
+    }
+  }
+
+  const int first = (d[1] < d[0]) ? 1 : 0;
+  for(int i : {first, 1 - first})
+  {
+    if(d[i] >= min_dist)
+      continue;
+
+    if(split1)
+    {
+      if(distanceRecurse(view1, children[i], view2, root2, cdata, callback, min_dist))
+        return true;
+    }
+    else
+    {
+      if(distanceRecurse(view1, root1, view2, children[i], cdata, callback, min_dist))
+        return true;
+    }
+  }
+  return false;
+}
+
+} // namespace hierarchy_view
+} // namespace detail
+
 //==============================================================================
 template <typename S>
 BroadPhaseCollisionManager<S>::BroadPhaseCollisionManager()
-  : enable_tested_set_(false)
+  : enable_tested_set_(false),
+    security_margin(0),
+    allowed_collision_matrix(nullptr)
 {
   // Do nothing
 }
@@ -91,6 +205,145 @@ void BroadPhaseCollisionManager<S>::update(
   update();
 }
 
+//==============================================================================
+template <typename S>
+const detail::AABBHierarchyView<S>*
+BroadPhaseCollisionManager<S>::getHierarchyView() const
+{
+  return nullptr;
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhaseCollisionManager<S>::setSecurityMargin(S margin)
+{
+  security_margin = margin;
+}
+
+//==============================================================================
+template <typename S>
+S BroadPhaseCollisionManager<S>::getSecurityMargin() const
+{
+  return security_margin;
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhaseCollisionManager<S>::setAllowedCollisionMatrix(
+    const AllowedCollisionMatrix<S>* matrix)
+{
+  allowed_collision_matrix = matrix;
+}
+
+//==============================================================================
+template <typename S>
+const AllowedCollisionMatrix<S>*
+BroadPhaseCollisionManager<S>::getAllowedCollisionMatrix() const
+{
+  return allowed_collision_matrix;
+}
+
+//==============================================================================
+template <typename S>
+bool BroadPhaseCollisionManager<S>::canCollide(
+    const CollisionObject<S>* o1, const CollisionObject<S>* o2) const
+{
+  if(!o1->canCollideWith(*o2))
+    return false;
+
+  return !allowed_collision_matrix
+      || !allowed_collision_matrix->isAllowed(o1, o2);
+}
+
+//==============================================================================
+template <typename S>
+AABB<S> BroadPhaseCollisionManager<S>::marginAABB(
+    const CollisionObject<S>* obj) const
+{
+  AABB<S> aabb = obj->getAABB();
+  inflateBV(aabb, security_margin * 0.5);
+  return aabb;
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhaseCollisionManager<S>::collideHierarchies(
+    BroadPhaseCollisionManager* other_manager, void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  if((size() == 0) || (other_manager->size() == 0)) return;
+
+  detail::ObjectHierarchyView<S> fallback;
+  detail::ObjectHierarchyView<S> other_fallback;
+  const detail::AABBHierarchyView<S>& view = hierarchyView(fallback);
+  const detail::AABBHierarchyView<S>& other_view
+      = other_manager->hierarchyView(other_fallback);
+
+  std::vector<typename detail::AABBHierarchyView<S>::Node> roots;
+  std::vector<typename detail::AABBHierarchyView<S>::Node> other_roots;
+  view.getRoots(roots);
+  other_view.getRoots(other_roots);
+
+  for(auto root : roots)
+  {
+    for(auto other_root : other_roots)
+    {
+      if(detail::hierarchy_view::collisionRecurse(*this, view, root, other_view, other_root, cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void BroadPhaseCollisionManager<S>::distanceHierarchies(
+    BroadPhaseCollisionManager* other_manager, void* cdata,
+    DistanceCallBack<S> callback) const
+{
+  if((size() == 0) || (other_manager->size() == 0)) return;
+
+  detail::ObjectHierarchyView<S> fallback;
+  detail::ObjectHierarchyView<S> other_fallback;
+  const detail::AABBHierarchyView<S>& view = hierarchyView(fallback);
+  const detail::AABBHierarchyView<S>& other_view
+      = other_manager->hierarchyView(other_fallback);
+
+  std::vector<typename detail::AABBHierarchyView<S>::Node> roots;
+  std::vector<typename detail::AABBHierarchyView<S>::Node> other_roots;
+  view.getRoots(roots);
+  other_view.getRoots(other_roots);
+
+  S min_dist = std::numeric_limits<S>::max();
+  for(auto root : roots)
+  {
+    for(auto other_root : other_roots)
+    {
+      if(detail::hierarchy_view::distanceRecurse(view, root, other_view, other_root, cdata, callback, min_dist))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+const detail::AABBHierarchyView<S>&
+BroadPhaseCollisionManager<S>::hierarchyView(
+    detail::ObjectHierarchyView<S>& fallback) const
+{
+  const detail::AABBHierarchyView<S>* view = getHierarchyView();
+  if(view)
+    return *view;
+
+  std::vector<CollisionObject<S>*> objs;
+  getObjects(objs);
+  std::vector<AABB<S>> aabbs(objs.size());
+  for(std::size_t i = 0; i < objs.size(); ++i)
+    aabbs[i] = marginAABB(objs[i]);
+
+  fallback.build(objs, aabbs);
+  return fallback;
+}
+
 //==============================================================================
 template <typename S>
 bool BroadPhaseCollisionManager<S>::inTestedSet(
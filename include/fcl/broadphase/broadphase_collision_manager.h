@@ -41,7 +41,10 @@
 #include <set>
 #include <vector>
 
+#include "fcl/math/bv/utility.h"
 #include "fcl/narrowphase/collision_object.h"
+#include "fcl/broadphase/allowed_collision_matrix.h"
+#include "fcl/broadphase/detail/aabb_hierarchy_view.h"
 
 namespace fcl
 {
@@ -115,12 +118,42 @@ public:
   /// @brief perform distance test with objects belonging to another manager
   virtual void distance(BroadPhaseCollisionManager* other_manager, void* cdata, DistanceCallBack<S> callback) const = 0;
 
+  /// @brief The AABB hierarchy the manager keeps over its objects, valid until
+  /// the manager is next modified, or nullptr if it keeps none. Collision and
+  /// distance queries with a manager of another type traverse the hierarchies
+  /// of both managers together, building one on demand for a manager without.
+  virtual const detail::AABBHierarchyView<S>* getHierarchyView() const;
+
   /// @brief whether the manager is empty
   virtual bool empty() const = 0;
   
   /// @brief the number of objects managed by the manager
   virtual size_t size() const = 0;
 
+  /// @brief Report the pairs whose AABBs are closer than margin to the
+  /// collision callback, so that a callback using a CollisionRequest with the
+  /// same security_margin sees every pair it may find in collision. Takes
+  /// effect at the next setup() or update(). Distance queries are unaffected.
+  void setSecurityMargin(S margin);
+
+  /// @brief The security margin of the collision queries
+  S getSecurityMargin() const;
+
+  /// @brief Do not report the pairs of the matrix to the collision callback.
+  /// The matrix is not copied and must outlive its use by the manager;
+  /// nullptr, the default, disables it. Pairs whose collision categories and
+  /// masks do not match are never reported either. Distance queries are
+  /// unaffected.
+  void setAllowedCollisionMatrix(const AllowedCollisionMatrix<S>* matrix);
+
+  /// @brief The allowed collision matrix, nullptr if none
+  const AllowedCollisionMatrix<S>* getAllowedCollisionMatrix() const;
+
+  /// @brief Whether the collision filter of the manager lets the pair of o1
+  /// and o2 through to the collision callback
+  bool canCollide(const CollisionObject<S>* o1,
+                  const CollisionObject<S>* o2) const;
+
 protected:
 
   /// @brief tools help to avoid repeating collision or distance callback for the pairs of objects tested before. It can be useful for some of the broadphase algorithms.
@@ -131,6 +164,30 @@ protected:
 
   void insertTestedSet(CollisionObject<S>* a, CollisionObject<S>* b) const;
 
+  /// @brief The security margin used for collision pruning, 0 by default
+  S security_margin;
+
+  /// @brief The AABB of obj grown by half the security margin. Two such boxes
+  /// overlap exactly when the AABBs of the objects are within the margin of
+  /// each other along every axis.
+  AABB<S> marginAABB(const CollisionObject<S>* obj) const;
+
+  /// @brief The allowed collision matrix, not owned by the manager
+  const AllowedCollisionMatrix<S>* allowed_collision_matrix;
+
+  /// @brief perform collision test with the objects of a manager of any type,
+  /// by traversing the hierarchies of both managers together
+  void collideHierarchies(BroadPhaseCollisionManager* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with the objects of a manager of any type,
+  /// by traversing the hierarchies of both managers together
+  void distanceHierarchies(BroadPhaseCollisionManager* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief the hierarchy of the manager, or else fallback built over its
+  /// objects
+  const detail::AABBHierarchyView<S>& hierarchyView(
+      detail::ObjectHierarchyView<S>& fallback) const;
+
 };
 
 using BroadPhaseCollisionManagerf = BroadPhaseCollisionManager<float>;
@@ -48,6 +48,9 @@ namespace fcl {
 extern template
 class FCL_EXPORT BroadPhaseContinuousCollisionManager<double>;
 
+extern template
+class FCL_EXPORT BroadPhaseContinuousCollisionManager<float>;
+
 //==============================================================================
 template <typename S>
 BroadPhaseContinuousCollisionManager<S>::BroadPhaseContinuousCollisionManager()
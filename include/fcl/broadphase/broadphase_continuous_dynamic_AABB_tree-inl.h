@@ -0,0 +1,542 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_INL_H
+#define FCL_BROAD_PHASE_CONTINUOUS_DYNAMIC_AABB_TREE_INL_H
+
+#include "fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
+
+#include <cmath>
+#include <limits>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT DynamicAABBTreeContinuousCollisionManager<double>;
+
+extern template
+class FCL_EXPORT DynamicAABBTreeContinuousCollisionManager<float>;
+
+namespace detail {
+
+namespace continuous_dynamic_AABB_tree {
+
+template <typename S>
+using DynamicAABBNode
+    = typename DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBNode;
+
+//==============================================================================
+template <typename S>
+ContinuousCollisionObject<S>* objectOf(const DynamicAABBNode<S>* leaf)
+{
+  return static_cast<ContinuousCollisionObject<S>*>(leaf->data);
+}
+
+//==============================================================================
+template <typename S>
+bool collisionRecurse(
+    DynamicAABBNode<S>* root1,
+    DynamicAABBNode<S>* root2,
+    void* cdata,
+    ContinuousCollisionCallBack<S> callback)
+{
+  if(!root1->bv.overlap(root2->bv)) return false;
+
+  if(root1->isLeaf() && root2->isLeaf())
+    return callback(objectOf<S>(root1), objectOf<S>(root2), cdata);
+
+  if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
+  {
+    if(collisionRecurse<S>(root1->children[0], root2, cdata, callback))
+      return true;
+    if(collisionRecurse<S>(root1->children[1], root2, cdata, callback))
+      return true;
+  }
+  else
+  {
+    if(collisionRecurse<S>(root1, root2->children[0], cdata, callback))
+      return true;
+    if(collisionRecurse<S>(root1, root2->children[1], cdata, callback))
+      return true;
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool collisionRecurse(
+    DynamicAABBNode<S>* root,
+    ContinuousCollisionObject<S>* query,
+    const AABB<S>& query_aabb,
+    void* cdata,
+    ContinuousCollisionCallBack<S> callback)
+{
+  if(!root->bv.overlap(query_aabb)) return false;
+
+  if(root->isLeaf())
+    return callback(objectOf<S>(root), query, cdata);
+
+  int select_res = select(query_aabb, *(root->children[0]), *(root->children[1]));
+
+  if(collisionRecurse(root->children[select_res], query, query_aabb, cdata, callback))
+    return true;
+
+  if(collisionRecurse(root->children[1-select_res], query, query_aabb, cdata, callback))
+    return true;
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool selfCollisionRecurse(
+    DynamicAABBNode<S>* root,
+    void* cdata,
+    ContinuousCollisionCallBack<S> callback)
+{
+  if(root->isLeaf()) return false;
+
+  if(selfCollisionRecurse<S>(root->children[0], cdata, callback))
+    return true;
+
+  if(selfCollisionRecurse<S>(root->children[1], cdata, callback))
+    return true;
+
+  if(collisionRecurse<S>(root->children[0], root->children[1], cdata, callback))
+    return true;
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool distanceRecurse(
+    DynamicAABBNode<S>* root1,
+    DynamicAABBNode<S>* root2,
+    void* cdata,
+    ContinuousDistanceCallBack<S> callback,
+    S& min_dist)
+{
+  if(root1->isLeaf() && root2->isLeaf())
+    return callback(objectOf<S>(root1), objectOf<S>(root2), cdata, min_dist);
+
+  // Split the larger node, and visit the closer child first
+  const bool split1 = root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size()));
+  DynamicAABBNode<S>* children[2];
+  S d[2];
+  for(int i = 0; i < 2; ++i)
+  {
+    children[i] = split1 ? root1->children[i] : root2->children[i];
+    d[i] = (split1 ? root2 : root1)->bv.distance(children[i]->bv);
+  }
+
+  const int first = (d[1] < d[0]) ? 1 : 0;
+  for(int i : {first, 1 - first})
+  {
+    if(d[i] >= min_dist)
+      continue;
+
+    if(split1)
+    {
+      if(distanceRecurse<S>(children[i], root2, cdata, callback, min_dist))
+        return true;
+    }
+    else
+    {
+      if(distanceRecurse<S>(root1, children[i], cdata, callback, min_dist))
+        return true;
+    }
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool distanceRecurse(
+    DynamicAABBNode<S>* root,
+    ContinuousCollisionObject<S>* query,
+    const AABB<S>& query_aabb,
+    void* cdata,
+    ContinuousDistanceCallBack<S> callback,
+    S& min_dist)
+{
+  if(root->isLeaf())
+    return callback(objectOf<S>(root), query, cdata, min_dist);
+
+  S d1 = query_aabb.distance(root->children[0]->bv);
+  S d2 = query_aabb.distance(root->children[1]->bv);
+
+  if(d2 < d1)
+  {
+    if(d2 < min_dist)
+    {
+      if(distanceRecurse(root->children[1], query, query_aabb, cdata, callback, min_dist))
+        return true;
+    }
+
+    if(d1 < min_dist)
+    {
+      if(distanceRecurse(root->children[0], query, query_aabb, cdata, callback, min_dist))
+        return true;
+    }
+  }
+  else
+  {
+    if(d1 < min_dist)
+    {
+      if(distanceRecurse(root->children[0], query, query_aabb, cdata, callback, min_dist))
+        return true;
+    }
+
+    if(d2 < min_dist)
+    {
+      if(distanceRecurse(root->children[1], query, query_aabb, cdata, callback, min_dist))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool selfDistanceRecurse(
+    DynamicAABBNode<S>* root,
+    void* cdata,
+    ContinuousDistanceCallBack<S> callback,
+    S& min_dist)
+{
+  if(root->isLeaf()) return false;
+
+  if(selfDistanceRecurse<S>(root->children[0], cdata, callback, min_dist))
+    return true;
+
+  if(selfDistanceRecurse<S>(root->children[1], cdata, callback, min_dist))
+    return true;
+
+  if(distanceRecurse<S>(root->children[0], root->children[1], cdata, callback, min_dist))
+    return true;
+
+  return false;
+}
+
+} // namespace continuous_dynamic_AABB_tree
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+DynamicAABBTreeContinuousCollisionManager<S>::DynamicAABBTreeContinuousCollisionManager()
+  : tree_topdown_balance_threshold(dtree.bu_threshold),
+    tree_topdown_level(dtree.topdown_level)
+{
+  max_tree_nonbalanced_level = 10;
+  tree_incremental_balance_pass = 10;
+  tree_topdown_balance_threshold = 2;
+  tree_topdown_level = 0;
+  tree_init_level = 0;
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::registerObjects(
+    const std::vector<ContinuousCollisionObject<S>*>& other_objs)
+{
+  if(other_objs.empty()) return;
+
+  if(dtree.size() > 0)
+  {
+    BroadPhaseContinuousCollisionManager<S>::registerObjects(other_objs);
+  }
+  else
+  {
+    std::vector<DynamicAABBNode*> leaves(other_objs.size());
+    table.rehash(other_objs.size());
+    for(size_t i = 0, size = other_objs.size(); i < size; ++i)
+    {
+      DynamicAABBNode* node = new DynamicAABBNode; // node will be managed by the dtree
+      node->bv = sweptAABB(other_objs[i]);
+      node->parent = nullptr;
+      node->children[1] = nullptr;
+      node->data = other_objs[i];
+      node->category = ~uint32(0);
+      node->mask = ~uint32(0);
+      table[other_objs[i]] = node;
+      leaves[i] = node;
+    }
+
+    dtree.init(leaves, tree_init_level);
+
+    setup_ = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::registerObject(
+    ContinuousCollisionObject<S>* obj)
+{
+  DynamicAABBNode* node = dtree.insert(sweptAABB(obj), obj);
+  table[obj] = node;
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::unregisterObject(
+    ContinuousCollisionObject<S>* obj)
+{
+  const auto it = table.find(obj);
+  if(it == table.end()) return;
+
+  DynamicAABBNode* node = it->second;
+  table.erase(it);
+  dtree.remove(node);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::setup()
+{
+  if(!setup_)
+  {
+    int num = dtree.size();
+    if(num == 0)
+    {
+      setup_ = true;
+      return;
+    }
+
+    int height = dtree.getMaxHeight();
+
+    if(height - std::log((S)num) / std::log(2.0) < max_tree_nonbalanced_level)
+      dtree.balanceIncremental(tree_incremental_balance_pass);
+    else
+      dtree.balanceTopdown();
+
+    setup_ = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update()
+{
+  for(auto it = table.cbegin(); it != table.cend(); ++it)
+    it->second->bv = sweptAABB(it->first);
+
+  dtree.refit();
+  setup_ = false;
+
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update_(
+    ContinuousCollisionObject<S>* updated_obj)
+{
+  const auto it = table.find(updated_obj);
+  if(it != table.end())
+  {
+    DynamicAABBNode* node = it->second;
+    const AABB<S>& aabb = sweptAABB(updated_obj);
+    if(!node->bv.equal(aabb))
+      dtree.update(node, aabb);
+  }
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update(
+    ContinuousCollisionObject<S>* updated_obj)
+{
+  update_(updated_obj);
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::update(
+    const std::vector<ContinuousCollisionObject<S>*>& updated_objs)
+{
+  for(size_t i = 0, size = updated_objs.size(); i < size; ++i)
+    update_(updated_objs[i]);
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::clear()
+{
+  dtree.clear();
+  table.clear();
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::getObjects(
+    std::vector<ContinuousCollisionObject<S>*>& objs) const
+{
+  objs.clear();
+  objs.reserve(table.size());
+  for(const auto& entry : table)
+    objs.push_back(entry.first);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(
+    ContinuousCollisionObject<S>* obj, void* cdata,
+    ContinuousCollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  detail::continuous_dynamic_AABB_tree::collisionRecurse(
+      dtree.getRoot(), obj, sweptAABB(obj), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(
+    ContinuousCollisionObject<S>* obj, void* cdata,
+    ContinuousDistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::distanceRecurse(
+      dtree.getRoot(), obj, sweptAABB(obj), cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(
+    void* cdata, ContinuousCollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  detail::continuous_dynamic_AABB_tree::selfCollisionRecurse<S>(
+      dtree.getRoot(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(
+    void* cdata, ContinuousDistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::selfDistanceRecurse<S>(
+      dtree.getRoot(), cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::collide(
+    BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata,
+    ContinuousCollisionCallBack<S> callback) const
+{
+  auto* other_manager
+      = dynamic_cast<DynamicAABBTreeContinuousCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    // Query the other manager with each object of this one
+    for(const auto& entry : table)
+      other_manager_->collide(entry.first, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0)) return;
+  detail::continuous_dynamic_AABB_tree::collisionRecurse<S>(
+      dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void DynamicAABBTreeContinuousCollisionManager<S>::distance(
+    BroadPhaseContinuousCollisionManager<S>* other_manager_, void* cdata,
+    ContinuousDistanceCallBack<S> callback) const
+{
+  auto* other_manager
+      = dynamic_cast<DynamicAABBTreeContinuousCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    for(const auto& entry : table)
+      other_manager_->distance(entry.first, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0)) return;
+  S min_dist = std::numeric_limits<S>::max();
+  detail::continuous_dynamic_AABB_tree::distanceRecurse<S>(
+      dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback,
+      min_dist);
+}
+
+//==============================================================================
+template <typename S>
+bool DynamicAABBTreeContinuousCollisionManager<S>::empty() const
+{
+  return dtree.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t DynamicAABBTreeContinuousCollisionManager<S>::size() const
+{
+  return dtree.size();
+}
+
+//==============================================================================
+template <typename S>
+const detail::HierarchyTree<AABB<S>>&
+DynamicAABBTreeContinuousCollisionManager<S>::getTree() const
+{
+  return dtree;
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& DynamicAABBTreeContinuousCollisionManager<S>::sweptAABB(
+    ContinuousCollisionObject<S>* obj)
+{
+  obj->computeAABB();
+  return obj->getAABB();
+}
+
+} // namespace fcl
+
+#endif
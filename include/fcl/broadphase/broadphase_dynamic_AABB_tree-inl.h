@@ -52,6 +52,9 @@ namespace fcl {
 extern template
 class FCL_EXPORT DynamicAABBTreeCollisionManager<double>;
 
+extern template
+class FCL_EXPORT DynamicAABBTreeCollisionManager<float>;
+
 namespace detail {
 
 namespace dynamic_AABB_tree {
@@ -488,35 +491,52 @@ bool distanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNod
 
 #endif
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool canCollide(
+    const typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* node,
+    const CollisionObject<S>* query)
+{
+  return (node->category & query->getCollisionMask())
+      && (query->getCollisionCategory() & node->mask);
+}
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
 bool collisionRecurse(
+    const BroadPhaseCollisionManager<S>& manager,
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root1,
     typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root2,
     void* cdata,
     CollisionCallBack<S> callback)
 {
+  if(!root1->canCollideWith(*root2)) return false;
+
   if(root1->isLeaf() && root2->isLeaf())
   {
     if(!root1->bv.overlap(root2->bv)) return false;
-    return callback(static_cast<CollisionObject<S>*>(root1->data), static_cast<CollisionObject<S>*>(root2->data), cdata);
+    CollisionObject<S>* root1_obj = static_cast<CollisionObject<S>*>(root1->data);
+    CollisionObject<S>* root2_obj = static_cast<CollisionObject<S>*>(root2->data);
+    if(!manager.canCollide(root1_obj, root2_obj)) return false;
+    return callback(root1_obj, root2_obj, cdata);
   }
 
   if(!root1->bv.overlap(root2->bv)) return false;
 
   if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
   {
-    if(collisionRecurse(root1->children[0], root2, cdata, callback))
+    if(collisionRecurse(manager, root1->children[0], root2, cdata, callback))
       return true;
-    if(collisionRecurse(root1->children[1], root2, cdata, callback))
+    if(collisionRecurse(manager, root1->children[1], root2, cdata, callback))
       return true;
   }
   else
   {
-    if(collisionRecurse(root1, root2->children[0], cdata, callback))
+    if(collisionRecurse(manager, root1, root2->children[0], cdata, callback))
       return true;
-    if(collisionRecurse(root1, root2->children[1], cdata, callback))
+    if(collisionRecurse(manager, root1, root2->children[1], cdata, callback))
       return true;
   }
   return false;
@@ -525,22 +545,26 @@ bool collisionRecurse(
 //==============================================================================
 template <typename S>
 FCL_EXPORT
-bool collisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, void* cdata, CollisionCallBack<S> callback)
+bool collisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, const AABB<S>& query_aabb, void* cdata, CollisionCallBack<S> callback)
 {
+  if(!canCollide<S>(root, query)) return false;
+
   if(root->isLeaf())
   {
-    if(!root->bv.overlap(query->getAABB())) return false;
-    return callback(static_cast<CollisionObject<S>*>(root->data), query, cdata);
+    if(!root->bv.overlap(query_aabb)) return false;
+    CollisionObject<S>* root_obj = static_cast<CollisionObject<S>*>(root->data);
+    if(!manager.canCollide(root_obj, query)) return false;
+    return callback(root_obj, query, cdata);
   }
 
-  if(!root->bv.overlap(query->getAABB())) return false;
+  if(!root->bv.overlap(query_aabb)) return false;
 
-  int select_res = select(query->getAABB(), *(root->children[0]), *(root->children[1]));
+  int select_res = select(query_aabb, *(root->children[0]), *(root->children[1]));
 
-  if(collisionRecurse(root->children[select_res], query, cdata, callback))
+  if(collisionRecurse(manager, root->children[select_res], query, query_aabb, cdata, callback))
     return true;
 
-  if(collisionRecurse(root->children[1-select_res], query, cdata, callback))
+  if(collisionRecurse(manager, root->children[1-select_res], query, query_aabb, cdata, callback))
     return true;
 
   return false;
@@ -549,17 +573,26 @@ bool collisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNo
 //==============================================================================
 template <typename S>
 FCL_EXPORT
-bool selfCollisionRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, void* cdata, CollisionCallBack<S> callback)
+bool collisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, CollisionObject<S>* query, void* cdata, CollisionCallBack<S> callback)
 {
-  if(root->isLeaf()) return false;
+  return collisionRecurse(manager, root, query, query->getAABB(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool selfCollisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root, void* cdata, CollisionCallBack<S> callback)
+{
+  // No two objects of the subtree can collide when this fails
+  if(root->isLeaf() || !root->canCollideWith(*root)) return false;
 
-  if(selfCollisionRecurse(root->children[0], cdata, callback))
+  if(selfCollisionRecurse(manager, root->children[0], cdata, callback))
     return true;
 
-  if(selfCollisionRecurse(root->children[1], cdata, callback))
+  if(selfCollisionRecurse(manager, root->children[1], cdata, callback))
     return true;
 
-  if(collisionRecurse(root->children[0], root->children[1], cdata, callback))
+  if(collisionRecurse(manager, root->children[0], root->children[1], cdata, callback))
     return true;
 
   return false;
@@ -728,14 +761,23 @@ template <typename S>
 FCL_EXPORT
 DynamicAABBTreeCollisionManager<S>::DynamicAABBTreeCollisionManager()
   : tree_topdown_balance_threshold(dtree.bu_threshold),
-    tree_topdown_level(dtree.topdown_level)
+    tree_topdown_level(dtree.topdown_level),
+    stree(16, 1),
+    hierarchy_view({&dtree, &stree})
 {
   max_tree_nonbalanced_level = 10;
   tree_incremental_balance_pass = 10;
   tree_topdown_balance_threshold = 2;
   tree_topdown_level = 0;
   tree_init_level = 0;
+  tree_refit_rotation = true;
+  tree_partial_rebuild_ratio = 1.25;
+  tree_full_rebuild_ratio = 1.6;
   setup_ = false;
+  static_setup_ = true;
+  tree_reference_cost = 0;
+  num_partial_rebuilds = 0;
+  num_full_rebuilds = 0;
 
   // from experiment, this is the optimal setting
   octree_as_geometry_collide = true;
@@ -750,26 +792,29 @@ void DynamicAABBTreeCollisionManager<S>::registerObjects(
 {
   if(other_objs.empty()) return;
 
-  if(size() > 0)
+  if(dtree.size() > 0)
   {
     BroadPhaseCollisionManager<S>::registerObjects(other_objs);
   }
   else
   {
     std::vector<DynamicAABBNode*> leaves(other_objs.size());
-    table.rehash(other_objs.size());
+    table.reserve(other_objs.size());
     for(size_t i = 0, size = other_objs.size(); i < size; ++i)
     {
       DynamicAABBNode* node = new DynamicAABBNode; // node will be managed by the dtree
-      node->bv = other_objs[i]->getAABB();
+      node->bv = this->marginAABB(other_objs[i]);
       node->parent = nullptr;
       node->children[1] = nullptr;
       node->data = other_objs[i];
-      table[other_objs[i]] = node;
+      node->category = other_objs[i]->getCollisionCategory();
+      node->mask = other_objs[i]->getCollisionMask();
+      table.insert(other_objs[i], node);
       leaves[i] = node;
     }
 
     dtree.init(leaves, tree_init_level);
+    tree_reference_cost = dtree.getCost();
 
     setup_ = true;
   }
@@ -780,8 +825,56 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::registerObject(CollisionObject<S>* obj)
 {
-  DynamicAABBNode* node = dtree.insert(obj->getAABB(), obj);
-  table[obj] = node;
+  DynamicAABBNode* node = dtree.insert(this->marginAABB(obj), obj);
+  dtree.updateCategories(node, obj->getCollisionCategory(), obj->getCollisionMask());
+  table.insert(obj, node);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void DynamicAABBTreeCollisionManager<S>::registerStaticObjects(
+    const std::vector<CollisionObject<S>*>& other_objs)
+{
+  if(other_objs.empty()) return;
+
+  if(stree.size() > 0)
+  {
+    for(auto* obj : other_objs)
+      registerStaticObject(obj);
+    return;
+  }
+
+  std::vector<DynamicAABBNode*> leaves(other_objs.size());
+  static_table.reserve(other_objs.size());
+  for(size_t i = 0, size = other_objs.size(); i < size; ++i)
+  {
+    DynamicAABBNode* node = new DynamicAABBNode; // node will be managed by the stree
+    node->bv = this->marginAABB(other_objs[i]);
+    node->parent = nullptr;
+    node->children[1] = nullptr;
+    node->data = other_objs[i];
+    node->category = other_objs[i]->getCollisionCategory();
+    node->mask = other_objs[i]->getCollisionMask();
+    static_table.insert(other_objs[i], node);
+    leaves[i] = node;
+  }
+
+  stree.init(leaves, 0);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void DynamicAABBTreeCollisionManager<S>::registerStaticObject(
+    CollisionObject<S>* obj)
+{
+  DynamicAABBNode* node = stree.insert(this->marginAABB(obj), obj);
+  stree.updateCategories(node, obj->getCollisionCategory(), obj->getCollisionMask());
+  static_table.insert(obj, node);
+
+  // Rebuilt top-down by the next setup()
+  static_setup_ = false;
 }
 
 //==============================================================================
@@ -789,9 +882,22 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
 {
-  DynamicAABBNode* node = table[obj];
-  table.erase(obj);
-  dtree.remove(node);
+  auto it = table.find(obj);
+  if(it != table.end())
+  {
+    DynamicAABBNode* node = it->second;
+    table.erase(it);
+    dtree.remove(node);
+    return;
+  }
+
+  it = static_table.find(obj);
+  if(it != static_table.end())
+  {
+    DynamicAABBNode* node = it->second;
+    static_table.erase(it);
+    stree.remove(node);
+  }
 }
 
 //==============================================================================
@@ -799,6 +905,12 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::setup()
 {
+  if(!static_setup_)
+  {
+    stree.balanceTopdown();
+    static_setup_ = true;
+  }
+
   if(!setup_)
   {
     int num = dtree.size();
@@ -812,9 +924,14 @@ void DynamicAABBTreeCollisionManager<S>::setup()
 
 
     if(height - std::log((S)num) / std::log(2.0) < max_tree_nonbalanced_level)
+    {
       dtree.balanceIncremental(tree_incremental_balance_pass);
+    }
     else
+    {
       dtree.balanceTopdown();
+      tree_reference_cost = dtree.getCost();
+    }
 
     setup_ = true;
   }
@@ -829,13 +946,51 @@ void DynamicAABBTreeCollisionManager<S>::update()
   {
     CollisionObject<S>* obj = it->first;
     DynamicAABBNode* node = it->second;
-    node->bv = obj->getAABB();
+    node->bv = this->marginAABB(obj);
+    node->category = obj->getCollisionCategory();
+    node->mask = obj->getCollisionMask();
   }
 
-  dtree.refit();
+  if(tree_refit_rotation)
+    dtree.refitRotate();
+  else
+    dtree.refit();
   setup_ = false;
 
   setup();
+  rebuildIfDegraded();
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void DynamicAABBTreeCollisionManager<S>::rebuildIfDegraded()
+{
+  if(dtree.size() < 2)
+    return;
+
+  const S cost = dtree.getCost();
+
+  // A tree built object by object has no reference yet
+  if(tree_reference_cost <= 0)
+  {
+    tree_reference_cost = cost;
+    return;
+  }
+
+  if(tree_full_rebuild_ratio > 0
+     && cost > tree_full_rebuild_ratio * tree_reference_cost)
+  {
+    dtree.balanceTopdown();
+    tree_reference_cost = dtree.getCost();
+    ++num_full_rebuilds;
+  }
+  else if(tree_partial_rebuild_ratio > 0
+          && cost > tree_partial_rebuild_ratio * tree_reference_cost)
+  {
+    dtree.rebuildCostliestSubtree(std::max<size_t>(dtree.size() / 4, 2));
+    ++num_partial_rebuilds;
+  }
 }
 
 //==============================================================================
@@ -847,8 +1002,23 @@ void DynamicAABBTreeCollisionManager<S>::update_(CollisionObject<S>* updated_obj
   if(it != table.end())
   {
     DynamicAABBNode* node = it->second;
-    if(!node->bv.equal(updated_obj->getAABB()))
-      dtree.update(node, updated_obj->getAABB());
+    const AABB<S> aabb = this->marginAABB(updated_obj);
+    if(!node->bv.equal(aabb))
+      dtree.update(node, aabb);
+    dtree.updateCategories(node, updated_obj->getCollisionCategory(), updated_obj->getCollisionMask());
+  }
+  else
+  {
+    // A static object that was moved after all
+    const auto static_it = static_table.find(updated_obj);
+    if(static_it != static_table.end())
+    {
+      DynamicAABBNode* node = static_it->second;
+      const AABB<S> aabb = this->marginAABB(updated_obj);
+      if(!node->bv.equal(aabb))
+        stree.update(node, aabb);
+      stree.updateCategories(node, updated_obj->getCollisionCategory(), updated_obj->getCollisionMask());
+    }
   }
   setup_ = false;
 }
@@ -879,6 +1049,10 @@ void DynamicAABBTreeCollisionManager<S>::clear()
 {
   dtree.clear();
   table.clear();
+  stree.clear();
+  static_table.clear();
+  static_setup_ = true;
+  tree_reference_cost = 0;
 }
 
 //==============================================================================
@@ -887,7 +1061,8 @@ FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::getObjects(std::vector<CollisionObject<S>*>& objs) const
 {
   objs.resize(this->size());
-  std::transform(table.begin(), table.end(), objs.begin(), std::bind(&DynamicAABBTable::value_type::first, std::placeholders::_1));
+  auto it = std::transform(table.begin(), table.end(), objs.begin(), std::bind(&DynamicAABBTable::value_type::first, std::placeholders::_1));
+  std::transform(static_table.begin(), static_table.end(), it, std::bind(&DynamicAABBTable::value_type::first, std::placeholders::_1));
 }
 
 //==============================================================================
@@ -896,24 +1071,8 @@ FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
 {
   if(size() == 0) return;
-  switch(obj->collisionGeometry()->getNodeType())
-  {
-#if FCL_HAVE_OCTOMAP
-  case GEOM_OCTREE:
-    {
-      if(!octree_as_geometry_collide)
-      {
-        const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
-        detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback);
-      }
-      else
-        detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), obj, cdata, callback);
-    }
-    break;
-#endif
-  default:
-    detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), obj, cdata, callback);
-  }
+  if(collide_(dtree.getRoot(), obj, cdata, callback)) return;
+  collide_(stree.getRoot(), obj, cdata, callback);
 }
 
 //==============================================================================
@@ -923,24 +1082,8 @@ void DynamicAABBTreeCollisionManager<S>::distance(CollisionObject<S>* obj, void*
 {
   if(size() == 0) return;
   S min_dist = std::numeric_limits<S>::max();
-  switch(obj->collisionGeometry()->getNodeType())
-  {
-#if FCL_HAVE_OCTOMAP
-  case GEOM_OCTREE:
-    {
-      if(!octree_as_geometry_distance)
-      {
-        const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
-        detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback, min_dist);
-      }
-      else
-        detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), obj, cdata, callback, min_dist);
-    }
-    break;
-#endif
-  default:
-    detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), obj, cdata, callback, min_dist);
-  }
+  if(distance_(dtree.getRoot(), obj, cdata, callback, min_dist)) return;
+  distance_(stree.getRoot(), obj, cdata, callback, min_dist);
 }
 
 //==============================================================================
@@ -948,8 +1091,13 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
 {
-  if(size() == 0) return;
-  detail::dynamic_AABB_tree::selfCollisionRecurse(dtree.getRoot(), cdata, callback);
+  if(dtree.empty()) return;
+  if(detail::dynamic_AABB_tree::selfCollisionRecurse(*this, dtree.getRoot(), cdata, callback))
+    return;
+
+  // The static objects are only tested against the moving ones
+  if(!stree.empty())
+    detail::dynamic_AABB_tree::collisionRecurse(*this, dtree.getRoot(), stree.getRoot(), cdata, callback);
 }
 
 //==============================================================================
@@ -957,9 +1105,13 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback) const
 {
-  if(size() == 0) return;
+  if(dtree.empty()) return;
   S min_dist = std::numeric_limits<S>::max();
-  detail::dynamic_AABB_tree::selfDistanceRecurse(dtree.getRoot(), cdata, callback, min_dist);
+  if(detail::dynamic_AABB_tree::selfDistanceRecurse(dtree.getRoot(), cdata, callback, min_dist))
+    return;
+
+  if(!stree.empty())
+    detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), stree.getRoot(), cdata, callback, min_dist);
 }
 
 //==============================================================================
@@ -967,9 +1119,26 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  DynamicAABBTreeCollisionManager* other_manager = dynamic_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
   if((size() == 0) || (other_manager->size() == 0)) return;
-  detail::dynamic_AABB_tree::collisionRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback);
+
+  // Every pair of trees, the static ones included
+  const detail::HierarchyTree<AABB<S>>* trees[2] = {&dtree, &stree};
+  const detail::HierarchyTree<AABB<S>>* other_trees[2] = {&other_manager->dtree, &other_manager->stree};
+  for(const auto* tree : trees)
+  {
+    for(const auto* other_tree : other_trees)
+    {
+      if(tree->empty() || other_tree->empty()) continue;
+      if(detail::dynamic_AABB_tree::collisionRecurse(*this, tree->getRoot(), other_tree->getRoot(), cdata, callback))
+        return;
+    }
+  }
 }
 
 //==============================================================================
@@ -977,10 +1146,26 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  DynamicAABBTreeCollisionManager* other_manager = static_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  DynamicAABBTreeCollisionManager* other_manager = dynamic_cast<DynamicAABBTreeCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
   if((size() == 0) || (other_manager->size() == 0)) return;
   S min_dist = std::numeric_limits<S>::max();
-  detail::dynamic_AABB_tree::distanceRecurse(dtree.getRoot(), other_manager->dtree.getRoot(), cdata, callback, min_dist);
+
+  const detail::HierarchyTree<AABB<S>>* trees[2] = {&dtree, &stree};
+  const detail::HierarchyTree<AABB<S>>* other_trees[2] = {&other_manager->dtree, &other_manager->stree};
+  for(const auto* tree : trees)
+  {
+    for(const auto* other_tree : other_trees)
+    {
+      if(tree->empty() || other_tree->empty()) continue;
+      if(detail::dynamic_AABB_tree::distanceRecurse(tree->getRoot(), other_tree->getRoot(), cdata, callback, min_dist))
+        return;
+    }
+  }
 }
 
 //==============================================================================
@@ -988,7 +1173,7 @@ template <typename S>
 FCL_EXPORT
 bool DynamicAABBTreeCollisionManager<S>::empty() const
 {
-  return dtree.empty();
+  return dtree.empty() && stree.empty();
 }
 
 //==============================================================================
@@ -996,7 +1181,15 @@ template <typename S>
 FCL_EXPORT
 size_t DynamicAABBTreeCollisionManager<S>::size() const
 {
-  return dtree.size();
+  return dtree.size() + stree.size();
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+size_t DynamicAABBTreeCollisionManager<S>::numStaticObjects() const
+{
+  return stree.size();
 }
 
 //==============================================================================
@@ -1008,6 +1201,106 @@ DynamicAABBTreeCollisionManager<S>::getTree() const
   return dtree;
 }
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+const detail::HierarchyTree<AABB<S>>&
+DynamicAABBTreeCollisionManager<S>::getStaticTree() const
+{
+  return stree;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+S DynamicAABBTreeCollisionManager<S>::getTreeCost() const
+{
+  return dtree.getCost();
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+S DynamicAABBTreeCollisionManager<S>::getTreeReferenceCost() const
+{
+  return tree_reference_cost;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+size_t DynamicAABBTreeCollisionManager<S>::getNumPartialRebuilds() const
+{
+  return num_partial_rebuilds;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+size_t DynamicAABBTreeCollisionManager<S>::getNumFullRebuilds() const
+{
+  return num_full_rebuilds;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+const detail::AABBHierarchyView<S>*
+DynamicAABBTreeCollisionManager<S>::getHierarchyView() const
+{
+  return &hierarchy_view;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool DynamicAABBTreeCollisionManager<S>::collide_(DynamicAABBNode* root, CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(!root) return false;
+  switch(obj->collisionGeometry()->getNodeType())
+  {
+#if FCL_HAVE_OCTOMAP
+  case GEOM_OCTREE:
+    {
+      if(!octree_as_geometry_collide)
+      {
+        const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
+        return detail::dynamic_AABB_tree::collisionRecurse(root, octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback);
+      }
+      else
+        return detail::dynamic_AABB_tree::collisionRecurse(*this, root, obj, this->marginAABB(obj), cdata, callback);
+    }
+#endif
+  default:
+    return detail::dynamic_AABB_tree::collisionRecurse(*this, root, obj, this->marginAABB(obj), cdata, callback);
+  }
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool DynamicAABBTreeCollisionManager<S>::distance_(DynamicAABBNode* root, CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const
+{
+  if(!root) return false;
+  switch(obj->collisionGeometry()->getNodeType())
+  {
+#if FCL_HAVE_OCTOMAP
+  case GEOM_OCTREE:
+    {
+      if(!octree_as_geometry_distance)
+      {
+        const OcTree<S>* octree = static_cast<const OcTree<S>*>(obj->collisionGeometry().get());
+        return detail::dynamic_AABB_tree::distanceRecurse(root, octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback, min_dist);
+      }
+      else
+        return detail::dynamic_AABB_tree::distanceRecurse(root, obj, cdata, callback, min_dist);
+    }
+#endif
+  default:
+    return detail::dynamic_AABB_tree::distanceRecurse(root, obj, cdata, callback, min_dist);
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -38,7 +38,6 @@
 #ifndef FCL_BROAD_PHASE_DYNAMIC_AABB_TREE_H
 #define FCL_BROAD_PHASE_DYNAMIC_AABB_TREE_H
 
-#include <unordered_map>
 #include <functional>
 
 #include "fcl/math/bv/utility.h"
@@ -46,17 +45,25 @@
 #include "fcl/geometry/shape/utility.h"
 #include "fcl/broadphase/broadphase_collision_manager.h"
 #include "fcl/broadphase/detail/hierarchy_tree.h"
+#include "fcl/broadphase/detail/proxy_table.h"
 
 namespace fcl
 {
 
+/// @brief Collision manager keeping the objects in a dynamic AABB tree.
+///
+/// Objects that never move can be registered as static: they go in a second
+/// tree, built top-down once with the higher quality split and then left
+/// alone by update(), so that the cost of updating the manager only depends
+/// on the moving objects. Self collision and self distance only consider the
+/// pairs with at least one moving object.
 template <typename S>
 class FCL_EXPORT DynamicAABBTreeCollisionManager : public BroadPhaseCollisionManager<S>
 {
 public:
 
   using DynamicAABBNode = detail::NodeBase<AABB<S>>;
-  using DynamicAABBTable = std::unordered_map<CollisionObject<S>*, DynamicAABBNode*> ;
+  using DynamicAABBTable = detail::ProxyTable<S, DynamicAABBNode*>;
 
   int max_tree_nonbalanced_level;
   int tree_incremental_balance_pass;
@@ -64,6 +71,17 @@ public:
   int& tree_topdown_level;
   int tree_init_level;
 
+  /// @brief whether update() rotates the tree nodes while refitting them,
+  /// which keeps the surface area cost of the tree down as objects move
+  bool tree_refit_rotation;
+
+  /// @brief once update() finds the surface area cost of the tree above
+  /// its cost after the last full build times tree_partial_rebuild_ratio,
+  /// the costliest subtree of at most a quarter of the objects is rebuilt;
+  /// above tree_full_rebuild_ratio, the whole tree is. 0 disables either.
+  S tree_partial_rebuild_ratio;
+  S tree_full_rebuild_ratio;
+
   bool octree_as_geometry_collide;
   bool octree_as_geometry_distance;
 
@@ -75,6 +93,12 @@ public:
   /// @brief add one object to the manager
   void registerObject(CollisionObject<S>* obj);
 
+  /// @brief add objects that never move to the static tree
+  void registerStaticObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object that never moves to the static tree
+  void registerStaticObject(CollisionObject<S>* obj);
+
   /// @brief remove one object from the manager
   void unregisterObject(CollisionObject<S>* obj);
 
@@ -120,15 +144,64 @@ public:
   /// @brief the number of objects managed by the manager
   size_t size() const;
 
+  /// @brief the number of static objects
+  size_t numStaticObjects() const;
+
+  /// @brief the tree of the moving objects
   const detail::HierarchyTree<AABB<S>>& getTree() const;
 
+  /// @brief the tree of the static objects
+  const detail::HierarchyTree<AABB<S>>& getStaticTree() const;
+
+  /// @brief the surface area heuristic cost of the tree, see
+  /// detail::HierarchyTree::getCost()
+  S getTreeCost() const;
+
+  /// @brief the cost of the tree after its last full build, which
+  /// update() compares the current cost with; 0 until measured
+  S getTreeReferenceCost() const;
+
+  /// @brief the number of partial and full rebuilds update() made because
+  /// of the tree cost
+  size_t getNumPartialRebuilds() const;
+
+  size_t getNumFullRebuilds() const;
+
+  /// @brief a view of the trees of the moving and the static objects
+  const detail::AABBHierarchyView<S>* getHierarchyView() const;
+
 private:
   detail::HierarchyTree<AABB<S>> dtree;
-  std::unordered_map<CollisionObject<S>*, DynamicAABBNode*> table;
+  DynamicAABBTable table;
+
+  detail::HierarchyTree<AABB<S>> stree;
+  DynamicAABBTable static_table;
+
+  detail::HierarchyTreeView<S> hierarchy_view;
 
   bool setup_;
 
+  /// @brief false once static objects are added one by one, until setup()
+  /// rebuilds the static tree
+  bool static_setup_;
+
+  S tree_reference_cost;
+  size_t num_partial_rebuilds;
+  size_t num_full_rebuilds;
+
   void update_(CollisionObject<S>* updated_obj);
+
+  /// @brief perform collision test between one object and the objects of
+  /// one tree; returns whether the callback asked to stop
+  bool collide_(DynamicAABBNode* root, CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and the objects
+  /// of one tree; returns whether the callback asked to stop
+  bool distance_(DynamicAABBNode* root, CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief rebuild part or all of the tree if its cost grew too much since
+  /// its last full build
+  void rebuildIfDegraded();
 };
 
 using DynamicAABBTreeCollisionManagerf = DynamicAABBTreeCollisionManager<float>;
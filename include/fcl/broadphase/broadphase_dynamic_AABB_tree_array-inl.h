@@ -51,6 +51,9 @@ namespace fcl
 extern template
 class FCL_EXPORT DynamicAABBTreeCollisionManager_Array<double>;
 
+extern template
+class FCL_EXPORT DynamicAABBTreeCollisionManager_Array<float>;
+
 namespace detail
 {
 
@@ -465,32 +468,49 @@ bool distanceRecurse_(
 //==============================================================================
 template <typename S>
 FCL_EXPORT
-bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes1, size_t root1_id,
+bool canCollide(
+    const typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* node,
+    const CollisionObject<S>* query)
+{
+  return (node->category & query->getCollisionMask())
+      && (query->getCollisionCategory() & node->mask);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool collisionRecurse(const BroadPhaseCollisionManager<S>& manager,
+                      typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes1, size_t root1_id,
                       typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes2, size_t root2_id,
                       void* cdata, CollisionCallBack<S> callback)
 {
   typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* root1 = nodes1 + root1_id;
   typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* root2 = nodes2 + root2_id;
+  if(!root1->canCollideWith(*root2)) return false;
+
   if(root1->isLeaf() && root2->isLeaf())
   {
     if(!root1->bv.overlap(root2->bv)) return false;
-    return callback(static_cast<CollisionObject<S>*>(root1->data), static_cast<CollisionObject<S>*>(root2->data), cdata);
+    CollisionObject<S>* root1_obj = static_cast<CollisionObject<S>*>(root1->data);
+    CollisionObject<S>* root2_obj = static_cast<CollisionObject<S>*>(root2->data);
+    if(!manager.canCollide(root1_obj, root2_obj)) return false;
+    return callback(root1_obj, root2_obj, cdata);
   }
 
   if(!root1->bv.overlap(root2->bv)) return false;
 
   if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
   {
-    if(collisionRecurse(nodes1, root1->children[0], nodes2, root2_id, cdata, callback))
+    if(collisionRecurse(manager, nodes1, root1->children[0], nodes2, root2_id, cdata, callback))
       return true;
-    if(collisionRecurse(nodes1, root1->children[1], nodes2, root2_id, cdata, callback))
+    if(collisionRecurse(manager, nodes1, root1->children[1], nodes2, root2_id, cdata, callback))
       return true;
   }
   else
   {
-    if(collisionRecurse(nodes1, root1_id, nodes2, root2->children[0], cdata, callback))
+    if(collisionRecurse(manager, nodes1, root1_id, nodes2, root2->children[0], cdata, callback))
       return true;
-    if(collisionRecurse(nodes1, root1_id, nodes2, root2->children[1], cdata, callback))
+    if(collisionRecurse(manager, nodes1, root1_id, nodes2, root2->children[1], cdata, callback))
       return true;
   }
   return false;
@@ -499,23 +519,27 @@ bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::Dynamic
 //==============================================================================
 template <typename S>
 FCL_EXPORT
-bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes, size_t root_id, CollisionObject<S>* query, void* cdata, CollisionCallBack<S> callback)
+bool collisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes, size_t root_id, CollisionObject<S>* query, const AABB<S>& query_aabb, void* cdata, CollisionCallBack<S> callback)
 {
   typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* root = nodes + root_id;
+  if(!canCollide<S>(root, query)) return false;
+
   if(root->isLeaf())
   {
-    if(!root->bv.overlap(query->getAABB())) return false;
-    return callback(static_cast<CollisionObject<S>*>(root->data), query, cdata);
+    if(!root->bv.overlap(query_aabb)) return false;
+    CollisionObject<S>* root_obj = static_cast<CollisionObject<S>*>(root->data);
+    if(!manager.canCollide(root_obj, query)) return false;
+    return callback(root_obj, query, cdata);
   }
 
-  if(!root->bv.overlap(query->getAABB())) return false;
+  if(!root->bv.overlap(query_aabb)) return false;
 
-  int select_res = implementation_array::select(query->getAABB(), root->children[0], root->children[1], nodes);
+  int select_res = implementation_array::select(query_aabb, root->children[0], root->children[1], nodes);
 
-  if(collisionRecurse(nodes, root->children[select_res], query, cdata, callback))
+  if(collisionRecurse(manager, nodes, root->children[select_res], query, query_aabb, cdata, callback))
     return true;
 
-  if(collisionRecurse(nodes, root->children[1-select_res], query, cdata, callback))
+  if(collisionRecurse(manager, nodes, root->children[1-select_res], query, query_aabb, cdata, callback))
     return true;
 
   return false;
@@ -524,18 +548,28 @@ bool collisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::Dynamic
 //==============================================================================
 template <typename S>
 FCL_EXPORT
-bool selfCollisionRecurse(typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes, size_t root_id, void* cdata, CollisionCallBack<S> callback)
+bool collisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes, size_t root_id, CollisionObject<S>* query, void* cdata, CollisionCallBack<S> callback)
+{
+  return collisionRecurse(manager, nodes, root_id, query, query->getAABB(), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool selfCollisionRecurse(const BroadPhaseCollisionManager<S>& manager, typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* nodes, size_t root_id, void* cdata, CollisionCallBack<S> callback)
 {
   typename DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBNode* root = nodes + root_id;
-  if(root->isLeaf()) return false;
 
-  if(selfCollisionRecurse(nodes, root->children[0], cdata, callback))
+  // No two objects of the subtree can collide when this fails
+  if(root->isLeaf() || !root->canCollideWith(*root)) return false;
+
+  if(selfCollisionRecurse(manager, nodes, root->children[0], cdata, callback))
     return true;
 
-  if(selfCollisionRecurse(nodes, root->children[1], cdata, callback))
+  if(selfCollisionRecurse(manager, nodes, root->children[1], cdata, callback))
     return true;
 
-  if(collisionRecurse(nodes, root->children[0], nodes, root->children[1], cdata, callback))
+  if(collisionRecurse(manager, nodes, root->children[0], nodes, root->children[1], cdata, callback))
     return true;
 
   return false;
@@ -732,7 +766,8 @@ template <typename S>
 FCL_EXPORT
 DynamicAABBTreeCollisionManager_Array<S>::DynamicAABBTreeCollisionManager_Array()
   : tree_topdown_balance_threshold(dtree.bu_threshold),
-    tree_topdown_level(dtree.topdown_level)
+    tree_topdown_level(dtree.topdown_level),
+    hierarchy_view(&dtree)
 {
   max_tree_nonbalanced_level = 10;
   tree_incremental_balance_pass = 10;
@@ -761,14 +796,16 @@ void DynamicAABBTreeCollisionManager_Array<S>::registerObjects(
   else
   {
     DynamicAABBNode* leaves = new DynamicAABBNode[other_objs.size()];
-    table.rehash(other_objs.size());
+    table.reserve(other_objs.size());
     for(size_t i = 0, size = other_objs.size(); i < size; ++i)
     {
-      leaves[i].bv = other_objs[i]->getAABB();
+      leaves[i].bv = this->marginAABB(other_objs[i]);
       leaves[i].parent = dtree.NULL_NODE;
       leaves[i].children[1] = dtree.NULL_NODE;
       leaves[i].data = other_objs[i];
-      table[other_objs[i]] = i;
+      leaves[i].category = other_objs[i]->getCollisionCategory();
+      leaves[i].mask = other_objs[i]->getCollisionMask();
+      table.insert(other_objs[i], i);
     }
 
     int n_leaves = other_objs.size();
@@ -784,8 +821,9 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager_Array<S>::registerObject(CollisionObject<S>* obj)
 {
-  size_t node = dtree.insert(obj->getAABB(), obj);
-  table[obj] = node;
+  size_t node = dtree.insert(this->marginAABB(obj), obj);
+  dtree.updateCategories(node, obj->getCollisionCategory(), obj->getCollisionMask());
+  table.insert(obj, node);
 }
 
 //==============================================================================
@@ -793,8 +831,12 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager_Array<S>::unregisterObject(CollisionObject<S>* obj)
 {
-  size_t node = table[obj];
-  table.erase(obj);
+  const auto it = table.find(obj);
+  if(it == table.end())
+    return;
+
+  const size_t node = it->second;
+  table.erase(it);
   dtree.remove(node);
 }
 
@@ -833,7 +875,9 @@ void DynamicAABBTreeCollisionManager_Array<S>::update()
   {
     const CollisionObject<S>* obj = it->first;
     size_t node = it->second;
-    dtree.getNodes()[node].bv = obj->getAABB();
+    dtree.getNodes()[node].bv = this->marginAABB(obj);
+    dtree.getNodes()[node].category = obj->getCollisionCategory();
+    dtree.getNodes()[node].mask = obj->getCollisionMask();
   }
 
   dtree.refit();
@@ -851,8 +895,10 @@ void DynamicAABBTreeCollisionManager_Array<S>::update_(CollisionObject<S>* updat
   if(it != table.end())
   {
     size_t node = it->second;
-    if(!dtree.getNodes()[node].bv.equal(updated_obj->getAABB()))
-      dtree.update(node, updated_obj->getAABB());
+    const AABB<S> aabb = this->marginAABB(updated_obj);
+    if(!dtree.getNodes()[node].bv.equal(aabb))
+      dtree.update(node, aabb);
+    dtree.updateCategories(node, updated_obj->getCollisionCategory(), updated_obj->getCollisionMask());
   }
   setup_ = false;
 }
@@ -911,12 +957,12 @@ void DynamicAABBTreeCollisionManager_Array<S>::collide(CollisionObject<S>* obj,
         detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), octree, octree->getRoot(), octree->getRootBV(), obj->getTransform(), cdata, callback);
       }
       else
-        detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback);
+        detail::dynamic_AABB_tree_array::collisionRecurse(*this, dtree.getNodes(), dtree.getRoot(), obj, this->marginAABB(obj), cdata, callback);
     }
     break;
 #endif
   default:
-    detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), obj, cdata, callback);
+    detail::dynamic_AABB_tree_array::collisionRecurse(*this, dtree.getNodes(), dtree.getRoot(), obj, this->marginAABB(obj), cdata, callback);
   }
 }
 
@@ -953,7 +999,7 @@ FCL_EXPORT
 void DynamicAABBTreeCollisionManager_Array<S>::collide(void* cdata, CollisionCallBack<S> callback) const
 {
   if(size() == 0) return;
-  detail::dynamic_AABB_tree_array::selfCollisionRecurse(dtree.getNodes(), dtree.getRoot(), cdata, callback);
+  detail::dynamic_AABB_tree_array::selfCollisionRecurse(*this, dtree.getNodes(), dtree.getRoot(), cdata, callback);
 }
 
 //==============================================================================
@@ -971,9 +1017,14 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager_Array<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  DynamicAABBTreeCollisionManager_Array* other_manager = static_cast<DynamicAABBTreeCollisionManager_Array*>(other_manager_);
+  DynamicAABBTreeCollisionManager_Array* other_manager = dynamic_cast<DynamicAABBTreeCollisionManager_Array*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
   if((size() == 0) || (other_manager->size() == 0)) return;
-  detail::dynamic_AABB_tree_array::collisionRecurse(dtree.getNodes(), dtree.getRoot(), other_manager->dtree.getNodes(), other_manager->dtree.getRoot(), cdata, callback);
+  detail::dynamic_AABB_tree_array::collisionRecurse(*this, dtree.getNodes(), dtree.getRoot(), other_manager->dtree.getNodes(), other_manager->dtree.getRoot(), cdata, callback);
 }
 
 //==============================================================================
@@ -981,7 +1032,12 @@ template <typename S>
 FCL_EXPORT
 void DynamicAABBTreeCollisionManager_Array<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  DynamicAABBTreeCollisionManager_Array* other_manager = static_cast<DynamicAABBTreeCollisionManager_Array*>(other_manager_);
+  DynamicAABBTreeCollisionManager_Array* other_manager = dynamic_cast<DynamicAABBTreeCollisionManager_Array*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
   if((size() == 0) || (other_manager->size() == 0)) return;
   S min_dist = std::numeric_limits<S>::max();
   detail::dynamic_AABB_tree_array::distanceRecurse(dtree.getNodes(), dtree.getRoot(), other_manager->dtree.getNodes(), other_manager->dtree.getRoot(), cdata, callback, min_dist);
@@ -1012,6 +1068,15 @@ DynamicAABBTreeCollisionManager_Array<S>::getTree() const
   return dtree;
 }
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+const detail::AABBHierarchyView<S>*
+DynamicAABBTreeCollisionManager_Array<S>::getHierarchyView() const
+{
+  return &hierarchy_view;
+}
+
 } // namespace fcl
 
 #endif
@@ -38,7 +38,6 @@
 #ifndef FCL_BROAD_PHASE_DYNAMIC_AABB_TREE_ARRAY_H
 #define FCL_BROAD_PHASE_DYNAMIC_AABB_TREE_ARRAY_H
 
-#include <unordered_map>
 #include <functional>
 #include <limits>
 
@@ -47,6 +46,7 @@
 #include "fcl/geometry/shape/utility.h"
 #include "fcl/broadphase/broadphase_collision_manager.h"
 #include "fcl/broadphase/detail/hierarchy_tree_array.h"
+#include "fcl/broadphase/detail/proxy_table.h"
 
 namespace fcl
 {
@@ -57,7 +57,7 @@ class FCL_EXPORT DynamicAABBTreeCollisionManager_Array : public BroadPhaseCollis
 public:
 
   using DynamicAABBNode = detail::implementation_array::NodeBase<AABB<S>>;
-  using DynamicAABBTable = std::unordered_map<CollisionObject<S>*, size_t>;
+  using DynamicAABBTable = detail::ProxyTable<S, size_t>;
 
   int max_tree_nonbalanced_level;
   int tree_incremental_balance_pass;
@@ -123,9 +123,14 @@ public:
 
   const detail::implementation_array::HierarchyTree<AABB<S>>& getTree() const;
 
+  /// @brief a view of the tree
+  const detail::AABBHierarchyView<S>* getHierarchyView() const;
+
 private:
   detail::implementation_array::HierarchyTree<AABB<S>> dtree;
-  std::unordered_map<CollisionObject<S>*, size_t> table;
+  DynamicAABBTable table;
+
+  detail::HierarchyTreeArrayView<S> hierarchy_view;
 
   bool setup_;
 
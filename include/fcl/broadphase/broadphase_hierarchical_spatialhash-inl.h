@@ -0,0 +1,563 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASEHIERARCHICALSPATIALHASH_INL_H
+#define FCL_BROADPHASE_BROADPHASEHIERARCHICALSPATIALHASH_INL_H
+
+#include "fcl/broadphase/broadphase_hierarchical_spatialhash.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT HierarchicalSpatialHashCollisionManager<double>;
+
+extern template
+class FCL_EXPORT HierarchicalSpatialHashCollisionManager<float>;
+
+//==============================================================================
+template <typename S>
+HierarchicalSpatialHashCollisionManager<S>::
+HierarchicalSpatialHashCollisionManager(S min_cell_size, S ratio)
+  : min_cell_size(min_cell_size),
+    ratio(ratio),
+    dirty(false)
+{
+  if(!(ratio > 1))
+    throw std::logic_error(
+        "HierarchicalSpatialHashCollisionManager ratio must exceed 1.");
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::registerObjects(
+    const std::vector<CollisionObject<S>*>& other_objs)
+{
+  objs.reserve(objs.size() + other_objs.size());
+  for(auto* obj : other_objs)
+    registerObject(obj);
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::registerObject(
+    CollisionObject<S>* obj)
+{
+  if(obj_index.emplace(obj, objs.size()).second)
+  {
+    objs.push_back(obj);
+    dirty = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::unregisterObject(
+    CollisionObject<S>* obj)
+{
+  auto it = obj_index.find(obj);
+  if(it == obj_index.end())
+    return;
+
+  const std::size_t index = it->second;
+  obj_index.erase(it);
+
+  CollisionObject<S>* last = objs.back();
+  objs.pop_back();
+  if(last != obj)
+  {
+    objs[index] = last;
+    obj_index[last] = index;
+  }
+
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::setup()
+{
+  dirty = true;
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::update()
+{
+  dirty = true;
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::update(
+    CollisionObject<S>* updated_obj)
+{
+  FCL_UNUSED(updated_obj);
+
+  // Rebuilt once by the next query, however many objects moved
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::update(
+    const std::vector<CollisionObject<S>*>& updated_objs)
+{
+  FCL_UNUSED(updated_objs);
+
+  update();
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::clear()
+{
+  objs.clear();
+  obj_index.clear();
+  for(auto& level : levels)
+    level.clear();
+  for(auto& members : level_objs)
+    members.clear();
+  aabbs.clear();
+  boxes.clear();
+  scene_bound = AABB<S>();
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::getObjects(
+    std::vector<CollisionObject<S>*>& objs) const
+{
+  objs = this->objs;
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::collide(
+    CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  collide_(obj, this->marginAABB(obj), 0, cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::distance(
+    CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  S min_dist = std::numeric_limits<S>::max();
+  distance_(obj, 0, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::collide(
+    void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  for(std::size_t l = 0; l < levels.size(); ++l)
+  {
+    // Pairs within the level, each reported in the first cell it shares
+    auto visitor = [&](int x, int y, int z,
+                       const unsigned int* begin, const unsigned int* end) -> bool
+    {
+      for(auto a = begin; a != end; ++a)
+      {
+        for(auto b = a + 1; b != end; ++b)
+        {
+          if(!detail::SpatialHashGrid<S>::isFirstSharedCell(
+               boxes[*a], boxes[*b], x, y, z))
+            continue;
+
+          if(aabbs[*a].overlap(aabbs[*b])
+             && this->canCollide(objs[*a], objs[*b])
+             && callback(objs[*a], objs[*b], cdata))
+            return true;
+        }
+      }
+      return false;
+    };
+
+    if(levels[l].forEachOccupiedCell(visitor))
+      return;
+
+    // Pairs with the coarser levels, found from the finer object
+    if(l + 1 < levels.size())
+    {
+      for(const auto i : level_objs[l])
+      {
+        if(collide_(objs[i], aabbs[i], l + 1, cdata, callback))
+          return;
+      }
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::distance(
+    void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  // Each pair is considered from its object of lower index only
+  S min_dist = std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    if(distance_(objs[i], i + 1, cdata, callback, min_dist))
+      return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::collide(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<
+      HierarchicalSpatialHashCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  // Query the larger manager with the objects of the smaller one, grown by
+  // the margin of the manager they belong to
+  if(this->size() < other_manager->size())
+  {
+    for(std::size_t i = 0; i < objs.size(); ++i)
+    {
+      if(other_manager->collide_(objs[i], aabbs[i], 0, cdata, callback))
+        return;
+    }
+  }
+  else
+  {
+    for(std::size_t i = 0; i < other_manager->objs.size(); ++i)
+    {
+      if(collide_(other_manager->objs[i], other_manager->aabbs[i], 0,
+                  cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::distance(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    DistanceCallBack<S> callback) const
+{
+  auto* other_manager = dynamic_cast<
+      HierarchicalSpatialHashCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  if(this->size() < other_manager->size())
+  {
+    for(const auto& obj : objs)
+      if(other_manager->distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+  else
+  {
+    for(const auto& obj : other_manager->objs)
+      if(distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool HierarchicalSpatialHashCollisionManager<S>::empty() const
+{
+  return objs.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t HierarchicalSpatialHashCollisionManager<S>::size() const
+{
+  return objs.size();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t HierarchicalSpatialHashCollisionManager<S>::numLevels() const
+{
+  build();
+
+  std::size_t num_levels = level_objs.size();
+  while(num_levels > 0 && level_objs[num_levels - 1].empty())
+    --num_levels;
+
+  return num_levels;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t HierarchicalSpatialHashCollisionManager<S>::numObjectsInLevel(
+    std::size_t level) const
+{
+  build();
+
+  return level < level_objs.size() ? level_objs[level].size() : 0;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t HierarchicalSpatialHashCollisionManager<S>::levelOf(
+    const AABB<S>& aabb) const
+{
+  // Beyond this many levels, the coarsest one takes the rest
+  const std::size_t max_levels = 32;
+
+  const S extent = (aabb.max_ - aabb.min_).maxCoeff();
+  S cell_size = min_cell_size;
+  std::size_t level = 0;
+  while(cell_size < extent && level + 1 < max_levels)
+  {
+    cell_size *= ratio;
+    ++level;
+  }
+
+  return level;
+}
+
+//==============================================================================
+template <typename S>
+void HierarchicalSpatialHashCollisionManager<S>::build() const
+{
+  if(!dirty)
+    return;
+
+  const std::size_t n = objs.size();
+  aabbs.resize(n);
+  boxes.resize(n);
+  for(auto& members : level_objs)
+    members.clear();
+  scene_bound = AABB<S>();
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    aabbs[i] = this->marginAABB(objs[i]);
+    scene_bound += aabbs[i];
+
+    const std::size_t l = levelOf(aabbs[i]);
+    while(levels.size() <= l)
+    {
+      const S cell_size = levels.empty()
+          ? min_cell_size : levels.back().getCellSize() * ratio;
+      levels.emplace_back(cell_size);
+      level_objs.emplace_back();
+    }
+
+    boxes[i] = levels[l].cellBox(aabbs[i]);
+    level_objs[l].push_back(static_cast<unsigned int>(i));
+  }
+
+  for(std::size_t l = 0; l < levels.size(); ++l)
+    levels[l].build(boxes, level_objs[l]);
+
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+bool HierarchicalSpatialHashCollisionManager<S>::collide_(
+    CollisionObject<S>* obj,
+    const AABB<S>& obj_aabb,
+    std::size_t first_level,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  for(std::size_t l = first_level; l < levels.size(); ++l)
+  {
+    if(level_objs[l].empty())
+      continue;
+
+    const CellBox box = levels[l].cellBox(obj_aabb);
+    auto visitor = [&](int x, int y, int z,
+                       const unsigned int* begin, const unsigned int* end) -> bool
+    {
+      for(auto it = begin; it != end; ++it)
+      {
+        if(!detail::SpatialHashGrid<S>::isFirstSharedCell(
+             box, boxes[*it], x, y, z))
+          continue;
+
+        if(objs[*it] != obj && aabbs[*it].overlap(obj_aabb)
+           && this->canCollide(obj, objs[*it])
+           && callback(obj, objs[*it], cdata))
+          return true;
+      }
+      return false;
+    };
+
+    if(levels[l].forEachCell(box, visitor))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool HierarchicalSpatialHashCollisionManager<S>::distance_(
+    CollisionObject<S>* obj,
+    std::size_t first_index,
+    void* cdata,
+    DistanceCallBack<S> callback,
+    S& min_dist) const
+{
+  const AABB<S>& obj_aabb = obj->getAABB();
+
+  // Search boxes of doubling size around the object. Each round only visits
+  // the objects whose AABB distance falls in [lower, upper), and the search
+  // stops once the best distance is within the searched radius.
+  S lower = 0;
+  S upper = 0;
+  auto test = [&](unsigned int i) -> bool
+  {
+    if(i < first_index || objs[i] == obj)
+      return false;
+
+    const S d = objs[i]->getAABB().distance(obj_aabb);
+    if(d < lower || d >= upper || d >= min_dist)
+      return false;
+
+    return callback(obj, objs[i], cdata, min_dist);
+  };
+
+  S radius = min_cell_size;
+  while(true)
+  {
+    const Vector3<S> delta = Vector3<S>::Constant(radius);
+    const AABB<S> search(obj_aabb.min_ - delta, obj_aabb.max_ + delta);
+    const bool last = !(radius < std::numeric_limits<S>::max() / 2)
+        || search.contain(scene_bound);
+    upper = last ? std::numeric_limits<S>::max() : radius;
+
+    if(last)
+    {
+      for(std::size_t i = 0; i < objs.size(); ++i)
+        if(test(static_cast<unsigned int>(i))) return true;
+      return false;
+    }
+
+    for(std::size_t l = 0; l < levels.size(); ++l)
+    {
+      if(level_objs[l].empty())
+        continue;
+
+      const CellBox box = levels[l].cellBox(search);
+      auto visitor = [&](int x, int y, int z,
+                         const unsigned int* begin, const unsigned int* end) -> bool
+      {
+        for(auto it = begin; it != end; ++it)
+        {
+          if(detail::SpatialHashGrid<S>::isFirstSharedCell(
+               box, boxes[*it], x, y, z) && test(*it))
+            return true;
+        }
+        return false;
+      };
+
+      if(levels[l].forEachCell(box, visitor))
+        return true;
+    }
+
+    if(min_dist <= radius)
+      return false;
+
+    lower = radius;
+    radius *= 2;
+  }
+}
+
+} // namespace fcl
+
+#endif
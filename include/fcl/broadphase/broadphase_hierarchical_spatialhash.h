@@ -0,0 +1,177 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASEHIERARCHICALSPATIALHASH_H
+#define FCL_BROADPHASE_BROADPHASEHIERARCHICALSPATIALHASH_H
+
+#include <unordered_map>
+#include <vector>
+#include "fcl/math/bv/AABB.h"
+#include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/spatial_hash_grid.h"
+
+namespace fcl
+{
+
+/// @brief Hierarchical spatial hashing collision manager for scenes whose
+/// object sizes span orders of magnitude.
+///
+/// Level l is an unbounded hash grid of cell size min_cell_size * ratio^l.
+/// Each object is binned into the finest level whose cells are at least as
+/// large as the object, so it covers at most two cells per axis whatever its
+/// size. Pairs within a level are found in the shared cells, pairs across
+/// levels by querying the coarser levels with the finer object. There is no
+/// scene limit.
+///
+/// As in SpatialHashGridCollisionManager, the levels are rebuilt by update()
+/// or setup(), or lazily by the next query.
+template <typename S>
+class FCL_EXPORT HierarchicalSpatialHashCollisionManager
+    : public BroadPhaseCollisionManager<S>
+{
+public:
+
+  HierarchicalSpatialHashCollisionManager(S min_cell_size, S ratio = 2);
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(CollisionObject<S>* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<CollisionObject<S>*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging ot the manager
+  void distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e, N^2 self collision)
+  void collide(void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager<S>* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager<S>* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  /// @brief the number of levels holding objects, as of the last build
+  std::size_t numLevels() const;
+
+  /// @brief the number of objects binned into a level, as of the last build
+  std::size_t numObjectsInLevel(std::size_t level) const;
+
+protected:
+
+  using CellBox = typename detail::SpatialHashGrid<S>::CellBox;
+
+  /// @brief the level of an object of the given AABB
+  std::size_t levelOf(const AABB<S>& aabb) const;
+
+  /// @brief rebuild the levels if objects were added, removed or moved
+  void build() const;
+
+  /// @brief perform collision test between one object and the objects of the
+  /// levels from first_level on, given the AABB to query with
+  bool collide_(CollisionObject<S>* obj, const AABB<S>& obj_aabb, std::size_t first_level, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and the objects
+  /// of the manager whose index is at least first_index
+  bool distance_(CollisionObject<S>* obj, std::size_t first_index, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief all objects in the scene
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief index of each object in objs
+  std::unordered_map<CollisionObject<S>*, std::size_t> obj_index;
+
+  /// @brief cell size of the finest level and size ratio between levels
+  S min_cell_size;
+  S ratio;
+
+  /// @brief whether the levels are out of date
+  mutable bool dirty;
+
+  /// @brief the grid of each level, kept between builds
+  mutable std::vector<detail::SpatialHashGrid<S>> levels;
+
+  /// @brief indices of the objects of each level
+  mutable std::vector<std::vector<unsigned int>> level_objs;
+
+  /// @brief the AABB (grown by the security margin) of each object and its
+  /// cells in its level, as of the last build
+  mutable std::vector<AABB<S>> aabbs;
+  mutable std::vector<CellBox> boxes;
+
+  /// @brief bound of all the objects
+  mutable AABB<S> scene_bound;
+};
+
+using HierarchicalSpatialHashCollisionManagerf = HierarchicalSpatialHashCollisionManager<float>;
+using HierarchicalSpatialHashCollisionManagerd = HierarchicalSpatialHashCollisionManager<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_hierarchical_spatialhash-inl.h"
+
+#endif
@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT IntervalTreeCollisionManager<double>;
 
+extern template
+class FCL_EXPORT IntervalTreeCollisionManager<float>;
+
 //==============================================================================
 template <typename S>
 void IntervalTreeCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
@@ -54,104 +57,41 @@ void IntervalTreeCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
   // must sorted before
   setup();
 
-  EndPoint p;
-  p.value = obj->getAABB().min_[0];
-  auto start1 = std::lower_bound(endpoints[0].begin(), endpoints[0].end(), p);
-  p.value = obj->getAABB().max_[0];
-  auto end1 = std::upper_bound(start1, endpoints[0].end(), p);
-
-  if(start1 < end1)
+  // The endpoints of the object are at the bounds of its intervals, which are
+  // not those of its AABB if it moved since its last update
+  AABB<S> aabb = this->marginAABB(obj);
+  const auto it = obj_intervals.find(obj);
+  if(it != obj_intervals.end())
   {
-    unsigned int start_id = start1 - endpoints[0].begin();
-    unsigned int end_id = end1 - endpoints[0].begin();
-    unsigned int cur_id = start_id;
-    for(unsigned int i = start_id; i < end_id; ++i)
+    for(int i = 0; i < 3; ++i)
     {
-      if(endpoints[0][i].obj != obj)
-      {
-        if(i == cur_id) cur_id++;
-        else
-        {
-          endpoints[0][cur_id] = endpoints[0][i];
-          cur_id++;
-        }
-      }
+      aabb.min_[i] = it->second[i]->low;
+      aabb.max_[i] = it->second[i]->high;
     }
-    if(cur_id < end_id)
-      endpoints[0].resize(endpoints[0].size() - 2);
   }
 
-  p.value = obj->getAABB().min_[1];
-  auto start2 = std::lower_bound(endpoints[1].begin(), endpoints[1].end(), p);
-  p.value = obj->getAABB().max_[1];
-  auto end2 = std::upper_bound(start2, endpoints[1].end(), p);
-
-  if(start2 < end2)
+  EndPoint p;
+  for(int i = 0; i < 3; ++i)
   {
-    unsigned int start_id = start2 - endpoints[1].begin();
-    unsigned int end_id = end2 - endpoints[1].begin();
-    unsigned int cur_id = start_id;
-    for(unsigned int i = start_id; i < end_id; ++i)
-    {
-      if(endpoints[1][i].obj != obj)
-      {
-        if(i == cur_id) cur_id++;
-        else
-        {
-          endpoints[1][cur_id] = endpoints[1][i];
-          cur_id++;
-        }
-      }
-    }
-    if(cur_id < end_id)
-      endpoints[1].resize(endpoints[1].size() - 2);
+    p.value = aabb.min_[i];
+    const auto start = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), p);
+    p.value = aabb.max_[i];
+    const auto end = std::upper_bound(start, endpoints[i].end(), p);
+    endpoints[i].erase(
+        std::remove_if(start, end, [obj](const EndPoint& q) { return q.obj == obj; }),
+        end);
   }
 
-
-  p.value = obj->getAABB().min_[2];
-  auto start3 = std::lower_bound(endpoints[2].begin(), endpoints[2].end(), p);
-  p.value = obj->getAABB().max_[2];
-  auto end3 = std::upper_bound(start3, endpoints[2].end(), p);
-
-  if(start3 < end3)
+  // update the interval tree
+  if(it != obj_intervals.end())
   {
-    unsigned int start_id = start3 - endpoints[2].begin();
-    unsigned int end_id = end3 - endpoints[2].begin();
-    unsigned int cur_id = start_id;
-    for(unsigned int i = start_id; i < end_id; ++i)
+    for(int i = 0; i < 3; ++i)
     {
-      if(endpoints[2][i].obj != obj)
-      {
-        if(i == cur_id) cur_id++;
-        else
-        {
-          endpoints[2][cur_id] = endpoints[2][i];
-          cur_id++;
-        }
-      }
+      interval_trees[i]->deleteNode(it->second[i]);
+      delete it->second[i];
     }
-    if(cur_id < end_id)
-      endpoints[2].resize(endpoints[2].size() - 2);
-  }
 
-  // update the interval tree
-  if(obj_interval_maps[0].find(obj) != obj_interval_maps[0].end())
-  {
-    SAPInterval* ivl1 = obj_interval_maps[0][obj];
-    SAPInterval* ivl2 = obj_interval_maps[1][obj];
-    SAPInterval* ivl3 = obj_interval_maps[2][obj];
-
-    interval_trees[0]->deleteNode(ivl1);
-    interval_trees[1]->deleteNode(ivl2);
-    interval_trees[2]->deleteNode(ivl3);
-
-    delete ivl1;
-    delete ivl2;
-    delete ivl3;
-
-    obj_interval_maps[0].erase(obj);
-    obj_interval_maps[1].erase(obj);
-    obj_interval_maps[2].erase(obj);
+    obj_intervals.erase(it);
   }
 }
 
@@ -175,23 +115,24 @@ template <typename S>
 void IntervalTreeCollisionManager<S>::registerObject(CollisionObject<S>* obj)
 {
   EndPoint p, q;
+  const AABB<S> aabb = this->marginAABB(obj);
 
   p.obj = obj;
   q.obj = obj;
   p.minmax = 0;
   q.minmax = 1;
-  p.value = obj->getAABB().min_[0];
-  q.value = obj->getAABB().max_[0];
+  p.value = aabb.min_[0];
+  q.value = aabb.max_[0];
   endpoints[0].push_back(p);
   endpoints[0].push_back(q);
 
-  p.value = obj->getAABB().min_[1];
-  q.value = obj->getAABB().max_[1];
+  p.value = aabb.min_[1];
+  q.value = aabb.max_[1];
   endpoints[1].push_back(p);
   endpoints[1].push_back(q);
 
-  p.value = obj->getAABB().min_[2];
-  q.value = obj->getAABB().max_[2];
+  p.value = aabb.min_[2];
+  q.value = aabb.max_[2];
   endpoints[2].push_back(p);
   endpoints[2].push_back(q);
   setup_ = false;
@@ -213,23 +154,26 @@ void IntervalTreeCollisionManager<S>::setup()
     for(int i = 0; i < 3; ++i)
       interval_trees[i] = new detail::IntervalTree<S>;
 
+    // The intervals of the last setup went with the old trees
+    clearIntervals();
+    obj_intervals.reserve(endpoints[0].size() / 2);
+
     for(unsigned int i = 0, size = endpoints[0].size(); i < size; ++i)
     {
       EndPoint p = endpoints[0][i];
       CollisionObject<S>* obj = p.obj;
       if(p.minmax == 0)
       {
-        SAPInterval* ivl1 = new SAPInterval(obj->getAABB().min_[0], obj->getAABB().max_[0], obj);
-        SAPInterval* ivl2 = new SAPInterval(obj->getAABB().min_[1], obj->getAABB().max_[1], obj);
-        SAPInterval* ivl3 = new SAPInterval(obj->getAABB().min_[2], obj->getAABB().max_[2], obj);
+        const AABB<S> aabb = this->marginAABB(obj);
+        SAPInterval* ivl1 = new SAPInterval(aabb.min_[0], aabb.max_[0], obj);
+        SAPInterval* ivl2 = new SAPInterval(aabb.min_[1], aabb.max_[1], obj);
+        SAPInterval* ivl3 = new SAPInterval(aabb.min_[2], aabb.max_[2], obj);
 
         interval_trees[0]->insert(ivl1);
         interval_trees[1]->insert(ivl2);
         interval_trees[2]->insert(ivl3);
 
-        obj_interval_maps[0][obj] = ivl1;
-        obj_interval_maps[1][obj] = ivl2;
-        obj_interval_maps[2][obj] = ivl3;
+        obj_intervals.insert(obj, {{ivl1, ivl2, ivl3}});
       }
     }
 
@@ -246,25 +190,25 @@ void IntervalTreeCollisionManager<S>::update()
   for(unsigned int i = 0, size = endpoints[0].size(); i < size; ++i)
   {
     if(endpoints[0][i].minmax == 0)
-      endpoints[0][i].value = endpoints[0][i].obj->getAABB().min_[0];
+      endpoints[0][i].value = this->marginAABB(endpoints[0][i].obj).min_[0];
     else
-      endpoints[0][i].value = endpoints[0][i].obj->getAABB().max_[0];
+      endpoints[0][i].value = this->marginAABB(endpoints[0][i].obj).max_[0];
   }
 
   for(unsigned int i = 0, size = endpoints[1].size(); i < size; ++i)
   {
     if(endpoints[1][i].minmax == 0)
-      endpoints[1][i].value = endpoints[1][i].obj->getAABB().min_[1];
+      endpoints[1][i].value = this->marginAABB(endpoints[1][i].obj).min_[1];
     else
-      endpoints[1][i].value = endpoints[1][i].obj->getAABB().max_[1];
+      endpoints[1][i].value = this->marginAABB(endpoints[1][i].obj).max_[1];
   }
 
   for(unsigned int i = 0, size = endpoints[2].size(); i < size; ++i)
   {
     if(endpoints[2][i].minmax == 0)
-      endpoints[2][i].value = endpoints[2][i].obj->getAABB().min_[2];
+      endpoints[2][i].value = this->marginAABB(endpoints[2][i].obj).min_[2];
     else
-      endpoints[2][i].value = endpoints[2][i].obj->getAABB().max_[2];
+      endpoints[2][i].value = this->marginAABB(endpoints[2][i].obj).max_[2];
   }
 
   setup();
@@ -276,43 +220,30 @@ template <typename S>
 void IntervalTreeCollisionManager<S>::update(CollisionObject<S>* updated_obj)
 {
   AABB<S> old_aabb;
-  const AABB<S>& new_aabb = updated_obj->getAABB();
-  for(int i = 0; i < 3; ++i)
-  {
-    const auto it = obj_interval_maps[i].find(updated_obj);
-    interval_trees[i]->deleteNode(it->second);
-    old_aabb.min_[i] = it->second->low;
-    old_aabb.max_[i] = it->second->high;
-    it->second->low = new_aabb.min_[i];
-    it->second->high = new_aabb.max_[i];
-    interval_trees[i]->insert(it->second);
-  }
+  if(!updateIntervals(updated_obj, old_aabb))
+    return;
+
+  const AABB<S> new_aabb = this->marginAABB(updated_obj);
 
+  // Both endpoints are found before either moves, the search needs them
+  // sorted
   EndPoint dummy;
-  typename std::vector<EndPoint>::iterator it;
   for(int i = 0; i < 3; ++i)
   {
     dummy.value = old_aabb.min_[i];
-    it = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), dummy);
-    for(; it != endpoints[i].end(); ++it)
-    {
-      if(it->obj == updated_obj && it->minmax == 0)
-      {
-        it->value = new_aabb.min_[i];
-        break;
-      }
-    }
+    auto lo = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), dummy);
+    while(lo != endpoints[i].end() && (lo->obj != updated_obj || lo->minmax != 0))
+      ++lo;
 
     dummy.value = old_aabb.max_[i];
-    it = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), dummy);
-    for(; it != endpoints[i].end(); ++it)
-    {
-      if(it->obj == updated_obj && it->minmax == 0)
-      {
-        it->value = new_aabb.max_[i];
-        break;
-      }
-    }
+    auto hi = std::lower_bound(endpoints[i].begin(), endpoints[i].end(), dummy);
+    while(hi != endpoints[i].end() && (hi->obj != updated_obj || hi->minmax != 1))
+      ++hi;
+
+    if(lo != endpoints[i].end())
+      lo->value = new_aabb.min_[i];
+    if(hi != endpoints[i].end())
+      hi->value = new_aabb.max_[i];
 
     std::sort(endpoints[i].begin(), endpoints[i].end());
   }
@@ -322,8 +253,52 @@ void IntervalTreeCollisionManager<S>::update(CollisionObject<S>* updated_obj)
 template <typename S>
 void IntervalTreeCollisionManager<S>::update(const std::vector<CollisionObject<S>*>& updated_objs)
 {
+  bool moved = false;
+  AABB<S> old_aabb;
   for(size_t i = 0; i < updated_objs.size(); ++i)
-    update(updated_objs[i]);
+    moved |= updateIntervals(updated_objs[i], old_aabb);
+
+  if(!moved)
+    return;
+
+  // Rather than searching for the endpoints of every object, each endpoint
+  // takes the bound of the interval of its object, and each axis is sorted
+  // once
+  for(int i = 0; i < 3; ++i)
+  {
+    for(auto& p : endpoints[i])
+    {
+      const auto ivl = obj_intervals.find(p.obj);
+      if(ivl != obj_intervals.end())
+        p.value = (p.minmax == 0) ? ivl->second[i]->low : ivl->second[i]->high;
+    }
+
+    std::sort(endpoints[i].begin(), endpoints[i].end());
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool IntervalTreeCollisionManager<S>::updateIntervals(
+    CollisionObject<S>* updated_obj, AABB<S>& old_aabb)
+{
+  const auto ivl = obj_intervals.find(updated_obj);
+  if(ivl == obj_intervals.end())
+    return false;
+
+  const AABB<S> new_aabb = this->marginAABB(updated_obj);
+  for(int i = 0; i < 3; ++i)
+  {
+    SAPInterval* interval = ivl->second[i];
+    interval_trees[i]->deleteNode(interval);
+    old_aabb.min_[i] = interval->low;
+    old_aabb.max_[i] = interval->high;
+    interval->low = new_aabb.min_[i];
+    interval->high = new_aabb.max_[i];
+    interval_trees[i]->insert(interval);
+  }
+
+  return true;
 }
 
 //==============================================================================
@@ -338,19 +313,23 @@ void IntervalTreeCollisionManager<S>::clear()
   delete interval_trees[1]; interval_trees[1] = nullptr;
   delete interval_trees[2]; interval_trees[2] = nullptr;
 
-  for(int i = 0; i < 3; ++i)
+  clearIntervals();
+
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void IntervalTreeCollisionManager<S>::clearIntervals()
+{
+  for(auto it = obj_intervals.cbegin(), end = obj_intervals.cend(); it != end;
+      ++it)
   {
-    for(auto it = obj_interval_maps[i].cbegin(), end = obj_interval_maps[i].cend();
-        it != end; ++it)
-    {
-      delete it->second;
-    }
+    for(int i = 0; i < 3; ++i)
+      delete it->second[i];
   }
 
-  for(int i = 0; i < 3; ++i)
-    obj_interval_maps[i].clear();
-
-  setup_ = false;
+  obj_intervals.clear();
 }
 
 //==============================================================================
@@ -383,14 +362,15 @@ bool IntervalTreeCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cd
   static const unsigned int CUTOFF = 100;
 
   std::deque<detail::SimpleInterval<S>*> results0, results1, results2;
+  const AABB<S> aabb = this->marginAABB(obj);
 
-  results0 = interval_trees[0]->query(obj->getAABB().min_[0], obj->getAABB().max_[0]);
+  results0 = interval_trees[0]->query(aabb.min_[0], aabb.max_[0]);
   if(results0.size() > CUTOFF)
   {
-    results1 = interval_trees[1]->query(obj->getAABB().min_[1], obj->getAABB().max_[1]);
+    results1 = interval_trees[1]->query(aabb.min_[1], aabb.max_[1]);
     if(results1.size() > CUTOFF)
     {
-      results2 = interval_trees[2]->query(obj->getAABB().min_[2], obj->getAABB().max_[2]);
+      results2 = interval_trees[2]->query(aabb.min_[2], aabb.max_[2]);
       if(results2.size() > CUTOFF)
       {
         int d1 = results0.size();
@@ -541,13 +521,14 @@ void IntervalTreeCollisionManager<S>::collide(void* cdata, CollisionCallBack<S>
       for(; iter != end; ++iter)
       {
         CollisionObject<S>* active_index = *iter;
-        const AABB<S>& b0 = active_index->getAABB();
-        const AABB<S>& b1 = index->getAABB();
+        const AABB<S> b0 = this->marginAABB(active_index);
+        const AABB<S> b1 = this->marginAABB(index);
 
         int axis2 = (axis + 1) % 3;
         int axis3 = (axis + 2) % 3;
 
-        if(b0.axisOverlap(b1, axis2) && b0.axisOverlap(b1, axis3))
+        if(b0.axisOverlap(b1, axis2) && b0.axisOverlap(b1, axis3)
+           && this->canCollide(active_index, index))
         {
           std::pair<typename std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*> >::iterator, bool> insert_res;
           if(active_index < index)
@@ -591,7 +572,12 @@ void IntervalTreeCollisionManager<S>::distance(void* cdata, DistanceCallBack<S>
 template <typename S>
 void IntervalTreeCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  IntervalTreeCollisionManager* other_manager = static_cast<IntervalTreeCollisionManager*>(other_manager_);
+  IntervalTreeCollisionManager* other_manager = dynamic_cast<IntervalTreeCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -617,7 +603,12 @@ void IntervalTreeCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* oth
 template <typename S>
 void IntervalTreeCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  IntervalTreeCollisionManager* other_manager = static_cast<IntervalTreeCollisionManager*>(other_manager_);
+  IntervalTreeCollisionManager* other_manager = dynamic_cast<IntervalTreeCollisionManager*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0)) return;
 
@@ -664,12 +655,15 @@ bool IntervalTreeCollisionManager<S>::checkColl(
     void* cdata,
     CollisionCallBack<S> callback) const
 {
+  const AABB<S> aabb = this->marginAABB(obj);
+
   while(pos_start < pos_end)
   {
     SAPInterval* ivl = static_cast<SAPInterval*>(*pos_start);
     if(ivl->obj != obj)
     {
-      if(ivl->obj->getAABB().overlap(obj->getAABB()))
+      if(this->marginAABB(ivl->obj).overlap(aabb)
+         && this->canCollide(ivl->obj, obj))
       {
         if(callback(ivl->obj, obj, cdata))
           return true;
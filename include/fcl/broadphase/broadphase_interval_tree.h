@@ -38,10 +38,11 @@
 #ifndef FCL_BROAD_PHASE_INTERVAL_TREE_H
 #define FCL_BROAD_PHASE_INTERVAL_TREE_H
 
+#include <array>
 #include <deque>
-#include <map>
 #include "fcl/broadphase/broadphase_collision_manager.h"
 #include "fcl/broadphase/detail/interval_tree.h"
+#include "fcl/broadphase/detail/proxy_table.h"
 
 namespace fcl
 {
@@ -130,13 +131,22 @@ protected:
 
   bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
 
+  /// @brief move the intervals of the object to its AABB, which leaves its
+  /// endpoints to the caller. Returns false if the object has no intervals.
+  bool updateIntervals(CollisionObject<S>* updated_obj, AABB<S>& old_aabb);
+
+  /// @brief delete the intervals of the objects
+  void clearIntervals();
+
   /// @brief vector stores all the end points
   std::vector<EndPoint> endpoints[3];
 
   /// @brief  interval tree manages the intervals
   detail::IntervalTree<S>* interval_trees[3];
 
-  std::map<CollisionObject<S>*, SAPInterval*> obj_interval_maps[3];
+  /// @brief the intervals of the objects in the three interval trees, found
+  /// through the handles of the objects
+  detail::ProxyTable<S, std::array<SAPInterval*, 3>> obj_intervals;
 
   /// @brief tag for whether the interval tree is maintained suitably
   bool setup_;
@@ -77,7 +77,7 @@ void SpatialHashingCollisionManager<S, HashTable>::registerObject(
 {
   objs.push_back(obj);
 
-  const AABB<S>& obj_aabb = obj->getAABB();
+  const AABB<S> obj_aabb = this->marginAABB(obj);
   AABB<S> overlap_aabb;
 
   if(scene_limit.overlap(obj_aabb, overlap_aabb))
@@ -101,7 +101,7 @@ void SpatialHashingCollisionManager<S, HashTable>::unregisterObject(CollisionObj
 {
   objs.remove(obj);
 
-  const AABB<S>& obj_aabb = obj->getAABB();
+  const AABB<S> obj_aabb = this->marginAABB(obj);
   AABB<S> overlap_aabb;
 
   if(scene_limit.overlap(obj_aabb, overlap_aabb))
@@ -137,7 +137,7 @@ void SpatialHashingCollisionManager<S, HashTable>::update()
   for(auto it = objs.cbegin(), end = objs.cend(); it != end; ++it)
   {
     CollisionObject<S>* obj = *it;
-    const AABB<S>& obj_aabb = obj->getAABB();
+    const AABB<S> obj_aabb = this->marginAABB(obj);
     AABB<S> overlap_aabb;
 
     if(scene_limit.overlap(obj_aabb, overlap_aabb))
@@ -160,7 +160,7 @@ void SpatialHashingCollisionManager<S, HashTable>::update()
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::update(CollisionObject<S>* updated_obj)
 {
-  const AABB<S>& new_aabb = updated_obj->getAABB();
+  const AABB<S> new_aabb = this->marginAABB(updated_obj);
   const AABB<S>& old_aabb = obj_aabb_map[updated_obj];
 
   AABB<S> old_overlap_aabb;
@@ -318,7 +318,7 @@ template<typename S, typename HashTable>
 bool SpatialHashingCollisionManager<S, HashTable>::collide_(
     CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
 {
-  const auto& obj_aabb = obj->getAABB();
+  const AABB<S> obj_aabb = this->marginAABB(obj);
   AABB<S> overlap_aabb;
 
   if(scene_limit.overlap(obj_aabb, overlap_aabb))
@@ -326,7 +326,7 @@ bool SpatialHashingCollisionManager<S, HashTable>::collide_(
     const auto query_result = hash_table->query(overlap_aabb);
     for(const auto& obj2 : query_result)
     {
-      if(obj == obj2)
+      if(obj == obj2 || !this->canCollide(obj, obj2))
         continue;
 
       if(callback(obj, obj2, cdata))
@@ -337,7 +337,7 @@ bool SpatialHashingCollisionManager<S, HashTable>::collide_(
     {
       for(const auto& obj2 : objs_outside_scene_limit)
       {
-        if(obj == obj2)
+        if(obj == obj2 || !this->canCollide(obj, obj2))
           continue;
 
         if(callback(obj, obj2, cdata))
@@ -349,7 +349,7 @@ bool SpatialHashingCollisionManager<S, HashTable>::collide_(
   {
     for(const auto& obj2 : objs_partially_penetrating_scene_limit)
     {
-      if(obj == obj2)
+      if(obj == obj2 || !this->canCollide(obj, obj2))
         continue;
 
       if(callback(obj, obj2, cdata))
@@ -358,7 +358,7 @@ bool SpatialHashingCollisionManager<S, HashTable>::collide_(
 
     for(const auto& obj2 : objs_outside_scene_limit)
     {
-      if(obj == obj2)
+      if(obj == obj2 || !this->canCollide(obj, obj2))
         continue;
 
       if(callback(obj, obj2, cdata))
@@ -465,7 +465,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
 
   for(const auto& obj1 : objs)
   {
-    const auto& obj_aabb = obj1->getAABB();
+    const AABB<S> obj_aabb = this->marginAABB(obj1);
     AABB<S> overlap_aabb;
 
     if(scene_limit.overlap(obj_aabb, overlap_aabb))
@@ -473,7 +473,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
       auto query_result = hash_table->query(overlap_aabb);
       for(const auto& obj2 : query_result)
       {
-        if(obj1 < obj2)
+        if(obj1 < obj2 && this->canCollide(obj1, obj2))
         {
           if(callback(obj1, obj2, cdata))
             return;
@@ -484,7 +484,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
       {
         for(const auto& obj2 : objs_outside_scene_limit)
         {
-          if(obj1 < obj2)
+          if(obj1 < obj2 && this->canCollide(obj1, obj2))
           {
             if(callback(obj1, obj2, cdata))
               return;
@@ -496,7 +496,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
     {
       for(const auto& obj2 : objs_partially_penetrating_scene_limit)
       {
-        if(obj1 < obj2)
+        if(obj1 < obj2 && this->canCollide(obj1, obj2))
         {
           if(callback(obj1, obj2, cdata))
             return;
@@ -505,7 +505,7 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(
 
       for(const auto& obj2 : objs_outside_scene_limit)
       {
-        if(obj1 < obj2)
+        if(obj1 < obj2 && this->canCollide(obj1, obj2))
         {
           if(callback(obj1, obj2, cdata))
             return;
@@ -542,7 +542,12 @@ void SpatialHashingCollisionManager<S, HashTable>::distance(
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
 {
-  auto* other_manager = static_cast<SpatialHashingCollisionManager<S, HashTable>* >(other_manager_);
+  auto* other_manager = dynamic_cast<SpatialHashingCollisionManager<S, HashTable>* >(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0))
     return;
@@ -575,7 +580,12 @@ void SpatialHashingCollisionManager<S, HashTable>::collide(BroadPhaseCollisionMa
 template<typename S, typename HashTable>
 void SpatialHashingCollisionManager<S, HashTable>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
 {
-  auto* other_manager = static_cast<SpatialHashingCollisionManager<S, HashTable>* >(other_manager_);
+  auto* other_manager = dynamic_cast<SpatialHashingCollisionManager<S, HashTable>* >(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
 
   if((size() == 0) || (other_manager->size() == 0))
     return;
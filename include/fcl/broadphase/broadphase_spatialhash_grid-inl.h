@@ -0,0 +1,521 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASESPATIALHASHGRID_INL_H
+#define FCL_BROADPHASE_BROADPHASESPATIALHASHGRID_INL_H
+
+#include "fcl/broadphase/broadphase_spatialhash_grid.h"
+
+#include <limits>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT SpatialHashGridCollisionManager<double>;
+
+extern template
+class FCL_EXPORT SpatialHashGridCollisionManager<float>;
+
+//==============================================================================
+template <typename S>
+SpatialHashGridCollisionManager<S>::SpatialHashGridCollisionManager(
+    S cell_size, unsigned int max_cells_per_object)
+  : max_cells_per_object(max_cells_per_object),
+    dirty(false),
+    grid(cell_size)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::registerObjects(
+    const std::vector<CollisionObject<S>*>& other_objs)
+{
+  objs.reserve(objs.size() + other_objs.size());
+  for(auto* obj : other_objs)
+    registerObject(obj);
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::registerObject(CollisionObject<S>* obj)
+{
+  if(obj_index.emplace(obj, objs.size()).second)
+  {
+    objs.push_back(obj);
+    dirty = true;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::unregisterObject(
+    CollisionObject<S>* obj)
+{
+  auto it = obj_index.find(obj);
+  if(it == obj_index.end())
+    return;
+
+  const std::size_t index = it->second;
+  obj_index.erase(it);
+
+  CollisionObject<S>* last = objs.back();
+  objs.pop_back();
+  if(last != obj)
+  {
+    objs[index] = last;
+    obj_index[last] = index;
+  }
+
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::setup()
+{
+  dirty = true;
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::update()
+{
+  dirty = true;
+  build();
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::update(
+    CollisionObject<S>* updated_obj)
+{
+  FCL_UNUSED(updated_obj);
+
+  // Rebuilt once by the next query, however many objects moved
+  dirty = true;
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::update(
+    const std::vector<CollisionObject<S>*>& updated_objs)
+{
+  FCL_UNUSED(updated_objs);
+
+  update();
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::clear()
+{
+  objs.clear();
+  obj_index.clear();
+  grid.clear();
+  aabbs.clear();
+  boxes.clear();
+  grid_objs.clear();
+  large_objs.clear();
+  scene_bound = AABB<S>();
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::getObjects(
+    std::vector<CollisionObject<S>*>& objs) const
+{
+  objs = this->objs;
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::collide(
+    CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  collide_(obj, this->marginAABB(obj), cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::distance(
+    CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+  S min_dist = std::numeric_limits<S>::max();
+  distance_(obj, 0, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::collide(
+    void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  // Each pair of grid objects is reported in the first cell they share only
+  auto visitor = [&](int x, int y, int z,
+                     const unsigned int* begin, const unsigned int* end) -> bool
+  {
+    for(auto a = begin; a != end; ++a)
+    {
+      for(auto b = a + 1; b != end; ++b)
+      {
+        if(!detail::SpatialHashGrid<S>::isFirstSharedCell(
+             boxes[*a], boxes[*b], x, y, z))
+          continue;
+
+        if(aabbs[*a].overlap(aabbs[*b])
+           && this->canCollide(objs[*a], objs[*b])
+           && callback(objs[*a], objs[*b], cdata))
+          return true;
+      }
+    }
+    return false;
+  };
+
+  if(grid.forEachOccupiedCell(visitor))
+    return;
+
+  for(std::size_t a = 0; a < large_objs.size(); ++a)
+  {
+    const unsigned int i = large_objs[a];
+
+    for(const auto j : grid_objs)
+    {
+      if(aabbs[i].overlap(aabbs[j]) && this->canCollide(objs[i], objs[j])
+         && callback(objs[i], objs[j], cdata))
+        return;
+    }
+
+    for(std::size_t b = a + 1; b < large_objs.size(); ++b)
+    {
+      const unsigned int j = large_objs[b];
+      if(aabbs[i].overlap(aabbs[j]) && this->canCollide(objs[i], objs[j])
+         && callback(objs[i], objs[j], cdata))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::distance(
+    void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0)
+    return;
+
+  build();
+
+  // Each pair is considered from its object of lower index only
+  S min_dist = std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    if(distance_(objs[i], i + 1, cdata, callback, min_dist))
+      return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::collide(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  auto* other_manager
+      = dynamic_cast<SpatialHashGridCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->collideHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  // Query the larger grid with the objects of the smaller one, grown by the
+  // margin of the manager they belong to
+  if(this->size() < other_manager->size())
+  {
+    for(std::size_t i = 0; i < objs.size(); ++i)
+    {
+      if(other_manager->collide_(objs[i], aabbs[i], cdata, callback))
+        return;
+    }
+  }
+  else
+  {
+    for(std::size_t i = 0; i < other_manager->objs.size(); ++i)
+    {
+      if(collide_(other_manager->objs[i], other_manager->aabbs[i],
+                  cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::distance(
+    BroadPhaseCollisionManager<S>* other_manager_,
+    void* cdata,
+    DistanceCallBack<S> callback) const
+{
+  auto* other_manager
+      = dynamic_cast<SpatialHashGridCollisionManager<S>*>(other_manager_);
+  if(!other_manager)
+  {
+    this->distanceHierarchies(other_manager_, cdata, callback);
+    return;
+  }
+
+  if((size() == 0) || (other_manager->size() == 0))
+    return;
+
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+
+  build();
+  other_manager->build();
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  if(this->size() < other_manager->size())
+  {
+    for(const auto& obj : objs)
+      if(other_manager->distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+  else
+  {
+    for(const auto& obj : other_manager->objs)
+      if(distance_(obj, 0, cdata, callback, min_dist)) return;
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool SpatialHashGridCollisionManager<S>::empty() const
+{
+  return objs.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t SpatialHashGridCollisionManager<S>::size() const
+{
+  return objs.size();
+}
+
+//==============================================================================
+template <typename S>
+S SpatialHashGridCollisionManager<S>::getCellSize() const
+{
+  return grid.getCellSize();
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGridCollisionManager<S>::build() const
+{
+  if(!dirty)
+    return;
+
+  const std::size_t n = objs.size();
+  aabbs.resize(n);
+  boxes.resize(n);
+  grid_objs.clear();
+  large_objs.clear();
+  scene_bound = AABB<S>();
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    aabbs[i] = this->marginAABB(objs[i]);
+    boxes[i] = grid.cellBox(aabbs[i]);
+    scene_bound += aabbs[i];
+
+    if(detail::SpatialHashGrid<S>::numCells(boxes[i]) > max_cells_per_object)
+      large_objs.push_back(static_cast<unsigned int>(i));
+    else
+      grid_objs.push_back(static_cast<unsigned int>(i));
+  }
+
+  grid.build(boxes, grid_objs);
+  dirty = false;
+}
+
+//==============================================================================
+template <typename S>
+bool SpatialHashGridCollisionManager<S>::collide_(
+    CollisionObject<S>* obj,
+    const AABB<S>& obj_aabb,
+    void* cdata,
+    CollisionCallBack<S> callback) const
+{
+  const CellBox box = grid.cellBox(obj_aabb);
+
+  auto visitor = [&](int x, int y, int z,
+                     const unsigned int* begin, const unsigned int* end) -> bool
+  {
+    for(auto it = begin; it != end; ++it)
+    {
+      if(!detail::SpatialHashGrid<S>::isFirstSharedCell(
+           box, boxes[*it], x, y, z))
+        continue;
+
+      if(objs[*it] != obj && aabbs[*it].overlap(obj_aabb)
+         && this->canCollide(obj, objs[*it])
+         && callback(obj, objs[*it], cdata))
+        return true;
+    }
+    return false;
+  };
+
+  if(grid.forEachCell(box, visitor))
+    return true;
+
+  for(const auto i : large_objs)
+  {
+    if(objs[i] != obj && aabbs[i].overlap(obj_aabb)
+       && this->canCollide(obj, objs[i])
+       && callback(obj, objs[i], cdata))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool SpatialHashGridCollisionManager<S>::distance_(
+    CollisionObject<S>* obj,
+    std::size_t first_index,
+    void* cdata,
+    DistanceCallBack<S> callback,
+    S& min_dist) const
+{
+  const AABB<S>& obj_aabb = obj->getAABB();
+
+  // Search boxes of doubling size around the object. Each round only visits
+  // the objects whose AABB distance falls in [lower, upper), and the search
+  // stops once the best distance is within the searched radius.
+  S lower = 0;
+  S upper = 0;
+  auto test = [&](unsigned int i) -> bool
+  {
+    if(i < first_index || objs[i] == obj)
+      return false;
+
+    const S d = objs[i]->getAABB().distance(obj_aabb);
+    if(d < lower || d >= upper || d >= min_dist)
+      return false;
+
+    return callback(obj, objs[i], cdata, min_dist);
+  };
+
+  S radius = grid.getCellSize();
+  while(true)
+  {
+    const Vector3<S> delta = Vector3<S>::Constant(radius);
+    const AABB<S> search(obj_aabb.min_ - delta, obj_aabb.max_ + delta);
+    const bool last = !(radius < std::numeric_limits<S>::max() / 2)
+        || search.contain(scene_bound);
+    upper = last ? std::numeric_limits<S>::max() : radius;
+
+    if(last)
+    {
+      for(const auto i : grid_objs)
+        if(test(i)) return true;
+    }
+    else
+    {
+      const CellBox box = grid.cellBox(search);
+      auto visitor = [&](int x, int y, int z,
+                         const unsigned int* begin, const unsigned int* end) -> bool
+      {
+        for(auto it = begin; it != end; ++it)
+        {
+          if(detail::SpatialHashGrid<S>::isFirstSharedCell(
+               box, boxes[*it], x, y, z) && test(*it))
+            return true;
+        }
+        return false;
+      };
+
+      if(grid.forEachCell(box, visitor))
+        return true;
+    }
+
+    for(const auto i : large_objs)
+      if(test(i)) return true;
+
+    if(last || min_dist <= radius)
+      return false;
+
+    lower = radius;
+    radius *= 2;
+  }
+}
+
+} // namespace fcl
+
+#endif
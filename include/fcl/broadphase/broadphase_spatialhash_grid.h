@@ -0,0 +1,170 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_BROADPHASESPATIALHASHGRID_H
+#define FCL_BROADPHASE_BROADPHASESPATIALHASHGRID_H
+
+#include <unordered_map>
+#include <vector>
+#include "fcl/math/bv/AABB.h"
+#include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/spatial_hash_grid.h"
+
+namespace fcl
+{
+
+/// @brief Spatial hashing collision manager built on a flat hash grid.
+///
+/// Unlike SpatialHashingCollisionManager, the grid is unbounded and holds no
+/// per-cell containers: every update() rebuilds it with a counting sort into
+/// one contiguous array, and queries visit the cells in place. Once the scene
+/// has reached its size, updates and collision queries do not allocate.
+/// Objects covering more than max_cells_per_object cells are kept out of the
+/// grid and tested against everything.
+///
+/// Registering, unregistering and moving objects is cheap; the grid is
+/// rebuilt by update() or setup(), or lazily by the next query.
+template <typename S>
+class FCL_EXPORT SpatialHashGridCollisionManager
+    : public BroadPhaseCollisionManager<S>
+{
+public:
+
+  SpatialHashGridCollisionManager(
+      S cell_size, unsigned int max_cells_per_object = 64);
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief update the manager by explicitly given the object updated
+  void update(CollisionObject<S>* updated_obj);
+
+  /// @brief update the manager by explicitly given the set of objects update
+  void update(const std::vector<CollisionObject<S>*>& updated_objs);
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging ot the manager
+  void distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e, N^2 self collision)
+  void collide(void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager<S>* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager<S>* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+  /// @brief the edge length of the grid cells
+  S getCellSize() const;
+
+protected:
+
+  using CellBox = typename detail::SpatialHashGrid<S>::CellBox;
+
+  /// @brief rebuild the grid if objects were added, removed or moved
+  void build() const;
+
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager, given the AABB to query with
+  bool collide_(CollisionObject<S>* obj, const AABB<S>& obj_aabb, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and the objects
+  /// of the manager whose index is at least first_index
+  bool distance_(CollisionObject<S>* obj, std::size_t first_index, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief all objects in the scene
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief index of each object in objs
+  std::unordered_map<CollisionObject<S>*, std::size_t> obj_index;
+
+  /// @brief objects covering more cells than this are not put in the grid
+  unsigned int max_cells_per_object;
+
+  /// @brief whether the grid is out of date
+  mutable bool dirty;
+
+  mutable detail::SpatialHashGrid<S> grid;
+
+  /// @brief the AABB (grown by the security margin) and the cells of each
+  /// object, as of the last build
+  mutable std::vector<AABB<S>> aabbs;
+  mutable std::vector<CellBox> boxes;
+
+  /// @brief indices of the objects in the grid and of the large ones
+  mutable std::vector<unsigned int> grid_objs;
+  mutable std::vector<unsigned int> large_objs;
+
+  /// @brief bound of all the objects
+  mutable AABB<S> scene_bound;
+};
+
+using SpatialHashGridCollisionManagerf = SpatialHashGridCollisionManager<float>;
+using SpatialHashGridCollisionManagerd = SpatialHashGridCollisionManager<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_spatialhash_grid-inl.h"
+
+#endif
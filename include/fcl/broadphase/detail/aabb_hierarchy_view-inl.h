@@ -0,0 +1,238 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_AABBHIERARCHYVIEW_INL_H
+#define FCL_BROADPHASE_DETAIL_AABBHIERARCHYVIEW_INL_H
+
+#include "fcl/broadphase/detail/aabb_hierarchy_view.h"
+
+#include <utility>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename S>
+uint32 AABBHierarchyView<S>::getCategory(Node /*node*/) const
+{
+  return ~uint32(0);
+}
+
+//==============================================================================
+template <typename S>
+uint32 AABBHierarchyView<S>::getMask(Node /*node*/) const
+{
+  return ~uint32(0);
+}
+
+//==============================================================================
+template <typename S>
+bool AABBHierarchyView<S>::canCollide(
+    Node node1, const AABBHierarchyView& other, Node node2) const
+{
+  return (getCategory(node1) & other.getMask(node2))
+      && (other.getCategory(node2) & getMask(node1));
+}
+
+//==============================================================================
+template <typename S>
+HierarchyTreeView<S>::HierarchyTreeView(std::vector<const Tree*> trees_)
+  : trees(std::move(trees_))
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void HierarchyTreeView<S>::getRoots(std::vector<Node>& roots) const
+{
+  for(const auto* tree : trees)
+  {
+    if(!tree->empty())
+      roots.push_back(reinterpret_cast<Node>(tree->getRoot()));
+  }
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& HierarchyTreeView<S>::getBV(Node node) const
+{
+  return nodeOf(node)->bv;
+}
+
+//==============================================================================
+template <typename S>
+bool HierarchyTreeView<S>::isLeaf(Node node) const
+{
+  return nodeOf(node)->isLeaf();
+}
+
+//==============================================================================
+template <typename S>
+typename HierarchyTreeView<S>::Node HierarchyTreeView<S>::getChild(
+    Node node, int i) const
+{
+  return reinterpret_cast<Node>(nodeOf(node)->children[i]);
+}
+
+//==============================================================================
+template <typename S>
+CollisionObject<S>* HierarchyTreeView<S>::getObject(Node leaf) const
+{
+  return static_cast<CollisionObject<S>*>(nodeOf(leaf)->data);
+}
+
+//==============================================================================
+template <typename S>
+uint32 HierarchyTreeView<S>::getCategory(Node node) const
+{
+  return nodeOf(node)->category;
+}
+
+//==============================================================================
+template <typename S>
+uint32 HierarchyTreeView<S>::getMask(Node node) const
+{
+  return nodeOf(node)->mask;
+}
+
+//==============================================================================
+template <typename S>
+const typename HierarchyTreeView<S>::NodeType* HierarchyTreeView<S>::nodeOf(
+    Node node)
+{
+  return reinterpret_cast<const NodeType*>(node);
+}
+
+//==============================================================================
+template <typename S>
+HierarchyTreeArrayView<S>::HierarchyTreeArrayView(const Tree* tree_)
+  : tree(tree_)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void HierarchyTreeArrayView<S>::getRoots(std::vector<Node>& roots) const
+{
+  if(tree->size() > 0)
+    roots.push_back(tree->getRoot());
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& HierarchyTreeArrayView<S>::getBV(Node node) const
+{
+  return tree->getNodes()[node].bv;
+}
+
+//==============================================================================
+template <typename S>
+bool HierarchyTreeArrayView<S>::isLeaf(Node node) const
+{
+  return tree->getNodes()[node].isLeaf();
+}
+
+//==============================================================================
+template <typename S>
+typename HierarchyTreeArrayView<S>::Node HierarchyTreeArrayView<S>::getChild(
+    Node node, int i) const
+{
+  return tree->getNodes()[node].children[i];
+}
+
+//==============================================================================
+template <typename S>
+CollisionObject<S>* HierarchyTreeArrayView<S>::getObject(Node leaf) const
+{
+  return static_cast<CollisionObject<S>*>(tree->getNodes()[leaf].data);
+}
+
+//==============================================================================
+template <typename S>
+uint32 HierarchyTreeArrayView<S>::getCategory(Node node) const
+{
+  return tree->getNodes()[node].category;
+}
+
+//==============================================================================
+template <typename S>
+uint32 HierarchyTreeArrayView<S>::getMask(Node node) const
+{
+  return tree->getNodes()[node].mask;
+}
+
+//==============================================================================
+template <typename S>
+ObjectHierarchyView<S>::ObjectHierarchyView()
+  : HierarchyTreeView<S>({&tree})
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void ObjectHierarchyView<S>::build(
+    const std::vector<CollisionObject<S>*>& objs,
+    const std::vector<AABB<S>>& aabbs)
+{
+  tree.clear();
+  if(objs.empty())
+    return;
+
+  std::vector<typename HierarchyTreeView<S>::NodeType*> leaves(objs.size());
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    auto* node = new typename HierarchyTreeView<S>::NodeType; // node will be managed by the tree
+    node->bv = aabbs[i];
+    node->parent = nullptr;
+    node->children[1] = nullptr;
+    node->data = objs[i];
+    node->category = objs[i]->getCollisionCategory();
+    node->mask = objs[i]->getCollisionMask();
+    leaves[i] = node;
+  }
+
+  // The Morton code build is the cheapest, and the tree is only used once
+  tree.init(leaves, 2);
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_AABBHIERARCHYVIEW_H
+#define FCL_BROADPHASE_DETAIL_AABBHIERARCHYVIEW_H
+
+#include <cstdint>
+#include <vector>
+#include "fcl/broadphase/detail/hierarchy_tree.h"
+#include "fcl/broadphase/detail/hierarchy_tree_array.h"
+#include "fcl/narrowphase/collision_object.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Read-only view of the binary AABB hierarchy a broadphase manager
+/// keeps over its objects, whatever the layout of its nodes. Two managers of
+/// different types collide and compute distances by traversing their views
+/// together.
+template <typename S>
+class FCL_EXPORT AABBHierarchyView
+{
+public:
+
+  /// @brief a node of the hierarchy: a pointer or an index, depending on the
+  /// hierarchy
+  using Node = std::uintptr_t;
+
+  virtual ~AABBHierarchyView() = default;
+
+  /// @brief add the roots of the non-empty trees of the hierarchy to roots
+  virtual void getRoots(std::vector<Node>& roots) const = 0;
+
+  /// @brief the bounding volume of a node
+  virtual const AABB<S>& getBV(Node node) const = 0;
+
+  virtual bool isLeaf(Node node) const = 0;
+
+  /// @brief child 0 or 1 of an internal node
+  virtual Node getChild(Node node, int i) const = 0;
+
+  /// @brief the object of a leaf
+  virtual CollisionObject<S>* getObject(Node leaf) const = 0;
+
+  /// @brief union of the collision categories of the objects below the node,
+  /// all of them unless the hierarchy keeps track of them
+  virtual uint32 getCategory(Node node) const;
+
+  /// @brief union of the collision masks of the objects below the node, all
+  /// of them unless the hierarchy keeps track of them
+  virtual uint32 getMask(Node node) const;
+
+  /// @brief whether an object below node1 may collide with one below node2 of
+  /// other, according to their collision categories and masks
+  bool canCollide(Node node1, const AABBHierarchyView& other, Node node2) const;
+};
+
+/// @brief View of one or more trees whose leaves hold the objects, such as
+/// those of DynamicAABBTreeCollisionManager
+template <typename S>
+class FCL_EXPORT HierarchyTreeView : public AABBHierarchyView<S>
+{
+public:
+
+  using Node = typename AABBHierarchyView<S>::Node;
+  using Tree = HierarchyTree<AABB<S>>;
+  using NodeType = typename Tree::NodeType;
+
+  /// @brief view of the trees, which must outlive the view
+  explicit HierarchyTreeView(std::vector<const Tree*> trees_);
+
+  void getRoots(std::vector<Node>& roots) const;
+
+  const AABB<S>& getBV(Node node) const;
+
+  bool isLeaf(Node node) const;
+
+  Node getChild(Node node, int i) const;
+
+  CollisionObject<S>* getObject(Node leaf) const;
+
+  uint32 getCategory(Node node) const;
+
+  uint32 getMask(Node node) const;
+
+private:
+
+  static const NodeType* nodeOf(Node node);
+
+  std::vector<const Tree*> trees;
+};
+
+/// @brief View of a tree stored in an array, such as that of
+/// DynamicAABBTreeCollisionManager_Array
+template <typename S>
+class FCL_EXPORT HierarchyTreeArrayView : public AABBHierarchyView<S>
+{
+public:
+
+  using Node = typename AABBHierarchyView<S>::Node;
+  using Tree = implementation_array::HierarchyTree<AABB<S>>;
+
+  /// @brief view of the tree, which must outlive the view
+  explicit HierarchyTreeArrayView(const Tree* tree_);
+
+  void getRoots(std::vector<Node>& roots) const;
+
+  const AABB<S>& getBV(Node node) const;
+
+  bool isLeaf(Node node) const;
+
+  Node getChild(Node node, int i) const;
+
+  CollisionObject<S>* getObject(Node leaf) const;
+
+  uint32 getCategory(Node node) const;
+
+  uint32 getMask(Node node) const;
+
+private:
+
+  const Tree* tree;
+};
+
+/// @brief A tree built on demand over the objects of a manager that keeps no
+/// hierarchy of its own, such as the sweep and prune and spatial hash
+/// managers
+template <typename S>
+class FCL_EXPORT ObjectHierarchyView : public HierarchyTreeView<S>
+{
+public:
+
+  ObjectHierarchyView();
+
+  /// @brief The view refers to its own tree, which a copy would not
+  ObjectHierarchyView(const ObjectHierarchyView&) = delete;
+
+  ObjectHierarchyView& operator=(const ObjectHierarchyView&) = delete;
+
+  /// @brief rebuild the tree over the objects, with the given AABBs
+  void build(const std::vector<CollisionObject<S>*>& objs,
+             const std::vector<AABB<S>>& aabbs);
+
+private:
+
+  typename HierarchyTreeView<S>::Tree tree;
+};
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/aabb_hierarchy_view-inl.h"
+
+#endif
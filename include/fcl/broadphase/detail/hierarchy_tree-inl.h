@@ -87,6 +87,8 @@ void HierarchyTree<BV>::init(std::vector<NodeType*>& leaves, int level)
   default:
     init_0(leaves);
   }
+
+  refitCategories();
 }
 
 //==============================================================================
@@ -228,6 +230,7 @@ void HierarchyTree<BV>::balanceBottomup()
     fetchLeaves(root_node, leaves);
     bottomup(leaves.begin(), leaves.end());
     root_node = leaves[0];
+    recurseRefitCategories(root_node);
   }
 }
 
@@ -241,6 +244,7 @@ void HierarchyTree<BV>::balanceTopdown()
     leaves.reserve(n_leaves);
     fetchLeaves(root_node, leaves);
     root_node = topdown(leaves.begin(), leaves.end());
+    recurseRefitCategories(root_node);
   }
 }
 
@@ -274,6 +278,78 @@ void HierarchyTree<BV>::refit()
     recurseRefit(root_node);
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::refitRotate()
+{
+  if(root_node)
+    recurseRefitRotate(root_node);
+}
+
+//==============================================================================
+template<typename BV>
+typename HierarchyTree<BV>::S HierarchyTree<BV>::getCost() const
+{
+  if(!root_node || root_node->isLeaf())
+    return 0;
+
+  const S root_area = surfaceArea(root_node->bv);
+  if(root_area <= 0)
+    return 0;
+
+  return recurseCost(root_node) / root_area;
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::rebuildCostliestSubtree(size_t max_leaves)
+{
+  if(!root_node || root_node->isLeaf())
+    return;
+
+  S cost;
+  NodeType* best = nullptr;
+  S best_cost = -1;
+  recurseCostliest(root_node, max_leaves, cost, best, best_cost);
+  if(!best)
+    return;
+
+  NodeType* parent = best->parent;
+  const int side = (parent && parent->children[1] == best) ? 1 : 0;
+
+  std::vector<NodeType*> leaves;
+  fetchLeaves(best, leaves);
+  NodeType* subtree = topdown(leaves.begin(), leaves.end());
+  recurseRefitCategories(subtree);
+
+  // The subtree keeps the leaves, hence the bounding volume and categories,
+  // it had
+  subtree->parent = parent;
+  if(parent)
+    parent->children[side] = subtree;
+  else
+    root_node = subtree;
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::updateCategories(
+    NodeType* leaf, uint32 category, uint32 mask)
+{
+  leaf->category = category;
+  leaf->mask = mask;
+  for(NodeType* node = leaf->parent; node; node = node->parent)
+    fitCategories(node);
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::refitCategories()
+{
+  if(root_node)
+    recurseRefitCategories(root_node);
+}
+
 //==============================================================================
 template<typename BV>
 void HierarchyTree<BV>::extractLeaves(const NodeType* root, std::vector<NodeType*>& leaves) const
@@ -769,6 +845,8 @@ typename HierarchyTree<BV>::NodeType* HierarchyTree<BV>::sort(NodeType* n, NodeT
     n->children[i] = p;
     n->children[j] = s;
     std::swap(p->bv, n->bv);
+    std::swap(p->category, n->category);
+    std::swap(p->mask, n->mask);
     return p;
   }
   return n;
@@ -816,6 +894,18 @@ void HierarchyTree<BV>::insertLeaf(NodeType* root, NodeType* leaf)
       node->children[1] = leaf; leaf->parent = node;
       root_node = node;
     }
+
+    // Unlike the bounding volumes of the ancestors, their categories need
+    // not cover those of the new leaf yet
+    fitCategories(leaf->parent);
+    for(prev = leaf->parent->parent; prev; prev = prev->parent)
+    {
+      if((prev->category & leaf->category) == leaf->category
+         && (prev->mask & leaf->mask) == leaf->mask)
+        break;
+      prev->category |= leaf->category;
+      prev->mask |= leaf->mask;
+    }
   }
 }
 
@@ -923,6 +1013,8 @@ typename HierarchyTree<BV>::NodeType* HierarchyTree<BV>::createNode(NodeType* pa
   node->parent = parent;
   node->data = data;
   node->children[1] = 0;
+  node->category = ~uint32(0);
+  node->mask = ~uint32(0);
   return node;
 }
 
@@ -960,11 +1052,156 @@ void HierarchyTree<BV>::recurseRefit(NodeType* node)
     recurseRefit(node->children[0]);
     recurseRefit(node->children[1]);
     node->bv = node->children[0]->bv + node->children[1]->bv;
+    fitCategories(node);
   }
   else
     return;
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::recurseRefitRotate(NodeType* node)
+{
+  if(node->isLeaf())
+    return;
+
+  recurseRefitRotate(node->children[0]);
+  recurseRefitRotate(node->children[1]);
+  node->bv = node->children[0]->bv + node->children[1]->bv;
+  fitCategories(node);
+
+  // Swapping the child on one side with a grandchild on the other leaves the
+  // bounding volume of the node as it is, and changes the one of the child
+  // that gets the new grandchild
+  S best_gain = 0;
+  int best_side = -1;
+  int best_grandchild = 0;
+  for(int side = 0; side < 2; ++side)
+  {
+    const NodeType* inner = node->children[side];
+    if(inner->isLeaf())
+      continue;
+
+    const NodeType* other = node->children[1 - side];
+    const S area = surfaceArea(inner->bv);
+    for(int g = 0; g < 2; ++g)
+    {
+      const S gain
+          = area - surfaceArea(other->bv + inner->children[1 - g]->bv);
+      if(gain > best_gain)
+      {
+        best_gain = gain;
+        best_side = side;
+        best_grandchild = g;
+      }
+    }
+  }
+
+  if(best_side < 0)
+    return;
+
+  NodeType* inner = node->children[best_side];
+  NodeType* other = node->children[1 - best_side];
+  NodeType* grandchild = inner->children[best_grandchild];
+
+  inner->children[best_grandchild] = other;
+  other->parent = inner;
+  node->children[1 - best_side] = grandchild;
+  grandchild->parent = node;
+  inner->bv = inner->children[0]->bv + inner->children[1]->bv;
+  fitCategories(inner);
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::recurseRefitCategories(NodeType* node)
+{
+  if(node->isLeaf())
+    return;
+
+  recurseRefitCategories(node->children[0]);
+  recurseRefitCategories(node->children[1]);
+  fitCategories(node);
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::fitCategories(NodeType* node)
+{
+  node->category = node->children[0]->category | node->children[1]->category;
+  node->mask = node->children[0]->mask | node->children[1]->mask;
+}
+
+//==============================================================================
+template<typename BV>
+typename HierarchyTree<BV>::S HierarchyTree<BV>::recurseCost(
+    const NodeType* node) const
+{
+  if(node->isLeaf())
+    return 0;
+
+  return surfaceArea(node->bv) + recurseCost(node->children[0])
+      + recurseCost(node->children[1]);
+}
+
+//==============================================================================
+template<typename BV>
+size_t HierarchyTree<BV>::recurseCostliest(
+    NodeType* node, size_t max_leaves, S& cost, NodeType*& best,
+    S& best_cost) const
+{
+  if(node->isLeaf())
+  {
+    cost = 0;
+    return 1;
+  }
+
+  S child_cost[2];
+  size_t child_leaves[2];
+  for(int i = 0; i < 2; ++i)
+  {
+    child_leaves[i] = recurseCostliest(node->children[i], max_leaves,
+                                       child_cost[i], best, best_cost);
+  }
+
+  cost = surfaceArea(node->bv) + child_cost[0] + child_cost[1];
+  const size_t num_leaves = child_leaves[0] + child_leaves[1];
+
+  // The candidates are the largest subtrees with at most max_leaves leaves
+  if(num_leaves > max_leaves)
+  {
+    for(int i = 0; i < 2; ++i)
+    {
+      NodeType* child = node->children[i];
+      if(child->isLeaf() || child_leaves[i] > max_leaves)
+        continue;
+
+      const S density = child_cost[i] / child_leaves[i];
+      if(density > best_cost)
+      {
+        best_cost = density;
+        best = child;
+      }
+    }
+  }
+  else if(node == root_node)
+  {
+    best = node;
+  }
+
+  return num_leaves;
+}
+
+//==============================================================================
+template<typename BV>
+typename HierarchyTree<BV>::S HierarchyTree<BV>::surfaceArea(const BV& bv)
+{
+  const S w = bv.width();
+  const S h = bv.height();
+  const S d = bv.depth();
+  return 2 * (w * h + h * d + d * w);
+}
+
 //==============================================================================
 template<typename BV>
 BV HierarchyTree<BV>::bounds(const std::vector<NodeType*>& leaves)
@@ -116,6 +116,32 @@ public:
   /// @brief refit the tree, i.e., when the leaf nodes' bounding volumes change, update the entire tree in a bottom-up manner
   void refit();
 
+  /// @brief refit the tree and rotate its nodes on the way up: each node may
+  /// swap one of its children with a grandchild on the other side, when that
+  /// shrinks the surface area of the other child (Kopta et al., "Fast,
+  /// Effective BVH Updates for Animated Scenes", 2012)
+  void refitRotate();
+
+  /// @brief surface area heuristic cost of the tree: the summed surface
+  /// areas of the internal nodes relative to the root's, i.e. the expected
+  /// number of internal nodes a small query overlaps
+  S getCost() const;
+
+  /// @brief rebuild in the topdown manner the subtree whose internal nodes
+  /// have the largest summed surface area per leaf, among the largest ones
+  /// with at most max_leaves leaves
+  void rebuildCostliestSubtree(size_t max_leaves);
+
+  /// @brief set the collision category and mask of a leaf, and recompute
+  /// those of its ancestors
+  void updateCategories(NodeType* leaf, uint32 category, uint32 mask);
+
+  /// @brief recompute the collision categories and masks of the internal
+  /// nodes from those of the leaves. Building or refitting the tree does it
+  /// too; an incremental insertion gives the new internal node all the
+  /// categories until then.
+  void refitCategories();
+
   /// @brief extract all the leaves of the tree 
   void extractLeaves(const NodeType* root, std::vector<NodeType*>& leaves) const;
 
@@ -223,6 +249,24 @@ private:
 
   void recurseRefit(NodeType* node);
 
+  void recurseRefitRotate(NodeType* node);
+
+  void recurseRefitCategories(NodeType* node);
+
+  /// @brief the categories and mask of a node from those of its children
+  static void fitCategories(NodeType* node);
+
+  /// @brief summed surface area of the internal nodes of a subtree
+  S recurseCost(const NodeType* node) const;
+
+  /// @brief count the leaves and sum the surface areas of the internal nodes
+  /// of a subtree, and keep in best the costliest candidate subtree below
+  /// it, as rebuildCostliestSubtree() defines them
+  size_t recurseCostliest(NodeType* node, size_t max_leaves, S& cost,
+                          NodeType*& best, S& best_cost) const;
+
+  static S surfaceArea(const BV& bv);
+
   static BV bounds(const std::vector<NodeType*>& leaves);
 
   static BV bounds(const NodeVecIterator lbeg, const NodeVecIterator lend);
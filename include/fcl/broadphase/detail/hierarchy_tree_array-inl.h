@@ -98,6 +98,8 @@ void HierarchyTree<BV>::init(NodeType* leaves, int n_leaves_, int level)
   default:
     init_0(leaves, n_leaves_);
   }
+
+  refitCategories();
 }
 
 //==============================================================================
@@ -410,6 +412,7 @@ void HierarchyTree<BV>::balanceBottomup()
     root_node = *ids;
 
     delete [] ids;
+    recurseRefitCategories(root_node);
   }
 }
 
@@ -436,6 +439,7 @@ void HierarchyTree<BV>::balanceTopdown()
 
     root_node = topdown(ids, ids + n_leaves);
     delete [] ids;
+    recurseRefitCategories(root_node);
   }
 }
 
@@ -469,6 +473,26 @@ void HierarchyTree<BV>::refit()
     recurseRefit(root_node);
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::updateCategories(
+    size_t leaf, uint32 category, uint32 mask)
+{
+  nodes[leaf].category = category;
+  nodes[leaf].mask = mask;
+  for(size_t node = nodes[leaf].parent; node != NULL_NODE;
+      node = nodes[node].parent)
+    fitCategories(node);
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::refitCategories()
+{
+  if(root_node != NULL_NODE)
+    recurseRefitCategories(root_node);
+}
+
 //==============================================================================
 template<typename BV>
 void HierarchyTree<BV>::extractLeaves(size_t root, NodeType*& leaves) const
@@ -879,6 +903,19 @@ void HierarchyTree<BV>::insertLeaf(size_t root, size_t leaf)
       nodes[node].children[1] = leaf; nodes[leaf].parent = node;
       root_node = node;
     }
+
+    // Unlike the bounding volumes of the ancestors, their categories need
+    // not cover those of the new leaf yet
+    fitCategories(nodes[leaf].parent);
+    for(prev = nodes[nodes[leaf].parent].parent; prev != NULL_NODE;
+        prev = nodes[prev].parent)
+    {
+      if((nodes[prev].category & nodes[leaf].category) == nodes[leaf].category
+         && (nodes[prev].mask & nodes[leaf].mask) == nodes[leaf].mask)
+        break;
+      nodes[prev].category |= nodes[leaf].category;
+      nodes[prev].mask |= nodes[leaf].mask;
+    }
   }
 }
 
@@ -973,6 +1010,8 @@ size_t HierarchyTree<BV>::allocateNode()
   nodes[node_id].parent = NULL_NODE;
   nodes[node_id].children[0] = NULL_NODE;
   nodes[node_id].children[1] = NULL_NODE;
+  nodes[node_id].category = ~uint32(0);
+  nodes[node_id].mask = ~uint32(0);
   ++n_nodes;
   return node_id;
 }
@@ -1033,11 +1072,34 @@ void HierarchyTree<BV>::recurseRefit(size_t node)
     recurseRefit(nodes[node].children[0]);
     recurseRefit(nodes[node].children[1]);
     nodes[node].bv = nodes[nodes[node].children[0]].bv + nodes[nodes[node].children[1]].bv;
+    fitCategories(node);
   }
   else
     return;
 }
 
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::recurseRefitCategories(size_t node)
+{
+  if(nodes[node].isLeaf())
+    return;
+
+  recurseRefitCategories(nodes[node].children[0]);
+  recurseRefitCategories(nodes[node].children[1]);
+  fitCategories(node);
+}
+
+//==============================================================================
+template<typename BV>
+void HierarchyTree<BV>::fitCategories(size_t node)
+{
+  const NodeType& child0 = nodes[nodes[node].children[0]];
+  const NodeType& child1 = nodes[nodes[node].children[1]];
+  nodes[node].category = child0.category | child1.category;
+  nodes[node].mask = child0.mask | child1.mask;
+}
+
 //==============================================================================
 template<typename BV>
 void HierarchyTree<BV>::fetchLeaves(size_t root, NodeType*& leaves, int depth)
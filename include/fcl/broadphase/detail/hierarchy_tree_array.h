@@ -135,6 +135,16 @@ public:
   /// @brief refit the tree, i.e., when the leaf nodes' bounding volumes change, update the entire tree in a bottom-up manner
   void refit();
 
+  /// @brief set the collision category and mask of a leaf, and recompute
+  /// those of its ancestors
+  void updateCategories(size_t leaf, uint32 category, uint32 mask);
+
+  /// @brief recompute the collision categories and masks of the internal
+  /// nodes from those of the leaves. Building or refitting the tree does it
+  /// too; an incremental insertion gives the new internal node all the
+  /// categories until then.
+  void refitCategories();
+
   /// @brief extract all the leaves of the tree 
   void extractLeaves(size_t root, NodeType*& leaves) const;
 
@@ -229,6 +239,11 @@ private:
 
   void recurseRefit(size_t node);
 
+  void recurseRefitCategories(size_t node);
+
+  /// @brief the categories and mask of a node from those of its children
+  void fitCategories(size_t node);
+
 protected:
   size_t root_node;
   NodeType* nodes;
@@ -66,6 +66,13 @@ bool NodeBase<BV>::isInternal() const
   return !isLeaf();
 }
 
+//==============================================================================
+template <typename BV>
+bool NodeBase<BV>::canCollideWith(const NodeBase& other) const
+{
+  return (category & other.mask) && (other.category & mask);
+}
+
 //==============================================================================
 template <typename BV>
 NodeBase<BV>::NodeBase()
@@ -73,6 +80,8 @@ NodeBase<BV>::NodeBase()
   parent = nullptr;
   children[0] = nullptr;
   children[1] = nullptr;
+  category = ~uint32(0);
+  mask = ~uint32(0);
 }
 
 } // namespace detail
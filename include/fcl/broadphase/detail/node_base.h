@@ -72,6 +72,18 @@ struct NodeBase
   /// @brief morton code for current BV
   uint32 code;
 
+  /// @brief union of the collision categories of the objects below the node,
+  /// all of them unless set
+  uint32 category;
+
+  /// @brief union of the collision masks of the objects below the node, all
+  /// of them unless set
+  uint32 mask;
+
+  /// @brief whether an object below the node may collide with one below
+  /// other, according to their collision categories and masks
+  bool canCollideWith(const NodeBase& other) const;
+
   NodeBase();
 };
 
@@ -63,6 +63,13 @@ bool NodeBase<BV>::isInternal() const
   return !isLeaf();
 }
 
+//==============================================================================
+template<typename BV>
+bool NodeBase<BV>::canCollideWith(const NodeBase& other) const
+{
+  return (category & other.mask) && (other.category & mask);
+}
+
 } // namespace implementation_array
 } // namespace detail
 } // namespace fcl
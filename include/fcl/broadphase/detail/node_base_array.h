@@ -67,9 +67,19 @@ struct NodeBase
   };
 
   uint32 code;
-  
+
+  /// @brief union of the collision categories of the objects below the node
+  uint32 category;
+
+  /// @brief union of the collision masks of the objects below the node
+  uint32 mask;
+
   bool isLeaf() const;
   bool isInternal() const;
+
+  /// @brief whether an object below the node may collide with one below
+  /// other, according to their collision categories and masks
+  bool canCollideWith(const NodeBase& other) const;
 };
 
 } // namespace implementation_array
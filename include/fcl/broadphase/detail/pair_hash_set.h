@@ -0,0 +1,120 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_PAIRHASHSET_H
+#define FCL_BROADPHASE_DETAIL_PAIRHASHSET_H
+
+#include <cstdint>
+#include <vector>
+#include "fcl/export.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Set of unordered pairs of object indices, stored flat in an
+/// open-addressed hash table with linear probing. Insertion and removal take
+/// expected constant time, and the storage is kept across clear() so that a
+/// set of steady size does not allocate.
+class FCL_EXPORT PairHashSet
+{
+public:
+
+  PairHashSet();
+
+  /// @brief Add the pair {a, b}; returns false if it was already there
+  bool insert(unsigned int a, unsigned int b);
+
+  /// @brief Remove the pair {a, b}; returns false if it was not there
+  bool erase(unsigned int a, unsigned int b);
+
+  /// @brief Whether the pair {a, b} is in the set
+  bool contains(unsigned int a, unsigned int b) const;
+
+  /// @brief Remove all the pairs
+  void clear();
+
+  /// @brief Number of pairs
+  std::size_t size() const;
+
+  bool empty() const;
+
+  /// @brief Call visitor(a, b), a < b, for every pair. Stops and returns true
+  /// as soon as the visitor returns true. The set must not be changed by the
+  /// visitor.
+  template <typename Visitor>
+  bool forEach(Visitor& visitor) const;
+
+private:
+
+  static constexpr std::uint64_t kEmptyKey = ~std::uint64_t(0);
+
+  static std::uint64_t pairKey(unsigned int a, unsigned int b);
+
+  static std::uint64_t mix(std::uint64_t key);
+
+  /// @brief Slot of the key: either the slot holding it or the empty slot
+  /// where it would be inserted
+  std::size_t findSlot(std::uint64_t key) const;
+
+  void rehash(std::size_t num_slots);
+
+  std::vector<std::uint64_t> slots;
+
+  std::size_t num_pairs;
+};
+
+//==============================================================================
+template <typename Visitor>
+bool PairHashSet::forEach(Visitor& visitor) const
+{
+  for(const auto key : slots)
+  {
+    if(key == kEmptyKey)
+      continue;
+
+    if(visitor(static_cast<unsigned int>(key >> 32),
+               static_cast<unsigned int>(key & 0xffffffff)))
+      return true;
+  }
+
+  return false;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_PARALLELFOR_INL_H
+#define FCL_BROADPHASE_DETAIL_PARALLELFOR_INL_H
+
+#include "fcl/broadphase/detail/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename Task>
+void parallelFor(unsigned int num_threads, std::size_t num_tasks, Task task)
+{
+  const unsigned int num_workers = static_cast<unsigned int>(
+      std::min<std::size_t>(num_threads, num_tasks));
+
+  if(num_workers <= 1)
+  {
+    for(std::size_t t = 0; t < num_tasks; ++t)
+      task(t);
+    return;
+  }
+
+  std::atomic<std::size_t> next_task(0);
+  auto worker = [&]()
+  {
+    std::size_t t;
+    while((t = next_task++) < num_tasks)
+      task(t);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for(unsigned int w = 1; w < num_workers; ++w)
+    threads.emplace_back(worker);
+  worker();
+  for(auto& thread : threads)
+    thread.join();
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_PROXYTABLE_INL_H
+#define FCL_BROADPHASE_DETAIL_PROXYTABLE_INL_H
+
+#include "fcl/broadphase/detail/proxy_table.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename S, typename Proxy>
+void ProxyTable<S, Proxy>::insert(CollisionObject<S>* obj, const Proxy& proxy)
+{
+  obj->setBroadPhaseHandle(this, entries.size());
+  entries.emplace_back(obj, proxy);
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::iterator ProxyTable<S, Proxy>::find(
+    const CollisionObject<S>* obj)
+{
+  return entries.begin() + handleOf(obj);
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::const_iterator ProxyTable<S, Proxy>::find(
+    const CollisionObject<S>* obj) const
+{
+  return entries.cbegin() + handleOf(obj);
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+void ProxyTable<S, Proxy>::erase(iterator it)
+{
+  it->first->setBroadPhaseHandle(this, -1);
+  if(it + 1 != entries.end())
+  {
+    *it = entries.back();
+    it->first->setBroadPhaseHandle(this, it - entries.begin());
+  }
+  entries.pop_back();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+void ProxyTable<S, Proxy>::clear()
+{
+  entries.clear();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+void ProxyTable<S, Proxy>::reserve(std::size_t n)
+{
+  entries.reserve(n);
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+std::size_t ProxyTable<S, Proxy>::size() const
+{
+  return entries.size();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+bool ProxyTable<S, Proxy>::empty() const
+{
+  return entries.empty();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::iterator ProxyTable<S, Proxy>::begin()
+{
+  return entries.begin();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::iterator ProxyTable<S, Proxy>::end()
+{
+  return entries.end();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::const_iterator ProxyTable<S, Proxy>::begin()
+    const
+{
+  return entries.begin();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::const_iterator ProxyTable<S, Proxy>::end() const
+{
+  return entries.end();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::const_iterator ProxyTable<S, Proxy>::cbegin()
+    const
+{
+  return entries.cbegin();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+typename ProxyTable<S, Proxy>::const_iterator ProxyTable<S, Proxy>::cend()
+    const
+{
+  return entries.cend();
+}
+
+//==============================================================================
+template <typename S, typename Proxy>
+std::size_t ProxyTable<S, Proxy>::handleOf(const CollisionObject<S>* obj) const
+{
+  // A copy of an object, or an object left in a table that was cleared, may
+  // still carry a handle that points to the entry of another object
+  const std::size_t handle = obj->getBroadPhaseHandle(this);
+  if(handle < entries.size() && entries[handle].first == obj)
+    return handle;
+  return entries.size();
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_PROXYTABLE_H
+#define FCL_BROADPHASE_DETAIL_PROXYTABLE_H
+
+#include <utility>
+#include <vector>
+#include "fcl/narrowphase/collision_object.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Table of the proxies a broadphase manager keeps for its objects,
+/// e.g. their tree leaves. The entries are stored contiguously and each object
+/// stores the index of its entry as its broadphase handle in the table, so
+/// that finding, adding and removing an object take constant time without any
+/// hashing. Removing an entry moves the last one into its place.
+///
+/// The handles of an object are only trusted when the entry they point to is
+/// the one of the object, so that the table never has to reach objects that
+/// are no longer in it (and may have been deleted) to clear them.
+template <typename S, typename Proxy>
+class FCL_EXPORT ProxyTable
+{
+public:
+
+  using value_type = std::pair<CollisionObject<S>*, Proxy>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  ProxyTable() = default;
+
+  /// @brief The handles of the objects are keyed by the address of the table,
+  /// which a copy would not share
+  ProxyTable(const ProxyTable&) = delete;
+
+  ProxyTable& operator=(const ProxyTable&) = delete;
+
+  /// @brief Add an object that is not in the table yet, with its proxy
+  void insert(CollisionObject<S>* obj, const Proxy& proxy);
+
+  /// @brief The entry of the object, or end() if it is not in the table
+  iterator find(const CollisionObject<S>* obj);
+
+  /// @brief The entry of the object, or end() if it is not in the table
+  const_iterator find(const CollisionObject<S>* obj) const;
+
+  /// @brief Remove an entry, which invalidates the iterators to the last one
+  void erase(iterator it);
+
+  /// @brief Remove all the entries, leaving the objects untouched
+  void clear();
+
+  void reserve(std::size_t n);
+
+  std::size_t size() const;
+
+  bool empty() const;
+
+  iterator begin();
+
+  iterator end();
+
+  const_iterator begin() const;
+
+  const_iterator end() const;
+
+  const_iterator cbegin() const;
+
+  const_iterator cend() const;
+
+private:
+
+  /// @brief The handle of the object in the table, or size() if it is not in
+  /// it
+  std::size_t handleOf(const CollisionObject<S>* obj) const;
+
+  std::vector<value_type> entries;
+};
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/proxy_table-inl.h"
+
+#endif
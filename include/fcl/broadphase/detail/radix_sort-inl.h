@@ -0,0 +1,162 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_RADIXSORT_INL_H
+#define FCL_BROADPHASE_DETAIL_RADIXSORT_INL_H
+
+#include "fcl/broadphase/detail/radix_sort.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "fcl/broadphase/detail/parallel_for.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+inline SortableKey<float>::Type SortableKey<float>::encode(float value)
+{
+  // Adding zero turns -0 into +0
+  value += 0.0f;
+  Type bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  // Flip all the bits of negative values and the sign bit of the others
+  const Type sign = Type(1) << 31;
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+
+//==============================================================================
+inline SortableKey<double>::Type SortableKey<double>::encode(double value)
+{
+  value += 0.0;
+  Type bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const Type sign = Type(1) << 63;
+  return (bits & sign) ? ~bits : (bits | sign);
+}
+
+//==============================================================================
+template <typename Key>
+void radixSort(std::vector<Key>& keys, std::vector<unsigned int>& values,
+               std::vector<Key>& key_buffer,
+               std::vector<unsigned int>& value_buffer,
+               unsigned int num_threads)
+{
+  const std::size_t n = keys.size();
+  if(n < 2)
+    return;
+
+  key_buffer.resize(n);
+  value_buffer.resize(n);
+
+  // Blocks of fewer keys cost more in thread start up than they save
+  const std::size_t num_blocks
+      = std::max<std::size_t>(1, std::min<std::size_t>(num_threads, n / 16384));
+
+  // One byte histogram per block, on the stack unless there are several
+  std::size_t single_count[256];
+  std::vector<std::size_t> block_counts;
+  std::size_t* count = single_count;
+  if(num_blocks > 1)
+  {
+    block_counts.resize(256 * num_blocks);
+    count = block_counts.data();
+  }
+
+  // The bits in which the keys differ: bytes outside them need no pass
+  std::atomic<Key> block_varying(0);
+  parallelFor(num_threads, num_blocks, [&](std::size_t c)
+  {
+    const std::size_t end = n * (c + 1) / num_blocks;
+    Key varying = 0;
+    for(std::size_t i = n * c / num_blocks; i < end; ++i)
+      varying |= keys[i] ^ keys[0];
+    block_varying.fetch_or(varying);
+  });
+  const Key varying = block_varying.load();
+
+  for(unsigned int shift = 0; shift < 8 * sizeof(Key); shift += 8)
+  {
+    if(((varying >> shift) & 0xff) == 0)
+      continue;
+
+    std::fill(count, count + 256 * num_blocks, 0);
+    parallelFor(num_threads, num_blocks, [&](std::size_t c)
+    {
+      std::size_t* block_count = &count[256 * c];
+      const std::size_t end = n * (c + 1) / num_blocks;
+      for(std::size_t i = n * c / num_blocks; i < end; ++i)
+        ++block_count[(keys[i] >> shift) & 0xff];
+    });
+
+    // Each block writes its keys of a byte after those of the same byte in
+    // the blocks before it
+    std::size_t offset = 0;
+    for(std::size_t b = 0; b < 256; ++b)
+    {
+      for(std::size_t c = 0; c < num_blocks; ++c)
+      {
+        const std::size_t block_count = count[256 * c + b];
+        count[256 * c + b] = offset;
+        offset += block_count;
+      }
+    }
+
+    parallelFor(num_threads, num_blocks, [&](std::size_t c)
+    {
+      std::size_t* block_offset = &count[256 * c];
+      const std::size_t end = n * (c + 1) / num_blocks;
+      for(std::size_t i = n * c / num_blocks; i < end; ++i)
+      {
+        const std::size_t pos = block_offset[(keys[i] >> shift) & 0xff]++;
+        key_buffer[pos] = keys[i];
+        value_buffer[pos] = values[i];
+      }
+    });
+
+    keys.swap(key_buffer);
+    values.swap(value_buffer);
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_RADIXSORT_H
+#define FCL_BROADPHASE_DETAIL_RADIXSORT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Unsigned integer key whose order matches the order of the floating
+/// point values it encodes, with -0 and +0 mapped to the same key.
+template <typename S>
+struct SortableKey;
+
+template <>
+struct SortableKey<float>
+{
+  using Type = std::uint32_t;
+  static Type encode(float value);
+};
+
+template <>
+struct SortableKey<double>
+{
+  using Type = std::uint64_t;
+  static Type encode(double value);
+};
+
+/// @brief Stable LSD radix sort of (keys[i], values[i]) by key, one byte per
+/// pass. Passes over a byte all the keys share are skipped. The buffers are
+/// scratch space kept by the caller so that repeated sorts do not allocate.
+///
+/// With more than one thread, large arrays are split into one block per
+/// thread: each pass counts the bytes of the blocks in parallel, and the
+/// blocks then scatter their keys in parallel to disjoint ranges of the
+/// output, which keeps the sort stable.
+template <typename Key>
+void radixSort(std::vector<Key>& keys, std::vector<unsigned int>& values,
+               std::vector<Key>& key_buffer,
+               std::vector<unsigned int>& value_buffer,
+               unsigned int num_threads = 1);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/radix_sort-inl.h"
+
+#endif
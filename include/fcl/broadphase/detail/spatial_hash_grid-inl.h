@@ -0,0 +1,326 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_SPATIALHASHGRID_INL_H
+#define FCL_BROADPHASE_DETAIL_SPATIALHASHGRID_INL_H
+
+#include "fcl/broadphase/detail/spatial_hash_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT SpatialHashGrid<double>;
+
+extern template
+class FCL_EXPORT SpatialHashGrid<float>;
+
+//==============================================================================
+template <typename S>
+constexpr int SpatialHashGrid<S>::kCoordBits;
+
+//==============================================================================
+template <typename S>
+constexpr int SpatialHashGrid<S>::kCoordLimit;
+
+//==============================================================================
+template <typename S>
+constexpr std::uint64_t SpatialHashGrid<S>::kEmptyKey;
+
+//==============================================================================
+template <typename S>
+SpatialHashGrid<S>::SpatialHashGrid(S cell_size)
+  : cell_size(cell_size), inv_cell_size(1 / cell_size)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+S SpatialHashGrid<S>::getCellSize() const
+{
+  return cell_size;
+}
+
+//==============================================================================
+template <typename S>
+typename SpatialHashGrid<S>::CellBox SpatialHashGrid<S>::cellBox(
+    const AABB<S>& aabb) const
+{
+  CellBox box;
+  for(int i = 0; i < 3; ++i)
+  {
+    box.min[i] = clampCoord(aabb.min_[i] * inv_cell_size);
+    box.max[i] = clampCoord(aabb.max_[i] * inv_cell_size);
+  }
+  return box;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t SpatialHashGrid<S>::numCells(const CellBox& box)
+{
+  return static_cast<std::size_t>(box.max[0] - box.min[0] + 1)
+      * static_cast<std::size_t>(box.max[1] - box.min[1] + 1)
+      * static_cast<std::size_t>(box.max[2] - box.min[2] + 1);
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGrid<S>::build(
+    const std::vector<CellBox>& boxes, const std::vector<unsigned int>& members)
+{
+  std::size_t num_entries = 0;
+  for(const auto m : members)
+    num_entries += numCells(boxes[m]);
+
+  // At most num_entries distinct cells: keep the load factor below 1/2.
+  std::size_t table_size = 16;
+  while(table_size < 2 * num_entries)
+    table_size <<= 1;
+  if(slot_keys.size() < table_size || slot_keys.size() > 8 * table_size)
+  {
+    slot_keys.resize(table_size);
+    slot_cells.resize(table_size);
+  }
+  std::fill(slot_keys.begin(), slot_keys.end(), kEmptyKey);
+
+  cell_keys.clear();
+  cell_start.clear();
+  entry_cells.resize(num_entries);
+
+  // Count the objects of each cell, numbering the cells as they are found
+  std::size_t e = 0;
+  for(const auto m : members)
+  {
+    const CellBox& box = boxes[m];
+    for(int x = box.min[0]; x <= box.max[0]; ++x)
+    {
+      for(int y = box.min[1]; y <= box.max[1]; ++y)
+      {
+        for(int z = box.min[2]; z <= box.max[2]; ++z)
+        {
+          const std::uint64_t key = cellKey(x, y, z);
+          const std::size_t slot = findSlot(key);
+          if(slot_keys[slot] == kEmptyKey)
+          {
+            slot_keys[slot] = key;
+            slot_cells[slot] = static_cast<unsigned int>(cell_keys.size());
+            cell_keys.push_back(key);
+            cell_start.push_back(0);
+          }
+
+          const unsigned int cell = slot_cells[slot];
+          ++cell_start[cell];
+          entry_cells[e++] = cell;
+        }
+      }
+    }
+  }
+
+  // Counts to offsets
+  unsigned int offset = 0;
+  for(auto& start : cell_start)
+  {
+    const unsigned int count = start;
+    start = offset;
+    offset += count;
+  }
+  cell_start.push_back(offset);
+
+  // Scatter the objects into their cells
+  cursor.assign(cell_start.begin(), cell_start.end() - 1);
+  cell_objects.resize(num_entries);
+  e = 0;
+  for(const auto m : members)
+  {
+    const std::size_t n = numCells(boxes[m]);
+    for(std::size_t k = 0; k < n; ++k)
+      cell_objects[cursor[entry_cells[e++]]++] = m;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGrid<S>::clear()
+{
+  std::fill(slot_keys.begin(), slot_keys.end(), kEmptyKey);
+  cell_keys.clear();
+  cell_start.clear();
+  cell_objects.clear();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t SpatialHashGrid<S>::numOccupiedCells() const
+{
+  return cell_keys.size();
+}
+
+//==============================================================================
+template <typename S>
+template <typename Visitor>
+bool SpatialHashGrid<S>::forEachCell(const CellBox& box, Visitor& visitor) const
+{
+  if(cell_keys.empty())
+    return false;
+
+  // A box larger than the occupied region is cheaper to filter than to probe
+  if(numCells(box) > cell_keys.size())
+  {
+    for(std::size_t c = 0; c < cell_keys.size(); ++c)
+    {
+      int x, y, z;
+      cellCoords(cell_keys[c], x, y, z);
+      if(x < box.min[0] || x > box.max[0]
+         || y < box.min[1] || y > box.max[1]
+         || z < box.min[2] || z > box.max[2])
+        continue;
+
+      if(visitor(x, y, z,
+                 cell_objects.data() + cell_start[c],
+                 cell_objects.data() + cell_start[c + 1]))
+        return true;
+    }
+    return false;
+  }
+
+  for(int x = box.min[0]; x <= box.max[0]; ++x)
+  {
+    for(int y = box.min[1]; y <= box.max[1]; ++y)
+    {
+      for(int z = box.min[2]; z <= box.max[2]; ++z)
+      {
+        const std::size_t slot = findSlot(cellKey(x, y, z));
+        if(slot_keys[slot] == kEmptyKey)
+          continue;
+
+        const unsigned int c = slot_cells[slot];
+        if(visitor(x, y, z,
+                   cell_objects.data() + cell_start[c],
+                   cell_objects.data() + cell_start[c + 1]))
+          return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+template <typename Visitor>
+bool SpatialHashGrid<S>::forEachOccupiedCell(Visitor& visitor) const
+{
+  for(std::size_t c = 0; c < cell_keys.size(); ++c)
+  {
+    int x, y, z;
+    cellCoords(cell_keys[c], x, y, z);
+    if(visitor(x, y, z,
+               cell_objects.data() + cell_start[c],
+               cell_objects.data() + cell_start[c + 1]))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool SpatialHashGrid<S>::isFirstSharedCell(
+    const CellBox& box1, const CellBox& box2, int x, int y, int z)
+{
+  return x == std::max(box1.min[0], box2.min[0])
+      && y == std::max(box1.min[1], box2.min[1])
+      && z == std::max(box1.min[2], box2.min[2]);
+}
+
+//==============================================================================
+template <typename S>
+int SpatialHashGrid<S>::clampCoord(S v)
+{
+  const S c = std::floor(v);
+  if(!(c >= -kCoordLimit)) // also catches NaN
+    return -kCoordLimit;
+  if(c > kCoordLimit - 1)
+    return kCoordLimit - 1;
+  return static_cast<int>(c);
+}
+
+//==============================================================================
+template <typename S>
+std::uint64_t SpatialHashGrid<S>::cellKey(int x, int y, int z)
+{
+  return (static_cast<std::uint64_t>(x + kCoordLimit) << (2 * kCoordBits))
+      | (static_cast<std::uint64_t>(y + kCoordLimit) << kCoordBits)
+      | static_cast<std::uint64_t>(z + kCoordLimit);
+}
+
+//==============================================================================
+template <typename S>
+void SpatialHashGrid<S>::cellCoords(
+    std::uint64_t key, int& x, int& y, int& z)
+{
+  const std::uint64_t mask = (std::uint64_t(1) << kCoordBits) - 1;
+  x = static_cast<int>((key >> (2 * kCoordBits)) & mask) - kCoordLimit;
+  y = static_cast<int>((key >> kCoordBits) & mask) - kCoordLimit;
+  z = static_cast<int>(key & mask) - kCoordLimit;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t SpatialHashGrid<S>::findSlot(std::uint64_t key) const
+{
+  const std::size_t mask = slot_keys.size() - 1;
+  std::uint64_t h = key * 0x9E3779B97F4A7C15ull;
+  h ^= h >> 32;
+
+  std::size_t slot = static_cast<std::size_t>(h) & mask;
+  while(slot_keys[slot] != kEmptyKey && slot_keys[slot] != key)
+    slot = (slot + 1) & mask;
+
+  return slot;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_SPATIALHASHGRID_H
+#define FCL_BROADPHASE_DETAIL_SPATIALHASHGRID_H
+
+#include <cstdint>
+#include <vector>
+#include "fcl/math/bv/AABB.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Uniform grid over the whole space whose occupied cells are found
+/// through an open-addressed hash table. The grid is rebuilt from scratch by a
+/// counting sort into a flat (CSR) array: cell i holds the objects
+/// cell_objects[cell_start[i], cell_start[i + 1]). All storage is kept
+/// between builds, so rebuilding and querying a scene of steady size do not
+/// allocate.
+template <typename S_>
+class FCL_EXPORT SpatialHashGrid
+{
+public:
+
+  using S = S_;
+
+  /// @brief Inclusive range of integer cell coordinates
+  struct CellBox
+  {
+    int min[3];
+    int max[3];
+  };
+
+  explicit SpatialHashGrid(S cell_size);
+
+  S getCellSize() const;
+
+  /// @brief The cells overlapped by the given box. Coordinates are clamped
+  /// to the range the hash keys can represent, which merges far away cells
+  /// without losing any of them.
+  CellBox cellBox(const AABB<S>& aabb) const;
+
+  /// @brief Number of cells in the box
+  static std::size_t numCells(const CellBox& box);
+
+  /// @brief Rebuild the grid, inserting the object indices listed in members
+  /// into all the cells of their box. Indices within a cell stay in the order
+  /// they are listed.
+  void build(const std::vector<CellBox>& boxes,
+             const std::vector<unsigned int>& members);
+
+  /// @brief Remove all the objects
+  void clear();
+
+  /// @brief Number of occupied cells
+  std::size_t numOccupiedCells() const;
+
+  /// @brief Call visitor(x, y, z, begin, end) for every occupied cell within
+  /// the box, [begin, end) being the object indices in the cell. Stops and
+  /// returns true as soon as the visitor returns true.
+  template <typename Visitor>
+  bool forEachCell(const CellBox& box, Visitor& visitor) const;
+
+  /// @brief Call visitor(x, y, z, begin, end) for every occupied cell. Stops
+  /// and returns true as soon as the visitor returns true.
+  template <typename Visitor>
+  bool forEachOccupiedCell(Visitor& visitor) const;
+
+  /// @brief Whether cell (x, y, z) is the lowest cell shared by the boxes,
+  /// i.e. the one cell in which a pair of objects is reported.
+  static bool isFirstSharedCell(
+      const CellBox& box1, const CellBox& box2, int x, int y, int z);
+
+private:
+
+  static constexpr int kCoordBits = 21;
+  static constexpr int kCoordLimit = 1 << (kCoordBits - 1);
+  static constexpr std::uint64_t kEmptyKey = ~std::uint64_t(0);
+
+  static int clampCoord(S v);
+  static std::uint64_t cellKey(int x, int y, int z);
+  static void cellCoords(std::uint64_t key, int& x, int& y, int& z);
+
+  /// @brief Slot of the key in the hash table: either the slot holding it or
+  /// the empty slot where it would be inserted
+  std::size_t findSlot(std::uint64_t key) const;
+
+  S cell_size;
+  S inv_cell_size;
+
+  /// @brief Open-addressed table (linear probing, power of two size) mapping
+  /// cell keys to dense cell indices
+  std::vector<std::uint64_t> slot_keys;
+  std::vector<unsigned int> slot_cells;
+
+  /// @brief Key of each dense cell
+  std::vector<std::uint64_t> cell_keys;
+
+  /// @brief CSR offsets, one more than the number of occupied cells
+  std::vector<unsigned int> cell_start;
+
+  /// @brief Object indices, grouped by cell
+  std::vector<unsigned int> cell_objects;
+
+  /// @brief Scratch space of the counting sort: the dense cell of each
+  /// (object, cell) entry and the fill cursor of each cell
+  std::vector<unsigned int> entry_cells;
+  std::vector<unsigned int> cursor;
+};
+
+using SpatialHashGridf = SpatialHashGrid<float>;
+using SpatialHashGridd = SpatialHashGrid<double>;
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/broadphase/detail/spatial_hash_grid-inl.h"
+
+#endif
@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT CollisionGeometry<double>;
 
+extern template
+class FCL_EXPORT CollisionGeometry<float>;
+
 //==============================================================================
 template <typename S>
 CollisionGeometry<S>::CollisionGeometry()
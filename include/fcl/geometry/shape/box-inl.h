@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Box<double>;
 
+extern template
+class FCL_EXPORT Box<float>;
+
 //==============================================================================
 template <typename S>
 Box<S>::Box(S x, S y, S z)
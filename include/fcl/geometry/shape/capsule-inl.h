@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Capsule<double>;
 
+extern template
+class FCL_EXPORT Capsule<float>;
+
 //==============================================================================
 template <typename S>
 Capsule<S>::Capsule(S radius, S lz)
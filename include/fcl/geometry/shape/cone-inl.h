@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Cone<double>;
 
+extern template
+class FCL_EXPORT Cone<float>;
+
 //==============================================================================
 template <typename S>
 Cone<S>::Cone(S radius, S lz)
@@ -41,6 +41,8 @@
 
 #include "fcl/geometry/shape/convex.h"
 
+#include <set>
+
 namespace fcl
 {
 
@@ -48,6 +50,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Convex<double>;
 
+extern template
+class FCL_EXPORT Convex<float>;
+
 //==============================================================================
 template <typename S>
 Convex<S>::Convex(int num_vertices, Vector3<S>* vertices,
@@ -66,6 +71,9 @@ Convex<S>::Convex(int num_vertices, Vector3<S>* vertices,
     sum += vertices[i];
   }
   interior_point = sum * (S)(1.0 / num_vertices);
+
+  if(num_vertices >= kMinVertexCountForAdjacencyWalk)
+    buildVertexAdjacency();
 }
 
 //==============================================================================
@@ -241,6 +249,128 @@ std::vector<Vector3<S>> Convex<S>::getBoundVertices(
   return result;
 }
 
+//==============================================================================
+template <typename S>
+int Convex<S>::findExtremeVertexIndex(const Vector3<S>& dir,
+                                      int start_index) const {
+  if(!soa_vertices_.empty())
+    return soa_vertices_.argmaxDot(dir);
+
+  if(neighbors_.empty()) {
+    int extreme_index = 0;
+    S extreme_value = dir.dot(vertices[0]);
+    for(int i = 1; i < num_vertices; ++i) {
+      const S value = dir.dot(vertices[i]);
+      if(value > extreme_value) {
+        extreme_index = i;
+        extreme_value = value;
+      }
+    }
+    return extreme_index;
+  }
+
+  assert(start_index >= 0 && start_index < num_vertices);
+  int extreme_index = start_index;
+  S extreme_value = dir.dot(vertices[extreme_index]);
+  bool flat = false;
+  bool keep_walking = true;
+  while(keep_walking) {
+    keep_walking = false;
+    flat = true;
+    const S current_value = extreme_value;
+    const int* neighbor = neighbors_.data() + neighbors_[extreme_index];
+    const int neighbor_count = *neighbor++;
+    for(int j = 0; j < neighbor_count; ++j) {
+      const int neighbor_index = neighbor[j];
+      const S value = dir.dot(vertices[neighbor_index]);
+      if(value > extreme_value) {
+        extreme_index = neighbor_index;
+        extreme_value = value;
+        keep_walking = true;
+      }
+      if(value != current_value)
+        flat = false;
+    }
+  }
+
+  // The walk can only stall on a non-extreme vertex if every neighbor has
+  // exactly the same dot product (e.g., a vertex interior to a triangulated
+  // face and `dir` is the face's inward normal). This is vanishingly rare; fall
+  // back to the exhaustive search.
+  if(flat) {
+    for(int i = 0; i < num_vertices; ++i) {
+      const S value = dir.dot(vertices[i]);
+      if(value > extreme_value) {
+        extreme_index = i;
+        extreme_value = value;
+      }
+    }
+  }
+
+  return extreme_index;
+}
+
+//==============================================================================
+template <typename S>
+const Vector3<S>& Convex<S>::findExtremeVertex(const Vector3<S>& dir) const {
+  return vertices[findExtremeVertexIndex(dir)];
+}
+
+//==============================================================================
+template <typename S>
+bool Convex<S>::usesVertexAdjacency() const {
+  return !neighbors_.empty();
+}
+
+//==============================================================================
+template <typename S>
+void Convex<S>::setVectorizedSupport(bool enabled) {
+  if(enabled)
+    soa_vertices_.assign(vertices, num_vertices);
+  else
+    soa_vertices_.clear();
+}
+
+//==============================================================================
+template <typename S>
+bool Convex<S>::usesVectorizedSupport() const {
+  return !soa_vertices_.empty();
+}
+
+//==============================================================================
+template <typename S>
+void Convex<S>::buildVertexAdjacency() {
+  // Every edge of a face connects consecutive vertices; an edge shared by two
+  // faces is reported twice and de-duplicated here.
+  std::vector<std::set<int>> adjacency(num_vertices);
+  const int* face_encoding = faces;
+  for(int i = 0; i < num_faces; ++i) {
+    const int vertex_count = *face_encoding;
+    const int* index = face_encoding + 1;
+    for(int j = 0; j < vertex_count; ++j) {
+      const int v0 = index[j];
+      const int v1 = index[(j + 1) % vertex_count];
+      adjacency[v0].insert(v1);
+      adjacency[v1].insert(v0);
+    }
+    face_encoding += vertex_count + 1;
+  }
+
+  std::size_t total = num_vertices;
+  for(const auto& adjacent : adjacency)
+    total += adjacent.size() + 1;
+
+  neighbors_.clear();
+  neighbors_.reserve(total);
+  neighbors_.resize(num_vertices);
+  for(int i = 0; i < num_vertices; ++i) {
+    neighbors_[i] = static_cast<int>(neighbors_.size());
+    neighbors_.push_back(static_cast<int>(adjacency[i].size()));
+    neighbors_.insert(neighbors_.end(), adjacency[i].begin(),
+                      adjacency[i].end());
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -40,6 +40,7 @@
 #define FCL_SHAPE_CONVEX_H
 
 #include "fcl/geometry/shape/shape_base.h"
+#include "fcl/math/detail/soa_vertices.h"
 
 namespace fcl
 {
@@ -161,6 +162,69 @@ public:
   /// @brief get the vertices of some convex shape which can bound this shape in
   /// a specific configuration
   std::vector<Vector3<S>> getBoundVertices(const Transform3<S>& tf) const;
+
+  /// @brief Reports the index of the vertex that is farthest in the direction
+  /// `dir` (i.e., the vertex `v` that maximizes `dir · v`).
+  ///
+  /// For polytopes with many vertices, the search walks the vertex adjacency
+  /// graph (built from `faces` at construction) from `start_index`, moving to
+  /// any neighbor with a larger dot product until none remains. Because the
+  /// polytope is convex, the local maximum found this way is the global one.
+  /// Seeding the walk with the answer of a previous query in a similar
+  /// direction (as happens between GJK iterations) typically visits only a
+  /// handful of vertices. Small polytopes, and polytopes using the vectorized
+  /// search (see setVectorizedSupport()), are searched linearly and
+  /// `start_index` is ignored.
+  ///
+  /// @param dir          The query direction, expressed in the geometry's
+  ///                     frame G. Need not be unit length.
+  /// @param start_index  The vertex from which the walk starts; must be in
+  ///                     the range [0, num_vertices).
+  int findExtremeVertexIndex(const Vector3<S>& dir, int start_index = 0) const;
+
+  /// @brief Reports the vertex that is farthest in the direction `dir`. See
+  /// findExtremeVertexIndex() for details.
+  const Vector3<S>& findExtremeVertex(const Vector3<S>& dir) const;
+
+  /// @brief Whether support queries walk the vertex adjacency graph (true) or
+  /// scan all vertices (false).
+  bool usesVertexAdjacency() const;
+
+  /// @brief Enables or disables the vectorized support search.
+  ///
+  /// When enabled, the polytope keeps a structure-of-arrays copy of `vertices`
+  /// and support queries scan that copy with SIMD instructions instead of
+  /// walking the adjacency graph. This pays off for vertex sets without a
+  /// meaningful face structure (e.g., point clouds with `num_faces` of zero)
+  /// and for polytopes of moderate size, where a vectorized scan beats the
+  /// branchy graph walk.
+  ///
+  /// @warning The copy is taken at the time of this call. Since %Convex does
+  /// not own `vertices`, this must be called again whenever the vertex data
+  /// changes.
+  void setVectorizedSupport(bool enabled);
+
+  /// @brief Whether support queries scan a vectorized copy of the vertices.
+  bool usesVectorizedSupport() const;
+
+  /// @brief Polytopes with fewer vertices than this are searched linearly;
+  /// below this size, a linear scan is as fast as walking the adjacency graph.
+  static constexpr int kMinVertexCountForAdjacencyWalk = 32;
+
+private:
+  /// @brief Builds `neighbors_` from the face encoding.
+  void buildVertexAdjacency();
+
+  /// @brief The vertex adjacency graph in a compact, flat encoding. The first
+  /// `num_vertices` entries are offsets into this same array, one per vertex.
+  /// At the offset for vertex `i` is the number `k` of vertices adjacent to
+  /// `i`, followed by the `k` indices of those vertices. It is empty if the
+  /// adjacency walk is not used.
+  std::vector<int> neighbors_;
+
+  /// @brief The structure-of-arrays copy of `vertices` used by the vectorized
+  /// support search; empty unless enabled with setVectorizedSupport().
+  detail::SoAVertices<S> soa_vertices_;
 };
 
 using Convexf = Convex<float>;
@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Cylinder<double>;
 
+extern template
+class FCL_EXPORT Cylinder<float>;
+
 //==============================================================================
 template <typename S>
 Cylinder<S>::Cylinder(S radius, S lz)
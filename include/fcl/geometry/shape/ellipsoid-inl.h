@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Ellipsoid<double>;
 
+extern template
+class FCL_EXPORT Ellipsoid<float>;
+
 //==============================================================================
 template <typename S>
 Ellipsoid<S>::Ellipsoid(S a, S b, S c)
@@ -47,10 +47,16 @@ namespace fcl
 extern template
 class FCL_EXPORT Halfspace<double>;
 
+extern template
+class FCL_EXPORT Halfspace<float>;
+
 //==============================================================================
 extern template
 Halfspace<double> transform(const Halfspace<double>& a, const Transform3<double>& tf);
 
+extern template
+Halfspace<float> transform(const Halfspace<float>& a, const Transform3<float>& tf);
+
 //==============================================================================
 template <typename S>
 Halfspace<S>::Halfspace(const Vector3<S>& n, S d)
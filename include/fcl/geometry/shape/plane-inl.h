@@ -47,10 +47,16 @@ namespace fcl
 extern template
 class FCL_EXPORT Plane<double>;
 
+extern template
+class FCL_EXPORT Plane<float>;
+
 //==============================================================================
 extern template
 Plane<double> transform(const Plane<double>& a, const Transform3<double>& tf);
 
+extern template
+Plane<float> transform(const Plane<float>& a, const Transform3<float>& tf);
+
 //==============================================================================
 template <typename S>
 Plane<S>::Plane(const Vector3<S>& n, S d)
@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT ShapeBase<double>;
 
+extern template
+class FCL_EXPORT ShapeBase<float>;
+
 //==============================================================================
 template <typename S>
 ShapeBase<S>::ShapeBase()
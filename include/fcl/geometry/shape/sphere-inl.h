@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT Sphere<double>;
 
+extern template
+class FCL_EXPORT Sphere<float>;
+
 //==============================================================================
 template <typename S>
 Sphere<S>::Sphere(S radius) : ShapeBase<S>(), radius(radius)
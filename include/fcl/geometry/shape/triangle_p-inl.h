@@ -47,6 +47,9 @@ namespace fcl
 extern template
 class FCL_EXPORT TriangleP<double>;
 
+extern template
+class FCL_EXPORT TriangleP<float>;
+
 //==============================================================================
 template <typename S>
 TriangleP<S>::TriangleP(
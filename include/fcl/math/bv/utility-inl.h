@@ -975,6 +975,114 @@ void convertBV(
   detail::ConvertBVImpl<typename BV1::S, BV1, BV2>::run(bv1, tf1, bv2);
 }
 
+//==============================================================================
+namespace detail {
+//==============================================================================
+
+/// @brief Grow a bounding volume of type BV by a margin.
+template <typename S, typename BV>
+struct FCL_EXPORT InflateBVImpl;
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT InflateBVImpl<S, AABB<S>>
+{
+  static void run(AABB<S>& bv, S margin)
+  {
+    const Vector3<S> delta = Vector3<S>::Constant(margin);
+    bv.min_ -= delta;
+    bv.max_ += delta;
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT InflateBVImpl<S, OBB<S>>
+{
+  static void run(OBB<S>& bv, S margin)
+  {
+    bv.extent.array() += margin;
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT InflateBVImpl<S, RSS<S>>
+{
+  static void run(RSS<S>& bv, S margin)
+  {
+    bv.r += margin;
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT InflateBVImpl<S, kIOS<S>>
+{
+  static void run(kIOS<S>& bv, S margin)
+  {
+    for(unsigned int i = 0; i < bv.num_spheres; ++i)
+      bv.spheres[i].r += margin;
+    InflateBVImpl<S, OBB<S>>::run(bv.obb, margin);
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT InflateBVImpl<S, OBBRSS<S>>
+{
+  static void run(OBBRSS<S>& bv, S margin)
+  {
+    InflateBVImpl<S, OBB<S>>::run(bv.obb, margin);
+    InflateBVImpl<S, RSS<S>>::run(bv.rss, margin);
+  }
+};
+
+//==============================================================================
+template <typename S, std::size_t N>
+struct FCL_EXPORT InflateBVImpl<S, KDOP<S, N>>
+{
+  static void run(KDOP<S, N>& bv, S margin)
+  {
+    // The slab distances are measured along unnormalized directions, so each
+    // slab moves by the margin scaled with the length of its direction.
+    const std::size_t M = (N - 6) / 2;
+    S dx[M], dy[M], dz[M];
+    getDistances<S, M>(Vector3<S>::UnitX(), dx);
+    getDistances<S, M>(Vector3<S>::UnitY(), dy);
+    getDistances<S, M>(Vector3<S>::UnitZ(), dz);
+
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+      bv.dist(i) -= margin;
+      bv.dist(i + N / 2) += margin;
+    }
+
+    for(std::size_t i = 0; i < M; ++i)
+    {
+      const S delta
+          = margin * std::sqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
+      bv.dist(3 + i) -= delta;
+      bv.dist(3 + i + N / 2) += delta;
+    }
+  }
+};
+
+//==============================================================================
+} // namespace detail
+//==============================================================================
+
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+void inflateBV(BV& bv, typename BV::S margin)
+{
+  if(margin <= 0)
+    return;
+
+  detail::InflateBVImpl<typename BV::S, BV>::run(bv, margin);
+}
+
 } // namespace fcl
 
 #endif
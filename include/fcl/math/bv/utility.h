@@ -56,6 +56,13 @@ FCL_EXPORT
 void convertBV(
     const BV1& bv1, const Transform3<typename BV1::S>& tf1, BV2& bv2);
 
+/// @brief Grow a bounding volume so that it contains every point within
+/// distance margin of the original volume (conservatively for the BVs that
+/// cannot represent the exact offset). A non-positive margin is a no-op.
+template <typename BV>
+FCL_EXPORT
+void inflateBV(BV& bv, typename BV::S margin);
+
 } // namespace fcl
 
 #include "fcl/math/bv/utility-inl.h"
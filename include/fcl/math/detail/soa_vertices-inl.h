@@ -0,0 +1,118 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_MATH_DETAIL_SOAVERTICES_INL_H
+#define FCL_MATH_DETAIL_SOAVERTICES_INL_H
+
+#include "fcl/math/detail/soa_vertices.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT SoAVertices<double>;
+
+//==============================================================================
+template <typename S>
+int argmaxDot(const S* x, const S* y, const S* z, int n,
+              S dx, S dy, S dz)
+{
+  int best_index = -1;
+  S best_value = -std::numeric_limits<S>::max();
+  for(int i = 0; i < n; ++i)
+  {
+    const S value = dx * x[i] + dy * y[i] + dz * z[i];
+    if(best_index < 0 || value > best_value)
+    {
+      best_index = i;
+      best_value = value;
+    }
+  }
+  return best_index;
+}
+
+//==============================================================================
+template <typename S>
+void SoAVertices<S>::assign(const Vector3<S>* points, int num_points)
+{
+  x_.resize(num_points);
+  y_.resize(num_points);
+  z_.resize(num_points);
+  for(int i = 0; i < num_points; ++i)
+  {
+    x_[i] = points[i][0];
+    y_[i] = points[i][1];
+    z_[i] = points[i][2];
+  }
+}
+
+//==============================================================================
+template <typename S>
+void SoAVertices<S>::clear()
+{
+  Coordinates().swap(x_);
+  Coordinates().swap(y_);
+  Coordinates().swap(z_);
+}
+
+//==============================================================================
+template <typename S>
+bool SoAVertices<S>::empty() const
+{
+  return x_.empty();
+}
+
+//==============================================================================
+template <typename S>
+int SoAVertices<S>::size() const
+{
+  return static_cast<int>(x_.size());
+}
+
+//==============================================================================
+template <typename S>
+int SoAVertices<S>::argmaxDot(const Vector3<S>& dir) const
+{
+  return detail::argmaxDot(x_.data(), y_.data(), z_.data(), size(),
+                           dir[0], dir[1], dir[2]);
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
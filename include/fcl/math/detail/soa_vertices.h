@@ -0,0 +1,108 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_MATH_DETAIL_SOAVERTICES_H
+#define FCL_MATH_DETAIL_SOAVERTICES_H
+
+#include <vector>
+
+#include "fcl/common/types.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Reports the index i in [0, n) maximizing
+/// `dx * x[i] + dy * y[i] + dz * z[i]`; the smallest such index in case of
+/// ties. Returns -1 if n is zero.
+///
+/// The float and double overloads are vectorized with SSE2, or with AVX when
+/// the library is compiled with AVX enabled (e.g., FCL_USE_HOST_NATIVE_ARCH).
+FCL_EXPORT
+int argmaxDot(const float* x, const float* y, const float* z, int n,
+              float dx, float dy, float dz);
+
+FCL_EXPORT
+int argmaxDot(const double* x, const double* y, const double* z, int n,
+              double dx, double dy, double dz);
+
+/// @brief Scalar fallback of argmaxDot for other scalar types.
+template <typename S>
+int argmaxDot(const S* x, const S* y, const S* z, int n,
+              S dx, S dy, S dz);
+
+/// @brief A structure-of-arrays copy of a set of points: all x coordinates,
+/// then all y coordinates, then all z coordinates, each in its own aligned
+/// array. This is the layout consumed by the vectorized argmaxDot kernels.
+template <typename S>
+class FCL_EXPORT SoAVertices
+{
+public:
+
+  /// @brief Copies the positions of the given points.
+  void assign(const Vector3<S>* points, int num_points);
+
+  /// @brief Releases the copy.
+  void clear();
+
+  /// @brief Whether no points are stored.
+  bool empty() const;
+
+  /// @brief The number of points stored.
+  int size() const;
+
+  /// @brief Reports the index of the point farthest in direction `dir`; the
+  /// smallest such index in case of ties.
+  int argmaxDot(const Vector3<S>& dir) const;
+
+private:
+
+  using Coordinates = std::vector<S, Eigen::aligned_allocator<S>>;
+
+  Coordinates x_;
+  Coordinates y_;
+  Coordinates z_;
+};
+
+using SoAVerticesf = SoAVertices<float>;
+using SoAVerticesd = SoAVertices<double>;
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/math/detail/soa_vertices-inl.h"
+
+#endif
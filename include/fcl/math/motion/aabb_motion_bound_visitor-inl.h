@@ -0,0 +1,198 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_CCD_AABBMOTIONBOUNDVISITOR_INL_H
+#define FCL_CCD_AABBMOTIONBOUNDVISITOR_INL_H
+
+#include "fcl/math/motion/aabb_motion_bound_visitor.h"
+
+#include <cmath>
+#include <limits>
+#include "fcl/common/unused.h"
+#include "fcl/math/motion/spline_motion.h"
+#include "fcl/math/motion/screw_motion.h"
+#include "fcl/math/motion/interp_motion.h"
+#include "fcl/math/motion/translation_motion.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT AABBMotionBoundVisitor<double>;
+
+//==============================================================================
+template <typename S>
+AABBMotionBoundVisitor<S>::AABBMotionBoundVisitor(const AABB<S>& bv_)
+  : bv(bv_)
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(const MotionBase<S>& motion) const
+{
+  return visit(motion, 0, 1);
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(const SplineMotion<S>& motion) const
+{
+  return visit(motion, motion.getCurrentTime(), 1);
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(const ScrewMotion<S>& motion) const
+{
+  return visit(motion, 0, 1);
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(const InterpMotion<S>& motion) const
+{
+  return visit(motion, 0, 1);
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(const TranslationMotion<S>& motion) const
+{
+  return visit(motion, 0, 1);
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(
+    const MotionBase<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(motion);
+  FCL_UNUSED(t0);
+  FCL_UNUSED(t1);
+
+  // Nothing is known about the motion
+  return std::numeric_limits<S>::infinity();
+}
+
+//==============================================================================
+/// @brief The translation and the rotation vector of the spline are uniform
+/// cubic B-splines, whose derivatives are convex combinations of the
+/// differences of consecutive de Boor points. The angular speed is bounded by
+/// the rate of change of the rotation vector. These bounds hold over the whole
+/// motion, hence over any interval of it.
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(
+    const SplineMotion<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(t0);
+  FCL_UNUSED(t1);
+
+  return motion.computeTSpeedBound()
+      + motion.computeWSpeedBound() * maxCornerDistance(Vector3<S>::Zero());
+}
+
+//==============================================================================
+/// @brief mu = |v| + |w| * max(||ci - o|| x axis) where o is a point of the
+/// screw axis and ci are the corners of the AABB in the global frame. The
+/// distance of a point to the screw axis does not change along the motion.
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(
+    const ScrewMotion<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(t1);
+
+  const Transform3<S> tf = motion.transformAt(t0);
+
+  const Vector3<S>& axis = motion.getAxis();
+  const Vector3<S>& p = motion.getAxisOrigin();
+
+  S proj_max = 0;
+  for(int i = 0; i < 8; ++i)
+  {
+    const Vector3<S> corner(
+          (i & 1) ? bv.max_[0] : bv.min_[0],
+          (i & 2) ? bv.max_[1] : bv.min_[1],
+          (i & 4) ? bv.max_[2] : bv.min_[2]);
+    const S proj = ((tf * corner - p).cross(axis)).squaredNorm();
+    if(proj > proj_max) proj_max = proj;
+  }
+
+  return std::abs(motion.getLinearVelocity())
+      + std::abs(motion.getAngularVelocity()) * std::sqrt(proj_max);
+}
+
+//==============================================================================
+/// @brief mu = |v| + |w| * max||ci - p|| where p is the reference point of the
+/// motion and ci are the corners of the AABB.
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(
+    const InterpMotion<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(t0);
+  FCL_UNUSED(t1);
+
+  return motion.getLinearVelocity().norm()
+      + std::abs(motion.getAngularVelocity())
+      * maxCornerDistance(motion.getReferencePoint());
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::visit(
+    const TranslationMotion<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(t0);
+  FCL_UNUSED(t1);
+
+  return motion.getVelocity().norm();
+}
+
+//==============================================================================
+template <typename S>
+S AABBMotionBoundVisitor<S>::maxCornerDistance(const Vector3<S>& p) const
+{
+  // The farthest corner along each axis
+  Vector3<S> d;
+  for(int i = 0; i < 3; ++i)
+    d[i] = std::max(std::abs(bv.min_[i] - p[i]), std::abs(bv.max_[i] - p[i]));
+
+  return d.norm();
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_CCD_AABBMOTIONBOUNDVISITOR_H
+#define FCL_CCD_AABBMOTIONBOUNDVISITOR_H
+
+#include "fcl/math/bv/AABB.h"
+#include "fcl/math/motion/bv_motion_bound_visitor.h"
+
+namespace fcl
+{
+
+template <typename S>
+class MotionBase;
+
+template <typename S>
+class SplineMotion;
+
+template <typename S>
+class ScrewMotion;
+
+template <typename S>
+class InterpMotion;
+
+template <typename S>
+class TranslationMotion;
+
+/// @brief Compute a bound of the speed of every point of an AABB, in any
+/// direction, over the whole motion or over a time interval of it.
+///
+/// Unlike TBVMotionBoundVisitor, the bound does not depend on a closest
+/// direction between the query objects, so it stays valid for nonconvex
+/// objects: no point of the AABB moves farther than bound * (t1 - t0) between
+/// the times t0 and t1. The AABB is in the local frame of the object.
+template <typename S>
+class FCL_EXPORT AABBMotionBoundVisitor : public BVMotionBoundVisitor<S>
+{
+public:
+  AABBMotionBoundVisitor(const AABB<S>& bv_);
+
+  virtual S visit(const MotionBase<S>& motion) const;
+  virtual S visit(const SplineMotion<S>& motion) const;
+  virtual S visit(const ScrewMotion<S>& motion) const;
+  virtual S visit(const InterpMotion<S>& motion) const;
+  virtual S visit(const TranslationMotion<S>& motion) const;
+
+  virtual S visit(const MotionBase<S>& motion, S t0, S t1) const;
+  virtual S visit(const SplineMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const ScrewMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const InterpMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const TranslationMotion<S>& motion, S t0, S t1) const;
+
+protected:
+  /// @brief The largest distance between a corner of the AABB and p
+  S maxCornerDistance(const Vector3<S>& p) const;
+
+  AABB<S> bv;
+};
+
+} // namespace fcl
+
+#include "fcl/math/motion/aabb_motion_bound_visitor-inl.h"
+
+#endif
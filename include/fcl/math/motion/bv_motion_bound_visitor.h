@@ -67,6 +67,14 @@ public:
   virtual S visit(const ScrewMotion<S>& motion) const = 0;
   virtual S visit(const InterpMotion<S>& motion) const = 0;
   virtual S visit(const TranslationMotion<S>& motion) const = 0;
+
+  /// @brief Bounds over the time interval [t0, t1] of the motion, which do
+  /// not depend on its current step
+  virtual S visit(const MotionBase<S>& motion, S t0, S t1) const = 0;
+  virtual S visit(const SplineMotion<S>& motion, S t0, S t1) const = 0;
+  virtual S visit(const ScrewMotion<S>& motion, S t0, S t1) const = 0;
+  virtual S visit(const InterpMotion<S>& motion, S t0, S t1) const = 0;
+  virtual S visit(const TranslationMotion<S>& motion, S t0, S t1) const = 0;
 };
 
 } // namespace fcl
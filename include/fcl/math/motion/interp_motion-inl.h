@@ -56,8 +56,10 @@ InterpMotion<S>::InterpMotion()
   angular_vel = 0;
 
   // Default reference point is local zero point
+  reference_p.setZero();
 
   // Default linear velocity is zero
+  linear_vel.setZero();
 }
 
 //==============================================================================
@@ -67,7 +69,8 @@ InterpMotion<S>::InterpMotion(
     const Matrix3<S>& R2, const Vector3<S>& T2)
   : MotionBase<S>(),
     tf1(Transform3<S>::Identity()),
-    tf2(Transform3<S>::Identity())
+    tf2(Transform3<S>::Identity()),
+    reference_p(Vector3<S>::Zero())
 {
   tf1.linear() = R1;
   tf1.translation() = T1;
@@ -85,7 +88,8 @@ InterpMotion<S>::InterpMotion(
 template <typename S>
 InterpMotion<S>::InterpMotion(
     const Transform3<S>& tf1_, const Transform3<S>& tf2_)
-  : MotionBase<S>(), tf1(tf1_), tf2(tf2_), tf(tf1)
+  : MotionBase<S>(), tf1(tf1_), tf2(tf2_), tf(tf1),
+    reference_p(Vector3<S>::Zero())
 {
   // Compute the velocities for the motion
   computeVelocity();
@@ -122,17 +126,15 @@ InterpMotion<S>::InterpMotion(
     const Transform3<S>& tf1_, const Transform3<S>& tf2_, const Vector3<S>& O)
   : MotionBase<S>(), tf1(tf1_), tf2(tf2_), tf(tf1), reference_p(O)
 {
-  // Do nothing
+  // Compute the velocities for the motion
+  computeVelocity();
 }
 
 //==============================================================================
 template <typename S>
-bool InterpMotion<S>::integrate(double dt) const
+bool InterpMotion<S>::integrate(S dt) const
 {
-  if(dt > 1) dt = 1;
-
-  tf.linear() = absoluteRotation(dt).toRotationMatrix();
-  tf.translation() = linear_vel * dt + tf1 * reference_p - tf.linear() * reference_p;
+  tf = transformAt(dt);
 
   return true;
 }
@@ -151,6 +153,35 @@ S InterpMotion<S>::computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_vi
   return mb_visitor.visit(*this);
 }
 
+//==============================================================================
+template <typename S>
+Transform3<S> InterpMotion<S>::transformAt(S t) const
+{
+  if(t > 1) t = 1;
+
+  Transform3<S> transform = Transform3<S>::Identity();
+  transform.linear() = absoluteRotation(t).toRotationMatrix();
+  transform.translation() = linear_vel * t + tf1 * reference_p - transform.linear() * reference_p;
+
+  return transform;
+}
+
+//==============================================================================
+template <typename S>
+S InterpMotion<S>::computeMotionBound(
+    const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
+//==============================================================================
+template <typename S>
+S InterpMotion<S>::computeMotionBound(
+    const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
 //==============================================================================
 template <typename S>
 void InterpMotion<S>::getCurrentTransform(Transform3<S>& tf_) const
@@ -76,7 +76,7 @@ public:
 
   /// @brief Integrate the motion from 0 to dt
   /// We compute the current transformation from zero point instead of from last integrate time, for precision.
-  bool integrate(double dt) const;
+  bool integrate(S dt) const;
 
   /// @brief Compute the motion bound for a bounding volume along a given direction n, which is defined in the visitor
   S computeMotionBound(const BVMotionBoundVisitor<S>& mb_visitor) const;
@@ -84,6 +84,15 @@ public:
   /// @brief Compute the motion bound for a triangle along a given direction n, which is defined in the visitor 
   S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor) const;
 
+  /// @brief Compute the transformation at time t without changing the current step
+  Transform3<S> transformAt(S t) const;
+
+  /// @brief Compute the motion bound for a bounding volume over the time interval [t0, t1]
+  S computeMotionBound(const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const;
+
+  /// @brief Compute the motion bound for a triangle over the time interval [t0, t1]
+  S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const;
+
   /// @brief Get the rotation and translation in current step
   void getCurrentTransform(Transform3<S>& tf_) const;
 
@@ -68,6 +68,16 @@ public:
   /** @brief Compute the motion bound for a triangle, given the closest direction n between two query objects */
   virtual S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor) const = 0;
 
+  /** @brief Compute the transform at time t, without changing the current step.
+   * Unlike integrate(), this can be called concurrently on a shared motion */
+  virtual Transform3<S> transformAt(S t) const = 0;
+
+  /** @brief Compute the motion bound for a bounding volume over the time interval [t0, t1], independently of the current step */
+  virtual S computeMotionBound(const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const = 0;
+
+  /** @brief Compute the motion bound for a triangle over the time interval [t0, t1], independently of the current step */
+  virtual S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const = 0;
+
   /** @brief Get the rotation and translation in current step */
   void getCurrentTransform(Matrix3<S>& R, Vector3<S>& T) const;
 
@@ -92,14 +92,9 @@ ScrewMotion<S>::ScrewMotion(
 
 //==============================================================================
 template <typename S>
-bool ScrewMotion<S>::integrate(double dt) const
+bool ScrewMotion<S>::integrate(S dt) const
 {
-  if(dt > 1) dt = 1;
-
-  tf.linear() = absoluteRotation(dt).toRotationMatrix();
-
-  Quaternion<S> delta_rot = deltaRotation(dt);
-  tf.translation() = p + axis * (dt * linear_vel) + delta_rot * (tf1.translation() - p);
+  tf = transformAt(dt);
 
   return true;
 }
@@ -120,6 +115,37 @@ S ScrewMotion<S>::computeMotionBound(
   return mb_visitor.visit(*this);
 }
 
+//==============================================================================
+template <typename S>
+Transform3<S> ScrewMotion<S>::transformAt(S t) const
+{
+  if(t > 1) t = 1;
+
+  Transform3<S> transform = Transform3<S>::Identity();
+  transform.linear() = absoluteRotation(t).toRotationMatrix();
+
+  Quaternion<S> delta_rot = deltaRotation(t);
+  transform.translation() = p + axis * (t * linear_vel) + delta_rot * (tf1.translation() - p);
+
+  return transform;
+}
+
+//==============================================================================
+template <typename S>
+S ScrewMotion<S>::computeMotionBound(
+    const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
+//==============================================================================
+template <typename S>
+S ScrewMotion<S>::computeMotionBound(
+    const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
 //==============================================================================
 template <typename S>
 void ScrewMotion<S>::getCurrentTransform(Transform3<S>& tf_) const
@@ -121,14 +121,7 @@ bool SplineMotion<S>::integrate(S dt) const
 {
   if(dt > 1) dt = 1;
 
-  Vector3<S> cur_T = Td[0] * getWeight0(dt) + Td[1] * getWeight1(dt) + Td[2] * getWeight2(dt) + Td[3] * getWeight3(dt);
-  Vector3<S> cur_w = Rd[0] * getWeight0(dt) + Rd[1] * getWeight1(dt) + Rd[2] * getWeight2(dt) + Rd[3] * getWeight3(dt);
-  S cur_angle = cur_w.norm();
-  cur_w.normalize();
-
-  tf.linear() = AngleAxis<S>(cur_angle, cur_w).toRotationMatrix();
-  tf.translation() = cur_T;
-
+  tf = transformAt(dt);
   tf_t = dt;
 
   return true;
@@ -148,6 +141,40 @@ S SplineMotion<S>::computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_vi
   return mb_visitor.visit(*this);
 }
 
+//==============================================================================
+template <typename S>
+Transform3<S> SplineMotion<S>::transformAt(S t) const
+{
+  if(t > 1) t = 1;
+
+  Vector3<S> cur_T = Td[0] * getWeight0(t) + Td[1] * getWeight1(t) + Td[2] * getWeight2(t) + Td[3] * getWeight3(t);
+  Vector3<S> cur_w = Rd[0] * getWeight0(t) + Rd[1] * getWeight1(t) + Rd[2] * getWeight2(t) + Rd[3] * getWeight3(t);
+  S cur_angle = cur_w.norm();
+  cur_w.normalize();
+
+  Transform3<S> transform = Transform3<S>::Identity();
+  transform.linear() = AngleAxis<S>(cur_angle, cur_w).toRotationMatrix();
+  transform.translation() = cur_T;
+
+  return transform;
+}
+
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeMotionBound(
+    const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeMotionBound(
+    const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const
+{
+  return mb_visitor.visit(*this, t0, t1);
+}
+
 //==============================================================================
 template <typename S>
 void SplineMotion<S>::getCurrentTransform(Transform3<S>& tf_) const
@@ -245,14 +272,21 @@ void SplineMotion<S>::computeSplineParameter()
 //==============================================================================
 template <typename S>
 S SplineMotion<S>::computeTBound(const Vector3<S>& n) const
+{
+  return computeTBound(n, tf_t, 1);
+}
+
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeTBound(const Vector3<S>& n, S t0, S t1) const
 {
   S Ta = TA.dot(n);
   S Tb = TB.dot(n);
   S Tc = TC.dot(n);
 
   std::vector<S> T_potential;
-  T_potential.push_back(tf_t);
-  T_potential.push_back(1);
+  T_potential.push_back(t0);
+  T_potential.push_back(t1);
   if(Tb * Tb - 3 * Ta * Tc >= 0)
   {
     if(Ta == 0)
@@ -260,7 +294,7 @@ S SplineMotion<S>::computeTBound(const Vector3<S>& n) const
       if(Tb != 0)
       {
         S tmp = -Tc / (2 * Tb);
-        if(tmp < 1 && tmp > tf_t)
+        if(tmp < t1 && tmp > t0)
           T_potential.push_back(tmp);
       }
     }
@@ -269,9 +303,9 @@ S SplineMotion<S>::computeTBound(const Vector3<S>& n) const
       S tmp_delta = sqrt(Tb * Tb - 3 * Ta * Tc);
       S tmp1 = (-Tb + tmp_delta) / (3 * Ta);
       S tmp2 = (-Tb - tmp_delta) / (3 * Ta);
-      if(tmp1 < 1 && tmp1 > tf_t)
+      if(tmp1 < t1 && tmp1 > t0)
         T_potential.push_back(tmp1);
-      if(tmp2 < 1 && tmp2 > tf_t)
+      if(tmp2 < t1 && tmp2 > t0)
         T_potential.push_back(tmp2);
     }
   }
@@ -284,7 +318,7 @@ S SplineMotion<S>::computeTBound(const Vector3<S>& n) const
   }
 
 
-  S cur_delta = Ta * tf_t * tf_t * tf_t + Tb * tf_t * tf_t + Tc * tf_t;
+  S cur_delta = Ta * t0 * t0 * t0 + Tb * t0 * t0 + Tc * t0;
 
   T_bound -= cur_delta;
   T_bound /= 6.0;
@@ -295,6 +329,13 @@ S SplineMotion<S>::computeTBound(const Vector3<S>& n) const
 //==============================================================================
 template <typename S>
 S SplineMotion<S>::computeDWMax() const
+{
+  return computeDWMax(tf_t, 1);
+}
+
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeDWMax(S t0, S t1) const
 {
   // first compute ||w'||
   int a00[5] = {1,-4,6,-4,1};
@@ -345,14 +386,14 @@ S SplineMotion<S>::computeDWMax() const
 
   int root_num = detail::PolySolver<S>::solveCubic(da, roots);
 
-  S dWdW_max = a[0] * tf_t * tf_t * tf_t + a[1] * tf_t * tf_t * tf_t + a[2] * tf_t * tf_t + a[3] * tf_t + a[4];
-  S dWdW_1 = a[0] + a[1] + a[2] + a[3] + a[4];
+  S dWdW_max = a[0] * t0 * t0 * t0 * t0 + a[1] * t0 * t0 * t0 + a[2] * t0 * t0 + a[3] * t0 + a[4];
+  S dWdW_1 = a[0] * t1 * t1 * t1 * t1 + a[1] * t1 * t1 * t1 + a[2] * t1 * t1 + a[3] * t1 + a[4];
   if(dWdW_max < dWdW_1) dWdW_max = dWdW_1;
   for(int i = 0; i < root_num; ++i)
   {
     S v = roots[i];
 
-    if(v >= tf_t && v <= 1)
+    if(v >= t0 && v <= t1)
     {
       S value = a[0] * v * v * v * v + a[1] * v * v * v + a[2] * v * v + a[3] * v + a[4];
       if(value > dWdW_max) dWdW_max = value;
@@ -362,6 +403,30 @@ S SplineMotion<S>::computeDWMax() const
   return sqrt(dWdW_max);
 }
 
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeTSpeedBound() const
+{
+  // The derivative of the spline is a convex combination of the differences
+  // of consecutive de Boor points
+  S bound = 0;
+  for(int i = 0; i < 3; ++i)
+    bound = std::max(bound, (Td[i + 1] - Td[i]).norm());
+
+  return bound;
+}
+
+//==============================================================================
+template <typename S>
+S SplineMotion<S>::computeWSpeedBound() const
+{
+  S bound = 0;
+  for(int i = 0; i < 3; ++i)
+    bound = std::max(bound, (Rd[i + 1] - Rd[i]).norm());
+
+  return bound;
+}
+
 //==============================================================================
 template <typename S>
 S SplineMotion<S>::getCurrentTime() const
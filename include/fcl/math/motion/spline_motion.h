@@ -74,6 +74,15 @@ public:
   /// @brief Compute the motion bound for a triangle along a given direction n, which is defined in the visitor
   S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor) const override;
 
+  /// @brief Compute the transformation at time t without changing the current step
+  Transform3<S> transformAt(S t) const override;
+
+  /// @brief Compute the motion bound for a bounding volume over the time interval [t0, t1]
+  S computeMotionBound(const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const override;
+
+  /// @brief Compute the motion bound for a triangle over the time interval [t0, t1]
+  S computeMotionBound(const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const override;
+
   /// @brief Get the rotation and translation in current step
   void getCurrentTransform(Transform3<S>& tf_) const override;
 
@@ -102,9 +111,22 @@ protected:
 
 public:
   S computeTBound(const Vector3<S>& n) const;
+
+  /// @brief Bound of the displacement along n from time t0 over [t0, t1]
+  S computeTBound(const Vector3<S>& n, S t0, S t1) const;
   
   S computeDWMax() const;
 
+  /// @brief Bound of the rate of change of the rotation vector over [t0, t1]
+  S computeDWMax(S t0, S t1) const;
+
+  /// @brief Bound of the speed of the translation over the whole motion
+  S computeTSpeedBound() const;
+
+  /// @brief Bound of the rate of change of the rotation vector over the whole
+  /// motion, which bounds the angular speed
+  S computeWSpeedBound() const;
+
   S getCurrentTime() const;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
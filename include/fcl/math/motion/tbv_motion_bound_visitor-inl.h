@@ -60,7 +60,8 @@ struct TBVMotionBoundVisitorVisitImpl
 {
   static S run(
       const TBVMotionBoundVisitor<BV>& /*visitor*/,
-      const MotionT& /*motion*/)
+      const MotionT& /*motion*/,
+      S /*t0*/, S /*t1*/)
   {
     return 0;
   }
@@ -84,7 +85,7 @@ typename BV::S TBVMotionBoundVisitor<BV>::visit(
   using S = typename BV::S;
 
   return TBVMotionBoundVisitorVisitImpl<
-      S, BV, SplineMotion<S>>::run(*this, motion);
+      S, BV, SplineMotion<S>>::run(*this, motion, motion.getCurrentTime(), 1);
 }
 
 //==============================================================================
@@ -95,7 +96,7 @@ typename BV::S TBVMotionBoundVisitor<BV>::visit(
   using S = typename BV::S;
 
   return TBVMotionBoundVisitorVisitImpl<
-      S, BV, ScrewMotion<S>>::run(*this, motion);
+      S, BV, ScrewMotion<S>>::run(*this, motion, 0, 1);
 }
 
 //==============================================================================
@@ -106,7 +107,7 @@ typename BV::S TBVMotionBoundVisitor<BV>::visit(
   using S = typename BV::S;
 
   return TBVMotionBoundVisitorVisitImpl<
-      S, BV, InterpMotion<S>>::run(*this, motion);
+      S, BV, InterpMotion<S>>::run(*this, motion, 0, 1);
 }
 
 //==============================================================================
@@ -117,7 +118,63 @@ typename BV::S TBVMotionBoundVisitor<BV>::visit(
   using S = typename BV::S;
 
   return TBVMotionBoundVisitorVisitImpl<
-      S, BV, TranslationMotion<S>>::run(*this, motion);
+      S, BV, TranslationMotion<S>>::run(*this, motion, 0, 1);
+}
+
+//==============================================================================
+template<typename BV>
+typename BV::S TBVMotionBoundVisitor<BV>::visit(
+    const MotionBase<S>& motion, S t0, S t1) const
+{
+  FCL_UNUSED(motion);
+  FCL_UNUSED(t0);
+  FCL_UNUSED(t1);
+
+  return 0;
+}
+
+//==============================================================================
+template<typename BV>
+typename BV::S TBVMotionBoundVisitor<BV>::visit(
+    const SplineMotion<S>& motion, S t0, S t1) const
+{
+  using S = typename BV::S;
+
+  return TBVMotionBoundVisitorVisitImpl<
+      S, BV, SplineMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename BV>
+typename BV::S TBVMotionBoundVisitor<BV>::visit(
+    const ScrewMotion<S>& motion, S t0, S t1) const
+{
+  using S = typename BV::S;
+
+  return TBVMotionBoundVisitorVisitImpl<
+      S, BV, ScrewMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename BV>
+typename BV::S TBVMotionBoundVisitor<BV>::visit(
+    const InterpMotion<S>& motion, S t0, S t1) const
+{
+  using S = typename BV::S;
+
+  return TBVMotionBoundVisitorVisitImpl<
+      S, BV, InterpMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename BV>
+typename BV::S TBVMotionBoundVisitor<BV>::visit(
+    const TranslationMotion<S>& motion, S t0, S t1) const
+{
+  using S = typename BV::S;
+
+  return TBVMotionBoundVisitorVisitImpl<
+      S, BV, TranslationMotion<S>>::run(*this, motion, t0, t1);
 }
 
 //==============================================================================
@@ -126,10 +183,10 @@ struct TBVMotionBoundVisitorVisitImpl<S, RSS<S>, SplineMotion<S>>
 {
   static S run(
       const TBVMotionBoundVisitor<RSS<S>>& visitor,
-      const SplineMotion<S>& motion)
+      const SplineMotion<S>& motion,
+      S t0, S t1)
   {
-    S T_bound = motion.computeTBound(visitor.n);
-    S tf_t = motion.getCurrentTime();
+    S T_bound = motion.computeTBound(visitor.n, t0, t1);
 
     Vector3<S> c1 = visitor.bv.To;
     Vector3<S> c2 = visitor.bv.To + visitor.bv.axis.col(0) * visitor.bv.l[0];
@@ -166,8 +223,8 @@ struct TBVMotionBoundVisitorVisitImpl<S, RSS<S>, SplineMotion<S>>
     if(tmp > cxn_max) cxn_max = tmp;
     cxn_max = sqrt(cxn_max);
 
-    S dWdW_max = motion.computeDWMax();
-    S ratio = std::min(1 - tf_t, dWdW_max);
+    S dWdW_max = motion.computeDWMax(t0, t1);
+    S ratio = std::min(t1 - t0, dWdW_max);
 
     S R_bound = 2 * (cn_max + cmax + cxn_max + 3 * visitor.bv.r) * ratio;
 
@@ -188,10 +245,11 @@ struct TBVMotionBoundVisitorVisitImpl<S, RSS<S>, ScrewMotion<S>>
 {
   static S run(
       const TBVMotionBoundVisitor<RSS<S>>& visitor,
-      const ScrewMotion<S>& motion)
+      const ScrewMotion<S>& motion,
+      S t0, S /*t1*/)
   {
-    Transform3<S> tf;
-    motion.getCurrentTransform(tf);
+    // The distances to the screw axis do not change along the motion
+    const Transform3<S> tf = motion.transformAt(t0);
 
     const Vector3<S>& axis = motion.getAxis();
     S linear_vel = motion.getLinearVelocity();
@@ -229,10 +287,11 @@ struct TBVMotionBoundVisitorVisitImpl<S, RSS<S>, InterpMotion<S>>
 {
   static S run(
       const TBVMotionBoundVisitor<RSS<S>>& visitor,
-      const InterpMotion<S>& motion)
+      const InterpMotion<S>& motion,
+      S t0, S /*t1*/)
   {
-    Transform3<S> tf;
-    motion.getCurrentTransform(tf);
+    // The distances to the rotation axis do not change along the motion
+    const Transform3<S> tf = motion.transformAt(t0);
 
     const Vector3<S>& reference_p = motion.getReferencePoint();
     const Vector3<S>& angular_axis = motion.getAngularAxis();
@@ -265,7 +324,8 @@ struct TBVMotionBoundVisitorVisitImpl<S, RSS<S>, TranslationMotion<S>>
 {
   static S run(
       const TBVMotionBoundVisitor<RSS<S>>& visitor,
-      const TranslationMotion<S>& motion)
+      const TranslationMotion<S>& motion,
+      S /*t0*/, S /*t1*/)
   {
     return motion.getVelocity().dot(visitor.n);
   }
@@ -75,6 +75,12 @@ public:
   virtual S visit(const InterpMotion<S>& motion) const;
   virtual S visit(const TranslationMotion<S>& motion) const;
 
+  virtual S visit(const MotionBase<S>& motion, S t0, S t1) const;
+  virtual S visit(const SplineMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const ScrewMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const InterpMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const TranslationMotion<S>& motion, S t0, S t1) const;
+
 protected:
   template <typename, typename, typename>
   friend struct TBVMotionBoundVisitorVisitImpl;
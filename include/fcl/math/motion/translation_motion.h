@@ -63,6 +63,14 @@ public:
   S computeMotionBound(
       const TriangleMotionBoundVisitor<S>& mb_visitor) const override;
 
+  Transform3<S> transformAt(S t) const override;
+
+  S computeMotionBound(
+      const BVMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const override;
+
+  S computeMotionBound(
+      const TriangleMotionBoundVisitor<S>& mb_visitor, S t0, S t1) const override;
+
   void getCurrentTransform(Transform3<S>& tf_) const override;
 
   void getTaylorModel(TMatrix3<S>& tm, TVector3<S>& tv) const override;
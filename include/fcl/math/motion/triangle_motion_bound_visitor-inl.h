@@ -69,7 +69,8 @@ struct TriangleMotionBoundVisitorVisitImpl
 {
   static S run(
       const TriangleMotionBoundVisitor<S>& /*visitor*/,
-      const MotionT& /*motion*/)
+      const MotionT& /*motion*/,
+      S /*t0*/, S /*t1*/)
   {
     return 0;
   }
@@ -81,7 +82,7 @@ S TriangleMotionBoundVisitor<S>::visit(
     const SplineMotion<S>& motion) const
 {
   return TriangleMotionBoundVisitorVisitImpl<
-      S, SplineMotion<S>>::run(*this, motion);
+      S, SplineMotion<S>>::run(*this, motion, motion.getCurrentTime(), 1);
 }
 
 //==============================================================================
@@ -90,7 +91,7 @@ S TriangleMotionBoundVisitor<S>::visit(
     const ScrewMotion<S>& motion) const
 {
   return TriangleMotionBoundVisitorVisitImpl<
-      S, ScrewMotion<S>>::run(*this, motion);
+      S, ScrewMotion<S>>::run(*this, motion, 0, 1);
 }
 
 //==============================================================================
@@ -99,7 +100,7 @@ S TriangleMotionBoundVisitor<S>::visit(
     const InterpMotion<S>& motion) const
 {
   return TriangleMotionBoundVisitorVisitImpl<
-      S, InterpMotion<S>>::run(*this, motion);
+      S, InterpMotion<S>>::run(*this, motion, 0, 1);
 }
 
 //==============================================================================
@@ -108,7 +109,43 @@ S TriangleMotionBoundVisitor<S>::visit(
     const TranslationMotion<S>& motion) const
 {
   return TriangleMotionBoundVisitorVisitImpl<
-      S, TranslationMotion<S>>::run(*this, motion);
+      S, TranslationMotion<S>>::run(*this, motion, 0, 1);
+}
+
+//==============================================================================
+template<typename S>
+S TriangleMotionBoundVisitor<S>::visit(
+    const SplineMotion<S>& motion, S t0, S t1) const
+{
+  return TriangleMotionBoundVisitorVisitImpl<
+      S, SplineMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename S>
+S TriangleMotionBoundVisitor<S>::visit(
+    const ScrewMotion<S>& motion, S t0, S t1) const
+{
+  return TriangleMotionBoundVisitorVisitImpl<
+      S, ScrewMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename S>
+S TriangleMotionBoundVisitor<S>::visit(
+    const InterpMotion<S>& motion, S t0, S t1) const
+{
+  return TriangleMotionBoundVisitorVisitImpl<
+      S, InterpMotion<S>>::run(*this, motion, t0, t1);
+}
+
+//==============================================================================
+template<typename S>
+S TriangleMotionBoundVisitor<S>::visit(
+    const TranslationMotion<S>& motion, S t0, S t1) const
+{
+  return TriangleMotionBoundVisitorVisitImpl<
+      S, TranslationMotion<S>>::run(*this, motion, t0, t1);
 }
 
 //==============================================================================
@@ -121,10 +158,11 @@ struct TriangleMotionBoundVisitorVisitImpl<S, ScrewMotion<S>>
 {
   static S run(
       const TriangleMotionBoundVisitor<S>& visitor,
-      const ScrewMotion<S>& motion)
+      const ScrewMotion<S>& motion,
+      S t0, S /*t1*/)
   {
-    Transform3<S> tf;
-    motion.getCurrentTransform(tf);
+    // The distances to the screw axis do not change along the motion
+    const Transform3<S> tf = motion.transformAt(t0);
 
     const Vector3<S>& axis = motion.getAxis();
     S linear_vel = motion.getLinearVelocity();
@@ -158,10 +196,11 @@ struct TriangleMotionBoundVisitorVisitImpl<S, InterpMotion<S>>
 {
   static S run(
       const TriangleMotionBoundVisitor<S>& visitor,
-      const InterpMotion<S>& motion)
+      const InterpMotion<S>& motion,
+      S t0, S /*t1*/)
   {
-    Transform3<S> tf;
-    motion.getCurrentTransform(tf);
+    // The distances to the rotation axis do not change along the motion
+    const Transform3<S> tf = motion.transformAt(t0);
 
     const Vector3<S>& reference_p = motion.getReferencePoint();
     const Vector3<S>& angular_axis = motion.getAngularAxis();
@@ -191,10 +230,10 @@ struct TriangleMotionBoundVisitorVisitImpl<S, SplineMotion<S>>
 {
   static S run(
       const TriangleMotionBoundVisitor<S>& visitor,
-      const SplineMotion<S>& motion)
+      const SplineMotion<S>& motion,
+      S t0, S t1)
   {
-    S T_bound = motion.computeTBound(visitor.n);
-    S tf_t = motion.getCurrentTime();
+    S T_bound = motion.computeTBound(visitor.n, t0, t1);
 
     S R_bound = std::abs(visitor.a.dot(visitor.n)) + visitor.a.norm() + (visitor.a.cross(visitor.n)).norm();
     S R_bound_tmp = std::abs(visitor.b.dot(visitor.n)) + visitor.b.norm() + (visitor.b.cross(visitor.n)).norm();
@@ -202,8 +241,8 @@ struct TriangleMotionBoundVisitorVisitImpl<S, SplineMotion<S>>
     R_bound_tmp = std::abs(visitor.c.dot(visitor.n)) + visitor.c.norm() + (visitor.c.cross(visitor.n)).norm();
     if(R_bound_tmp > R_bound) R_bound = R_bound_tmp;
 
-    S dWdW_max = motion.computeDWMax();
-    S ratio = std::min(1 - tf_t, dWdW_max);
+    S dWdW_max = motion.computeDWMax(t0, t1);
+    S ratio = std::min(t1 - t0, dWdW_max);
 
     R_bound *= 2 * ratio;
 
@@ -220,7 +259,8 @@ struct TriangleMotionBoundVisitorVisitImpl<S, TranslationMotion<S>>
 {
   static S run(
       const TriangleMotionBoundVisitor<S>& visitor,
-      const TranslationMotion<S>& motion)
+      const TranslationMotion<S>& motion,
+      S /*t0*/, S /*t1*/)
   {
     return motion.getVelocity().dot(visitor.n);
   }
@@ -84,6 +84,14 @@ public:
   virtual S visit(const InterpMotion<S>& motion) const;
   virtual S visit(const TranslationMotion<S>& motion) const;
 
+  /// @brief Bounds over the time interval [t0, t1] of the motion, which do
+  /// not depend on its current step
+  virtual S visit(const MotionBase<S>& motion, S t0, S t1) const { FCL_UNUSED(motion); FCL_UNUSED(t0); FCL_UNUSED(t1); return 0; }
+  virtual S visit(const SplineMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const ScrewMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const InterpMotion<S>& motion, S t0, S t1) const;
+  virtual S visit(const TranslationMotion<S>& motion, S t0, S t1) const;
+
 protected:
   template <typename, typename>
   friend struct TriangleMotionBoundVisitorVisitImpl;
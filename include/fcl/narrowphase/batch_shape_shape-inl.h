@@ -0,0 +1,532 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_BATCHSHAPESHAPE_INL_H
+#define FCL_NARROWPHASE_BATCHSHAPESHAPE_INL_H
+
+#include "fcl/narrowphase/batch_shape_shape.h"
+
+#include <algorithm>
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_capsule.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_box.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_sphere.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+struct BatchCollisionResult<double>;
+
+//==============================================================================
+extern template
+struct BatchDistanceResult<double>;
+
+//==============================================================================
+extern template
+std::size_t collideBatch(
+    const Sphere<double>* s1, const Transform3<double>* tf1,
+    const Sphere<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<double>& result);
+
+//==============================================================================
+extern template
+std::size_t collideBatch(
+    const Sphere<double>* s1, const Transform3<double>* tf1,
+    const Box<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<double>& result);
+
+//==============================================================================
+extern template
+std::size_t collideBatch(
+    const Capsule<double>* s1, const Transform3<double>* tf1,
+    const Capsule<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<double>& result);
+
+//==============================================================================
+extern template
+std::size_t distanceBatch(
+    const Sphere<double>* s1, const Transform3<double>* tf1,
+    const Sphere<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<double>& result);
+
+//==============================================================================
+extern template
+std::size_t distanceBatch(
+    const Sphere<double>* s1, const Transform3<double>* tf1,
+    const Box<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<double>& result);
+
+//==============================================================================
+extern template
+std::size_t distanceBatch(
+    const Capsule<double>* s1, const Transform3<double>* tf1,
+    const Capsule<double>* s2, const Transform3<double>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<double>& result);
+
+//==============================================================================
+template <typename S>
+void BatchCollisionResult<S>::resize(std::size_t num_pairs)
+{
+  collision.resize(num_pairs);
+  penetration_depth.resize(num_pairs);
+  for(int k = 0; k < 3; ++k)
+  {
+    normal[k].resize(num_pairs);
+    pos[k].resize(num_pairs);
+  }
+}
+
+//==============================================================================
+template <typename S>
+std::size_t BatchCollisionResult<S>::size() const
+{
+  return collision.size();
+}
+
+//==============================================================================
+template <typename S>
+bool BatchCollisionResult<S>::isCollision(std::size_t i) const
+{
+  return collision[i] != 0;
+}
+
+//==============================================================================
+template <typename S>
+ContactPoint<S> BatchCollisionResult<S>::getContact(std::size_t i) const
+{
+  return ContactPoint<S>(Vector3<S>(normal[0][i], normal[1][i], normal[2][i]),
+                         Vector3<S>(pos[0][i], pos[1][i], pos[2][i]),
+                         penetration_depth[i]);
+}
+
+//==============================================================================
+template <typename S>
+void BatchDistanceResult<S>::resize(std::size_t num_pairs)
+{
+  separated.resize(num_pairs);
+  min_distance.resize(num_pairs);
+  for(int j = 0; j < 2; ++j)
+  {
+    for(int k = 0; k < 3; ++k)
+      nearest_points[j][k].resize(num_pairs);
+  }
+}
+
+//==============================================================================
+template <typename S>
+std::size_t BatchDistanceResult<S>::size() const
+{
+  return separated.size();
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> BatchDistanceResult<S>::getNearestPoint(int k, std::size_t i) const
+{
+  return Vector3<S>(nearest_points[k][0][i],
+                    nearest_points[k][1][i],
+                    nearest_points[k][2][i]);
+}
+
+namespace detail
+{
+
+/// @brief Number of pairs gathered into stack-resident SoA buffers for each
+/// call of a batched primitive kernel.
+constexpr int kBatchBlockSize = 64;
+
+//==============================================================================
+/// @brief SoA scratch for one block of shape pairs. The kernels take each
+/// 3-vector quantity as three component arrays, which view() exposes.
+template <typename S>
+struct BatchBlock
+{
+  S r1[kBatchBlockSize];
+  S r2[kBatchBlockSize];
+  S a1[3][kBatchBlockSize];
+  S a2[3][kBatchBlockSize];
+  S b1[3][kBatchBlockSize];
+  S b2[3][kBatchBlockSize];
+  S out1[3][kBatchBlockSize];
+  S out2[3][kBatchBlockSize];
+
+  static void view(S (&v)[3][kBatchBlockSize], S* ptr[3])
+  {
+    for(int k = 0; k < 3; ++k)
+      ptr[k] = v[k];
+  }
+
+  static void view(S (&v)[3][kBatchBlockSize], const S* ptr[3])
+  {
+    for(int k = 0; k < 3; ++k)
+      ptr[k] = v[k];
+  }
+};
+
+//==============================================================================
+template <typename S>
+void batchOutputView(std::vector<S> (&v)[3], std::size_t start, S* ptr[3])
+{
+  for(int k = 0; k < 3; ++k)
+    ptr[k] = v[k].data() + start;
+}
+
+//==============================================================================
+template <typename S>
+void gatherCenter(const Transform3<S>& tf, int i, S (&c)[3][kBatchBlockSize])
+{
+  const Vector3<S>& t = tf.translation();
+  for(int k = 0; k < 3; ++k)
+    c[k][i] = t[k];
+}
+
+//==============================================================================
+template <typename S>
+void gatherCapsule(const Capsule<S>& capsule, const Transform3<S>& tf, int i,
+                   S* r, S (&c)[3][kBatchBlockSize],
+                   S (&u)[3][kBatchBlockSize])
+{
+  r[i] = capsule.radius;
+  gatherCenter(tf, i, c);
+  const Vector3<S> half_axis = tf.linear().col(2) * (capsule.lz * 0.5);
+  for(int k = 0; k < 3; ++k)
+    u[k][i] = half_axis[k];
+}
+
+//==============================================================================
+template <typename S>
+void gatherSphereInBox(const Sphere<S>& sphere, const Transform3<S>& X_FS,
+                       const Box<S>& box, const Transform3<S>& X_FB, int i,
+                       S* r, S (&p_BC)[3][kBatchBlockSize],
+                       S (&half_size)[3][kBatchBlockSize])
+{
+  r[i] = sphere.radius;
+  const Vector3<S> p =
+      X_FB.linear().transpose() * (X_FS.translation() - X_FB.translation());
+  for(int k = 0; k < 3; ++k)
+  {
+    p_BC[k][i] = p[k];
+    half_size[k][i] = box.side[k] / 2;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void scatterFromBox(const Transform3<S>& X_FB, int i, bool is_point,
+                    const S (&v_B)[3][kBatchBlockSize],
+                    std::vector<S> (&v_F)[3], std::size_t index)
+{
+  const Vector3<S> v(v_B[0][i], v_B[1][i], v_B[2][i]);
+  const Vector3<S> w = is_point ? (X_FB * v).eval() : (X_FB.linear() * v).eval();
+  for(int k = 0; k < 3; ++k)
+    v_F[k][index] = w[k];
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+std::size_t collideBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Sphere<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* c1[3];
+  const S* c2[3];
+  Block::view(block.a1, c1);
+  Block::view(block.a2, c2);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      block.r1[i] = s1[start + i].radius;
+      block.r2[i] = s2[start + i].radius;
+      detail::gatherCenter(tf1[start + i], i, block.a1);
+      detail::gatherCenter(tf2[start + i], i, block.a2);
+    }
+
+    S* normal[3];
+    S* pos[3];
+    detail::batchOutputView(result.normal, start, normal);
+    detail::batchOutputView(result.pos, start, pos);
+    detail::sphereSphereIntersectBatch(
+        n, block.r1, c1, block.r2, c2, result.collision.data() + start,
+        result.penetration_depth.data() + start, normal, pos);
+  }
+
+  return std::count(result.collision.begin(), result.collision.end(), 1);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t collideBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Box<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* p_BC[3];
+  const S* half_size[3];
+  S* n_SB_B[3];
+  S* p_BP[3];
+  Block::view(block.a1, p_BC);
+  Block::view(block.a2, half_size);
+  Block::view(block.out1, n_SB_B);
+  Block::view(block.out2, p_BP);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      detail::gatherSphereInBox(s1[start + i], tf1[start + i],
+                                s2[start + i], tf2[start + i], i,
+                                block.r1, block.a1, block.a2);
+    }
+
+    detail::sphereBoxIntersectBatch(
+        n, block.r1, p_BC, half_size, result.collision.data() + start,
+        result.penetration_depth.data() + start, n_SB_B, p_BP);
+
+    for(int i = 0; i < n; ++i)
+    {
+      detail::scatterFromBox(tf2[start + i], i, false, block.out1,
+                             result.normal, start + i);
+      detail::scatterFromBox(tf2[start + i], i, true, block.out2,
+                             result.pos, start + i);
+    }
+  }
+
+  return std::count(result.collision.begin(), result.collision.end(), 1);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t collideBatch(
+    const Capsule<S>* s1, const Transform3<S>* tf1,
+    const Capsule<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* c1[3];
+  const S* c2[3];
+  const S* u1[3];
+  const S* u2[3];
+  Block::view(block.a1, c1);
+  Block::view(block.a2, c2);
+  Block::view(block.b1, u1);
+  Block::view(block.b2, u2);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      detail::gatherCapsule(s1[start + i], tf1[start + i], i,
+                            block.r1, block.a1, block.b1);
+      detail::gatherCapsule(s2[start + i], tf2[start + i], i,
+                            block.r2, block.a2, block.b2);
+    }
+
+    S* normal[3];
+    S* pos[3];
+    detail::batchOutputView(result.normal, start, normal);
+    detail::batchOutputView(result.pos, start, pos);
+    detail::capsuleCapsuleIntersectBatch(
+        n, block.r1, c1, u1, block.r2, c2, u2,
+        result.collision.data() + start,
+        result.penetration_depth.data() + start, normal, pos);
+  }
+
+  return std::count(result.collision.begin(), result.collision.end(), 1);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t distanceBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Sphere<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* c1[3];
+  const S* c2[3];
+  Block::view(block.a1, c1);
+  Block::view(block.a2, c2);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      block.r1[i] = s1[start + i].radius;
+      block.r2[i] = s2[start + i].radius;
+      detail::gatherCenter(tf1[start + i], i, block.a1);
+      detail::gatherCenter(tf2[start + i], i, block.a2);
+    }
+
+    S* p1[3];
+    S* p2[3];
+    detail::batchOutputView(result.nearest_points[0], start, p1);
+    detail::batchOutputView(result.nearest_points[1], start, p2);
+    detail::sphereSphereDistanceBatch(
+        n, block.r1, c1, block.r2, c2, result.separated.data() + start,
+        result.min_distance.data() + start, p1, p2);
+  }
+
+  return std::count(result.separated.begin(), result.separated.end(), 1);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t distanceBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Box<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* p_BC[3];
+  const S* half_size[3];
+  S* p_BSb[3];
+  S* p_BBs[3];
+  Block::view(block.a1, p_BC);
+  Block::view(block.a2, half_size);
+  Block::view(block.out1, p_BSb);
+  Block::view(block.out2, p_BBs);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      detail::gatherSphereInBox(s1[start + i], tf1[start + i],
+                                s2[start + i], tf2[start + i], i,
+                                block.r1, block.a1, block.a2);
+    }
+
+    detail::sphereBoxDistanceBatch(
+        n, block.r1, p_BC, half_size, result.separated.data() + start,
+        result.min_distance.data() + start, p_BSb, p_BBs);
+
+    for(int i = 0; i < n; ++i)
+    {
+      detail::scatterFromBox(tf2[start + i], i, true, block.out1,
+                             result.nearest_points[0], start + i);
+      detail::scatterFromBox(tf2[start + i], i, true, block.out2,
+                             result.nearest_points[1], start + i);
+    }
+  }
+
+  return std::count(result.separated.begin(), result.separated.end(), 1);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t distanceBatch(
+    const Capsule<S>* s1, const Transform3<S>* tf1,
+    const Capsule<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result)
+{
+  using Block = detail::BatchBlock<S>;
+
+  result.resize(num_pairs);
+  Block block;
+  const S* c1[3];
+  const S* c2[3];
+  const S* u1[3];
+  const S* u2[3];
+  Block::view(block.a1, c1);
+  Block::view(block.a2, c2);
+  Block::view(block.b1, u1);
+  Block::view(block.b2, u2);
+
+  for(std::size_t start = 0; start < num_pairs;
+      start += detail::kBatchBlockSize)
+  {
+    const int n = static_cast<int>(std::min<std::size_t>(
+        detail::kBatchBlockSize, num_pairs - start));
+    for(int i = 0; i < n; ++i)
+    {
+      detail::gatherCapsule(s1[start + i], tf1[start + i], i,
+                            block.r1, block.a1, block.b1);
+      detail::gatherCapsule(s2[start + i], tf2[start + i], i,
+                            block.r2, block.a2, block.b2);
+    }
+
+    S* p1[3];
+    S* p2[3];
+    detail::batchOutputView(result.nearest_points[0], start, p1);
+    detail::batchOutputView(result.nearest_points[1], start, p2);
+    detail::capsuleCapsuleDistanceBatch(
+        n, block.r1, c1, u1, block.r2, c2, u2,
+        result.separated.data() + start,
+        result.min_distance.data() + start, p1, p2);
+  }
+
+  return std::count(result.separated.begin(), result.separated.end(), 1);
+}
+
+} // namespace fcl
+
+#endif
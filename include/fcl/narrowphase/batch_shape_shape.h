@@ -0,0 +1,175 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_BATCHSHAPESHAPE_H
+#define FCL_NARROWPHASE_BATCHSHAPESHAPE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "fcl/common/types.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/narrowphase/contact_point.h"
+
+namespace fcl
+{
+
+/// @brief Collision results of a batched shape-shape query, stored as
+/// structure-of-arrays. Entry i describes the i-th pair of the batch.
+template <typename S>
+struct FCL_EXPORT BatchCollisionResult
+{
+  /// @brief 1 if the pair is colliding (touching included), 0 otherwise
+  std::vector<unsigned char> collision;
+
+  /// @brief Penetration depth. Only meaningful for colliding pairs.
+  std::vector<S> penetration_depth;
+
+  /// @brief Contact normal components, pointing from shape 1 to shape 2. Only
+  /// meaningful for colliding pairs.
+  std::vector<S> normal[3];
+
+  /// @brief Contact position components, in world space. Only meaningful for
+  /// colliding pairs.
+  std::vector<S> pos[3];
+
+  /// @brief Resizes every array to hold num_pairs entries
+  void resize(std::size_t num_pairs);
+
+  /// @brief Number of pairs described
+  std::size_t size() const;
+
+  /// @brief Whether pair i is colliding
+  bool isCollision(std::size_t i) const;
+
+  /// @brief Contact of pair i, in the form returned by the per-pair kernels
+  ContactPoint<S> getContact(std::size_t i) const;
+};
+
+/// @brief Distance results of a batched shape-shape query, stored as
+/// structure-of-arrays. Entry i describes the i-th pair of the batch.
+template <typename S>
+struct FCL_EXPORT BatchDistanceResult
+{
+  /// @brief 1 if the pair is separated, 0 if it is penetrating or touching
+  std::vector<unsigned char> separated;
+
+  /// @brief Separating distance, or -1 for pairs that are not separated
+  std::vector<S> min_distance;
+
+  /// @brief Nearest point components on shape 1 (nearest_points[0]) and
+  /// shape 2 (nearest_points[1]), in world space. Only meaningful for
+  /// separated pairs.
+  std::vector<S> nearest_points[2][3];
+
+  /// @brief Resizes every array to hold num_pairs entries
+  void resize(std::size_t num_pairs);
+
+  /// @brief Number of pairs described
+  std::size_t size() const;
+
+  /// @brief Nearest point of pair i on shape k (0 or 1)
+  Vector3<S> getNearestPoint(int k, std::size_t i) const;
+};
+
+using BatchCollisionResultf = BatchCollisionResult<float>;
+using BatchCollisionResultd = BatchCollisionResult<double>;
+using BatchDistanceResultf = BatchDistanceResult<float>;
+using BatchDistanceResultd = BatchDistanceResult<double>;
+
+/// @brief Batched collision of num_pairs sphere pairs: pair i is s1[i] posed
+/// at tf1[i] against s2[i] posed at tf2[i]. The pairs are gathered into
+/// structure-of-arrays blocks and processed by vectorizable primitive kernels
+/// instead of being dispatched one at a time. Returns the number of colliding
+/// pairs.
+template <typename S>
+FCL_EXPORT
+std::size_t collideBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Sphere<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result);
+
+/// @brief Batched collision of num_pairs sphere-box pairs. See the sphere
+/// overload.
+template <typename S>
+FCL_EXPORT
+std::size_t collideBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Box<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result);
+
+/// @brief Batched collision of num_pairs capsule pairs. See the sphere
+/// overload.
+template <typename S>
+FCL_EXPORT
+std::size_t collideBatch(
+    const Capsule<S>* s1, const Transform3<S>* tf1,
+    const Capsule<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchCollisionResult<S>& result);
+
+/// @brief Batched distance of num_pairs sphere pairs: pair i is s1[i] posed
+/// at tf1[i] against s2[i] posed at tf2[i]. Returns the number of separated
+/// pairs.
+template <typename S>
+FCL_EXPORT
+std::size_t distanceBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Sphere<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result);
+
+/// @brief Batched distance of num_pairs sphere-box pairs. See the sphere
+/// overload.
+template <typename S>
+FCL_EXPORT
+std::size_t distanceBatch(
+    const Sphere<S>* s1, const Transform3<S>* tf1,
+    const Box<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result);
+
+/// @brief Batched distance of num_pairs capsule pairs. See the sphere
+/// overload.
+template <typename S>
+FCL_EXPORT
+std::size_t distanceBatch(
+    const Capsule<S>* s1, const Transform3<S>* tf1,
+    const Capsule<S>* s2, const Transform3<S>* tf2,
+    std::size_t num_pairs, BatchDistanceResult<S>& result);
+
+} // namespace fcl
+
+#include "fcl/narrowphase/batch_shape_shape-inl.h"
+
+#endif
@@ -43,6 +43,7 @@
 #include "fcl/narrowphase/detail/collision_func_matrix.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "fcl/narrowphase/detail/traversal/collision/shape_collision_traversal_node.h"
 
 namespace fcl
 {
@@ -56,6 +57,15 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+extern template
+FCL_EXPORT
+std::size_t collide(
+    const CollisionObject<float>* o1,
+    const CollisionObject<float>* o2,
+    const CollisionRequest<float>& request,
+    CollisionResult<float>& result);
+
 //==============================================================================
 extern template
 FCL_EXPORT
@@ -67,6 +77,17 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+extern template
+FCL_EXPORT
+std::size_t collide(
+    const CollisionGeometry<float>* o1,
+    const Transform3<float>& tf1,
+    const CollisionGeometry<float>* o2,
+    const Transform3<float>& tf2,
+    const CollisionRequest<float>& request,
+    CollisionResult<float>& result);
+
 //==============================================================================
 template<typename GJKSolver>
 detail::CollisionFunctionMatrix<GJKSolver>& getCollisionFunctionLookTable()
@@ -75,6 +96,47 @@ detail::CollisionFunctionMatrix<GJKSolver>& getCollisionFunctionLookTable()
   return table;
 }
 
+namespace detail
+{
+
+//==============================================================================
+/// @brief Statically dispatched counterpart of ShapeShapeCollide(): collides
+/// two shapes of known types with the given solver, without a traversal node.
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+std::size_t collideShapePair(
+    const Shape1& s1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename Shape1::S>& request,
+    CollisionResult<typename Shape1::S>& result)
+{
+  if(request.num_max_contacts == 0)
+    return 0;
+
+  nsolver->enableCachedGuess(true);
+  if(request.enable_cached_gjk_guess)
+    nsolver->setCachedGuess(request.cached_gjk_guess);
+  if(request.enable_solver_statistics)
+    nsolver->enableStatistics(true);
+
+  collideShapes(s1, tf1, s2, tf2, nsolver, request,
+                s1.cost_density * s2.cost_density, result);
+
+  if(request.enable_cached_gjk_guess)
+    result.cached_gjk_guess = nsolver->getCachedGuess();
+  if(request.enable_solver_statistics)
+  {
+    result.solver_statistics.update(nsolver->getStatistics());
+    nsolver->enableStatistics(false);
+  }
+
+  return result.numContacts();
+}
+
+} // namespace detail
+
 //==============================================================================
 template <typename S, typename NarrowPhaseSolver>
 FCL_EXPORT
@@ -107,6 +169,9 @@ std::size_t collide(
 
   const auto& looktable = getCollisionFunctionLookTable<NarrowPhaseSolver>();
 
+  if(request.enable_solver_statistics)
+    nsolver->enableStatistics(true);
+
   std::size_t res;
   if(request.num_max_contacts == 0)
   {
@@ -142,6 +207,12 @@ std::size_t collide(
     }
   }
 
+  if(request.enable_solver_statistics)
+  {
+    result.solver_statistics.update(nsolver->getStatistics());
+    nsolver->enableStatistics(false);
+  }
+
   if(!nsolver_)
     delete nsolver;
 
@@ -206,6 +277,40 @@ std::size_t collide(
   }
 }
 
+//==============================================================================
+template <typename Shape1, typename Shape2>
+FCL_EXPORT
+std::size_t collide(const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
+                    const Shape2& s2, const Transform3<typename Shape1::S>& tf2,
+                    const CollisionRequest<typename Shape1::S>& request,
+                    CollisionResult<typename Shape1::S>& result)
+{
+  using S = typename Shape1::S;
+  static_assert(std::is_base_of<ShapeBase<S>, Shape1>::value
+                && std::is_base_of<ShapeBase<S>, Shape2>::value,
+                "Static dispatch is only available for primitive shapes");
+
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    {
+      detail::GJKSolver_libccd<S> solver;
+      solver.collision_tolerance = request.gjk_tolerance;
+      return detail::collideShapePair(s1, tf1, s2, tf2, &solver, request, result);
+    }
+  case GST_INDEP:
+    {
+      detail::GJKSolver_indep<S> solver;
+      solver.gjk_tolerance = request.gjk_tolerance;
+      solver.epa_tolerance = request.gjk_tolerance;
+      return detail::collideShapePair(s1, tf1, s2, tf2, &solver, request, result);
+    }
+  default:
+    std::cerr << "Warning! Invalid GJK solver" << std::endl;
+    return -1; // error
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -65,6 +65,19 @@ std::size_t collide(const CollisionGeometry<S>* o1, const Transform3<S>& tf1,
                     const CollisionRequest<S>& request,
                     CollisionResult<S>& result);
 
+/// @brief Collision between two primitive shapes whose types are known at
+/// compile time. The narrowphase kernel for the pair is resolved statically,
+/// so neither the collision function matrix nor a traversal node is involved.
+/// Contacts, cost sources and the cached GJK guess are reported as by the
+/// CollisionGeometry overload. Return value is the number of contacts in the
+/// result.
+template <typename Shape1, typename Shape2>
+FCL_EXPORT
+std::size_t collide(const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
+                    const Shape2& s2, const Transform3<typename Shape1::S>& tf2,
+                    const CollisionRequest<typename Shape1::S>& request,
+                    CollisionResult<typename Shape1::S>& result);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/collision-inl.h"
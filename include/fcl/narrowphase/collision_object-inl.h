@@ -47,11 +47,15 @@ namespace fcl
 extern template
 class FCL_EXPORT CollisionObject<double>;
 
+extern template
+class FCL_EXPORT CollisionObject<float>;
+
 //==============================================================================
 template <typename S>
 CollisionObject<S>::CollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_)
-  : cgeom(cgeom_), cgeom_const(cgeom_), t(Transform3<S>::Identity())
+  : cgeom(cgeom_), cgeom_const(cgeom_), t(Transform3<S>::Identity()),
+    collision_category(1), collision_mask(~uint32(0))
 {
   if (cgeom)
   {
@@ -65,7 +69,8 @@ template <typename S>
 CollisionObject<S>::CollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_,
     const Transform3<S>& tf)
-  : cgeom(cgeom_), cgeom_const(cgeom_), t(tf)
+  : cgeom(cgeom_), cgeom_const(cgeom_), t(tf),
+    collision_category(1), collision_mask(~uint32(0))
 {
   cgeom->computeLocalAABB();
   computeAABB();
@@ -77,7 +82,8 @@ CollisionObject<S>::CollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_,
     const Matrix3<S>& R,
     const Vector3<S>& T)
-  : cgeom(cgeom_), cgeom_const(cgeom_), t(Transform3<S>::Identity())
+  : cgeom(cgeom_), cgeom_const(cgeom_), t(Transform3<S>::Identity()),
+    collision_category(1), collision_mask(~uint32(0))
 {
   t.linear() = R;
   t.translation() = T;
@@ -280,6 +286,81 @@ bool CollisionObject<S>::isUncertain() const
   return cgeom->isUncertain();
 }
 
+//==============================================================================
+template <typename S>
+uint32 CollisionObject<S>::getCollisionCategory() const
+{
+  return collision_category;
+}
+
+//==============================================================================
+template <typename S>
+void CollisionObject<S>::setCollisionCategory(uint32 category)
+{
+  collision_category = category;
+}
+
+//==============================================================================
+template <typename S>
+uint32 CollisionObject<S>::getCollisionMask() const
+{
+  return collision_mask;
+}
+
+//==============================================================================
+template <typename S>
+void CollisionObject<S>::setCollisionMask(uint32 mask)
+{
+  collision_mask = mask;
+}
+
+//==============================================================================
+template <typename S>
+bool CollisionObject<S>::canCollideWith(const CollisionObject& other) const
+{
+  return (collision_category & other.collision_mask)
+      && (other.collision_category & collision_mask);
+}
+
+//==============================================================================
+template <typename S>
+std::size_t CollisionObject<S>::getBroadPhaseHandle(const void* table) const
+{
+  for(const auto& handle : broadphase_handles)
+  {
+    if(handle.first == table)
+      return handle.second;
+  }
+
+  return -1;
+}
+
+//==============================================================================
+template <typename S>
+void CollisionObject<S>::setBroadPhaseHandle(const void* table,
+                                             std::size_t handle)
+{
+  for(auto it = broadphase_handles.begin(); it != broadphase_handles.end(); ++it)
+  {
+    if(it->first != table)
+      continue;
+
+    if(handle == std::size_t(-1))
+    {
+      *it = broadphase_handles.back();
+      broadphase_handles.pop_back();
+    }
+    else
+    {
+      it->second = handle;
+    }
+    return;
+  }
+
+  if(handle != std::size_t(-1))
+    broadphase_handles.emplace_back(table, handle);
+}
+
 } // namespace fcl
 
 #endif
@@ -39,6 +39,8 @@
 #define FCL_COLLISION_OBJECT_H
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "fcl/geometry/collision_geometry.h"
 
@@ -138,6 +140,32 @@ public:
   /// @brief whether the object is uncertain
   bool isUncertain() const;
 
+  /// @brief get the collision categories of the object, one per bit
+  uint32 getCollisionCategory() const;
+
+  /// @brief set the collision categories of the object, one per bit
+  void setCollisionCategory(uint32 category);
+
+  /// @brief get the categories the object can collide with
+  uint32 getCollisionMask() const;
+
+  /// @brief set the categories the object can collide with
+  void setCollisionMask(uint32 mask);
+
+  /// @brief whether each of the two objects belongs to a category the other
+  /// can collide with. The broadphase managers do not report the pairs for
+  /// which this is false.
+  bool canCollideWith(const CollisionObject& other) const;
+
+  /// @brief get the handle of the object in the broadphase proxy table
+  /// @p table, or -1 if the object has none there. Only meant for the
+  /// broadphase managers, which check the handle against their own table.
+  std::size_t getBroadPhaseHandle(const void* table) const;
+
+  /// @brief set the handle of the object in the broadphase proxy table
+  /// @p table; -1 removes it
+  void setBroadPhaseHandle(const void* table, std::size_t handle);
+
 protected:
 
   std::shared_ptr<CollisionGeometry<S>> cgeom;
@@ -151,6 +179,17 @@ protected:
   /// @brief pointer to user defined data specific to this object
   void *user_data;
 
+  /// @brief collision categories, the first one by default
+  uint32 collision_category;
+
+  /// @brief categories the object collides with, all of them by default
+  uint32 collision_mask;
+
+  /// @brief handles of the object in the broadphase proxy tables, keyed by
+  /// the address of the table. An object is rarely in more than a couple of
+  /// managers at once, so they are searched linearly.
+  std::vector<std::pair<const void*, std::size_t>> broadphase_handles;
+
 public:
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
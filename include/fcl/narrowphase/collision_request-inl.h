@@ -49,6 +49,10 @@ namespace fcl
 extern template
 struct CollisionRequest<double>;
 
+//==============================================================================
+extern template
+struct CollisionRequest<float>;
+
 //==============================================================================
 template <typename S>
 CollisionRequest<S>::CollisionRequest(
@@ -67,7 +71,9 @@ CollisionRequest<S>::CollisionRequest(
     gjk_solver_type(gjk_solver_type_),
     enable_cached_gjk_guess(false),
     cached_gjk_guess(Vector3<S>::UnitX()),
-    gjk_tolerance(gjk_tolerance_)
+    gjk_tolerance(gjk_tolerance_),
+    enable_solver_statistics(false),
+    security_margin(0)
 {
   // Do nothing
 }
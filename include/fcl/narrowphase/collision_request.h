@@ -93,6 +93,21 @@ struct FCL_EXPORT CollisionRequest
   /// a value that is consistent with the precision of `S`.
   Real gjk_tolerance{1e-6};
 
+  /// @brief If true, the GJK/EPA iteration counts of the narrowphase solver
+  /// are reported in CollisionResult::solver_statistics. Off by default; the
+  /// solvers do no bookkeeping then.
+  bool enable_solver_statistics;
+
+  /// @brief Objects closer than this margin are reported as colliding, as if
+  /// one of them were grown by the margin. The penetration depth of such
+  /// contacts is the margin minus the distance between the objects (the true
+  /// depth plus the margin for penetrating objects). The default is 0.
+  ///
+  /// Shape, mesh and broadphase pruning all account for the margin; set the
+  /// same value with BroadPhaseCollisionManager::setSecurityMargin() when the
+  /// request is used from a broadphase callback. OcTree queries ignore it.
+  S security_margin;
+
   /// @brief Default constructor
   CollisionRequest(size_t num_max_contacts_ = 1,
                    bool enable_contact_ = false,
@@ -47,6 +47,10 @@ namespace fcl
 extern template
 struct CollisionResult<double>;
 
+//==============================================================================
+extern template
+struct CollisionResult<float>;
+
 //==============================================================================
 template <typename S>
 CollisionResult<S>::CollisionResult()
@@ -126,6 +130,7 @@ void CollisionResult<S>::clear()
 {
   contacts.clear();
   cost_sources.clear();
+  solver_statistics.clear();
 }
 
 } // namespace fcl
@@ -43,6 +43,7 @@
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact.h"
 #include "fcl/narrowphase/cost_source.h"
+#include "fcl/narrowphase/solver_statistics.h"
 
 namespace fcl
 {
@@ -61,6 +62,11 @@ private:
 public:
   Vector3<S> cached_gjk_guess;
 
+  /// @brief GJK/EPA iteration counts accumulated over the query
+  ///
+  /// @sa CollisionRequest::enable_solver_statistics
+  SolverStatistics solver_statistics;
+
 public:
   CollisionResult();
 
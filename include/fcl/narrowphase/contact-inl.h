@@ -47,6 +47,10 @@ namespace fcl
 extern template
 struct Contact<double>;
 
+//==============================================================================
+extern template
+struct Contact<float>;
+
 //==============================================================================
 template <typename S>
 Contact<S>::Contact()
@@ -46,9 +46,12 @@
 #include "fcl/math/motion/interp_motion.h"
 #include "fcl/math/motion/screw_motion.h"
 #include "fcl/math/motion/spline_motion.h"
+#include "fcl/math/motion/aabb_motion_bound_visitor.h"
 
 #include "fcl/narrowphase/collision.h"
 #include "fcl/narrowphase/collision_result.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/detail/convexity_based_algorithm/gjk_ray_cast.h"
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 
 namespace fcl
@@ -146,11 +149,8 @@ S continuousCollideNaive(
   for(std::size_t i = 0; i < n_iter; ++i)
   {
     S t = i / (S) (n_iter - 1);
-    motion1->integrate(t);
-    motion2->integrate(t);
-
-    motion1->getCurrentTransform(cur_tf1);
-    motion2->getCurrentTransform(cur_tf2);
+    cur_tf1 = motion1->transformAt(t);
+    cur_tf2 = motion2->transformAt(t);
 
     CollisionRequest<S> c_request;
     CollisionResult<S> c_result;
@@ -213,12 +213,8 @@ typename BV::S continuousCollideBVHPolynomial(
   MeshContinuousCollisionTraversalNode<BV> node;
   CollisionRequest<S> c_request;
 
-  motion1->integrate(0);
-  motion2->integrate(0);
-  Transform3<S> tf1;
-  Transform3<S> tf2;
-  motion1->getCurrentTransform(tf1);
-  motion2->getCurrentTransform(tf2);
+  Transform3<S> tf1 = motion1->transformAt(0);
+  Transform3<S> tf2 = motion2->transformAt(0);
   if(!initialize<BV>(node, *o1, tf1, *o2, tf2, c_request))
     return -1.0;
 
@@ -229,12 +225,8 @@ typename BV::S continuousCollideBVHPolynomial(
 
   if(result.is_collide)
   {
-    motion1->integrate(node.time_of_contact);
-    motion2->integrate(node.time_of_contact);
-    motion1->getCurrentTransform(tf1);
-    motion2->getCurrentTransform(tf2);
-    result.contact_tf1 = tf1;
-    result.contact_tf2 = tf2;
+    result.contact_tf1 = motion1->transformAt(node.time_of_contact);
+    result.contact_tf2 = motion2->transformAt(node.time_of_contact);
   }
 
   return result.time_of_contact;
@@ -338,18 +330,94 @@ typename NarrowPhaseSolver::S continuousCollideConservativeAdvancement(
 
   if(result.is_collide)
   {
-    motion1->integrate(result.time_of_contact);
-    motion2->integrate(result.time_of_contact);
+    result.contact_tf1 = motion1->transformAt(result.time_of_contact);
+    result.contact_tf2 = motion2->transformAt(result.time_of_contact);
+  }
+
+  return res;
+}
 
-    Transform3<S> tf1;
+//==============================================================================
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S continuousCollideAdaptiveAdvancement(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const MotionBase<typename NarrowPhaseSolver::S>* motion1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const MotionBase<typename NarrowPhaseSolver::S>* motion2,
+    NarrowPhaseSolver* nsolver,
+    const ContinuousCollisionRequest<typename NarrowPhaseSolver::S>& request,
+    ContinuousCollisionResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  // Pairs without a distance query are sampled instead, with shapes against
+  // meshes looked up the other way around as distance() does
+  const auto& looktable = getDistanceFunctionLookTable<NarrowPhaseSolver>();
+  const NODE_TYPE node_type1 = o1->getNodeType();
+  const NODE_TYPE node_type2 = o2->getNodeType();
+  const bool swapped
+      = o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_BVH;
+  if(!(swapped ? looktable.distance_matrix[node_type2][node_type1]
+               : looktable.distance_matrix[node_type1][node_type2]))
+    return continuousCollideNaive(o1, motion1, o2, motion2, request, result);
+
+  // Shapes only compute their local AABB on demand, as CollisionObject does
+  for(const CollisionGeometry<S>* o : {o1, o2})
+  {
+    if(o->aabb_local.min_[0] > o->aabb_local.max_[0])
+      const_cast<CollisionGeometry<S>*>(o)->computeLocalAABB();
+  }
+
+  // No point of either object moves faster than its bound, so the distance
+  // between the objects shrinks by at most mu per unit of time
+  const S mu
+      = motion1->computeMotionBound(AABBMotionBoundVisitor<S>(o1->aabb_local), 0, 1)
+      + motion2->computeMotionBound(AABBMotionBoundVisitor<S>(o2->aabb_local), 0, 1);
+  if(!(mu < std::numeric_limits<S>::max()))
+    return continuousCollideNaive(o1, motion1, o2, motion2, request, result);
+
+  DistanceRequest<S> distance_request;
+  distance_request.gjk_solver_type = request.gjk_solver_type;
+  DistanceResult<S> distance_result;
+
+  Transform3<S> tf1;
   Transform3<S> tf2;
-    motion1->getCurrentTransform(tf1);
-    motion2->getCurrentTransform(tf2);
-    result.contact_tf1 = tf1;
-    result.contact_tf2 = tf2;
+  S t = 0;
+  while(true)
+  {
+    tf1 = motion1->transformAt(t);
+    tf2 = motion2->transformAt(t);
+
+    // Distances the objects cannot close before the end of the motion need
+    // not be computed exactly
+    distance_request.distance_upper_bound = mu * (1 - t);
+    nsolver->distance_upper_bound = distance_request.distance_upper_bound;
+    distance_result.clear();
+    const S d = fcl::distance(
+        o1, tf1, o2, tf2, nsolver, distance_request, distance_result);
+    if(d <= 0)
+      break;
+
+    const S dt = d / mu;
+    if(t + dt > 1)
+    {
+      result.is_collide = false;
+      result.time_of_contact = S(1);
+      return result.time_of_contact;
+    }
+
+    // Closer in time to a contact than the tolerance
+    if(dt < request.toc_err)
+      break;
+
+    t += dt;
   }
 
-  return res;
+  result.is_collide = true;
+  result.time_of_contact = t;
+  result.contact_tf1 = tf1;
+  result.contact_tf2 = tf2;
+  return t;
 }
 
 } // namespace detail
@@ -381,6 +449,86 @@ S continuousCollideConservativeAdvancement(
   }
 }
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+S continuousCollideAdaptiveAdvancement(
+    const CollisionGeometry<S>* o1,
+    const MotionBase<S>* motion1,
+    const CollisionGeometry<S>* o2,
+    const MotionBase<S>* motion2,
+    const ContinuousCollisionRequest<S>& request,
+    ContinuousCollisionResult<S>& result)
+{
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    {
+      detail::GJKSolver_libccd<S> solver;
+      return detail::continuousCollideAdaptiveAdvancement(o1, motion1, o2, motion2, &solver, request, result);
+    }
+  case GST_INDEP:
+    {
+      detail::GJKSolver_indep<S> solver;
+      return detail::continuousCollideAdaptiveAdvancement(o1, motion1, o2, motion2, &solver, request, result);
+    }
+  default:
+    return -1;
+  }
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+S continuousCollideRayShooting(
+    const CollisionGeometry<S>* o1,
+    const TranslationMotion<S>* motion1,
+    const CollisionGeometry<S>* o2,
+    const TranslationMotion<S>* motion2,
+    const ContinuousCollisionRequest<S>& request,
+    ContinuousCollisionResult<S>& result)
+{
+  // The Minkowski difference of unbounded shapes has no support function
+  const NODE_TYPE node_type1 = o1->getNodeType();
+  const NODE_TYPE node_type2 = o2->getNodeType();
+  if(node_type1 == GEOM_PLANE || node_type1 == GEOM_HALFSPACE
+     || node_type2 == GEOM_PLANE || node_type2 == GEOM_HALFSPACE)
+    return continuousCollideConservativeAdvancement(o1, motion1, o2, motion2, request, result);
+
+  const Transform3<S> tf1 = motion1->transformAt(0);
+  const Transform3<S> tf2 = motion2->transformAt(0);
+
+  detail::MinkowskiDiff<S> shape;
+  shape.shapes[0] = static_cast<const ShapeBase<S>*>(o1);
+  shape.shapes[1] = static_cast<const ShapeBase<S>*>(o2);
+  shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
+  shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
+
+  // The translation of o2 relative to o1, in the frame of o1
+  const Vector3<S> r = tf1.linear().transpose()
+      * (motion2->getVelocity() - motion1->getVelocity());
+
+  detail::GJKSolver_indep<S> solver;
+  S time_of_contact;
+  Vector3<S> normal;
+  result.is_collide = detail::gjkRayCast(
+      shape, r, solver.gjk_max_iterations, constants<S>::eps_12(),
+      time_of_contact, normal);
+
+  if(!result.is_collide)
+  {
+    result.time_of_contact = S(1);
+    return result.time_of_contact;
+  }
+
+  result.time_of_contact = time_of_contact;
+  result.contact_normal = tf1.linear() * normal;
+  result.contact_tf1 = motion1->transformAt(time_of_contact);
+  result.contact_tf2 = motion2->transformAt(time_of_contact);
+
+  return result.time_of_contact;
+}
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
@@ -409,7 +557,9 @@ S continuousCollide(
   case CCDC_RAY_SHOOTING:
     if(o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_GEOM && request.ccd_motion_type == CCDM_TRANS)
     {
-
+      return continuousCollideRayShooting(o1, (const TranslationMotion<S>*)motion1,
+                                          o2, (const TranslationMotion<S>*)motion2,
+                                          request, result);
     }
     else
       std::cerr << "Warning! Invalid continuous collision setting" << std::endl;
@@ -424,6 +574,12 @@ S continuousCollide(
     else
       std::cerr << "Warning! Invalid continuous collision checking" << std::endl;
     break;
+  case CCDC_ADAPTIVE_ADVANCEMENT:
+    return continuousCollideAdaptiveAdvancement(o1, motion1,
+                                                o2, motion2,
+                                                request,
+                                                result);
+    break;
   default:
     std::cerr << "Warning! Invalid continuous collision setting" << std::endl;
   }
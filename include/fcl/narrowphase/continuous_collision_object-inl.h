@@ -53,7 +53,8 @@ ContinuousCollisionObject<S>::ContinuousCollisionObject(
     const std::shared_ptr<CollisionGeometry<S>>& cgeom_)
   : cgeom(cgeom_), cgeom_const(cgeom_)
 {
-  // Do nothing
+  if (cgeom)
+    cgeom->computeLocalAABB();
 }
 
 //==============================================================================
@@ -63,7 +64,8 @@ ContinuousCollisionObject<S>::ContinuousCollisionObject(
     const std::shared_ptr<MotionBase<S>>& motion_)
   : cgeom(cgeom_), cgeom_const(cgeom), motion(motion_)
 {
-  // Do nothing
+  cgeom->computeLocalAABB();
+  computeAABB();
 }
 
 //==============================================================================
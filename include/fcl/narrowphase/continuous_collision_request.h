@@ -46,7 +46,11 @@ namespace fcl
 {
 
 enum CCDMotionType {CCDM_TRANS, CCDM_LINEAR, CCDM_SCREW, CCDM_SPLINE};
-enum CCDSolverType {CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT, CCDC_RAY_SHOOTING, CCDC_POLYNOMIAL_SOLVER};
+/// @brief CCDC_ADAPTIVE_ADVANCEMENT advances in time by the distance between
+/// the objects over a bound of their relative speed, for every pair with a
+/// distance query. It never steps past a contact, and stops within toc_err
+/// of it. num_max_iterations only applies to CCDC_NAIVE.
+enum CCDSolverType {CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT, CCDC_RAY_SHOOTING, CCDC_POLYNOMIAL_SOLVER, CCDC_ADAPTIVE_ADVANCEMENT};
 
 template <typename S>
 struct FCL_EXPORT ContinuousCollisionRequest
@@ -56,6 +56,10 @@ struct FCL_EXPORT ContinuousCollisionResult
   Transform3<S> contact_tf1;
 
   Transform3<S> contact_tf2;
+
+  /// @brief contact normal at the time of contact, pointing from o1 to o2.
+  /// Only computed by the ray shooting solver, zero otherwise
+  Vector3<S> contact_normal;
   
   ContinuousCollisionResult();
 
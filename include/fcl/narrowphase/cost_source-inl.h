@@ -47,6 +47,10 @@ namespace fcl
 extern template
 struct CostSource<double>;
 
+//==============================================================================
+extern template
+struct CostSource<float>;
+
 //==============================================================================
 template <typename S>
 CostSource<S>::CostSource(
@@ -40,6 +40,7 @@
 
 #include "fcl/narrowphase/detail/conservative_advancement_func_matrix.h"
 
+#include "fcl/config.h"
 #include "fcl/common/unused.h"
 
 #include "fcl/narrowphase/collision_object.h"
@@ -64,6 +65,13 @@
 #include "fcl/narrowphase/detail/traversal/distance/mesh_shape_conservative_advancement_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/distance/shape_mesh_conservative_advancement_traversal_node.h"
 
+#if FCL_HAVE_OCTOMAP
+
+#include "fcl/math/motion/aabb_motion_bound_visitor.h"
+#include "fcl/narrowphase/detail/distance_func_matrix.h"
+
+#endif // FCL_HAVE_OCTOMAP
+
 namespace fcl
 {
 
@@ -776,6 +784,136 @@ typename BV::S BVHShapeConservativeAdvancement(const CollisionGeometry<typename
   return toc;
 }
 
+#if FCL_HAVE_OCTOMAP
+//==============================================================================
+/// @brief Conservative advancement driven by a distance query. No point of
+/// either object moves faster than the motion bound of its local AABB over the
+/// rest of the motion, so the objects cannot touch before the distance between
+/// them divided by the sum of the bounds.
+template<typename NarrowPhaseSolver>
+bool conservativeAdvancementOcTree(const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+                                   const MotionBase<typename NarrowPhaseSolver::S>* motion1,
+                                   const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+                                   const MotionBase<typename NarrowPhaseSolver::S>* motion2,
+                                   const NarrowPhaseSolver* nsolver,
+                                   typename DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunc distance_func,
+                                   const ContinuousCollisionRequest<typename NarrowPhaseSolver::S>& request,
+                                   typename NarrowPhaseSolver::S& toc)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  // Shapes only compute their local AABB on demand, as CollisionObject does
+  for(const CollisionGeometry<S>* o : {o1, o2})
+  {
+    if(o->aabb_local.min_[0] > o->aabb_local.max_[0])
+      const_cast<CollisionGeometry<S>*>(o)->computeLocalAABB();
+  }
+
+  const AABBMotionBoundVisitor<S> visitor1(o1->aabb_local);
+  const AABBMotionBoundVisitor<S> visitor2(o2->aabb_local);
+
+  DistanceRequest<S> d_request;
+  DistanceResult<S> d_result;
+
+  toc = 0;
+  while(true)
+  {
+    const Transform3<S> tf1 = motion1->transformAt(toc);
+    const Transform3<S> tf2 = motion2->transformAt(toc);
+
+    d_result.clear();
+    const S d = distance_func(o1, tf1, o2, tf2, nsolver, d_request, d_result);
+    if(d <= 0)
+      return true;
+
+    // Only the rest of the motion is bounded, which tightens as toc advances
+    const S mu = motion1->computeMotionBound(visitor1, toc, 1)
+        + motion2->computeMotionBound(visitor2, toc, 1);
+    if(mu <= 0 || toc + d / mu > 1)
+    {
+      toc = 1;
+      return false;
+    }
+
+    const S delta_t = d / mu;
+    if(delta_t <= request.toc_err)
+      return true;
+
+    toc += delta_t;
+  }
+}
+
+template<typename Shape, typename NarrowPhaseSolver>
+typename Shape::S OcTreeShapeConservativeAdvancement(const CollisionGeometry<typename Shape::S>* o1, const MotionBase<typename Shape::S>* motion1, const CollisionGeometry<typename Shape::S>* o2, const MotionBase<typename Shape::S>* motion2, const NarrowPhaseSolver* nsolver, const ContinuousCollisionRequest<typename Shape::S>& request, ContinuousCollisionResult<typename Shape::S>& result)
+{
+  using S = typename Shape::S;
+
+  S toc;
+  bool is_collide = conservativeAdvancementOcTree(o1, motion1, o2, motion2, nsolver, &OcTreeShapeDistance<Shape, NarrowPhaseSolver>, request, toc);
+
+  result.is_collide = is_collide;
+  result.time_of_contact = toc;
+
+  return toc;
+}
+
+template<typename Shape, typename NarrowPhaseSolver>
+typename Shape::S ShapeOcTreeConservativeAdvancement(const CollisionGeometry<typename Shape::S>* o1, const MotionBase<typename Shape::S>* motion1, const CollisionGeometry<typename Shape::S>* o2, const MotionBase<typename Shape::S>* motion2, const NarrowPhaseSolver* nsolver, const ContinuousCollisionRequest<typename Shape::S>& request, ContinuousCollisionResult<typename Shape::S>& result)
+{
+  using S = typename Shape::S;
+
+  S toc;
+  bool is_collide = conservativeAdvancementOcTree(o1, motion1, o2, motion2, nsolver, &ShapeOcTreeDistance<Shape, NarrowPhaseSolver>, request, toc);
+
+  result.is_collide = is_collide;
+  result.time_of_contact = toc;
+
+  return toc;
+}
+
+template<typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S OcTreeConservativeAdvancement(const CollisionGeometry<typename NarrowPhaseSolver::S>* o1, const MotionBase<typename NarrowPhaseSolver::S>* motion1, const CollisionGeometry<typename NarrowPhaseSolver::S>* o2, const MotionBase<typename NarrowPhaseSolver::S>* motion2, const NarrowPhaseSolver* nsolver, const ContinuousCollisionRequest<typename NarrowPhaseSolver::S>& request, ContinuousCollisionResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  S toc;
+  bool is_collide = conservativeAdvancementOcTree(o1, motion1, o2, motion2, nsolver, &OcTreeDistance<NarrowPhaseSolver>, request, toc);
+
+  result.is_collide = is_collide;
+  result.time_of_contact = toc;
+
+  return toc;
+}
+
+template<typename BV, typename NarrowPhaseSolver>
+typename BV::S OcTreeBVHConservativeAdvancement(const CollisionGeometry<typename BV::S>* o1, const MotionBase<typename BV::S>* motion1, const CollisionGeometry<typename BV::S>* o2, const MotionBase<typename BV::S>* motion2, const NarrowPhaseSolver* nsolver, const ContinuousCollisionRequest<typename BV::S>& request, ContinuousCollisionResult<typename BV::S>& result)
+{
+  using S = typename BV::S;
+
+  S toc;
+  bool is_collide = conservativeAdvancementOcTree(o1, motion1, o2, motion2, nsolver, &OcTreeBVHDistance<BV, NarrowPhaseSolver>, request, toc);
+
+  result.is_collide = is_collide;
+  result.time_of_contact = toc;
+
+  return toc;
+}
+
+template<typename BV, typename NarrowPhaseSolver>
+typename BV::S BVHOcTreeConservativeAdvancement(const CollisionGeometry<typename BV::S>* o1, const MotionBase<typename BV::S>* motion1, const CollisionGeometry<typename BV::S>* o2, const MotionBase<typename BV::S>* motion2, const NarrowPhaseSolver* nsolver, const ContinuousCollisionRequest<typename BV::S>& request, ContinuousCollisionResult<typename BV::S>& result)
+{
+  using S = typename BV::S;
+
+  S toc;
+  bool is_collide = conservativeAdvancementOcTree(o1, motion1, o2, motion2, nsolver, &BVHOcTreeDistance<BV, NarrowPhaseSolver>, request, toc);
+
+  result.is_collide = is_collide;
+  result.time_of_contact = toc;
+
+  return toc;
+}
+#endif // FCL_HAVE_OCTOMAP
+
 template<typename NarrowPhaseSolver>
 ConservativeAdvancementFunctionMatrix<NarrowPhaseSolver>::ConservativeAdvancementFunctionMatrix()
 {
@@ -1014,6 +1152,46 @@ ConservativeAdvancementFunctionMatrix<NarrowPhaseSolver>::ConservativeAdvancemen
   conservative_advancement_matrix[BV_KDOP24][BV_KDOP24] = &BVHConservativeAdvancement<KDOP<S, 24>, NarrowPhaseSolver>;
   conservative_advancement_matrix[BV_kIOS][BV_kIOS] = &BVHConservativeAdvancement<kIOS<S>, NarrowPhaseSolver>;
 
+#if FCL_HAVE_OCTOMAP
+  // Planes and halfspaces are left out: their unbounded AABBs admit no motion
+  // bound to advance by
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_BOX] = &OcTreeShapeConservativeAdvancement<Box<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_SPHERE] = &OcTreeShapeConservativeAdvancement<Sphere<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_ELLIPSOID] = &OcTreeShapeConservativeAdvancement<Ellipsoid<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_CAPSULE] = &OcTreeShapeConservativeAdvancement<Capsule<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_CONE] = &OcTreeShapeConservativeAdvancement<Cone<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_CYLINDER] = &OcTreeShapeConservativeAdvancement<Cylinder<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_CONVEX] = &OcTreeShapeConservativeAdvancement<Convex<S>, NarrowPhaseSolver>;
+
+  conservative_advancement_matrix[GEOM_BOX][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Box<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_SPHERE][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Sphere<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_ELLIPSOID][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Ellipsoid<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_CAPSULE][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Capsule<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_CONE][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Cone<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_CYLINDER][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Cylinder<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_CONVEX][GEOM_OCTREE] = &ShapeOcTreeConservativeAdvancement<Convex<S>, NarrowPhaseSolver>;
+
+  conservative_advancement_matrix[GEOM_OCTREE][GEOM_OCTREE] = &OcTreeConservativeAdvancement<NarrowPhaseSolver>;
+
+  conservative_advancement_matrix[GEOM_OCTREE][BV_AABB] = &OcTreeBVHConservativeAdvancement<AABB<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_OBB] = &OcTreeBVHConservativeAdvancement<OBB<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_RSS] = &OcTreeBVHConservativeAdvancement<RSS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_OBBRSS] = &OcTreeBVHConservativeAdvancement<OBBRSS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_kIOS] = &OcTreeBVHConservativeAdvancement<kIOS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_KDOP16] = &OcTreeBVHConservativeAdvancement<KDOP<S, 16>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_KDOP18] = &OcTreeBVHConservativeAdvancement<KDOP<S, 18>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[GEOM_OCTREE][BV_KDOP24] = &OcTreeBVHConservativeAdvancement<KDOP<S, 24>, NarrowPhaseSolver>;
+
+  conservative_advancement_matrix[BV_AABB][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<AABB<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_OBB][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<OBB<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_RSS][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<RSS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_OBBRSS][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<OBBRSS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_kIOS][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<kIOS<S>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_KDOP16][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<KDOP<S, 16>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_KDOP18][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<KDOP<S, 18>, NarrowPhaseSolver>;
+  conservative_advancement_matrix[BV_KDOP24][GEOM_OCTREE] = &BVHOcTreeConservativeAdvancement<KDOP<S, 24>, NarrowPhaseSolver>;
+#endif // FCL_HAVE_OCTOMAP
+
 }
 
 } // namespace detail
@@ -116,6 +116,7 @@ void EPA<S>::initialize()
   sv_store = new SimplexV[max_vertex_num];
   fc_store = new SimplexF[max_face_num];
   status = Failed;
+  iterations = 0;
   normal = Vector3<S>(0, 0, 0);
   depth = 0;
   nextsv = 0;
@@ -225,6 +226,7 @@ template <typename S>
 typename EPA<S>::Status EPA<S>::evaluate(GJK<S>& gjk, const Vector3<S>& guess)
 {
   typename GJK<S>::Simplex& simplex = *gjk.getSimplex();
+  iterations = 0;
   if((simplex.rank > 1) && gjk.encloseOrigin())
   {
     while(hull.root)
@@ -258,7 +260,6 @@ typename EPA<S>::Status EPA<S>::evaluate(GJK<S>& gjk, const Vector3<S>& guess)
       SimplexF* best = findBest(); // find the best face (the face with the minimum distance to origin) to split
       SimplexF outer = *best;
       size_t pass = 0;
-      size_t iterations = 0;
 
       // set the face connectivity
       bind(tetrahedron[0], 0, tetrahedron[1], 0);
@@ -103,6 +103,10 @@ public:
   enum Status {Valid, Touching, Degenerated, NonConvex, InvalidHull, OutOfFaces, OutOfVertices, AccuracyReached, FallBack, Failed};
   
   Status status;
+
+  /// @brief number of iterations used by the last evaluate()
+  unsigned int iterations;
+
   typename GJK<S>::Simplex result;
   Vector3<S> normal;
   S depth;
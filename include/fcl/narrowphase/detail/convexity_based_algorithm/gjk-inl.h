@@ -40,6 +40,8 @@
 
 #include "fcl/narrowphase/detail/convexity_based_algorithm/gjk.h"
 
+#include <limits>
+
 namespace fcl
 {
 
@@ -53,7 +55,11 @@ struct GJK<double>;
 //==============================================================================
 template <typename S>
 GJK<S>::GJK(unsigned int max_iterations_, S tolerance_)
-  : max_iterations(max_iterations_), tolerance(tolerance_)
+  : distance_upper_bound(std::numeric_limits<S>::max()),
+    iterations(0),
+    upper_bound_reached(false),
+    max_iterations(max_iterations_),
+    tolerance(tolerance_)
 {
   initialize();
 }
@@ -81,7 +87,8 @@ Vector3<S> GJK<S>::getGuessFromSimplex() const
 template <typename S>
 typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const Vector3<S>& guess)
 {
-  size_t iterations = 0;
+  iterations = 0;
+  upper_bound_reached = false;
   S alpha = 0;
   Vector3<S> lastw[4];
   size_t clastw = 0;
@@ -150,6 +157,14 @@ typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const V
       break;
     }
 
+    // alpha is a lower bound of the distance
+    if(alpha > distance_upper_bound)
+    {
+      upper_bound_reached = true;
+      removeVertex(simplices[current]);
+      break;
+    }
+
     typename Project<S>::ProjectResult project_res;
     switch(curr_simplex.rank)
     {
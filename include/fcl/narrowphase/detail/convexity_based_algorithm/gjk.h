@@ -78,6 +78,18 @@ struct FCL_EXPORT GJK
   S distance;
   Simplex simplices[2];
 
+  /// @brief Once the separation is known to exceed this bound, evaluate()
+  /// stops and reports the current, over-estimated, distance. Defaults to
+  /// infinity.
+  S distance_upper_bound;
+
+  /// @brief number of iterations used by the last evaluate()
+  unsigned int iterations;
+
+  /// @brief whether the last evaluate() stopped because of
+  /// distance_upper_bound
+  bool upper_bound_reached;
+
   GJK(unsigned int max_iterations_, S tolerance_);
   
   void initialize();
@@ -119,7 +119,9 @@ bool GJKDistance(
     double tolerance,
     double* dist,
     Vector3d* p1,
-    Vector3d* p2);
+    Vector3d* p2,
+    double upper_bound,
+    SolverStatistics* stats);
 
 extern template
 bool GJKSignedDistance(
@@ -131,7 +133,9 @@ bool GJKSignedDistance(
     double tolerance,
     double* dist,
     Vector3d* p1,
-    Vector3d* p2);
+    Vector3d* p2,
+    double upper_bound,
+    SolverStatistics* stats);
 
 struct ccd_obj_t
 {
@@ -173,6 +177,10 @@ template <typename S>
 struct ccd_convex_t : public ccd_obj_t
 {
   const Convex<S>* convex;
+
+  /// @brief the index of the last support vertex; warm starts the next
+  /// support query
+  mutable int support_hint;
 };
 
 struct ccd_triangle_t : public ccd_obj_t
@@ -1342,8 +1350,11 @@ static int nextSupport(const ccd_pt_t* polytope, const void* obj1,
 }
 
 
+// @param num_iterations If not null, the number of iterations run is added
+// to it.
 static int __ccdGJK(const void *obj1, const void *obj2,
-                    const ccd_t *ccd, ccd_simplex_t *simplex)
+                    const ccd_t *ccd, ccd_simplex_t *simplex,
+                    unsigned long* num_iterations = nullptr)
 {
   unsigned long iterations;
   ccd_vec3_t dir; // direction vector
@@ -1365,7 +1376,11 @@ static int __ccdGJK(const void *obj1, const void *obj2,
   ccdVec3Scale(&dir, -CCD_ONE);
 
   // start iterations
+  int ret = -1;
   for (iterations = 0UL; iterations < ccd->max_iterations; ++iterations) {
+    if (num_iterations)
+      ++(*num_iterations);
+
     // obtain support point
     __ccdSupport(obj1, obj2, &dir, ccd, &last);
 
@@ -1373,7 +1388,7 @@ static int __ccdGJK(const void *obj1, const void *obj2,
     // isn't somewhere before origin (the test on negative dot product)
     // - because if it is, objects are not intersecting at all.
     if (ccdVec3Dot(&last.v, &dir) < CCD_ZERO){
-      return -1; // intersection not found
+      break; // intersection not found
     }
 
     // add last support vector to simplex
@@ -1383,25 +1398,27 @@ static int __ccdGJK(const void *obj1, const void *obj2,
     // intersect and 0 if algorithm should continue
     do_simplex_res = doSimplex(simplex, &dir);
     if (do_simplex_res == 1){
-      return 0; // intersection found
+      ret = 0; // intersection found
+      break;
     }else if (do_simplex_res == -1){
-      return -1; // intersection not found
+      break; // intersection not found
     }
 
     if (ccdIsZero(ccdVec3Len2(&dir))){
-      return -1; // intersection not found
+      break; // intersection not found
     }
   }
 
-  // intersection wasn't found
-  return -1;
+  return ret;
 }
 
 
+// @param stats If not null, the run is recorded in it.
 static int __ccdEPA(const void *obj1, const void *obj2,
                     const ccd_t *ccd,
                     ccd_simplex_t* simplex,
-                    ccd_pt_t *polytope, ccd_pt_el_t **nearest)
+                    ccd_pt_t *polytope, ccd_pt_el_t **nearest,
+                    SolverStatistics* stats = nullptr)
 {
     ccd_support_t supp; // support point
     int ret, size;
@@ -1423,12 +1440,17 @@ static int __ccdEPA(const void *obj1, const void *obj2,
 
     if (ret == -1){
         // touching contact
+        if (stats)
+          stats->addEPARun(0, false, SolverStatistics::EPA_TOUCHING);
         return 0;
     }else if (ret == -2){
         // failed memory allocation
+        if (stats)
+          stats->addEPARun(0, false, SolverStatistics::EPA_FAILED);
         return -2;
     }
 
+    unsigned int iterations = 0;
     while (1){
         // get triangle nearest to origin
         *nearest = ccdPtNearest(polytope);
@@ -1438,10 +1460,16 @@ static int __ccdEPA(const void *obj1, const void *obj2,
             break;
 
         // expand nearest triangle using new point - supp
-        if (expandPolytope(polytope, *nearest, &supp) != 0)
+        ++iterations;
+        if (expandPolytope(polytope, *nearest, &supp) != 0) {
+            if (stats)
+              stats->addEPARun(iterations, false, SolverStatistics::EPA_FAILED);
             return -2;
+        }
     }
 
+    if (stats)
+      stats->addEPARun(iterations, false, SolverStatistics::EPA_VALID);
     return 0;
 }
 
@@ -1675,17 +1703,30 @@ static void extractClosestPoints(ccd_simplex_t *simplex, ccd_vec3_t *p1,
 // obj1 closest to obj2 (expressed in the world frame).
 // @param p2 If the objects are non-penetrating, the point on the surface of
 // obj2 closest to obj1 (expressed in the world frame).
+// @param upper_bound The iterations stop once the distance is known to exceed
+// this bound; the returned distance is then larger than the bound but not
+// necessarily the minimum one.
+// @param num_iterations If not null, the number of iterations run is added
+// to it.
+// @param upper_bound_reached If not null, set to whether the iterations were
+// stopped by @p upper_bound.
 // @returns The minimum distance between the two objects. If they are
 // penetrating, -1 is returned.
 static inline ccd_real_t _ccdDist(const void *obj1, const void *obj2,
                                   const ccd_t *ccd,
                                   ccd_simplex_t* simplex,
-                                  ccd_vec3_t* p1, ccd_vec3_t* p2)
+                                  ccd_vec3_t* p1, ccd_vec3_t* p2,
+                                  ccd_real_t upper_bound = CCD_REAL_MAX,
+                                  unsigned long* num_iterations = nullptr,
+                                  bool* upper_bound_reached = nullptr)
 {
   ccd_real_t last_dist = CCD_REAL_MAX;
 
   for (unsigned long iterations = 0UL; iterations < ccd->max_iterations;
        ++iterations) {
+    if (num_iterations)
+      ++(*num_iterations);
+
     ccd_vec3_t closest_p; // The point on the simplex that is closest to the
                           // origin.
     ccd_real_t dist;
@@ -1742,6 +1783,16 @@ static inline ccd_real_t _ccdDist(const void *obj1, const void *obj2,
     // record last distance
     last_dist = dist;
 
+    // the support point bounds the Minkowski difference by a plane normal to
+    // dir, whose distance to the origin is a lower bound of the distance
+    if (-ccdVec3Dot(&last.v, &dir) > upper_bound)
+    {
+      if (upper_bound_reached)
+        *upper_bound_reached = true;
+      extractClosestPoints(simplex, p1, p2, &closest_p);
+      return last_dist;
+    }
+
     // check whether we improved for at least a minimum tolerance
     // this is here probably only for a degenerate cases when we got a
     // point that is already in the simplex
@@ -1828,18 +1879,35 @@ static int penEPAPosClosest(const ccd_pt_el_t* nearest, ccd_vec3_t* p1,
   }
 }
 
-static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, const ccd_t* ccd, ccd_vec3_t* p1, ccd_vec3_t* p2)
+// Records one GJK run of a distance query in `stats`.
+static inline void recordGJKDistRun(SolverStatistics* stats,
+                                    unsigned long iterations,
+                                    ccd_real_t dist,
+                                    bool upper_bound_reached)
+{
+  if (!stats)
+    return;
+  // _ccdDist only fails by running out of iterations
+  stats->addGJKRun(static_cast<unsigned int>(iterations), dist < CCD_ZERO,
+                   upper_bound_reached);
+}
+
+static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, const ccd_t* ccd, ccd_vec3_t* p1, ccd_vec3_t* p2, ccd_real_t upper_bound = CCD_REAL_MAX, SolverStatistics* stats = nullptr)
 {
   ccd_simplex_t simplex;
+  unsigned long iterations = 0UL;
 
-  if (__ccdGJK(obj1, obj2, ccd, &simplex) == 0) // in collision, then using the EPA
+  if (__ccdGJK(obj1, obj2, ccd, &simplex, &iterations) == 0) // in collision, then using the EPA
   {
+    if (stats)
+      stats->addGJKRun(static_cast<unsigned int>(iterations), false);
+
     ccd_pt_t polytope;
     ccd_pt_el_t *nearest;
     ccd_real_t depth;
 
     ccdPtInit(&polytope);
-    int ret = __ccdEPA(obj1, obj2, ccd, &simplex, &polytope, &nearest);
+    int ret = __ccdEPA(obj1, obj2, ccd, &simplex, &polytope, &nearest, stats);
     if (ret == 0 && nearest)
     {
       depth = -CCD_SQRT(nearest->dist);
@@ -1870,7 +1938,11 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, co
   }
   else // not in collision
   {
-    return _ccdDist(obj1, obj2, ccd, &simplex, p1, p2);
+    bool upper_bound_reached = false;
+    ccd_real_t dist = _ccdDist(obj1, obj2, ccd, &simplex, p1, p2, upper_bound,
+                               &iterations, &upper_bound_reached);
+    recordGJKDistRun(stats, iterations, dist, upper_bound_reached);
+    return dist;
   }
 }
 
@@ -1889,14 +1961,23 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, co
 // penetrating, -1 is returned.
 // @note Unlike _ccdDist function, this function does not need a warm-started
 // simplex as the input argument.
-static inline ccd_real_t ccdGJKDist2(const void *obj1, const void *obj2, const ccd_t *ccd, ccd_vec3_t* p1, ccd_vec3_t* p2)
+static inline ccd_real_t ccdGJKDist2(const void *obj1, const void *obj2, const ccd_t *ccd, ccd_vec3_t* p1, ccd_vec3_t* p2, ccd_real_t upper_bound = CCD_REAL_MAX, SolverStatistics* stats = nullptr)
 {
   ccd_simplex_t simplex;
+  unsigned long iterations = 0UL;
   // first find an intersection
-  if (__ccdGJK(obj1, obj2, ccd, &simplex) == 0)
+  if (__ccdGJK(obj1, obj2, ccd, &simplex, &iterations) == 0)
+  {
+    if (stats)
+      stats->addGJKRun(static_cast<unsigned int>(iterations), false);
     return -CCD_ONE;
+  }
 
-  return _ccdDist(obj1, obj2, ccd, &simplex, p1, p2);
+  bool upper_bound_reached = false;
+  ccd_real_t dist = _ccdDist(obj1, obj2, ccd, &simplex, p1, p2, upper_bound,
+                             &iterations, &upper_bound_reached);
+  recordGJKDistRun(stats, iterations, dist, upper_bound_reached);
+  return dist;
 }
 
 } // namespace libccd_extension
@@ -1968,6 +2049,7 @@ static void convexToGJK(const Convex<S>& s, const Transform3<S>& tf, ccd_convex_
 {
   shapeToGJK(s, tf, conv);
   conv->convex = &s;
+  conv->support_hint = 0;
 }
 
 /** Support functions */
@@ -2114,28 +2196,15 @@ template <typename S>
 static void supportConvex(const void* obj, const ccd_vec3_t* dir_, ccd_vec3_t* v)
 {
   const auto* c = (const ccd_convex_t<S>*)obj;
-  ccd_vec3_t dir, p;
-  ccd_real_t maxdot, dot;
-  int i;
-  Vector3<S>* curp;
-  const auto& center = c->convex->interior_point;
+  ccd_vec3_t dir;
 
   ccdVec3Copy(&dir, dir_);
   ccdQuatRotVec(&dir, &c->rot_inv);
 
-  maxdot = -CCD_REAL_MAX;
-  curp = c->convex->vertices;
-
-  for(i = 0; i < c->convex->num_vertices; ++i, curp += 1)
-  {
-    ccdVec3Set(&p, (*curp)[0] - center[0], (*curp)[1] - center[1], (*curp)[2] - center[2]);
-    dot = ccdVec3Dot(&dir, &p);
-    if(dot > maxdot)
-    {
-      ccdVec3Set(v, (*curp)[0], (*curp)[1], (*curp)[2]);
-      maxdot = dot;
-    }
-  }
+  const Vector3<S> dir_C(ccdVec3X(&dir), ccdVec3Y(&dir), ccdVec3Z(&dir));
+  c->support_hint = c->convex->findExtremeVertexIndex(dir_C, c->support_hint);
+  const Vector3<S>& p = c->convex->vertices[c->support_hint];
+  ccdVec3Set(v, p[0], p[1], p[2]);
 
   // transform support vertex
   ccdQuatRotVec(v, &c->rot);
@@ -2240,7 +2309,8 @@ bool GJKCollide(void* obj1, ccd_support_fn supp1, ccd_center_fn cen1,
 // number when the object is colliding, though the meaning of that negative
 // number depends on the implementation.
 using DistanceFn = std::function<ccd_real_t (
-    const void*, const void*, const ccd_t*, ccd_vec3_t*, ccd_vec3_t*)>;
+    const void*, const void*, const ccd_t*, ccd_vec3_t*, ccd_vec3_t*,
+    ccd_real_t, SolverStatistics*)>;
 
 /** Compute the distance between two objects using GJK algorithm.
  * @param[in] obj1 A convex geometric object.
@@ -2262,13 +2332,16 @@ using DistanceFn = std::function<ccd_real_t (
  * negative distance is defined by `distance_func`.
  * @param[out] p1 The closest point on object 1 in the world frame.
  * @param[out] p2 The closest point on object 2 in the world frame.
+ * @param[in] upper_bound Passed on to `distance_func`, see GJKDistance().
+ * @param[out] stats Passed on to `distance_func`, see GJKDistance().
  * @retval is_separated True if the objects are separated, false otherwise.
  */
 template <typename S>
 bool GJKDistanceImpl(void* obj1, ccd_support_fn supp1, void* obj2,
                      ccd_support_fn supp2, unsigned int max_iterations,
                      S tolerance, detail::DistanceFn distance_func, S* res,
-                     Vector3<S>* p1, Vector3<S>* p2) {
+                     Vector3<S>* p1, Vector3<S>* p2, S upper_bound,
+                     SolverStatistics* stats) {
   ccd_t ccd;
   ccd_real_t dist;
   CCD_INIT(&ccd);
@@ -2287,7 +2360,10 @@ bool GJKDistanceImpl(void* obj1, ccd_support_fn supp1, void* obj2,
   // libccd_extension::ccdGJKDist2(...) to always set p1_ and p2_.
   ccdVec3Set(&p1_, 0.0, 0.0, 0.0);
   ccdVec3Set(&p2_, 0.0, 0.0, 0.0);
-  dist = distance_func(obj1, obj2, &ccd, &p1_, &p2_);
+  dist = distance_func(obj1, obj2, &ccd, &p1_, &p2_,
+                       upper_bound < std::numeric_limits<S>::max()
+                         ? static_cast<ccd_real_t>(upper_bound) : CCD_REAL_MAX,
+                       stats);
   if (p1) *p1 << ccdVec3X(&p1_), ccdVec3Y(&p1_), ccdVec3Z(&p1_);
   if (p2) *p2 << ccdVec3X(&p2_), ccdVec3Y(&p2_), ccdVec3Z(&p2_);
   if (res) *res = dist;
@@ -2301,10 +2377,11 @@ template <typename S>
 bool GJKDistance(void* obj1, ccd_support_fn supp1,
                  void* obj2, ccd_support_fn supp2,
                  unsigned int max_iterations, S tolerance,
-                 S* res, Vector3<S>* p1, Vector3<S>* p2) {
+                 S* res, Vector3<S>* p1, Vector3<S>* p2,
+                 S upper_bound, SolverStatistics* stats) {
   return detail::GJKDistanceImpl(obj1, supp1, obj2, supp2, max_iterations,
                                  tolerance, libccd_extension::ccdGJKDist2, res,
-                                 p1, p2);
+                                 p1, p2, upper_bound, stats);
 }
 
 /**
@@ -2324,10 +2401,11 @@ template <typename S>
 bool GJKSignedDistance(void* obj1, ccd_support_fn supp1,
                        void* obj2, ccd_support_fn supp2,
                        unsigned int max_iterations,
-                       S tolerance, S* res, Vector3<S>* p1, Vector3<S>* p2) {
+                       S tolerance, S* res, Vector3<S>* p1, Vector3<S>* p2,
+                       S upper_bound, SolverStatistics* stats) {
   return detail::GJKDistanceImpl(
       obj1, supp1, obj2, supp2, max_iterations, tolerance,
-      libccd_extension::ccdGJKSignedDist, res, p1, p2);
+      libccd_extension::ccdGJKSignedDist, res, p1, p2, upper_bound, stats);
 }
 
 template <typename S>
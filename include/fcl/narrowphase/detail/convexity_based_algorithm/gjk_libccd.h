@@ -42,6 +42,8 @@
 #include <ccd/quat.h>
 #include <ccd/vec3.h>
 
+#include <limits>
+
 #include "fcl/common/unused.h"
 
 #include "fcl/geometry/shape/box.h"
@@ -55,6 +57,8 @@
 #include "fcl/geometry/shape/sphere.h"
 #include "fcl/geometry/shape/triangle_p.h"
 
+#include "fcl/narrowphase/solver_statistics.h"
+
 #include "fcl/narrowphase/detail/convexity_based_algorithm/simplex.h"
 #include "fcl/narrowphase/detail/convexity_based_algorithm/polytope.h"
 #include "fcl/narrowphase/detail/convexity_based_algorithm/alloc.h"
@@ -219,6 +223,9 @@ bool GJKCollide(
  * objects are colliding, it is -1.
  * @param[out] p1 The closest point on object 1 in the world frame.
  * @param[out] p2 The closest point on object 2 in the world frame.
+ * @param[in] upper_bound GJK stops once the distance is known to exceed this
+ * bound; dist is then larger than the bound but not necessarily exact.
+ * @param[out] stats If not null, the GJK (and EPA) runs are recorded in it.
  * @retval is_separated True if the objects are separated, false otherwise.
  */
 template <typename S>
@@ -226,7 +233,9 @@ FCL_EXPORT
 bool GJKDistance(void* obj1, ccd_support_fn supp1,
                  void* obj2, ccd_support_fn supp2,
                  unsigned int max_iterations, S tolerance,
-                 S* dist, Vector3<S>* p1, Vector3<S>* p2);
+                 S* dist, Vector3<S>* p1, Vector3<S>* p2,
+                 S upper_bound = std::numeric_limits<S>::max(),
+                 SolverStatistics* stats = nullptr);
 
 /** Compute the signed distance between two objects using GJK and EPA algorithm.
  * @param[in] obj1 A convex geometric object.
@@ -245,6 +254,9 @@ bool GJKDistance(void* obj1, ccd_support_fn supp1,
  * negative value.
  * @param[out] p1 The closest point on object 1 in the world frame.
  * @param[out] p2 The closest point on object 2 in the world frame.
+ * @param[in] upper_bound GJK stops once the distance is known to exceed this
+ * bound; dist is then larger than the bound but not necessarily exact.
+ * @param[out] stats If not null, the GJK (and EPA) runs are recorded in it.
  * @retval is_separated True if the objects are separated, false otherwise.
  */
 template <typename S>
@@ -252,7 +264,9 @@ FCL_EXPORT
 bool GJKSignedDistance(void* obj1, ccd_support_fn supp1,
                        void* obj2, ccd_support_fn supp2,
                        unsigned int max_iterations, S tolerance,
-                       S* dist, Vector3<S>* p1, Vector3<S>* p2);
+                       S* dist, Vector3<S>* p1, Vector3<S>* p2,
+                       S upper_bound = std::numeric_limits<S>::max(),
+                       SolverStatistics* stats = nullptr);
 
 
 
@@ -0,0 +1,205 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_GJKRAYCAST_INL_H
+#define FCL_NARROWPHASE_DETAIL_GJKRAYCAST_INL_H
+
+#include "fcl/narrowphase/detail/convexity_based_algorithm/gjk_ray_cast.h"
+
+#include <algorithm>
+#include "fcl/math/detail/project.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+bool gjkRayCast(
+    const MinkowskiDiff<double>& shape,
+    const Vector3<double>& r,
+    unsigned int max_iterations,
+    double tolerance,
+    double& lambda,
+    Vector3<double>& normal);
+
+//==============================================================================
+/// @brief Projects the origin onto the simplex of the first rank points of y.
+/// A degenerate simplex is replaced by the closest of its faces holding its
+/// last point.
+template <typename S>
+typename Project<S>::ProjectResult projectOriginOnSimplex(
+    const Vector3<S>* y, std::size_t rank)
+{
+  using ProjectResult = typename Project<S>::ProjectResult;
+
+  ProjectResult res;
+  switch(rank)
+  {
+  case 1:
+    res.parameterization[0] = 1;
+    res.sqr_distance = y[0].squaredNorm();
+    res.encode = 1;
+    return res;
+  case 2:
+    res = Project<S>::projectLineOrigin(y[0], y[1]);
+    break;
+  case 3:
+    res = Project<S>::projectTriangleOrigin(y[0], y[1], y[2]);
+    break;
+  default:
+    res = Project<S>::projectTetrahedraOrigin(y[0], y[1], y[2], y[3]);
+  }
+
+  if(res.sqr_distance >= 0)
+    return res;
+
+  Vector3<S> face[3];
+  for(std::size_t skip = 0; skip + 1 < rank; ++skip)
+  {
+    std::size_t k = 0;
+    for(std::size_t j = 0; j < rank; ++j)
+    {
+      if(j != skip)
+        face[k++] = y[j];
+    }
+
+    const ProjectResult face_res = projectOriginOnSimplex(face, rank - 1);
+    if(face_res.sqr_distance < 0
+       || (res.sqr_distance >= 0 && face_res.sqr_distance >= res.sqr_distance))
+      continue;
+
+    res = ProjectResult();
+    res.sqr_distance = face_res.sqr_distance;
+    k = 0;
+    for(std::size_t j = 0; j < rank; ++j)
+    {
+      if(j == skip)
+        continue;
+      res.parameterization[j] = face_res.parameterization[k];
+      if(face_res.encode & (1u << k))
+        res.encode |= (1u << j);
+      ++k;
+    }
+  }
+
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool gjkRayCast(
+    const MinkowskiDiff<S>& shape,
+    const Vector3<S>& r,
+    unsigned int max_iterations,
+    S tolerance,
+    S& lambda,
+    Vector3<S>& normal)
+{
+  lambda = 0;
+  normal.setZero();
+
+  // The point of the ray, and the support points spanning the simplex of the
+  // difference closest to it
+  Vector3<S> x = Vector3<S>::Zero();
+  Vector3<S> simplex[4];
+  std::size_t rank = 0;
+
+  // From the difference towards x
+  Vector3<S> v = x - shape.support(Vector3<S>::UnitX());
+  S max_sqr_size = v.squaredNorm();
+  const S sqr_tolerance = tolerance * tolerance;
+
+  for(unsigned int i = 0; i < max_iterations; ++i)
+  {
+    if(v.squaredNorm() <= sqr_tolerance * max_sqr_size)
+      return true;
+
+    // The supports of the shapes expect unit directions
+    const Vector3<S> p = shape.support(v.normalized());
+    const Vector3<S> w = x - p;
+    const S vw = v.dot(w);
+    if(vw > 0)
+    {
+      // v separates x from the difference: advance x up to the plane, or give
+      // up if the ray leaves it
+      const S vr = v.dot(r);
+      if(vr >= 0)
+        return false;
+
+      lambda -= vw / vr;
+      if(lambda > 1)
+        return false;
+
+      x = lambda * r;
+      normal = v.normalized();
+    }
+
+    simplex[rank++] = p;
+
+    Vector3<S> y[4];
+    for(std::size_t j = 0; j < rank; ++j)
+      y[j] = simplex[j] - x;
+    const auto res = projectOriginOnSimplex(y, rank);
+
+    // Keep the points spanning the closest point only
+    v.setZero();
+    max_sqr_size = 0;
+    std::size_t new_rank = 0;
+    for(std::size_t j = 0; j < rank; ++j)
+    {
+      if(!(res.encode & (1u << j)))
+        continue;
+      v.noalias() -= res.parameterization[j] * y[j];
+      max_sqr_size = std::max(max_sqr_size, y[j].squaredNorm());
+      simplex[new_rank++] = simplex[j];
+    }
+    rank = new_rank;
+
+    // The simplex encloses x: the ray point lies in the difference
+    if(rank == 4)
+      return true;
+  }
+
+  // Out of iterations, lambda is still a lower bound of the hit
+  return true;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
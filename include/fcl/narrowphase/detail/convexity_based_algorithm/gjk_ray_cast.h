@@ -0,0 +1,86 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_GJKRAYCAST_H
+#define FCL_NARROWPHASE_DETAIL_GJKRAYCAST_H
+
+#include "fcl/common/types.h"
+#include "fcl/narrowphase/detail/convexity_based_algorithm/minkowski_diff.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Casts the segment from the origin to r against the Minkowski
+/// difference of two convex shapes, with the conservative advancement ray cast
+/// of GJK (G. van den Bergen, "Ray casting against general convex objects with
+/// application to continuous collision detection").
+///
+/// When shape1 translates by r relative to shape0, the shapes first touch at
+/// the fraction lambda of the translation where lambda * r enters the
+/// Minkowski difference. lambda only ever advances up to points outside the
+/// difference, so it never overshoots the contact; it stops once the ray
+/// point is within tolerance of the difference, relative to the size of the
+/// current simplex. Running out of iterations reports a hit at the current
+/// lambda, which is still a lower bound of the actual one.
+///
+/// @param shape the Minkowski difference, in the frame of shape0
+/// @param r the end of the segment
+/// @param max_iterations the maximum number of support queries
+/// @param tolerance the relative distance at which the ray point is
+/// considered to be on the difference
+/// @param lambda the fraction of r where the segment hits the difference, 0
+/// if the origin already lies in it
+/// @param normal the unit normal of the difference at the hit point, pointing
+/// out of it and from shape0 towards shape1; zero if the origin already lies
+/// in the difference
+/// @return whether the segment hits the difference
+template <typename S>
+FCL_EXPORT
+bool gjkRayCast(
+    const MinkowskiDiff<S>& shape,
+    const Vector3<S>& r,
+    unsigned int max_iterations,
+    S tolerance,
+    S& lambda,
+    Vector3<S>& normal);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/convexity_based_algorithm/gjk_ray_cast-inl.h"
+
+#endif
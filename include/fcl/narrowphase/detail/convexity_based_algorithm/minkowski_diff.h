@@ -48,10 +48,16 @@ namespace detail
 {
 
 /// @brief the support function for shape
+///
+/// @param hint  Optional warm-start state for polytope shapes. On input, the
+///              index of a vertex from which to start the search; on output,
+///              the index of the returned support vertex. Ignored by all
+///              other shapes.
 template <typename S, typename Derived>
 Vector3<S> getSupport(
     const ShapeBase<S>* shape,
-    const Eigen::MatrixBase<Derived>& dir);
+    const Eigen::MatrixBase<Derived>& dir,
+    int* hint = nullptr);
 
 /// @brief Minkowski difference class of two shapes
 template <typename S>
@@ -66,6 +72,11 @@ struct FCL_EXPORT MinkowskiDiff
   /// @brief transform from shape1 to shape0 
   Transform3<S> toshape0;
 
+  /// @brief the support vertex indices of the last support queries on shape0
+  /// and shape1; used to warm start the support search on polytopes, since
+  /// successive GJK/EPA directions are usually close to each other
+  mutable int support_hints[2];
+
   MinkowskiDiff();
 
   /// @brief support function for shape0
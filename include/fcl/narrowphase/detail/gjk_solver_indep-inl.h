@@ -41,6 +41,7 @@
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "fcl/common/unused.h"
 
@@ -68,6 +69,32 @@ namespace detail
 extern template
 struct GJKSolver_indep<double>;
 
+//==============================================================================
+extern template
+struct GJKSolver_indep<float>;
+
+//==============================================================================
+template <typename S>
+void recordGJKRun(const GJKSolver_indep<S>& gjkSolver, const GJK<S>& gjk)
+{
+  if(!gjkSolver.enable_statistics) return;
+  gjkSolver.statistics.addGJKRun(
+        gjk.iterations,
+        gjk.iterations >= gjkSolver.gjk_max_iterations,
+        gjk.upper_bound_reached);
+}
+
+//==============================================================================
+template <typename S>
+void recordEPARun(const GJKSolver_indep<S>& gjkSolver, const EPA<S>& epa)
+{
+  if(!gjkSolver.enable_statistics) return;
+  gjkSolver.statistics.addEPARun(
+        epa.iterations,
+        epa.iterations >= gjkSolver.epa_max_iterations,
+        static_cast<SolverStatistics::EPAStatus>(epa.status + 1));
+}
+
 //==============================================================================
 template <typename S>
 template<typename Shape1, typename Shape2>
@@ -129,6 +156,7 @@ struct ShapeIntersectIndepImpl
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     switch(gjk_status)
@@ -137,6 +165,7 @@ struct ShapeIntersectIndepImpl
       {
         detail::EPA<S> epa(gjkSolver.epa_max_face_num, gjkSolver.epa_max_vertex_num, gjkSolver.epa_max_iterations, gjkSolver.epa_tolerance);
         typename detail::EPA<S>::Status epa_status = epa.evaluate(gjk, -guess);
+        recordEPARun(gjkSolver, epa);
         if(epa_status != detail::EPA<S>::Failed)
         {
           Vector3<S> w0 = Vector3<S>::Zero();
@@ -372,6 +401,7 @@ struct ShapeTriangleIntersectIndepImpl
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     switch(gjk_status)
@@ -380,6 +410,7 @@ struct ShapeTriangleIntersectIndepImpl
       {
         detail::EPA<S> epa(gjkSolver.epa_max_face_num, gjkSolver.epa_max_vertex_num, gjkSolver.epa_max_iterations, gjkSolver.epa_tolerance);
         typename detail::EPA<S>::Status epa_status = epa.evaluate(gjk, -guess);
+        recordEPARun(gjkSolver, epa);
         if(epa_status != detail::EPA<S>::Failed)
         {
           Vector3<S> w0 = Vector3<S>::Zero();
@@ -469,6 +500,7 @@ struct ShapeTransformedTriangleIntersectIndepImpl
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     switch(gjk_status)
@@ -477,6 +509,7 @@ struct ShapeTransformedTriangleIntersectIndepImpl
       {
         detail::EPA<S> epa(gjkSolver.epa_max_face_num, gjkSolver.epa_max_vertex_num, gjkSolver.epa_max_iterations, gjkSolver.epa_tolerance);
         typename detail::EPA<S>::Status epa_status = epa.evaluate(gjk, -guess);
+        recordEPARun(gjkSolver, epa);
         if(epa_status != detail::EPA<S>::Failed)
         {
           Vector3<S> w0 = Vector3<S>::Zero();
@@ -609,7 +642,9 @@ struct ShapeDistanceIndepImpl
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
+    gjk.distance_upper_bound = gjkSolver.distance_upper_bound;
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     if(gjk_status == detail::GJK<S>::Valid)
@@ -867,7 +902,9 @@ struct ShapeTriangleDistanceIndepImpl
     shape.toshape0 = tf.inverse(Eigen::Isometry);
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
+    gjk.distance_upper_bound = gjkSolver.distance_upper_bound;
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     if(gjk_status == detail::GJK<S>::Valid)
@@ -958,7 +995,9 @@ struct ShapeTransformedTriangleDistanceIndepImpl
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
+    gjk.distance_upper_bound = gjkSolver.distance_upper_bound;
     typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    recordGJKRun(gjkSolver, gjk);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
     if(gjk_status == detail::GJK<S>::Valid)
@@ -1036,6 +1075,8 @@ GJKSolver_indep<S>::GJKSolver_indep()
   epa_tolerance = constants<S>::gjk_default_tolerance();
   enable_cached_guess = false;
   cached_guess = Vector3<S>(1, 0, 0);
+  distance_upper_bound = std::numeric_limits<S>::max();
+  enable_statistics = false;
 }
 
 //==============================================================================
@@ -1059,6 +1100,21 @@ Vector3<S> GJKSolver_indep<S>::getCachedGuess() const
   return cached_guess;
 }
 
+//==============================================================================
+template <typename S>
+void GJKSolver_indep<S>::enableStatistics(bool if_enable) const
+{
+  enable_statistics = if_enable;
+  if(if_enable) statistics.clear();
+}
+
+//==============================================================================
+template <typename S>
+const SolverStatistics& GJKSolver_indep<S>::getStatistics() const
+{
+  return statistics;
+}
+
 } // namespace detail
 } // namespace fcl
 
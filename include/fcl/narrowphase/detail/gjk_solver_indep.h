@@ -40,6 +40,7 @@
 
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact_point.h"
+#include "fcl/narrowphase/solver_statistics.h"
 
 namespace fcl
 {
@@ -156,6 +157,12 @@ struct FCL_EXPORT GJKSolver_indep
 
   Vector3<S> getCachedGuess() const;
 
+  /// @brief Start (and reset) or stop recording GJK/EPA statistics
+  void enableStatistics(bool if_enable) const;
+
+  /// @brief Statistics recorded since the last enableStatistics(true)
+  const SolverStatistics& getStatistics() const;
+
   /// @brief maximum number of simplex face used in EPA algorithm
   unsigned int epa_max_face_num;
 
@@ -179,6 +186,16 @@ struct FCL_EXPORT GJKSolver_indep
 
   /// @brief smart guess
   mutable Vector3<S> cached_guess;
+
+  /// @brief GJK distance stops once the separation is known to exceed this
+  /// bound; the reported distance is then only guaranteed to be larger than it
+  mutable S distance_upper_bound;
+
+  /// @brief Whether GJK/EPA runs are recorded in statistics
+  mutable bool enable_statistics;
+
+  /// @brief Accumulated GJK/EPA statistics
+  mutable SolverStatistics statistics;
 };
 
 using GJKSolver_indepf = GJKSolver_indep<float>;
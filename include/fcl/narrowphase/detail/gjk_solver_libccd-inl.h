@@ -41,6 +41,7 @@
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "fcl/common/unused.h"
 
@@ -65,6 +66,10 @@ namespace detail
 extern template
 struct GJKSolver_libccd<double>;
 
+//==============================================================================
+extern template
+struct GJKSolver_libccd<float>;
+
 //==============================================================================
 template<typename S>
 template<typename Shape1, typename Shape2>
@@ -565,7 +570,9 @@ struct ShapeSignedDistanceLibccdImpl
           gjkSolver.distance_tolerance,
           dist,
           p1,
-          p2);
+          p2,
+          gjkSolver.distance_upper_bound,
+          gjkSolver.enable_statistics ? &gjkSolver.statistics : nullptr);
 
     detail::GJKInitializer<S, Shape1>::deleteGJKObject(o1);
     detail::GJKInitializer<S, Shape2>::deleteGJKObject(o2);
@@ -616,7 +623,9 @@ struct ShapeDistanceLibccdImpl
           gjkSolver.distance_tolerance,
           dist,
           p1,
-          p2);
+          p2,
+          gjkSolver.distance_upper_bound,
+          gjkSolver.enable_statistics ? &gjkSolver.statistics : nullptr);
 
     detail::GJKInitializer<S, Shape1>::deleteGJKObject(o1);
     detail::GJKInitializer<S, Shape2>::deleteGJKObject(o2);
@@ -835,7 +844,9 @@ struct ShapeTriangleDistanceLibccdImpl
           gjkSolver.distance_tolerance,
           dist,
           p1,
-          p2);
+          p2,
+          gjkSolver.distance_upper_bound,
+          gjkSolver.enable_statistics ? &gjkSolver.statistics : nullptr);
 
     detail::GJKInitializer<S, Shape>::deleteGJKObject(o1);
     detail::triDeleteGJKObject(o2);
@@ -908,7 +919,9 @@ struct ShapeTransformedTriangleDistanceLibccdImpl
           gjkSolver.distance_tolerance,
           dist,
           p1,
-          p2);
+          p2,
+          gjkSolver.distance_upper_bound,
+          gjkSolver.enable_statistics ? &gjkSolver.statistics : nullptr);
 
     detail::GJKInitializer<S, Shape>::deleteGJKObject(o1);
     detail::triDeleteGJKObject(o2);
@@ -964,6 +977,8 @@ GJKSolver_libccd<S>::GJKSolver_libccd()
   max_distance_iterations = 1000;
   collision_tolerance = constants<S>::gjk_default_tolerance();
   distance_tolerance = 1e-6;
+  distance_upper_bound = std::numeric_limits<S>::max();
+  enable_statistics = false;
 }
 
 //==============================================================================
@@ -992,6 +1007,21 @@ Vector3<S> GJKSolver_libccd<S>::getCachedGuess() const
   return Vector3<S>(-1, 0, 0);
 }
 
+//==============================================================================
+template<typename S>
+void GJKSolver_libccd<S>::enableStatistics(bool if_enable) const
+{
+  enable_statistics = if_enable;
+  if(if_enable) statistics.clear();
+}
+
+//==============================================================================
+template<typename S>
+const SolverStatistics& GJKSolver_libccd<S>::getStatistics() const
+{
+  return statistics;
+}
+
 } // namespace detail
 } // namespace fcl
 
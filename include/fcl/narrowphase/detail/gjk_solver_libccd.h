@@ -40,6 +40,7 @@
 
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact_point.h"
+#include "fcl/narrowphase/solver_statistics.h"
 
 namespace fcl
 {
@@ -156,6 +157,13 @@ struct FCL_EXPORT GJKSolver_libccd
 
   Vector3<S> getCachedGuess() const;
 
+  /// @brief Start (and reset) or stop recording GJK/EPA statistics. Only the
+  /// distance queries are recorded; collision runs libccd's MPR.
+  void enableStatistics(bool if_enable) const;
+
+  /// @brief Statistics recorded since the last enableStatistics(true)
+  const SolverStatistics& getStatistics() const;
+
   /// @brief maximum number of iterations used in GJK algorithm for collision
   unsigned int max_collision_iterations;
 
@@ -168,6 +176,16 @@ struct FCL_EXPORT GJKSolver_libccd
   /// @brief the threshold used in GJK algorithm to stop distance iteration
   S distance_tolerance;
 
+  /// @brief GJK distance stops once the separation is known to exceed this
+  /// bound; the reported distance is then only guaranteed to be larger than it
+  mutable S distance_upper_bound;
+
+  /// @brief Whether GJK/EPA runs are recorded in statistics
+  mutable bool enable_statistics;
+
+  /// @brief Accumulated GJK/EPA statistics
+  mutable SolverStatistics statistics;
+
 };
 
 using GJKSolver_libccdf = GJKSolver_libccd<float>;
@@ -40,6 +40,8 @@
 
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_capsule.h"
 
+#include "fcl/math/constants.h"
+
 namespace fcl
 {
 
@@ -182,6 +184,124 @@ bool capsuleCapsuleDistance(const Capsule<S>& s1, const Transform3<S>& tf1,
   return true;
 }
 
+//==============================================================================
+// Branch-free variant of closestPtSegmentSegment() for the segments c1 -/+ u1
+// and c2 -/+ u2 of pair i, writing the closest points to cp1 and cp2.
+template <typename S>
+void closestPtSegmentSegmentBatchLane(
+    int i, const S* const c1[3], const S* const u1[3],
+    const S* const c2[3], const S* const u2[3], S cp1[3], S cp2[3])
+{
+  S p1[3], d1[3], p2[3], d2[3], r[3];
+  for(int k = 0; k < 3; ++k)
+  {
+    p1[k] = c1[k][i] - u1[k][i];
+    d1[k] = 2 * u1[k][i];
+    p2[k] = c2[k][i] - u2[k][i];
+    d2[k] = 2 * u2[k][i];
+    r[k] = p1[k] - p2[k];
+  }
+
+  const S a = d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2];
+  const S e = d2[0] * d2[0] + d2[1] * d2[1] + d2[2] * d2[2];
+  const S b = d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2];
+  const S c = d1[0] * r[0] + d1[1] * r[1] + d1[2] * r[2];
+  const S f = d2[0] * r[0] + d2[1] * r[1] + d2[2] * r[2];
+
+  // Degenerate (point) segments and parallel segments are handled by
+  // selecting between the candidate parameters instead of branching, which
+  // the packed kernels mirror lane by lane; the divisors are replaced by 1
+  // wherever their quotient is discarded.
+  const bool point1 = !(a > 0);
+  const bool point2 = !(e > 0);
+  const S denom = a * e - b * b;
+  const bool parallel = !(denom > constants<S>::eps() * a * e);
+  const S safe_a = point1 ? S(1) : a;
+  const S safe_e = point2 ? S(1) : e;
+  const S safe_denom = parallel ? S(1) : denom;
+
+  S s = parallel ? S(0) : clamp((b * f - c * e) / safe_denom, S(0), S(1));
+  S t = (b * s + f) / safe_e;
+  s = t < 0 ? clamp(-c / safe_a, S(0), S(1))
+            : (t > 1 ? clamp((b - c) / safe_a, S(0), S(1)) : s);
+  t = clamp(t, S(0), S(1));
+
+  s = point1 ? S(0) : (point2 ? clamp(-c / safe_a, S(0), S(1)) : s);
+  t = point2 ? S(0) : (point1 ? clamp(f / safe_e, S(0), S(1)) : t);
+
+  for(int k = 0; k < 3; ++k)
+  {
+    cp1[k] = p1[k] + d1[k] * s;
+    cp2[k] = p2[k] + d2[k] * t;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void capsuleCapsuleIntersectBatch(
+    int n,
+    const S* r1, const S* const c1[3], const S* const u1[3],
+    const S* r2, const S* const c2[3], const S* const u2[3],
+    unsigned char* collide, S* depth, S* const normal[3], S* const pos[3])
+{
+  for(int i = 0; i < n; ++i)
+  {
+    S cp1[3], cp2[3];
+    closestPtSegmentSegmentBatchLane(i, c1, u1, c2, u2, cp1, cp2);
+
+    const S dx = cp2[0] - cp1[0];
+    const S dy = cp2[1] - cp1[1];
+    const S dz = cp2[2] - cp1[2];
+    const S len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const S sum = r1[i] + r2[i];
+    const S inv_len = len > 0 ? 1 / len : S(0);
+    const S w = r1[i] / sum;
+
+    collide[i] = len <= sum;
+    depth[i] = sum - len;
+    normal[0][i] = dx * inv_len;
+    normal[1][i] = dy * inv_len;
+    normal[2][i] = dz * inv_len;
+    pos[0][i] = cp1[0] + dx * w;
+    pos[1][i] = cp1[1] + dy * w;
+    pos[2][i] = cp1[2] + dz * w;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void capsuleCapsuleDistanceBatch(
+    int n,
+    const S* r1, const S* const c1[3], const S* const u1[3],
+    const S* r2, const S* const c2[3], const S* const u2[3],
+    unsigned char* separated, S* dist, S* const p1[3], S* const p2[3])
+{
+  for(int i = 0; i < n; ++i)
+  {
+    S cp1[3], cp2[3];
+    closestPtSegmentSegmentBatchLane(i, c1, u1, c2, u2, cp1, cp2);
+
+    const S dx = cp2[0] - cp1[0];
+    const S dy = cp2[1] - cp1[1];
+    const S dz = cp2[2] - cp1[2];
+    const S len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const S sum = r1[i] + r2[i];
+    const bool apart = len > sum;
+    const S inv_len = len > 0 ? 1 / len : S(0);
+    const S w1 = r1[i] * inv_len;
+    const S w2 = r2[i] * inv_len;
+
+    separated[i] = apart;
+    dist[i] = apart ? len - sum : S(-1);
+    p1[0][i] = cp1[0] + dx * w1;
+    p1[1][i] = cp1[1] + dy * w1;
+    p1[2][i] = cp1[2] + dz * w1;
+    p2[0][i] = cp2[0] - dx * w2;
+    p2[1][i] = cp2[1] - dy * w2;
+    p2[2][i] = cp2[2] - dz * w2;
+  }
+}
+
 } // namespace detail
 } // namespace fcl
 
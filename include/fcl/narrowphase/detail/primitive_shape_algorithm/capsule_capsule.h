@@ -70,6 +70,57 @@ bool capsuleCapsuleDistance(const Capsule<S>& s1, const Transform3<S>& tf1,
           const Capsule<S>& s2, const Transform3<S>& tf2,
           S* dist, Vector3<S>* p1_res, Vector3<S>* p2_res);
 
+// Batched capsule-capsule collision over n pairs stored as structure-of-arrays.
+// Capsule i of each side is the set of points within radius r[i] of the
+// segment from c - u to c + u, where c = (c[0][i], c[1][i], c[2][i]) is its
+// center and u its half axis (i.e., lz / 2 along the capsule's z axis).
+//
+// collide[i] is set to 1 if pair i is colliding (touching included) and to 0
+// otherwise. The normal points from capsule 1 to capsule 2 and, like the
+// position and depth, follows the sphere-sphere conventions applied to the
+// closest points of the segments. These outputs are only meaningful where
+// collide[i] is 1.
+template <typename S>
+FCL_EXPORT
+void capsuleCapsuleIntersectBatch(
+    int n,
+    const S* r1, const S* const c1[3], const S* const u1[3],
+    const S* r2, const S* const c2[3], const S* const u2[3],
+    unsigned char* collide, S* depth, S* const normal[3], S* const pos[3]);
+
+// Vectorized double overload of capsuleCapsuleIntersectBatch(). It uses SSE2,
+// or AVX when the library is compiled with AVX enabled, and produces the same
+// results as the scalar template.
+FCL_EXPORT
+void capsuleCapsuleIntersectBatch(
+    int n,
+    const double* r1, const double* const c1[3], const double* const u1[3],
+    const double* r2, const double* const c2[3], const double* const u2[3],
+    unsigned char* collide, double* depth,
+    double* const normal[3], double* const pos[3]);
+
+// Batched capsule-capsule distance over n pairs stored as structure-of-arrays
+// (see capsuleCapsuleIntersectBatch()). separated[i] is set to 1 if pair i is
+// separated, in which case dist[i] is the separating distance and p1, p2 hold
+// the nearest points on the capsule surfaces. Otherwise dist[i] is -1 and the
+// nearest points are unspecified.
+template <typename S>
+FCL_EXPORT
+void capsuleCapsuleDistanceBatch(
+    int n,
+    const S* r1, const S* const c1[3], const S* const u1[3],
+    const S* r2, const S* const c2[3], const S* const u2[3],
+    unsigned char* separated, S* dist, S* const p1[3], S* const p2[3]);
+
+// Vectorized double overload of capsuleCapsuleDistanceBatch().
+FCL_EXPORT
+void capsuleCapsuleDistanceBatch(
+    int n,
+    const double* r1, const double* const c1[3], const double* const u1[3],
+    const double* r2, const double* const c2[3], const double* const u2[3],
+    unsigned char* separated, double* dist,
+    double* const p1[3], double* const p2[3]);
+
 } // namespace detail
 } // namespace fcl
 
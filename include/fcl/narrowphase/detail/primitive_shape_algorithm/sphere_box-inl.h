@@ -225,6 +225,95 @@ FCL_EXPORT bool sphereBoxDistance(const Sphere<S>& sphere,
   return false;
 }
 
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT void sphereBoxIntersectBatch(
+    int n, const S* r, const S* const p_BC[3], const S* const half_size[3],
+    unsigned char* collide, S* depth, S* const n_SB_B[3], S* const p_BP[3]) {
+  // See sphereBoxIntersect() for the reasoning behind this epsilon.
+  const S eps = 16 * constants<S>::eps();
+  const S inf = std::numeric_limits<typename constants<S>::Real>::infinity();
+
+  for (int i = 0; i < n; ++i) {
+    // The nearest point N inside the box, and its offset from the center C.
+    S p_BN[3], p_CN[3], face_distance[3];
+    for (int k = 0; k < 3; ++k) {
+      const S c = p_BC[k][i];
+      const S h = half_size[k][i];
+      p_BN[k] = c < -h ? -h : (c > h ? h : c);
+      p_CN[k] = p_BN[k] - c;
+      face_distance[k] = c >= 0 ? h - c : c + h;
+    }
+    const S squared_distance =
+        p_CN[0] * p_CN[0] + p_CN[1] * p_CN[1] + p_CN[2] * p_CN[2];
+    const S radius = r[i];
+    const bool outside = squared_distance > eps * eps;
+
+    // Center outside: the normal runs from C to N.
+    const S distance = std::sqrt(squared_distance);
+    const S inv_distance = outside ? 1 / distance : S(0);
+    const S outside_depth = radius - distance;
+
+    // Center inside: the nearest face defines the normal, prioritized in the
+    // order x, y, z.
+    S min_distance = inf;
+    int min_axis = 0;
+    for (int k = 0; k < 3; ++k) {
+      const bool closer = face_distance[k] + eps < min_distance;
+      min_distance = closer ? face_distance[k] : min_distance;
+      min_axis = closer ? k : min_axis;
+    }
+    const S inside_depth = min_distance + radius;
+
+    collide[i] = squared_distance <= radius * radius;
+    depth[i] = outside ? outside_depth : inside_depth;
+    for (int k = 0; k < 3; ++k) {
+      const S inside_normal =
+          min_axis == k ? (p_BC[k][i] >= 0 ? S(-1) : S(1)) : S(0);
+      const S normal = outside ? p_CN[k] * inv_distance : inside_normal;
+      n_SB_B[k][i] = normal;
+      p_BP[k][i] = outside
+          ? p_BN[k] + normal * (outside_depth * 0.5)
+          : p_BC[k][i] + normal * ((radius - min_distance) / 2);
+    }
+  }
+}
+
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT void sphereBoxDistanceBatch(
+    int n, const S* r, const S* const p_BC[3], const S* const half_size[3],
+    unsigned char* separated, S* distance, S* const p_BSb[3],
+    S* const p_BBs[3]) {
+  for (int i = 0; i < n; ++i) {
+    S p_BN[3], p_NC[3];
+    for (int k = 0; k < 3; ++k) {
+      const S c = p_BC[k][i];
+      const S h = half_size[k][i];
+      p_BN[k] = c < -h ? -h : (c > h ? h : c);
+      p_NC[k] = c - p_BN[k];
+    }
+    const S squared_distance =
+        p_NC[0] * p_NC[0] + p_NC[1] * p_NC[1] + p_NC[2] * p_NC[2];
+    const S radius = r[i];
+    // A center inside the box has a zero squared distance, so this also
+    // covers the N == C test of sphereBoxDistance().
+    const bool apart = squared_distance > radius * radius;
+
+    const S d = std::sqrt(squared_distance);
+    const S scale = apart ? (d - radius) / d : S(0);
+
+    separated[i] = apart;
+    distance[i] = apart ? d - radius : S(-1);
+    for (int k = 0; k < 3; ++k) {
+      p_BBs[k][i] = p_BN[k];
+      p_BSb[k][i] = p_BN[k] + p_NC[k] * scale;
+    }
+  }
+}
+
 } // namespace detail
 } // namespace fcl
 
@@ -132,6 +132,61 @@ FCL_EXPORT bool sphereBoxDistance(const Sphere<S>& sphere,
                                   const Transform3<S>& X_FB, S* distance,
                                   Vector3<S>* p_FSb, Vector3<S>* p_FBs);
 
+/** Batched form of sphereBoxIntersect() over n sphere-box pairs stored as
+ structure-of-arrays. All quantities are measured and expressed in the frame
+ of each pair's box; the caller is responsible for mapping the sphere centers
+ into, and the results out of, that frame.
+
+ The contact data is computed with the same conventions (including the face
+ priority for centers inside the box) as sphereBoxIntersect().
+
+ @param n              The number of pairs.
+ @param r              The sphere radii.
+ @param p_BC           The sphere centers C in the box frame B; component k
+                       of pair i is p_BC[k][i].
+ @param half_size      The box half extents, laid out like p_BC.
+ @param collide[out]   Set to 1 for colliding (including touching) pairs and to
+                       0 otherwise.
+ @param depth[out]     The penetration depth.
+ @param n_SB_B[out]    The normal pointing from the sphere into the box.
+ @param p_BP[out]      The contact position P.
+ @note The outputs other than `collide` are only meaningful for colliding
+       pairs.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT void sphereBoxIntersectBatch(
+    int n, const S* r, const S* const p_BC[3], const S* const half_size[3],
+    unsigned char* collide, S* depth, S* const n_SB_B[3], S* const p_BP[3]);
+
+/** Vectorized double overload of sphereBoxIntersectBatch(). It uses SSE2, or
+ AVX when the library is compiled with AVX enabled, and produces the same
+ results as the scalar template.  */
+FCL_EXPORT void sphereBoxIntersectBatch(
+    int n, const double* r, const double* const p_BC[3],
+    const double* const half_size[3], unsigned char* collide, double* depth,
+    double* const n_SB_B[3], double* const p_BP[3]);
+
+/** Batched form of sphereBoxDistance() over n sphere-box pairs stored as
+ structure-of-arrays in each pair's box frame (see sphereBoxIntersectBatch()).
+
+ @param separated[out] Set to 1 for separated pairs and to 0 otherwise.
+ @param distance[out]  The separating distance, or -1 for penetrating pairs.
+ @param p_BSb[out]     The closest point on the sphere to the box.
+ @param p_BBs[out]     The closest point on the box to the sphere.
+ @note The nearest points are only meaningful for separated pairs.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT void sphereBoxDistanceBatch(
+    int n, const S* r, const S* const p_BC[3], const S* const half_size[3],
+    unsigned char* separated, S* distance, S* const p_BSb[3],
+    S* const p_BBs[3]);
+
+/** Vectorized double overload of sphereBoxDistanceBatch().  */
+FCL_EXPORT void sphereBoxDistanceBatch(
+    int n, const double* r, const double* const p_BC[3],
+    const double* const half_size[3], unsigned char* separated,
+    double* distance, double* const p_BSb[3], double* const p_BBs[3]);
+
 //@}
 
 } // namespace detail
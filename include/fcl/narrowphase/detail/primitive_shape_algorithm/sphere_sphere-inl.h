@@ -108,6 +108,69 @@ bool sphereSphereDistance(const Sphere<S>& s1, const Transform3<S>& tf1,
   return false;
 }
 
+//==============================================================================
+template <typename S>
+void sphereSphereIntersectBatch(
+    int n,
+    const S* r1, const S* const c1[3],
+    const S* r2, const S* const c2[3],
+    unsigned char* collide, S* depth, S* const normal[3], S* const pos[3])
+{
+  for(int i = 0; i < n; ++i)
+  {
+    const S dx = c2[0][i] - c1[0][i];
+    const S dy = c2[1][i] - c1[1][i];
+    const S dz = c2[2][i] - c1[2][i];
+    const S len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const S sum = r1[i] + r2[i];
+
+    // Coincident centers give a zero normal, as in sphereSphereIntersect().
+    const S inv_len = len > 0 ? 1 / len : S(0);
+    const S w = r1[i] / sum;
+
+    collide[i] = len <= sum;
+    depth[i] = sum - len;
+    normal[0][i] = dx * inv_len;
+    normal[1][i] = dy * inv_len;
+    normal[2][i] = dz * inv_len;
+    pos[0][i] = c1[0][i] + dx * w;
+    pos[1][i] = c1[1][i] + dy * w;
+    pos[2][i] = c1[2][i] + dz * w;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void sphereSphereDistanceBatch(
+    int n,
+    const S* r1, const S* const c1[3],
+    const S* r2, const S* const c2[3],
+    unsigned char* separated, S* dist, S* const p1[3], S* const p2[3])
+{
+  for(int i = 0; i < n; ++i)
+  {
+    const S dx = c1[0][i] - c2[0][i];
+    const S dy = c1[1][i] - c2[1][i];
+    const S dz = c1[2][i] - c2[2][i];
+    const S len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const S sum = r1[i] + r2[i];
+    const bool apart = len > sum;
+
+    const S inv_len = len > 0 ? 1 / len : S(0);
+    const S w1 = r1[i] * inv_len;
+    const S w2 = r2[i] * inv_len;
+
+    separated[i] = apart;
+    dist[i] = apart ? len - sum : S(-1);
+    p1[0][i] = c1[0][i] - dx * w1;
+    p1[1][i] = c1[1][i] - dy * w1;
+    p1[2][i] = c1[2][i] - dz * w1;
+    p2[0][i] = c2[0][i] + dx * w2;
+    p2[1][i] = c2[1][i] + dy * w2;
+    p2[2][i] = c2[2][i] + dz * w2;
+  }
+}
+
 } // namespace detail
 } // namespace fcl
 
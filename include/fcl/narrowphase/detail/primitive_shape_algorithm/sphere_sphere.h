@@ -57,6 +57,55 @@ bool sphereSphereDistance(const Sphere<S>& s1, const Transform3<S>& tf1,
                           const Sphere<S>& s2, const Transform3<S>& tf2,
                           S* dist, Vector3<S>* p1, Vector3<S>* p2);
 
+/// @brief Batched form of sphereSphereIntersect() over n sphere pairs stored
+/// as structure-of-arrays: pair i has radii r1[i], r2[i] and centers
+/// (c1[0][i], c1[1][i], c1[2][i]) and (c2[0][i], c2[1][i], c2[2][i]).
+///
+/// collide[i] is set to 1 if pair i is colliding (touching included) and to
+/// 0 otherwise. The depth, normal and position are written for every pair
+/// with the same conventions as sphereSphereIntersect(), but are only
+/// meaningful where collide[i] is 1.
+template <typename S>
+void sphereSphereIntersectBatch(
+    int n,
+    const S* r1, const S* const c1[3],
+    const S* r2, const S* const c2[3],
+    unsigned char* collide, S* depth, S* const normal[3], S* const pos[3]);
+
+/// @brief Vectorized double overload of sphereSphereIntersectBatch(). It uses
+/// SSE2, or AVX when the library is compiled with AVX enabled (e.g.,
+/// FCL_USE_HOST_NATIVE_ARCH), and produces the same results as the scalar
+/// template.
+FCL_EXPORT
+void sphereSphereIntersectBatch(
+    int n,
+    const double* r1, const double* const c1[3],
+    const double* r2, const double* const c2[3],
+    unsigned char* collide, double* depth,
+    double* const normal[3], double* const pos[3]);
+
+/// @brief Batched form of sphereSphereDistance() over n sphere pairs stored
+/// as structure-of-arrays (see sphereSphereIntersectBatch()).
+///
+/// separated[i] is set to 1 if pair i is separated, in which case dist[i] is
+/// the separating distance and p1, p2 hold the nearest points. Otherwise
+/// dist[i] is -1 and the nearest points are unspecified.
+template <typename S>
+void sphereSphereDistanceBatch(
+    int n,
+    const S* r1, const S* const c1[3],
+    const S* r2, const S* const c2[3],
+    unsigned char* separated, S* dist, S* const p1[3], S* const p2[3]);
+
+/// @brief Vectorized double overload of sphereSphereDistanceBatch().
+FCL_EXPORT
+void sphereSphereDistanceBatch(
+    int n,
+    const double* r1, const double* const c1[3],
+    const double* r2, const double* const c2[3],
+    unsigned char* separated, double* dist,
+    double* const p1[3], double* const p2[3]);
+
 } // namespace detail
 } // namespace fcl
 
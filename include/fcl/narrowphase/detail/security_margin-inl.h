@@ -0,0 +1,760 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_SECURITYMARGIN_INL_H
+#define FCL_NARROWPHASE_DETAIL_SECURITYMARGIN_INL_H
+
+#include "fcl/narrowphase/detail/security_margin.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/triangle_distance.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+bool triangleMarginContact(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    double margin,
+    Vector3<double>* contact_point,
+    double* penetration_depth,
+    Vector3<double>* normal);
+
+//==============================================================================
+extern template
+bool triangleMarginContact(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    const Matrix3<double>& R, const Vector3<double>& T,
+    double margin,
+    Vector3<double>* contact_point,
+    double* penetration_depth,
+    Vector3<double>* normal);
+
+//==============================================================================
+extern template
+bool triangleMarginContact(
+    const Vector3<double>& P1, const Vector3<double>& P2, const Vector3<double>& P3,
+    const Vector3<double>& Q1, const Vector3<double>& Q2, const Vector3<double>& Q3,
+    const Transform3<double>& tf,
+    double margin,
+    Vector3<double>* contact_point,
+    double* penetration_depth,
+    Vector3<double>* normal);
+
+//==============================================================================
+/// @brief How a shape takes part in a query with a security margin.
+enum class MarginShapeKind
+{
+  /// The margin is handled by a bounded distance query.
+  GENERIC,
+  /// Growing the shape by the margin gives another shape of the same type.
+  INFLATABLE,
+  /// A halfspace, grown by moving its boundary.
+  HALFSPACE,
+  /// A plane, thickened into a slab of two halfspaces.
+  PLANE
+};
+
+//==============================================================================
+template <typename Shape>
+struct FCL_EXPORT MarginShapeTraits
+{
+  static constexpr MarginShapeKind kind = MarginShapeKind::GENERIC;
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT MarginShapeTraits<Sphere<S>>
+{
+  static constexpr MarginShapeKind kind = MarginShapeKind::INFLATABLE;
+
+  static Sphere<S> inflate(const Sphere<S>& s, S margin)
+  {
+    return Sphere<S>(s.radius + margin);
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT MarginShapeTraits<Capsule<S>>
+{
+  static constexpr MarginShapeKind kind = MarginShapeKind::INFLATABLE;
+
+  static Capsule<S> inflate(const Capsule<S>& s, S margin)
+  {
+    return Capsule<S>(s.radius + margin, s.lz);
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT MarginShapeTraits<Halfspace<S>>
+{
+  static constexpr MarginShapeKind kind = MarginShapeKind::HALFSPACE;
+
+  static Halfspace<S> inflate(const Halfspace<S>& s, S margin)
+  {
+    return Halfspace<S>(s.n, s.d + margin);
+  }
+};
+
+//==============================================================================
+template <typename S>
+struct FCL_EXPORT MarginShapeTraits<Plane<S>>
+{
+  static constexpr MarginShapeKind kind = MarginShapeKind::PLANE;
+
+  /// @brief The halfspace {x | n.x <= d + margin}
+  static Halfspace<S> upper(const Plane<S>& s, S margin)
+  {
+    return Halfspace<S>(s.n, s.d + margin);
+  }
+
+  /// @brief The halfspace {x | n.x >= d - margin}
+  static Halfspace<S> lower(const Plane<S>& s, S margin)
+  {
+    return Halfspace<S>(-s.n, -s.d + margin);
+  }
+};
+
+//==============================================================================
+/// @brief Which of the two shapes carries the margin, and how.
+enum class MarginStrategy
+{
+  INFLATE_FIRST,
+  INFLATE_SECOND,
+  SLAB_FIRST,
+  SLAB_SECOND,
+  DISTANCE
+};
+
+//==============================================================================
+template <typename Shape1, typename Shape2>
+struct FCL_EXPORT ShapePairMarginStrategy
+{
+  static constexpr MarginShapeKind kind1 = MarginShapeTraits<Shape1>::kind;
+  static constexpr MarginShapeKind kind2 = MarginShapeTraits<Shape2>::kind;
+
+  // Halfspaces and planes come first: the specialized kernels against them
+  // are exact, while the other shape may only be handled by GJK.
+  static constexpr MarginStrategy value
+      = kind2 == MarginShapeKind::HALFSPACE ? MarginStrategy::INFLATE_SECOND
+      : kind1 == MarginShapeKind::HALFSPACE ? MarginStrategy::INFLATE_FIRST
+      : kind2 == MarginShapeKind::PLANE ? MarginStrategy::SLAB_SECOND
+      : kind1 == MarginShapeKind::PLANE ? MarginStrategy::SLAB_FIRST
+      : kind1 == MarginShapeKind::INFLATABLE ? MarginStrategy::INFLATE_FIRST
+      : kind2 == MarginShapeKind::INFLATABLE ? MarginStrategy::INFLATE_SECOND
+      : MarginStrategy::DISTANCE;
+};
+
+//==============================================================================
+/// @brief Grows a penetration depth by the margin. Some kernels (the
+/// sphere-triangle test, the EPA of GJKSolver_indep) report depths negated, so
+/// the margin is added to the magnitude.
+template <typename S>
+S growPenetrationDepth(S depth, S margin)
+{
+  return depth < 0 ? depth - margin : depth + margin;
+}
+
+//==============================================================================
+template <typename S>
+S maxPenetrationDepth(const std::vector<ContactPoint<S>>& contacts)
+{
+  S depth = -std::numeric_limits<S>::max();
+  for(const auto& contact : contacts)
+    depth = std::max(depth, contact.penetration_depth);
+  return depth;
+}
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver,
+          MarginStrategy strategy
+              = ShapePairMarginStrategy<Shape1, Shape2>::value>
+struct FCL_EXPORT ShapeIntersectWithMarginImpl
+{
+  using S = typename Shape1::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      S margin,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    S dist;
+    Vector3<S> p1, p2;
+
+    // GJK stops as soon as the separation is known to exceed the margin.
+    const S upper_bound = nsolver->distance_upper_bound;
+    nsolver->distance_upper_bound = margin;
+    const bool separated
+        = nsolver->shapeDistance(s1, tf1, s2, tf2, &dist, &p1, &p2);
+    nsolver->distance_upper_bound = upper_bound;
+
+    if(separated && dist > 0)
+    {
+      if(dist >= margin)
+        return false;
+
+      if(contacts)
+        contacts->emplace_back((p2 - p1) / dist, (p1 + p2) * 0.5, margin - dist);
+
+      return true;
+    }
+
+    std::vector<ContactPoint<S>> penetration_contacts;
+    if(nsolver->shapeIntersect(s1, tf1, s2, tf2,
+                               contacts ? &penetration_contacts : nullptr))
+    {
+      if(contacts)
+      {
+        for(auto& contact : penetration_contacts)
+        {
+          contact.penetration_depth
+              = growPenetrationDepth(contact.penetration_depth, margin);
+          contacts->push_back(contact);
+        }
+      }
+      return true;
+    }
+
+    // The shapes touch: the two solver queries disagree on the boundary.
+    if(contacts)
+    {
+      Vector3<S> normal = tf2.translation() - tf1.translation();
+      if(normal.squaredNorm() > 0)
+        normal.normalize();
+      else
+        normal = Vector3<S>::UnitX();
+
+      const Vector3<S> pos = separated
+          ? Vector3<S>((p1 + p2) * 0.5)
+          : Vector3<S>((tf1.translation() + tf2.translation()) * 0.5);
+      contacts->emplace_back(normal, pos, margin);
+    }
+
+    return true;
+  }
+};
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeIntersectWithMarginImpl<
+    Shape1, Shape2, NarrowPhaseSolver, MarginStrategy::INFLATE_FIRST>
+{
+  using S = typename Shape1::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      S margin,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    return nsolver->shapeIntersect(
+          MarginShapeTraits<Shape1>::inflate(s1, margin), tf1, s2, tf2,
+          contacts);
+  }
+};
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeIntersectWithMarginImpl<
+    Shape1, Shape2, NarrowPhaseSolver, MarginStrategy::INFLATE_SECOND>
+{
+  using S = typename Shape1::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      S margin,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    return nsolver->shapeIntersect(
+          s1, tf1, MarginShapeTraits<Shape2>::inflate(s2, margin), tf2,
+          contacts);
+  }
+};
+
+//==============================================================================
+/// @brief Intersection test against a plane thickened into a slab: the shape
+/// must reach into both halfspaces bounding the slab. The contacts are those
+/// of the shallower side.
+template <typename S, typename UpperQuery, typename LowerQuery>
+bool slabIntersect(
+    const UpperQuery& intersect_upper,
+    const LowerQuery& intersect_lower,
+    std::vector<ContactPoint<S>>* contacts)
+{
+  if(!contacts)
+    return intersect_upper(nullptr) && intersect_lower(nullptr);
+
+  std::vector<ContactPoint<S>> upper_contacts;
+  std::vector<ContactPoint<S>> lower_contacts;
+  if(!intersect_upper(&upper_contacts) || !intersect_lower(&lower_contacts))
+    return false;
+
+  const std::vector<ContactPoint<S>>& shallower
+      = (maxPenetrationDepth(upper_contacts)
+         <= maxPenetrationDepth(lower_contacts))
+      ? upper_contacts : lower_contacts;
+  contacts->insert(contacts->end(), shallower.begin(), shallower.end());
+
+  return true;
+}
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeIntersectWithMarginImpl<
+    Shape1, Shape2, NarrowPhaseSolver, MarginStrategy::SLAB_FIRST>
+{
+  using S = typename Shape1::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      S margin,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    const Halfspace<S> upper = MarginShapeTraits<Shape1>::upper(s1, margin);
+    const Halfspace<S> lower = MarginShapeTraits<Shape1>::lower(s1, margin);
+
+    const auto intersect_upper = [&](std::vector<ContactPoint<S>>* c)
+    { return nsolver->shapeIntersect(upper, tf1, s2, tf2, c); };
+    const auto intersect_lower = [&](std::vector<ContactPoint<S>>* c)
+    { return nsolver->shapeIntersect(lower, tf1, s2, tf2, c); };
+
+    return slabIntersect<S>(intersect_upper, intersect_lower, contacts);
+  }
+};
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeIntersectWithMarginImpl<
+    Shape1, Shape2, NarrowPhaseSolver, MarginStrategy::SLAB_SECOND>
+{
+  using S = typename Shape1::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      S margin,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    const Halfspace<S> upper = MarginShapeTraits<Shape2>::upper(s2, margin);
+    const Halfspace<S> lower = MarginShapeTraits<Shape2>::lower(s2, margin);
+
+    const auto intersect_upper = [&](std::vector<ContactPoint<S>>* c)
+    { return nsolver->shapeIntersect(s1, tf1, upper, tf2, c); };
+    const auto intersect_lower = [&](std::vector<ContactPoint<S>>* c)
+    { return nsolver->shapeIntersect(s1, tf1, lower, tf2, c); };
+
+    return slabIntersect<S>(intersect_upper, intersect_lower, contacts);
+  }
+};
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape1& s1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2,
+    const Transform3<typename Shape1::S>& tf2,
+    typename Shape1::S margin,
+    std::vector<ContactPoint<typename Shape1::S>>* contacts)
+{
+  if(margin <= 0)
+    return nsolver->shapeIntersect(s1, tf1, s2, tf2, contacts);
+
+  return ShapeIntersectWithMarginImpl<Shape1, Shape2, NarrowPhaseSolver>::run(
+        nsolver, s1, tf1, s2, tf2, margin, contacts);
+}
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver,
+          MarginShapeKind kind = MarginShapeTraits<Shape>::kind>
+struct FCL_EXPORT ShapeTriangleIntersectWithMarginImpl
+{
+  using S = typename Shape::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape& s,
+      const Transform3<S>& tf1,
+      const Vector3<S>& P1,
+      const Vector3<S>& P2,
+      const Vector3<S>& P3,
+      const Transform3<S>& tf2,
+      S margin,
+      Vector3<S>* contact_point,
+      S* penetration_depth,
+      Vector3<S>* normal)
+  {
+    S dist;
+    Vector3<S> p1, p2;
+
+    const S upper_bound = nsolver->distance_upper_bound;
+    nsolver->distance_upper_bound = margin;
+    const bool separated = nsolver->shapeTriangleDistance(
+          s, tf1, P1, P2, P3, tf2, &dist, &p1, &p2);
+    nsolver->distance_upper_bound = upper_bound;
+
+    if(separated && dist > 0)
+    {
+      if(dist >= margin)
+        return false;
+
+      // The solvers' normal points from the shape to the triangle.
+      if(contact_point) *contact_point = (p1 + p2) * 0.5;
+      if(penetration_depth) *penetration_depth = margin - dist;
+      if(normal) *normal = (p2 - p1) / dist;
+
+      return true;
+    }
+
+    if(nsolver->shapeTriangleIntersect(
+         s, tf1, P1, P2, P3, tf2, contact_point, penetration_depth, normal))
+    {
+      if(penetration_depth)
+        *penetration_depth = growPenetrationDepth(*penetration_depth, margin);
+      return true;
+    }
+
+    // The shape touches the triangle.
+    const Vector3<S> centroid = tf2 * ((P1 + P2 + P3) / 3);
+    Vector3<S> dir = centroid - tf1.translation();
+    if(dir.squaredNorm() > 0)
+      dir.normalize();
+    else
+      dir = Vector3<S>::UnitX();
+
+    if(contact_point)
+      *contact_point = separated ? Vector3<S>((p1 + p2) * 0.5) : centroid;
+    if(penetration_depth) *penetration_depth = margin;
+    if(normal) *normal = dir;
+
+    return true;
+  }
+};
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+struct FCL_EXPORT InflatedShapeTriangleIntersectImpl
+{
+  using S = typename Shape::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape& s,
+      const Transform3<S>& tf1,
+      const Vector3<S>& P1,
+      const Vector3<S>& P2,
+      const Vector3<S>& P3,
+      const Transform3<S>& tf2,
+      S margin,
+      Vector3<S>* contact_point,
+      S* penetration_depth,
+      Vector3<S>* normal)
+  {
+    return nsolver->shapeTriangleIntersect(
+          MarginShapeTraits<Shape>::inflate(s, margin), tf1, P1, P2, P3, tf2,
+          contact_point, penetration_depth, normal);
+  }
+};
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeTriangleIntersectWithMarginImpl<
+    Shape, NarrowPhaseSolver, MarginShapeKind::INFLATABLE>
+  : InflatedShapeTriangleIntersectImpl<Shape, NarrowPhaseSolver>
+{
+};
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeTriangleIntersectWithMarginImpl<
+    Shape, NarrowPhaseSolver, MarginShapeKind::HALFSPACE>
+  : InflatedShapeTriangleIntersectImpl<Shape, NarrowPhaseSolver>
+{
+};
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+struct FCL_EXPORT ShapeTriangleIntersectWithMarginImpl<
+    Shape, NarrowPhaseSolver, MarginShapeKind::PLANE>
+{
+  using S = typename Shape::S;
+
+  static bool run(
+      const NarrowPhaseSolver* nsolver,
+      const Shape& s,
+      const Transform3<S>& tf1,
+      const Vector3<S>& P1,
+      const Vector3<S>& P2,
+      const Vector3<S>& P3,
+      const Transform3<S>& tf2,
+      S margin,
+      Vector3<S>* contact_point,
+      S* penetration_depth,
+      Vector3<S>* normal)
+  {
+    const Halfspace<S> upper = MarginShapeTraits<Shape>::upper(s, margin);
+    const Halfspace<S> lower = MarginShapeTraits<Shape>::lower(s, margin);
+
+    if(!contact_point && !penetration_depth && !normal)
+    {
+      return nsolver->shapeTriangleIntersect(upper, tf1, P1, P2, P3, tf2)
+          && nsolver->shapeTriangleIntersect(lower, tf1, P1, P2, P3, tf2);
+    }
+
+    Vector3<S> upper_point, lower_point, upper_normal, lower_normal;
+    S upper_depth, lower_depth;
+    if(!nsolver->shapeTriangleIntersect(upper, tf1, P1, P2, P3, tf2,
+                                        &upper_point, &upper_depth,
+                                        &upper_normal)
+       || !nsolver->shapeTriangleIntersect(lower, tf1, P1, P2, P3, tf2,
+                                           &lower_point, &lower_depth,
+                                           &lower_normal))
+      return false;
+
+    const bool use_upper = upper_depth <= lower_depth;
+    if(contact_point) *contact_point = use_upper ? upper_point : lower_point;
+    if(penetration_depth)
+      *penetration_depth = use_upper ? upper_depth : lower_depth;
+    if(normal) *normal = use_upper ? upper_normal : lower_normal;
+
+    return true;
+  }
+};
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeTriangleIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape& s,
+    const Transform3<typename Shape::S>& tf,
+    const Vector3<typename Shape::S>& P1,
+    const Vector3<typename Shape::S>& P2,
+    const Vector3<typename Shape::S>& P3,
+    typename Shape::S margin,
+    Vector3<typename Shape::S>* contact_point,
+    typename Shape::S* penetration_depth,
+    Vector3<typename Shape::S>* normal)
+{
+  using S = typename Shape::S;
+
+  if(margin <= 0)
+  {
+    return nsolver->shapeTriangleIntersect(
+          s, tf, P1, P2, P3, contact_point, penetration_depth, normal);
+  }
+
+  // The transformed overloads report all their points in the world frame.
+  return ShapeTriangleIntersectWithMarginImpl<Shape, NarrowPhaseSolver>::run(
+        nsolver, s, tf, P1, P2, P3, Transform3<S>::Identity(), margin,
+        contact_point, penetration_depth, normal);
+}
+
+//==============================================================================
+template <typename Shape, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeTriangleIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape& s,
+    const Transform3<typename Shape::S>& tf1,
+    const Vector3<typename Shape::S>& P1,
+    const Vector3<typename Shape::S>& P2,
+    const Vector3<typename Shape::S>& P3,
+    const Transform3<typename Shape::S>& tf2,
+    typename Shape::S margin,
+    Vector3<typename Shape::S>* contact_point,
+    typename Shape::S* penetration_depth,
+    Vector3<typename Shape::S>* normal)
+{
+  if(margin <= 0)
+  {
+    return nsolver->shapeTriangleIntersect(
+          s, tf1, P1, P2, P3, tf2, contact_point, penetration_depth, normal);
+  }
+
+  return ShapeTriangleIntersectWithMarginImpl<Shape, NarrowPhaseSolver>::run(
+        nsolver, s, tf1, P1, P2, P3, tf2, margin,
+        contact_point, penetration_depth, normal);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    S margin,
+    Vector3<S>* contact_point,
+    S* penetration_depth,
+    Vector3<S>* normal)
+{
+  if(margin <= 0)
+    return false;
+
+  Vector3<S> P, Q;
+  const S dist = TriangleDistance<S>::triDistance(P1, P2, P3, Q1, Q2, Q3, P, Q);
+  if(dist >= margin)
+    return false;
+
+  if(contact_point) *contact_point = (P + Q) * 0.5;
+  if(penetration_depth) *penetration_depth = margin - dist;
+  if(normal)
+  {
+    if(dist > 0)
+    {
+      *normal = (Q - P) / dist;
+    }
+    else
+    {
+      // Touching triangles: use the first triangle's normal, facing the
+      // second one.
+      Vector3<S> n = (P2 - P1).cross(P3 - P1);
+      if(n.squaredNorm() > 0)
+        n.normalize();
+      else
+        n = Vector3<S>::UnitX();
+      if(n.dot((Q1 + Q2 + Q3) / 3 - (P1 + P2 + P3) / 3) < 0)
+        n = -n;
+      *normal = n;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Matrix3<S>& R, const Vector3<S>& T,
+    S margin,
+    Vector3<S>* contact_point,
+    S* penetration_depth,
+    Vector3<S>* normal)
+{
+  if(margin <= 0)
+    return false;
+
+  return triangleMarginContact<S>(
+        P1, P2, P3, R * Q1 + T, R * Q2 + T, R * Q3 + T, margin,
+        contact_point, penetration_depth, normal);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Transform3<S>& tf,
+    S margin,
+    Vector3<S>* contact_point,
+    S* penetration_depth,
+    Vector3<S>* normal)
+{
+  if(margin <= 0)
+    return false;
+
+  return triangleMarginContact<S>(
+        P1, P2, P3, tf * Q1, tf * Q2, tf * Q3, margin,
+        contact_point, penetration_depth, normal);
+}
+
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+bool overlapWithMargin(const BV& b1, const BV& b2, typename BV::S margin)
+{
+  if(margin <= 0)
+    return b1.overlap(b2);
+
+  BV inflated = b1;
+  inflateBV(inflated, margin);
+  return inflated.overlap(b2);
+}
+
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+bool overlapWithMargin(
+    const Matrix3<typename BV::S>& R,
+    const Vector3<typename BV::S>& T,
+    const BV& b1,
+    const BV& b2,
+    typename BV::S margin)
+{
+  if(margin <= 0)
+    return overlap(R, T, b1, b2);
+
+  BV inflated = b1;
+  inflateBV(inflated, margin);
+  return overlap(R, T, inflated, b2);
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
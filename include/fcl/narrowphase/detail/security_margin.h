@@ -0,0 +1,170 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_SECURITYMARGIN_H
+#define FCL_NARROWPHASE_DETAIL_SECURITYMARGIN_H
+
+#include <vector>
+
+#include "fcl/common/types.h"
+#include "fcl/math/bv/utility.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/halfspace.h"
+#include "fcl/geometry/shape/plane.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/narrowphase/contact_point.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Intersection test between two shapes, where shapes closer than
+/// margin also intersect. The penetration depth of the contacts includes the
+/// margin. A non-positive margin is a plain NarrowPhaseSolver::shapeIntersect.
+///
+/// Spheres, capsules and halfspaces are grown by the margin and planes are
+/// thickened into a slab, which is exact; the other pairs run a distance query
+/// bounded by the margin before falling back to the plain intersection test.
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape1& s1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2,
+    const Transform3<typename Shape1::S>& tf2,
+    typename Shape1::S margin,
+    std::vector<ContactPoint<typename Shape1::S>>* contacts = nullptr);
+
+/// @brief Intersection test between a shape and a triangle, where a triangle
+/// closer than margin also intersects. The outputs follow
+/// NarrowPhaseSolver::shapeTriangleIntersect().
+template <typename Shape, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeTriangleIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape& s,
+    const Transform3<typename Shape::S>& tf,
+    const Vector3<typename Shape::S>& P1,
+    const Vector3<typename Shape::S>& P2,
+    const Vector3<typename Shape::S>& P3,
+    typename Shape::S margin,
+    Vector3<typename Shape::S>* contact_point = nullptr,
+    typename Shape::S* penetration_depth = nullptr,
+    Vector3<typename Shape::S>* normal = nullptr);
+
+/// @brief Intersection test between a shape and a triangle in configuration
+/// tf2, where a triangle closer than margin also intersects.
+template <typename Shape, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool shapeTriangleIntersectWithMargin(
+    const NarrowPhaseSolver* nsolver,
+    const Shape& s,
+    const Transform3<typename Shape::S>& tf1,
+    const Vector3<typename Shape::S>& P1,
+    const Vector3<typename Shape::S>& P2,
+    const Vector3<typename Shape::S>& P3,
+    const Transform3<typename Shape::S>& tf2,
+    typename Shape::S margin,
+    Vector3<typename Shape::S>* contact_point = nullptr,
+    typename Shape::S* penetration_depth = nullptr,
+    Vector3<typename Shape::S>* normal = nullptr);
+
+/// @brief Contact between two disjoint triangles closer than margin. The
+/// contact lies halfway between the closest points, its normal points from
+/// the first triangle to the second and its depth is margin minus the
+/// distance. Returns false when the margin is not positive or the triangles
+/// are at least margin apart.
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    S margin,
+    Vector3<S>* contact_point = nullptr,
+    S* penetration_depth = nullptr,
+    Vector3<S>* normal = nullptr);
+
+/// @brief Same as above, with the second triangle in the configuration (R, T)
+/// relative to the first one. The outputs are in the first triangle's frame.
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Matrix3<S>& R, const Vector3<S>& T,
+    S margin,
+    Vector3<S>* contact_point = nullptr,
+    S* penetration_depth = nullptr,
+    Vector3<S>* normal = nullptr);
+
+/// @brief Same as above, with the second triangle in the configuration tf
+/// relative to the first one. The outputs are in the first triangle's frame.
+template <typename S>
+FCL_EXPORT
+bool triangleMarginContact(
+    const Vector3<S>& P1, const Vector3<S>& P2, const Vector3<S>& P3,
+    const Vector3<S>& Q1, const Vector3<S>& Q2, const Vector3<S>& Q3,
+    const Transform3<S>& tf,
+    S margin,
+    Vector3<S>* contact_point = nullptr,
+    S* penetration_depth = nullptr,
+    Vector3<S>* normal = nullptr);
+
+/// @brief Overlap test between two bounding volumes in the same frame, with
+/// the first one grown by margin.
+template <typename BV>
+FCL_EXPORT
+bool overlapWithMargin(const BV& b1, const BV& b2, typename BV::S margin);
+
+/// @brief Overlap test between two bounding volumes, the second one in the
+/// configuration (R, T) relative to the first one, with the first one grown
+/// by margin.
+template <typename BV>
+FCL_EXPORT
+bool overlapWithMargin(
+    const Matrix3<typename BV::S>& R,
+    const Vector3<typename BV::S>& T,
+    const BV& b1,
+    const BV& b2,
+    typename BV::S margin);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/security_margin-inl.h"
+
+#endif
@@ -121,7 +121,8 @@ template <typename BV>
 bool BVHCollisionTraversalNode<BV>::BVTesting(int b1, int b2) const
 {
   if(this->enable_statistics) num_bv_tests++;
-  return !model1->getBV(b1).overlap(model2->getBV(b2));
+  return !overlapWithMargin(model1->getBV(b1).bv, model2->getBV(b2).bv,
+                            this->request.security_margin);
 }
 
 } // namespace detail
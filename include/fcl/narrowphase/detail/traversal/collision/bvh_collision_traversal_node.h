@@ -39,6 +39,7 @@
 #define FCL_TRAVERSAL_BVHCOLLISIONTRAVERSALNODE_H
 
 #include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/narrowphase/detail/security_margin.h"
 #include "fcl/narrowphase/detail/traversal/collision/collision_traversal_node_base.h"
 
 namespace fcl
@@ -149,7 +149,9 @@ void MeshCollisionTraversalNode<BV>::leafTesting(int b1, int b2) const
 
     if(!this->request.enable_contact) // only interested in collision or not
     {
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3))
+      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3)
+         || triangleMarginContact(p1, p2, p3, q1, q2, q3,
+                                  this->request.security_margin))
       {
         is_intersect = true;
         if(this->result->numContacts() < this->request.num_max_contacts)
@@ -170,7 +172,18 @@ void MeshCollisionTraversalNode<BV>::leafTesting(int b1, int b2) const
                                        &normal))
       {
         is_intersect = true;
+        penetration += this->request.security_margin;
+      }
+      else if(triangleMarginContact(p1, p2, p3, q1, q2, q3,
+                                    this->request.security_margin,
+                                    contacts, &penetration, &normal))
+      {
+        is_intersect = true;
+        n_contacts = 1;
+      }
 
+      if(is_intersect)
+      {
         if(this->request.num_max_contacts < n_contacts + this->result->numContacts())
           n_contacts = (this->request.num_max_contacts >= this->result->numContacts()) ? (this->request.num_max_contacts - this->result->numContacts()) : 0;
 
@@ -293,7 +306,9 @@ bool MeshCollisionTraversalNodeOBB<S>::BVTesting(int b1, int b2) const
 {
   if(this->enable_statistics) this->num_bv_tests++;
 
-  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+  return !overlapWithMargin(R, T, this->model1->getBV(b1).bv,
+                            this->model2->getBV(b2).bv,
+                            this->request.security_margin);
 }
 
 //==============================================================================
@@ -329,7 +344,8 @@ bool MeshCollisionTraversalNodeOBB<S>::BVTesting(
 
   return obbDisjoint(
         Rc, Tc,
-        this->model1->getBV(b1).bv.extent,
+        Vector3<S>(this->model1->getBV(b1).bv.extent.array()
+                   + this->request.security_margin),
         this->model2->getBV(b2).bv.extent);
 }
 
@@ -341,7 +357,8 @@ bool MeshCollisionTraversalNodeOBB<S>::BVTesting(
   if(this->enable_statistics) this->num_bv_tests++;
 
   return obbDisjoint(tf,
-        this->model1->getBV(b1).bv.extent,
+        Vector3<S>(this->model1->getBV(b1).bv.extent.array()
+                   + this->request.security_margin),
         this->model2->getBV(b2).bv.extent);
 }
 
@@ -412,7 +429,9 @@ bool MeshCollisionTraversalNodeRSS<S>::BVTesting(int b1, int b2) const
 {
   if(this->enable_statistics) this->num_bv_tests++;
 
-  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+  return !overlapWithMargin(R, T, this->model1->getBV(b1).bv,
+                            this->model2->getBV(b2).bv,
+                            this->request.security_margin);
 }
 
 //==============================================================================
@@ -454,7 +473,9 @@ bool MeshCollisionTraversalNodekIOS<S>::BVTesting(int b1, int b2) const
 {
   if(this->enable_statistics) this->num_bv_tests++;
 
-  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+  return !overlapWithMargin(R, T, this->model1->getBV(b1).bv,
+                            this->model2->getBV(b2).bv,
+                            this->request.security_margin);
 }
 
 //==============================================================================
@@ -496,7 +517,9 @@ bool MeshCollisionTraversalNodeOBBRSS<S>::BVTesting(int b1, int b2) const
 {
   if(this->enable_statistics) this->num_bv_tests++;
 
-  return !overlap(R, T, this->model1->getBV(b1).bv, this->model2->getBV(b2).bv);
+  return !overlapWithMargin(R, T, this->model1->getBV(b1).bv,
+                            this->model2->getBV(b2).bv,
+                            this->request.security_margin);
 }
 
 //==============================================================================
@@ -568,7 +591,9 @@ void meshCollisionOrientedNodeLeafTesting(
 
     if(!request.enable_contact) // only interested in collision or not
     {
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, R, T))
+      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, R, T)
+         || triangleMarginContact(p1, p2, p3, q1, q2, q3, R, T,
+                                  request.security_margin))
       {
         is_intersect = true;
         if(result.numContacts() < request.num_max_contacts)
@@ -590,7 +615,18 @@ void meshCollisionOrientedNodeLeafTesting(
                                        &normal))
       {
         is_intersect = true;
+        penetration += request.security_margin;
+      }
+      else if(triangleMarginContact(p1, p2, p3, q1, q2, q3, R, T,
+                                    request.security_margin,
+                                    contacts, &penetration, &normal))
+      {
+        is_intersect = true;
+        n_contacts = 1;
+      }
 
+      if(is_intersect)
+      {
         if(request.num_max_contacts < result.numContacts() + n_contacts)
           n_contacts = (request.num_max_contacts > result.numContacts()) ? (request.num_max_contacts - result.numContacts()) : 0;
 
@@ -665,7 +701,9 @@ void meshCollisionOrientedNodeLeafTesting(
 
     if(!request.enable_contact) // only interested in collision or not
     {
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, tf))
+      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, tf)
+         || triangleMarginContact(p1, p2, p3, q1, q2, q3, tf,
+                                  request.security_margin))
       {
         is_intersect = true;
         if(result.numContacts() < request.num_max_contacts)
@@ -683,7 +721,18 @@ void meshCollisionOrientedNodeLeafTesting(
            p1, p2, p3, q1, q2, q3, tf, contacts, &n_contacts, &penetration, &normal))
       {
         is_intersect = true;
+        penetration += request.security_margin;
+      }
+      else if(triangleMarginContact(p1, p2, p3, q1, q2, q3, tf,
+                                    request.security_margin,
+                                    contacts, &penetration, &normal))
+      {
+        is_intersect = true;
+        n_contacts = 1;
+      }
 
+      if(is_intersect)
+      {
         if(request.num_max_contacts < result.numContacts() + n_contacts)
           n_contacts = (request.num_max_contacts > result.numContacts()) ? (request.num_max_contacts - result.numContacts()) : 0;
 
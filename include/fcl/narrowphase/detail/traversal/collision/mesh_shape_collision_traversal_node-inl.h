@@ -82,7 +82,7 @@ void MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::leafTesting(
 
     if(!this->request.enable_contact)
     {
-      if(nsolver->shapeTriangleIntersect(*(this->model2), this->tf2, p1, p2, p3, nullptr, nullptr, nullptr))
+      if(shapeTriangleIntersectWithMargin(nsolver, *(this->model2), this->tf2, p1, p2, p3, this->request.security_margin))
       {
         is_intersect = true;
         if(this->request.num_max_contacts > this->result->numContacts())
@@ -95,7 +95,7 @@ void MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::leafTesting(
       Vector3<S> normal;
       Vector3<S> contactp;
 
-      if(nsolver->shapeTriangleIntersect(*(this->model2), this->tf2, p1, p2, p3, &contactp, &penetration, &normal))
+      if(shapeTriangleIntersectWithMargin(nsolver, *(this->model2), this->tf2, p1, p2, p3, this->request.security_margin, &contactp, &penetration, &normal))
       {
         is_intersect = true;
         if(this->request.num_max_contacts > this->result->numContacts())
@@ -114,7 +114,7 @@ void MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::leafTesting(
   }
   if((!this->model1->isFree() && !this->model2->isFree()) && this->request.enable_cost)
   {
-    if(nsolver->shapeTriangleIntersect(*(this->model2), this->tf2, p1, p2, p3, nullptr, nullptr, nullptr))
+    if(shapeTriangleIntersectWithMargin(nsolver, *(this->model2), this->tf2, p1, p2, p3, this->request.security_margin))
     {
       AABB<S> overlap_part;
       AABB<S> shape_aabb;
@@ -175,6 +175,7 @@ bool initialize(
   node.nsolver = nsolver;
 
   computeBV(model2, tf2, node.model2_bv);
+  inflateBV(node.model2_bv, request.security_margin);
 
   node.vertices = model1.vertices;
   node.tri_indices = model1.tri_indices;
@@ -223,7 +224,7 @@ void meshShapeCollisionOrientedNodeLeafTesting(
 
     if(!request.enable_contact) // only interested in collision or not
     {
-      if(nsolver->shapeTriangleIntersect(model2, tf2, p1, p2, p3, tf1, nullptr, nullptr, nullptr))
+      if(shapeTriangleIntersectWithMargin(nsolver, model2, tf2, p1, p2, p3, tf1, request.security_margin))
       {
         is_intersect = true;
         if(request.num_max_contacts > result.numContacts())
@@ -236,7 +237,7 @@ void meshShapeCollisionOrientedNodeLeafTesting(
       Vector3<S> normal;
       Vector3<S> contactp;
 
-      if(nsolver->shapeTriangleIntersect(model2, tf2, p1, p2, p3, tf1, &contactp, &penetration, &normal))
+      if(shapeTriangleIntersectWithMargin(nsolver, model2, tf2, p1, p2, p3, tf1, request.security_margin, &contactp, &penetration, &normal))
       {
         is_intersect = true;
         if(request.num_max_contacts > result.numContacts())
@@ -255,7 +256,7 @@ void meshShapeCollisionOrientedNodeLeafTesting(
   }
   else if((!model1->isFree() || model2.isFree()) && request.enable_cost)
   {
-    if(nsolver->shapeTriangleIntersect(model2, tf2, p1, p2, p3, tf1, nullptr, nullptr, nullptr))
+    if(shapeTriangleIntersectWithMargin(nsolver, model2, tf2, p1, p2, p3, tf1, request.security_margin))
     {
       AABB<S> overlap_part;
       AABB<S> shape_aabb;
@@ -393,6 +394,7 @@ bool setupMeshShapeCollisionOrientedNode(
   node.nsolver = nsolver;
 
   computeBV(model2, tf2, node.model2_bv);
+  inflateBV(node.model2_bv, request.security_margin);
 
   node.vertices = model1.vertices;
   node.tri_indices = model1.tri_indices;
@@ -39,6 +39,7 @@
 #define FCL_TRAVERSAL_MESHSHAPECOLLISIONTRAVERSALNODE_H
 
 #include "fcl/geometry/shape/utility.h"
+#include "fcl/narrowphase/detail/security_margin.h"
 #include "fcl/narrowphase/detail/traversal/collision/bvh_shape_collision_traversal_node.h"
 
 namespace fcl
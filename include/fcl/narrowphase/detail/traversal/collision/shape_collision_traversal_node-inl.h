@@ -71,18 +71,38 @@ template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
 void ShapeCollisionTraversalNode<Shape1, Shape2, NarrowPhaseSolver>::
 leafTesting(int, int) const
 {
-  if(model1->isOccupied() && model2->isOccupied())
+  collideShapes(*model1, this->tf1, *model2, this->tf2, nsolver,
+                this->request, cost_density, *this->result);
+}
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+void collideShapes(
+    const Shape1& shape1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& shape2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename Shape1::S>& request,
+    typename Shape1::S cost_density,
+    CollisionResult<typename Shape1::S>& result)
+{
+  using S = typename Shape1::S;
+
+  if(shape1.isOccupied() && shape2.isOccupied())
   {
     bool is_collision = false;
-    if(this->request.enable_contact)
+    if(request.enable_contact)
     {
       std::vector<ContactPoint<S>> contacts;
-      if(nsolver->shapeIntersect(*model1, this->tf1, *model2, this->tf2, &contacts))
+      if(shapeIntersectWithMargin(
+           nsolver, shape1, tf1, shape2, tf2, request.security_margin,
+           &contacts))
       {
         is_collision = true;
-        if(this->request.num_max_contacts > this->result->numContacts())
+        if(request.num_max_contacts > result.numContacts())
         {
-          const size_t free_space = this->request.num_max_contacts - this->result->numContacts();
+          const size_t free_space = request.num_max_contacts - result.numContacts();
           size_t num_adding_contacts;
 
           // If the free space is not enough to add all the new contacts, we add contacts in descent order of penetration depth.
@@ -97,40 +117,42 @@ leafTesting(int, int) const
           }
 
           for(size_t i = 0; i < num_adding_contacts; ++i)
-            this->result->addContact(Contact<S>(model1, model2, Contact<S>::NONE, Contact<S>::NONE, contacts[i].pos, contacts[i].normal, contacts[i].penetration_depth));
+            result.addContact(Contact<S>(&shape1, &shape2, Contact<S>::NONE, Contact<S>::NONE, contacts[i].pos, contacts[i].normal, contacts[i].penetration_depth));
         }
       }
     }
     else
     {
-      if(nsolver->shapeIntersect(*model1, this->tf1, *model2, this->tf2, nullptr))
+      if(shapeIntersectWithMargin(
+           nsolver, shape1, tf1, shape2, tf2, request.security_margin))
       {
         is_collision = true;
-        if(this->request.num_max_contacts > this->result->numContacts())
-          this->result->addContact(Contact<S>(model1, model2, Contact<S>::NONE, Contact<S>::NONE));
+        if(request.num_max_contacts > result.numContacts())
+          result.addContact(Contact<S>(&shape1, &shape2, Contact<S>::NONE, Contact<S>::NONE));
       }
     }
 
-    if(is_collision && this->request.enable_cost)
+    if(is_collision && request.enable_cost)
     {
       AABB<S> aabb1, aabb2;
-      computeBV(*model1, this->tf1, aabb1);
-      computeBV(*model2, this->tf2, aabb2);
+      computeBV(shape1, tf1, aabb1);
+      computeBV(shape2, tf2, aabb2);
       AABB<S> overlap_part;
       aabb1.overlap(aabb2, overlap_part);
-      this->result->addCostSource(CostSource<S>(overlap_part, cost_density), this->request.num_max_cost_sources);
+      result.addCostSource(CostSource<S>(overlap_part, cost_density), request.num_max_cost_sources);
     }
   }
-  else if((!model1->isFree() && !model2->isFree()) && this->request.enable_cost)
+  else if((!shape1.isFree() && !shape2.isFree()) && request.enable_cost)
   {
-    if(nsolver->shapeIntersect(*model1, this->tf1, *model2, this->tf2, nullptr))
+    if(shapeIntersectWithMargin(
+         nsolver, shape1, tf1, shape2, tf2, request.security_margin))
     {
       AABB<S> aabb1, aabb2;
-      computeBV(*model1, this->tf1, aabb1);
-      computeBV(*model2, this->tf2, aabb2);
+      computeBV(shape1, tf1, aabb1);
+      computeBV(shape2, tf2, aabb2);
       AABB<S> overlap_part;
       aabb1.overlap(aabb2, overlap_part);
-      this->result->addCostSource(CostSource<S>(overlap_part, cost_density), this->request.num_max_cost_sources);
+      result.addCostSource(CostSource<S>(overlap_part, cost_density), request.num_max_cost_sources);
     }
   }
 }
@@ -40,6 +40,7 @@
 
 #include "fcl/narrowphase/contact_point.h"
 #include "fcl/geometry/shape/utility.h"
+#include "fcl/narrowphase/detail/security_margin.h"
 #include "fcl/narrowphase/detail/traversal/collision/collision_traversal_node_base.h"
 
 namespace fcl
@@ -73,6 +74,21 @@ public:
   const NarrowPhaseSolver* nsolver;
 };
 
+/// @brief Collides two shapes with the given solver and records the contacts
+/// and cost sources in result, as the leaf test of
+/// ShapeCollisionTraversalNode does. Callers that know the shape types at
+/// compile time may use it directly, bypassing the traversal node.
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+void collideShapes(
+    const Shape1& shape1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& shape2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename Shape1::S>& request,
+    typename Shape1::S cost_density,
+    CollisionResult<typename Shape1::S>& result);
+
 /// @brief Initialize traversal node for collision between two geometric shapes,
 /// given current object transform
 template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
@@ -86,7 +86,7 @@ void ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::leafTesting(
 
     if(!this->request.enable_contact)
     {
-      if(nsolver->shapeTriangleIntersect(*(this->model1), this->tf1, p1, p2, p3, nullptr, nullptr, nullptr))
+      if(shapeTriangleIntersectWithMargin(nsolver, *(this->model1), this->tf1, p1, p2, p3, this->request.security_margin))
       {
         is_intersect = true;
         if(this->request.num_max_contacts > this->result->numContacts())
@@ -99,7 +99,7 @@ void ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::leafTesting(
       Vector3<S> normal;
       Vector3<S> contactp;
 
-      if(nsolver->shapeTriangleIntersect(*(this->model1), this->tf1, p1, p2, p3, &contactp, &penetration, &normal))
+      if(shapeTriangleIntersectWithMargin(nsolver, *(this->model1), this->tf1, p1, p2, p3, this->request.security_margin, &contactp, &penetration, &normal))
       {
         is_intersect = true;
         if(this->request.num_max_contacts > this->result->numContacts())
@@ -118,7 +118,7 @@ void ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::leafTesting(
   }
   else if((!this->model1->isFree() && !this->model2->isFree()) && this->request.enable_cost)
   {
-    if(nsolver->shapeTriangleIntersect(*(this->model1), this->tf1, p1, p2, p3, nullptr, nullptr, nullptr))
+    if(shapeTriangleIntersectWithMargin(nsolver, *(this->model1), this->tf1, p1, p2, p3, this->request.security_margin))
     {
       AABB<S> overlap_part;
       AABB<S> shape_aabb;
@@ -181,6 +181,7 @@ bool initialize(
   node.nsolver = nsolver;
 
   computeBV(model1, tf1, node.model1_bv);
+  inflateBV(node.model1_bv, request.security_margin);
 
   node.vertices = model2.vertices;
   node.tri_indices = model2.tri_indices;
@@ -327,6 +328,7 @@ static bool setupShapeMeshCollisionOrientedNode(OrientedNode<Shape, NarrowPhaseS
   node.nsolver = nsolver;
 
   computeBV(model1, tf1, node.model1_bv);
+  inflateBV(node.model1_bv, request.security_margin);
 
   node.vertices = model2.vertices;
   node.tri_indices = model2.tri_indices;
@@ -149,6 +149,9 @@ bool MeshDistanceTraversalNode<BV>::canStop(typename BV::S c) const
 {
   if((c >= this->result->min_distance - abs_err) && (c * (1 + rel_err) >= this->result->min_distance))
     return true;
+  // No pair under this node can be closer than the requested upper bound
+  if(c >= this->request.distance_upper_bound)
+    return true;
   return false;
 }
 
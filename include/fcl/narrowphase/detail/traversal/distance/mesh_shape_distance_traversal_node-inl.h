@@ -103,6 +103,9 @@ canStop(S c) const
 {
   if((c >= this->result->min_distance - abs_err) && (c * (1 + rel_err) >= this->result->min_distance))
     return true;
+  // No pair under this node can be closer than the requested upper bound
+  if(c >= this->request.distance_upper_bound)
+    return true;
   return false;
 }
 
@@ -69,6 +69,21 @@ ShapeDistanceTraversalNode<Shape1, Shape2, NarrowPhaseSolver>::BVTesting(int, in
 template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
 void ShapeDistanceTraversalNode<Shape1, Shape2, NarrowPhaseSolver>::leafTesting(
     int, int) const
+{
+  distanceShapes(*model1, this->tf1, *model2, this->tf2, nsolver,
+                 this->request, *this->result);
+}
+
+//==============================================================================
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+void distanceShapes(
+    const Shape1& shape1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& shape2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename Shape1::S>& request,
+    DistanceResult<typename Shape1::S>& result)
 {
   using S = typename Shape1::S;
 
@@ -82,19 +97,19 @@ void ShapeDistanceTraversalNode<Shape1, Shape2, NarrowPhaseSolver>::leafTesting(
   Vector3<S> closest_p1 = Vector3<S>::Zero();
   Vector3<S> closest_p2 = Vector3<S>::Zero();
 
-  if (this->request.enable_signed_distance == true)
+  if (request.enable_signed_distance == true)
   {
-    nsolver->shapeSignedDistance(*model1, this->tf1, *model2, this->tf2, &distance, &closest_p1, &closest_p2);
+    nsolver->shapeSignedDistance(shape1, tf1, shape2, tf2, &distance, &closest_p1, &closest_p2);
   }
   else
   {
-    nsolver->shapeDistance(*model1, this->tf1, *model2, this->tf2, &distance, &closest_p1, &closest_p2);
+    nsolver->shapeDistance(shape1, tf1, shape2, tf2, &distance, &closest_p1, &closest_p2);
   }
 
-  this->result->update(
+  result.update(
         distance,
-        model1,
-        model2,
+        &shape1,
+        &shape2,
         DistanceResult<S>::NONE,
         DistanceResult<S>::NONE,
         closest_p1,
@@ -69,6 +69,20 @@ public:
   const NarrowPhaseSolver* nsolver;
 };
 
+/// @brief Computes the distance between two shapes with the given solver and
+/// updates result, as the leaf test of ShapeDistanceTraversalNode does.
+/// Callers that know the shape types at compile time may use it directly,
+/// bypassing the traversal node.
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+void distanceShapes(
+    const Shape1& shape1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& shape2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename Shape1::S>& request,
+    DistanceResult<typename Shape1::S>& result);
+
 /// @brief Initialize traversal node for distance between two geometric shapes
 template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
 bool initialize(
@@ -41,6 +41,7 @@
 #include "fcl/narrowphase/distance.h"
 
 #include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/detail/traversal/distance/shape_distance_traversal_node.h"
 
 namespace fcl
 {
@@ -53,6 +54,14 @@ double distance(
     const DistanceRequest<double>& request,
     DistanceResult<double>& result);
 
+//==============================================================================
+extern template
+float distance(
+    const CollisionObject<float>* o1,
+    const CollisionObject<float>* o2,
+    const DistanceRequest<float>& request,
+    DistanceResult<float>& result);
+
 //==============================================================================
 extern template
 double distance(
@@ -60,6 +69,13 @@ double distance(
     const CollisionGeometry<double>* o2, const Transform3<double>& tf2,
     const DistanceRequest<double>& request, DistanceResult<double>& result);
 
+//==============================================================================
+extern template
+float distance(
+    const CollisionGeometry<float>* o1, const Transform3<float>& tf1,
+    const CollisionGeometry<float>* o2, const Transform3<float>& tf2,
+    const DistanceRequest<float>& request, DistanceResult<float>& result);
+
 //==============================================================================
 template <typename GJKSolver>
 detail::DistanceFunctionMatrix<GJKSolver>& getDistanceFunctionLookTable()
@@ -68,6 +84,97 @@ detail::DistanceFunctionMatrix<GJKSolver>& getDistanceFunctionLookTable()
   return table;
 }
 
+namespace detail
+{
+
+//==============================================================================
+/// @brief Reports the deepest contact of a collision query as a negative
+/// distance, for the cases where the distance query itself cannot measure
+/// penetration.
+template <typename S>
+void setSignedDistanceFromContacts(
+    const CollisionResult<S>& collision_result,
+    const DistanceRequest<S>& request,
+    DistanceResult<S>& result)
+{
+  assert(collision_result.isCollision());
+
+  std::size_t index = static_cast<std::size_t>(-1);
+  S max_pen_depth = std::numeric_limits<S>::min();
+  for (auto i = 0u; i < collision_result.numContacts(); ++i)
+  {
+    const auto& contact = collision_result.getContact(i);
+    if (max_pen_depth < contact.penetration_depth)
+    {
+      max_pen_depth = contact.penetration_depth;
+      index = i;
+    }
+  }
+  result.min_distance = -max_pen_depth;
+  assert(index != static_cast<std::size_t>(-1));
+
+  if (request.enable_nearest_points)
+  {
+    const Vector3<S>& pos = collision_result.getContact(index).pos;
+    result.nearest_points[0] = pos;
+    result.nearest_points[1] = pos;
+    // Note: The pair of nearest points is not guaranteed to be on the
+    // surface of the objects.
+  }
+}
+
+//==============================================================================
+/// @brief Statically dispatched counterpart of ShapeShapeDistance(): computes
+/// the distance between two shapes of known types with the given solver,
+/// without a traversal node. Applies the same signed distance fallback as the
+/// CollisionGeometry overload of distance().
+template <typename Shape1, typename Shape2, typename NarrowPhaseSolver>
+typename Shape1::S distanceShapePair(
+    const Shape1& s1,
+    const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2,
+    const Transform3<typename Shape1::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename Shape1::S>& request,
+    DistanceResult<typename Shape1::S>& result)
+{
+  using S = typename Shape1::S;
+
+  if(request.enable_solver_statistics)
+    nsolver->enableStatistics(true);
+
+  distanceShapes(s1, tf1, s2, tf2, nsolver, request, result);
+  const S res = result.min_distance;
+
+  if(request.enable_solver_statistics)
+  {
+    result.solver_statistics.update(nsolver->getStatistics());
+    nsolver->enableStatistics(false);
+  }
+
+  if(result.min_distance < static_cast<S>(0)
+     && request.enable_signed_distance
+     && !std::is_same<NarrowPhaseSolver, GJKSolver_libccd<S>>::value)
+  {
+    CollisionRequest<S> collision_request;
+    collision_request.enable_contact = true;
+    collision_request.enable_solver_statistics =
+        request.enable_solver_statistics;
+
+    CollisionResult<S> collision_result;
+
+    collideShapePair(s1, tf1, s2, tf2, nsolver, collision_request,
+                     collision_result);
+
+    setSignedDistanceFromContacts(collision_result, request, result);
+    result.solver_statistics.update(collision_result.solver_statistics);
+  }
+
+  return res;
+}
+
+} // namespace detail
+
 //==============================================================================
 template <typename NarrowPhaseSolver>
 typename NarrowPhaseSolver::S distance(
@@ -113,6 +220,8 @@ typename NarrowPhaseSolver::S distance(
 
   S res = std::numeric_limits<S>::max();
 
+  if(request.enable_solver_statistics)
+    nsolver->enableStatistics(true);
 
   if(object_type1 == OT_GEOM && object_type2 == OT_BVH)
   {
@@ -137,6 +246,12 @@ typename NarrowPhaseSolver::S distance(
     }
   }
 
+  if(request.enable_solver_statistics)
+  {
+    result.solver_statistics.update(nsolver->getStatistics());
+    nsolver->enableStatistics(false);
+  }
+
   // TODO(JS): FCL supports negative distance calculation only for OT_GEOM shape
   // types (i.e., primitive shapes like sphere, cylinder, box, and so on). As a
   // workaround for the rest shape types like mesh and octree, following
@@ -156,34 +271,15 @@ typename NarrowPhaseSolver::S distance(
 
     CollisionRequest<S> collision_request;
     collision_request.enable_contact = true;
+    collision_request.enable_solver_statistics =
+        request.enable_solver_statistics;
 
     CollisionResult<S> collision_result;
 
     collide(o1, tf1, o2, tf2, nsolver, collision_request, collision_result);
-    assert(collision_result.isCollision());
-
-    std::size_t index = static_cast<std::size_t>(-1);
-    S max_pen_depth = std::numeric_limits<S>::min();
-    for (auto i = 0u; i < collision_result.numContacts(); ++i)
-    {
-      const auto& contact = collision_result.getContact(i);
-      if (max_pen_depth < contact.penetration_depth)
-      {
-        max_pen_depth = contact.penetration_depth;
-        index = i;
-      }
-    }
-    result.min_distance = -max_pen_depth;
-    assert(index != static_cast<std::size_t>(-1));
 
-    if (request.enable_nearest_points)
-    {
-      const Vector3<S>& pos = collision_result.getContact(index).pos;
-      result.nearest_points[0] = pos;
-      result.nearest_points[1] = pos;
-      // Note: The pair of nearest points is not guaranteed to be on the
-      // surface of the objects.
-    }
+    detail::setSignedDistanceFromContacts(collision_result, request, result);
+    result.solver_statistics.update(collision_result.solver_statistics);
   }
 
   if(!nsolver_)
@@ -206,12 +302,14 @@ S distance(
     {
       detail::GJKSolver_libccd<S> solver;
       solver.distance_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
       return distance(o1, o2, &solver, request, result);
     }
   case GST_INDEP:
     {
       detail::GJKSolver_indep<S> solver;
       solver.gjk_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
       return distance(o1, o2, &solver, request, result);
     }
   default:
@@ -232,12 +330,14 @@ S distance(
     {
       detail::GJKSolver_libccd<S> solver;
       solver.distance_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
       return distance(o1, tf1, o2, tf2, &solver, request, result);
     }
   case GST_INDEP:
     {
       detail::GJKSolver_indep<S> solver;
       solver.gjk_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
       return distance(o1, tf1, o2, tf2, &solver, request, result);
     }
   default:
@@ -245,6 +345,41 @@ S distance(
   }
 }
 
+//==============================================================================
+template <typename Shape1, typename Shape2>
+FCL_EXPORT
+typename Shape1::S distance(
+    const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2, const Transform3<typename Shape1::S>& tf2,
+    const DistanceRequest<typename Shape1::S>& request,
+    DistanceResult<typename Shape1::S>& result)
+{
+  using S = typename Shape1::S;
+  static_assert(std::is_base_of<ShapeBase<S>, Shape1>::value
+                && std::is_base_of<ShapeBase<S>, Shape2>::value,
+                "Static dispatch is only available for primitive shapes");
+
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    {
+      detail::GJKSolver_libccd<S> solver;
+      solver.distance_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
+      return detail::distanceShapePair(s1, tf1, s2, tf2, &solver, request, result);
+    }
+  case GST_INDEP:
+    {
+      detail::GJKSolver_indep<S> solver;
+      solver.gjk_tolerance = request.distance_tolerance;
+      solver.distance_upper_bound = request.distance_upper_bound;
+      return detail::distanceShapePair(s1, tf1, s2, tf2, &solver, request, result);
+    }
+  default:
+    return -1;
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -61,6 +61,18 @@ S distance(
     const CollisionGeometry<S>* o2, const Transform3<S>& tf2,
     const DistanceRequest<S>& request, DistanceResult<S>& result);
 
+/// @brief Distance between two primitive shapes whose types are known at
+/// compile time. The narrowphase kernel for the pair is resolved statically,
+/// so neither the distance function matrix nor a traversal node is involved.
+/// The result is reported as by the CollisionGeometry overload.
+template <typename Shape1, typename Shape2>
+FCL_EXPORT
+typename Shape1::S distance(
+    const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
+    const Shape2& s2, const Transform3<typename Shape1::S>& tf2,
+    const DistanceRequest<typename Shape1::S>& request,
+    DistanceResult<typename Shape1::S>& result);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/distance-inl.h"
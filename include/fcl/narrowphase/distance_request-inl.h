@@ -40,6 +40,8 @@
 
 #include "fcl/narrowphase/distance_request.h"
 
+#include <limits>
+
 #include "fcl/narrowphase/distance_result.h"
 
 namespace fcl
@@ -49,6 +51,10 @@ namespace fcl
 extern template
 struct DistanceRequest<double>;
 
+//==============================================================================
+extern template
+struct DistanceRequest<float>;
+
 //==============================================================================
 template <typename S>
 DistanceRequest<S>::DistanceRequest(
@@ -63,7 +69,9 @@ DistanceRequest<S>::DistanceRequest(
     rel_err(rel_err_),
     abs_err(abs_err_),
     distance_tolerance(distance_tolerance_),
-    gjk_solver_type(gjk_solver_type_)
+    gjk_solver_type(gjk_solver_type_),
+    distance_upper_bound(std::numeric_limits<S>::max()),
+    enable_solver_statistics(false)
 {
   // Do nothing
 }
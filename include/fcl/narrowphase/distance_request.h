@@ -101,6 +101,16 @@ struct FCL_EXPORT DistanceRequest
   /// @brief narrow phase solver type
   GJKSolverType gjk_solver_type;
 
+  /// @brief The query may stop as soon as the distance is known to exceed
+  /// this bound. DistanceResult::min_distance is then only guaranteed to be
+  /// larger than the bound, and the nearest points are unspecified. Distances
+  /// below the bound are unaffected. The default (max) disables the early-out.
+  S distance_upper_bound;
+
+  /// @brief If true, the GJK/EPA iteration counts of the narrowphase solver
+  /// are reported in DistanceResult::solver_statistics. Off by default.
+  bool enable_solver_statistics;
+
   explicit DistanceRequest(
       bool enable_nearest_points_ = false,
       bool enable_signed_distance = false,
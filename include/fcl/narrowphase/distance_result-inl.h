@@ -47,6 +47,10 @@ namespace fcl
 extern template
 struct DistanceResult<double>;
 
+//==============================================================================
+extern template
+struct DistanceResult<float>;
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
@@ -131,6 +135,7 @@ void DistanceResult<S>::clear()
   o2 = nullptr;
   b1 = NONE;
   b2 = NONE;
+  solver_statistics.clear();
 }
 
 } // namespace fcl
@@ -39,6 +39,7 @@
 #define FCL_DISTANCERESULT_H
 
 #include "fcl/common/types.h"
+#include "fcl/narrowphase/solver_statistics.h"
 
 namespace fcl
 {
@@ -86,6 +87,11 @@ public:
   /// if object 2 is octree, it is the id of the cell
   int b2;
 
+  /// @brief GJK/EPA iteration counts accumulated over the query
+  ///
+  /// @sa DistanceRequest::enable_solver_statistics
+  SolverStatistics solver_statistics;
+
   /// @brief invalid contact primitive information
   static const int NONE = -1;
   
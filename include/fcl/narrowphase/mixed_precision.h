@@ -0,0 +1,87 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_MIXED_PRECISION_H
+#define FCL_NARROWPHASE_MIXED_PRECISION_H
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+
+namespace fcl
+{
+
+/// @brief A collision geometry held in both single and double precision, as
+/// used by the mixed precision queries. Both copies must describe the same
+/// geometry in the same local frame.
+struct FCL_EXPORT MixedPrecisionGeometry
+{
+  const CollisionGeometry<float>* geometry_f;
+  const CollisionGeometry<double>* geometry_d;
+
+  MixedPrecisionGeometry(const CollisionGeometry<float>* geometry_f,
+                         const CollisionGeometry<double>* geometry_d);
+};
+
+/// @brief Mixed precision collision query. The query is first run in single
+/// precision. A pair found colliding with a penetration deeper than tolerance
+/// is reported from the single precision contacts. A pair found colliding with
+/// a shallower penetration is recomputed by the double precision collide().
+/// A pair found free in single precision is reported as free, so tolerance
+/// should exceed the single precision rounding error at the scale of the
+/// scene. Requests that enable cost sources always run in double precision.
+/// Return value is the number of contacts in the result.
+FCL_EXPORT
+std::size_t collideMixedPrecision(
+    const MixedPrecisionGeometry& o1, const Transform3<double>& tf1,
+    const MixedPrecisionGeometry& o2, const Transform3<double>& tf2,
+    double tolerance,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result);
+
+/// @brief Mixed precision distance query. The single precision result is
+/// returned when it is larger than tolerance; otherwise the distance is
+/// recomputed in double precision, where the sign and the nearest points of
+/// close or penetrating pairs are reliable. Return value is the minimum
+/// distance.
+FCL_EXPORT
+double distanceMixedPrecision(
+    const MixedPrecisionGeometry& o1, const Transform3<double>& tf1,
+    const MixedPrecisionGeometry& o2, const Transform3<double>& tf2,
+    double tolerance,
+    const DistanceRequest<double>& request,
+    DistanceResult<double>& result);
+
+} // namespace fcl
+
+#endif
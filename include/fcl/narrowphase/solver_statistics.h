@@ -0,0 +1,113 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_SOLVER_STATISTICS_H
+#define FCL_NARROWPHASE_SOLVER_STATISTICS_H
+
+#include "fcl/export.h"
+
+namespace fcl
+{
+
+/// @brief Iteration statistics of the GJK based narrowphase solvers. They are
+/// reported on CollisionResult and DistanceResult when the request enables
+/// them, and accumulate over all the solver calls made by the query.
+///
+/// GJKSolver_indep reports GJK and EPA for all its queries. GJKSolver_libccd
+/// reports GJK and EPA for its distance queries only; its collision queries
+/// run libccd's MPR, which does not expose its iterations.
+struct FCL_EXPORT SolverStatistics
+{
+  /// @brief Outcome of an EPA run, shared by both solvers. The values past
+  /// EPA_NOT_RUN mirror detail::EPA<S>::Status.
+  enum EPAStatus
+  {
+    EPA_NOT_RUN,
+    EPA_VALID,
+    EPA_TOUCHING,
+    EPA_DEGENERATED,
+    EPA_NON_CONVEX,
+    EPA_INVALID_HULL,
+    EPA_OUT_OF_FACES,
+    EPA_OUT_OF_VERTICES,
+    EPA_ACCURACY_REACHED,
+    EPA_FALLBACK,
+    EPA_FAILED
+  };
+
+  /// @brief Number of GJK runs
+  unsigned int num_gjk_runs;
+
+  /// @brief Total number of GJK iterations
+  unsigned int gjk_iterations;
+
+  /// @brief Number of GJK runs stopped by the iteration limit
+  unsigned int num_gjk_iteration_limit_reached;
+
+  /// @brief Number of GJK distance runs stopped early because the separation
+  /// exceeded DistanceRequest::distance_upper_bound
+  unsigned int num_gjk_upper_bound_reached;
+
+  /// @brief Number of EPA runs
+  unsigned int num_epa_runs;
+
+  /// @brief Total number of EPA iterations
+  unsigned int epa_iterations;
+
+  /// @brief Number of EPA runs stopped by the iteration limit
+  unsigned int num_epa_iteration_limit_reached;
+
+  /// @brief Outcome of the last EPA run
+  EPAStatus last_epa_status;
+
+  SolverStatistics();
+
+  /// @brief Record one GJK run
+  void addGJKRun(unsigned int iterations, bool iteration_limit_reached,
+                 bool upper_bound_reached = false);
+
+  /// @brief Record one EPA run
+  void addEPARun(unsigned int iterations, bool iteration_limit_reached,
+                 EPAStatus status);
+
+  /// @brief Accumulate the statistics of another query
+  void update(const SolverStatistics& other);
+
+  /// @brief Reset all counts
+  void clear();
+};
+
+} // namespace fcl
+
+#endif
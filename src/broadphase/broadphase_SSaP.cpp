@@ -43,4 +43,7 @@ namespace fcl
 template
 class SSaPCollisionManager<double>;
 
+template
+class SSaPCollisionManager<float>;
+
 } // namespace
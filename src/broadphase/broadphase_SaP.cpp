@@ -43,4 +43,7 @@ namespace fcl
 template
 class SaPCollisionManager<double>;
 
+template
+class SaPCollisionManager<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class NaiveCollisionManager<double>;
 
+template
+class NaiveCollisionManager<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class BroadPhaseCollisionManager<double>;
 
+template
+class BroadPhaseCollisionManager<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class BroadPhaseContinuousCollisionManager<double>;
 
+template
+class BroadPhaseContinuousCollisionManager<float>;
+
 } // namespace fcl
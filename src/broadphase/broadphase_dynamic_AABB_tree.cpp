@@ -43,4 +43,7 @@ namespace fcl
 template
 class DynamicAABBTreeCollisionManager<double>;
 
+template
+class DynamicAABBTreeCollisionManager<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class DynamicAABBTreeCollisionManager_Array<double>;
 
+template
+class DynamicAABBTreeCollisionManager_Array<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class IntervalTreeCollisionManager<double>;
 
+template
+class IntervalTreeCollisionManager<float>;
+
 } // namespace fcl
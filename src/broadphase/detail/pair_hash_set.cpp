@@ -0,0 +1,182 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/broadphase/detail/pair_hash_set.h"
+
+#include <algorithm>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+constexpr std::uint64_t PairHashSet::kEmptyKey;
+
+//==============================================================================
+PairHashSet::PairHashSet() : num_pairs(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool PairHashSet::insert(unsigned int a, unsigned int b)
+{
+  // Keep the load factor at most one half
+  if(2 * (num_pairs + 1) > slots.size())
+    rehash(slots.empty() ? 64 : 2 * slots.size());
+
+  const std::uint64_t key = pairKey(a, b);
+  const std::size_t slot = findSlot(key);
+  if(slots[slot] == key)
+    return false;
+
+  slots[slot] = key;
+  ++num_pairs;
+  return true;
+}
+
+//==============================================================================
+bool PairHashSet::erase(unsigned int a, unsigned int b)
+{
+  if(num_pairs == 0)
+    return false;
+
+  std::size_t slot = findSlot(pairKey(a, b));
+  if(slots[slot] == kEmptyKey)
+    return false;
+
+  // Backward shift deletion: move up the keys of the probe sequence that
+  // would otherwise become unreachable, so no tombstones are needed
+  const std::size_t mask = slots.size() - 1;
+  std::size_t next = slot;
+  while(true)
+  {
+    next = (next + 1) & mask;
+    const std::uint64_t key = slots[next];
+    if(key == kEmptyKey)
+      break;
+
+    const std::size_t home = mix(key) & mask;
+    if(((next - home) & mask) >= ((next - slot) & mask))
+    {
+      slots[slot] = key;
+      slot = next;
+    }
+  }
+
+  slots[slot] = kEmptyKey;
+  --num_pairs;
+  return true;
+}
+
+//==============================================================================
+bool PairHashSet::contains(unsigned int a, unsigned int b) const
+{
+  if(num_pairs == 0)
+    return false;
+
+  const std::uint64_t key = pairKey(a, b);
+  return slots[findSlot(key)] == key;
+}
+
+//==============================================================================
+void PairHashSet::clear()
+{
+  if(num_pairs == 0)
+    return;
+
+  std::fill(slots.begin(), slots.end(), kEmptyKey);
+  num_pairs = 0;
+}
+
+//==============================================================================
+std::size_t PairHashSet::size() const
+{
+  return num_pairs;
+}
+
+//==============================================================================
+bool PairHashSet::empty() const
+{
+  return num_pairs == 0;
+}
+
+//==============================================================================
+std::uint64_t PairHashSet::pairKey(unsigned int a, unsigned int b)
+{
+  if(a > b)
+    std::swap(a, b);
+
+  return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+
+//==============================================================================
+std::uint64_t PairHashSet::mix(std::uint64_t key)
+{
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+//==============================================================================
+std::size_t PairHashSet::findSlot(std::uint64_t key) const
+{
+  const std::size_t mask = slots.size() - 1;
+  std::size_t slot = mix(key) & mask;
+  while(slots[slot] != kEmptyKey && slots[slot] != key)
+    slot = (slot + 1) & mask;
+
+  return slot;
+}
+
+//==============================================================================
+void PairHashSet::rehash(std::size_t num_slots)
+{
+  std::vector<std::uint64_t> old_slots(num_slots, kEmptyKey);
+  old_slots.swap(slots);
+
+  for(const auto key : old_slots)
+  {
+    if(key != kEmptyKey)
+      slots[findSlot(key)] = key;
+  }
+}
+
+} // namespace detail
+} // namespace fcl
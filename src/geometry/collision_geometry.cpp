@@ -43,4 +43,7 @@ namespace fcl
 template
 class CollisionGeometry<double>;
 
+template
+class CollisionGeometry<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class Box<double>;
 
+template
+class Box<float>;
+
 } // namespace fcl
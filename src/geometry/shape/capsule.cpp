@@ -43,4 +43,7 @@ namespace fcl
 template
 class Capsule<double>;
 
+template
+class Capsule<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class Cone<double>;
 
+template
+class Cone<float>;
+
 } // namespace fcl
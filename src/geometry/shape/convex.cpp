@@ -43,4 +43,7 @@ namespace fcl
 template
 class Convex<double>;
 
+template
+class Convex<float>;
+
 } // namespace fcl
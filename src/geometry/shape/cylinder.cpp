@@ -43,4 +43,7 @@ namespace fcl
 template
 class Cylinder<double>;
 
+template
+class Cylinder<float>;
+
 } // namespace fcl
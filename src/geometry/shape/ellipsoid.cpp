@@ -43,4 +43,7 @@ namespace fcl
 template
 class Ellipsoid<double>;
 
+template
+class Ellipsoid<float>;
+
 } // namespace fcl
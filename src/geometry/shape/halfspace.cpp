@@ -43,7 +43,13 @@ namespace fcl
 template
 class Halfspace<double>;
 
+template
+class Halfspace<float>;
+
 template
 Halfspace<double> transform(const Halfspace<double>& a, const Transform3<double>& tf);
 
+template
+Halfspace<float> transform(const Halfspace<float>& a, const Transform3<float>& tf);
+
 } // namespace fcl
@@ -44,8 +44,14 @@ namespace fcl
 template
 class Plane<double>;
 
+template
+class Plane<float>;
+
 //==============================================================================
 template
 Plane<double> transform(const Plane<double>& a, const Transform3<double>& tf);
 
+template
+Plane<float> transform(const Plane<float>& a, const Transform3<float>& tf);
+
 } // namespace fcl
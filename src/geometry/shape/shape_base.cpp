@@ -43,4 +43,7 @@ namespace fcl
 template
 class ShapeBase<double>;
 
+template
+class ShapeBase<float>;
+
 } // namespace fcl
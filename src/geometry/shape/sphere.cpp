@@ -43,4 +43,7 @@ namespace fcl
 template
 class Sphere<double>;
 
+template
+class Sphere<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class TriangleP<double>;
 
+template
+class TriangleP<float>;
+
 } // namespace fcl
@@ -0,0 +1,296 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/math/detail/soa_vertices-inl.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template
+class SoAVertices<double>;
+
+namespace
+{
+
+// Lane indices are tracked in floating point registers so that they can be
+// selected with the same comparison masks as the values. Floats represent
+// every integer below 2^24 exactly; larger point sets use the scalar path.
+constexpr int kMaxVectorizedFloatCount = 1 << 24;
+
+// Picks the best of the per-lane winners, preferring the smallest index among
+// equal values so that the result matches the scalar kernel.
+template <typename S, int Lanes>
+void reduceLanes(const S* values, const S* indices,
+                 S* best_value, int* best_index)
+{
+  *best_value = values[0];
+  *best_index = static_cast<int>(indices[0]);
+  for(int k = 1; k < Lanes; ++k)
+  {
+    const int index = static_cast<int>(indices[k]);
+    if(values[k] > *best_value
+       || (values[k] == *best_value && index < *best_index))
+    {
+      *best_value = values[k];
+      *best_index = index;
+    }
+  }
+}
+
+} // namespace
+
+//==============================================================================
+int argmaxDot(const float* x, const float* y, const float* z, int n,
+              float dx, float dy, float dz)
+{
+#if defined(__AVX__)
+  constexpr int kLanes = 8;
+  if(n >= kLanes && n < kMaxVectorizedFloatCount)
+  {
+    const __m256 vdx = _mm256_set1_ps(dx);
+    const __m256 vdy = _mm256_set1_ps(dy);
+    const __m256 vdz = _mm256_set1_ps(dz);
+    const __m256 step = _mm256_set1_ps(static_cast<float>(kLanes));
+
+    __m256 index = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 best_index = index;
+    __m256 best = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(vdx, _mm256_loadu_ps(x)),
+                        _mm256_mul_ps(vdy, _mm256_loadu_ps(y))),
+          _mm256_mul_ps(vdz, _mm256_loadu_ps(z)));
+
+    int i = kLanes;
+    for(; i + kLanes <= n; i += kLanes)
+    {
+      index = _mm256_add_ps(index, step);
+      const __m256 value = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(vdx, _mm256_loadu_ps(x + i)),
+                          _mm256_mul_ps(vdy, _mm256_loadu_ps(y + i))),
+            _mm256_mul_ps(vdz, _mm256_loadu_ps(z + i)));
+      const __m256 greater = _mm256_cmp_ps(value, best, _CMP_GT_OQ);
+      best = _mm256_blendv_ps(best, value, greater);
+      best_index = _mm256_blendv_ps(best_index, index, greater);
+    }
+
+    alignas(32) float values[kLanes];
+    alignas(32) float indices[kLanes];
+    _mm256_store_ps(values, best);
+    _mm256_store_ps(indices, best_index);
+
+    float best_value;
+    int result;
+    reduceLanes<float, kLanes>(values, indices, &best_value, &result);
+    for(; i < n; ++i)
+    {
+      const float value = dx * x[i] + dy * y[i] + dz * z[i];
+      if(value > best_value)
+      {
+        best_value = value;
+        result = i;
+      }
+    }
+    return result;
+  }
+#elif defined(__SSE2__)
+  constexpr int kLanes = 4;
+  if(n >= kLanes && n < kMaxVectorizedFloatCount)
+  {
+    const __m128 vdx = _mm_set1_ps(dx);
+    const __m128 vdy = _mm_set1_ps(dy);
+    const __m128 vdz = _mm_set1_ps(dz);
+    const __m128 step = _mm_set1_ps(static_cast<float>(kLanes));
+
+    __m128 index = _mm_setr_ps(0, 1, 2, 3);
+    __m128 best_index = index;
+    __m128 best = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(vdx, _mm_loadu_ps(x)),
+                     _mm_mul_ps(vdy, _mm_loadu_ps(y))),
+          _mm_mul_ps(vdz, _mm_loadu_ps(z)));
+
+    int i = kLanes;
+    for(; i + kLanes <= n; i += kLanes)
+    {
+      index = _mm_add_ps(index, step);
+      const __m128 value = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(vdx, _mm_loadu_ps(x + i)),
+                       _mm_mul_ps(vdy, _mm_loadu_ps(y + i))),
+            _mm_mul_ps(vdz, _mm_loadu_ps(z + i)));
+      const __m128 greater = _mm_cmpgt_ps(value, best);
+      best = _mm_or_ps(_mm_and_ps(greater, value),
+                       _mm_andnot_ps(greater, best));
+      best_index = _mm_or_ps(_mm_and_ps(greater, index),
+                             _mm_andnot_ps(greater, best_index));
+    }
+
+    alignas(16) float values[kLanes];
+    alignas(16) float indices[kLanes];
+    _mm_store_ps(values, best);
+    _mm_store_ps(indices, best_index);
+
+    float best_value;
+    int result;
+    reduceLanes<float, kLanes>(values, indices, &best_value, &result);
+    for(; i < n; ++i)
+    {
+      const float value = dx * x[i] + dy * y[i] + dz * z[i];
+      if(value > best_value)
+      {
+        best_value = value;
+        result = i;
+      }
+    }
+    return result;
+  }
+#endif
+  return argmaxDot<float>(x, y, z, n, dx, dy, dz);
+}
+
+//==============================================================================
+int argmaxDot(const double* x, const double* y, const double* z, int n,
+              double dx, double dy, double dz)
+{
+#if defined(__AVX__)
+  constexpr int kLanes = 4;
+  if(n >= kLanes)
+  {
+    const __m256d vdx = _mm256_set1_pd(dx);
+    const __m256d vdy = _mm256_set1_pd(dy);
+    const __m256d vdz = _mm256_set1_pd(dz);
+    const __m256d step = _mm256_set1_pd(static_cast<double>(kLanes));
+
+    __m256d index = _mm256_setr_pd(0, 1, 2, 3);
+    __m256d best_index = index;
+    __m256d best = _mm256_add_pd(
+          _mm256_add_pd(_mm256_mul_pd(vdx, _mm256_loadu_pd(x)),
+                        _mm256_mul_pd(vdy, _mm256_loadu_pd(y))),
+          _mm256_mul_pd(vdz, _mm256_loadu_pd(z)));
+
+    int i = kLanes;
+    for(; i + kLanes <= n; i += kLanes)
+    {
+      index = _mm256_add_pd(index, step);
+      const __m256d value = _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(vdx, _mm256_loadu_pd(x + i)),
+                          _mm256_mul_pd(vdy, _mm256_loadu_pd(y + i))),
+            _mm256_mul_pd(vdz, _mm256_loadu_pd(z + i)));
+      const __m256d greater = _mm256_cmp_pd(value, best, _CMP_GT_OQ);
+      best = _mm256_blendv_pd(best, value, greater);
+      best_index = _mm256_blendv_pd(best_index, index, greater);
+    }
+
+    alignas(32) double values[kLanes];
+    alignas(32) double indices[kLanes];
+    _mm256_store_pd(values, best);
+    _mm256_store_pd(indices, best_index);
+
+    double best_value;
+    int result;
+    reduceLanes<double, kLanes>(values, indices, &best_value, &result);
+    for(; i < n; ++i)
+    {
+      const double value = dx * x[i] + dy * y[i] + dz * z[i];
+      if(value > best_value)
+      {
+        best_value = value;
+        result = i;
+      }
+    }
+    return result;
+  }
+#elif defined(__SSE2__)
+  constexpr int kLanes = 2;
+  if(n >= kLanes)
+  {
+    const __m128d vdx = _mm_set1_pd(dx);
+    const __m128d vdy = _mm_set1_pd(dy);
+    const __m128d vdz = _mm_set1_pd(dz);
+    const __m128d step = _mm_set1_pd(static_cast<double>(kLanes));
+
+    __m128d index = _mm_setr_pd(0, 1);
+    __m128d best_index = index;
+    __m128d best = _mm_add_pd(
+          _mm_add_pd(_mm_mul_pd(vdx, _mm_loadu_pd(x)),
+                     _mm_mul_pd(vdy, _mm_loadu_pd(y))),
+          _mm_mul_pd(vdz, _mm_loadu_pd(z)));
+
+    int i = kLanes;
+    for(; i + kLanes <= n; i += kLanes)
+    {
+      index = _mm_add_pd(index, step);
+      const __m128d value = _mm_add_pd(
+            _mm_add_pd(_mm_mul_pd(vdx, _mm_loadu_pd(x + i)),
+                       _mm_mul_pd(vdy, _mm_loadu_pd(y + i))),
+            _mm_mul_pd(vdz, _mm_loadu_pd(z + i)));
+      const __m128d greater = _mm_cmpgt_pd(value, best);
+      best = _mm_or_pd(_mm_and_pd(greater, value),
+                       _mm_andnot_pd(greater, best));
+      best_index = _mm_or_pd(_mm_and_pd(greater, index),
+                             _mm_andnot_pd(greater, best_index));
+    }
+
+    alignas(16) double values[kLanes];
+    alignas(16) double indices[kLanes];
+    _mm_store_pd(values, best);
+    _mm_store_pd(indices, best_index);
+
+    double best_value;
+    int result;
+    reduceLanes<double, kLanes>(values, indices, &best_value, &result);
+    for(; i < n; ++i)
+    {
+      const double value = dx * x[i] + dy * y[i] + dz * z[i];
+      if(value > best_value)
+      {
+        best_value = value;
+        result = i;
+      }
+    }
+    return result;
+  }
+#endif
+  return argmaxDot<double>(x, y, z, n, dx, dy, dz);
+}
+
+} // namespace detail
+} // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 class CollisionObject<double>;
 
+template
+class CollisionObject<float>;
+
 } // namespace fcl
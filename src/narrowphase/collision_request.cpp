@@ -43,4 +43,7 @@ namespace fcl
 template
 struct CollisionRequest<double>;
 
+template
+struct CollisionRequest<float>;
+
 } // namespace fcl
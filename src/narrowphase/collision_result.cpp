@@ -43,4 +43,7 @@ namespace fcl
 template
 struct CollisionResult<double>;
 
+template
+struct CollisionResult<float>;
+
 } // namespace fcl
@@ -43,4 +43,7 @@ namespace fcl
 template
 struct Contact<double>;
 
+template
+struct Contact<float>;
+
 } // namespace fcl
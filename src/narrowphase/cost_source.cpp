@@ -43,4 +43,7 @@ namespace fcl
 template
 struct CostSource<double>;
 
+template
+struct CostSource<float>;
+
 } // namespace fcl
@@ -110,7 +110,9 @@ bool GJKDistance(
     double tolerance,
     double* dist,
     Vector3d* p1,
-    Vector3d* p2);
+    Vector3d* p2,
+    double upper_bound,
+    SolverStatistics* stats);
 
 template
 bool GJKSignedDistance(
@@ -122,7 +124,9 @@ bool GJKSignedDistance(
     double tolerance,
     double* dist,
     Vector3d* p1,
-    Vector3d* p2);
+    Vector3d* p2,
+    double upper_bound,
+    SolverStatistics* stats);
 
 } // namespace detail
 } // namespace fcl
@@ -46,5 +46,8 @@ namespace detail
 template
 struct GJKSolver_indep<double>;
 
+template
+struct GJKSolver_indep<float>;
+
 } // namespace detail
 } // namespace fcl
@@ -46,5 +46,8 @@ namespace detail
 template
 struct GJKSolver_libccd<double>;
 
+template
+struct GJKSolver_libccd<float>;
+
 } // namespace detail
 } // namespace fcl
@@ -0,0 +1,541 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_capsule.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_box.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_sphere.h"
+
+#include <limits>
+
+#include "fcl/math/constants.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace fcl
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Offsets each component array of a structure-of-arrays 3-vector, to hand the
+// remainder of a batch to the scalar kernels.
+template <typename T>
+void offset3(T* const v[3], int i, T* out[3])
+{
+  for(int k = 0; k < 3; ++k)
+    out[k] = v[k] + i;
+}
+
+// A minimal set of packed double operations, so that each kernel is written
+// once for both instruction sets. Comparisons return lane masks, which select()
+// and storeMask() consume. The kernels below mirror the scalar templates
+// operation by operation so that both paths produce the same results.
+#if defined(__AVX__)
+
+#define FCL_PRIMITIVE_BATCH_SIMD
+using Pack = __m256d;
+constexpr int kLanes = 4;
+
+inline Pack load(const double* p) { return _mm256_loadu_pd(p); }
+inline void store(double* p, Pack a) { _mm256_storeu_pd(p, a); }
+inline Pack set1(double s) { return _mm256_set1_pd(s); }
+inline Pack add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+inline Pack div(Pack a, Pack b) { return _mm256_div_pd(a, b); }
+inline Pack sqrt(Pack a) { return _mm256_sqrt_pd(a); }
+inline Pack min(Pack a, Pack b) { return _mm256_min_pd(a, b); }
+inline Pack max(Pack a, Pack b) { return _mm256_max_pd(a, b); }
+inline Pack lt(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+inline Pack le(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+inline Pack gt(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+inline Pack ge(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+inline Pack eq(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+inline Pack ngt(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_NGT_UQ); }
+inline Pack select(Pack m, Pack a, Pack b) { return _mm256_blendv_pd(b, a, m); }
+inline int maskBits(Pack m) { return _mm256_movemask_pd(m); }
+
+#elif defined(__SSE2__)
+
+#define FCL_PRIMITIVE_BATCH_SIMD
+using Pack = __m128d;
+constexpr int kLanes = 2;
+
+inline Pack load(const double* p) { return _mm_loadu_pd(p); }
+inline void store(double* p, Pack a) { _mm_storeu_pd(p, a); }
+inline Pack set1(double s) { return _mm_set1_pd(s); }
+inline Pack add(Pack a, Pack b) { return _mm_add_pd(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm_sub_pd(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+inline Pack div(Pack a, Pack b) { return _mm_div_pd(a, b); }
+inline Pack sqrt(Pack a) { return _mm_sqrt_pd(a); }
+inline Pack min(Pack a, Pack b) { return _mm_min_pd(a, b); }
+inline Pack max(Pack a, Pack b) { return _mm_max_pd(a, b); }
+inline Pack lt(Pack a, Pack b) { return _mm_cmplt_pd(a, b); }
+inline Pack le(Pack a, Pack b) { return _mm_cmple_pd(a, b); }
+inline Pack gt(Pack a, Pack b) { return _mm_cmpgt_pd(a, b); }
+inline Pack ge(Pack a, Pack b) { return _mm_cmpge_pd(a, b); }
+inline Pack eq(Pack a, Pack b) { return _mm_cmpeq_pd(a, b); }
+inline Pack ngt(Pack a, Pack b) { return _mm_cmpngt_pd(a, b); }
+inline Pack select(Pack m, Pack a, Pack b)
+{
+  return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+}
+inline int maskBits(Pack m) { return _mm_movemask_pd(m); }
+
+#endif
+
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+
+inline void storeMask(unsigned char* p, Pack m)
+{
+  const int bits = maskBits(m);
+  for(int k = 0; k < kLanes; ++k)
+    p[k] = (bits >> k) & 1;
+}
+
+inline Pack clamp01(Pack a)
+{
+  return min(max(a, set1(0)), set1(1));
+}
+
+inline Pack norm3(Pack x, Pack y, Pack z)
+{
+  return sqrt(add(add(mul(x, x), mul(y, y)), mul(z, z)));
+}
+
+inline Pack dot3(const Pack a[3], const Pack b[3])
+{
+  return add(add(mul(a[0], b[0]), mul(a[1], b[1])), mul(a[2], b[2]));
+}
+
+// Packed form of closestPtSegmentSegmentBatchLane() for lanes [i, i + kLanes).
+void closestPtSegmentSegmentPack(
+    int i, const double* const c1[3], const double* const u1[3],
+    const double* const c2[3], const double* const u2[3],
+    Pack cp1[3], Pack cp2[3])
+{
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  const Pack two = set1(2);
+
+  Pack p1[3], d1[3], p2[3], d2[3], r[3];
+  for(int k = 0; k < 3; ++k)
+  {
+    const Pack u1k = load(u1[k] + i);
+    const Pack u2k = load(u2[k] + i);
+    p1[k] = sub(load(c1[k] + i), u1k);
+    d1[k] = mul(two, u1k);
+    p2[k] = sub(load(c2[k] + i), u2k);
+    d2[k] = mul(two, u2k);
+    r[k] = sub(p1[k], p2[k]);
+  }
+
+  const Pack a = dot3(d1, d1);
+  const Pack e = dot3(d2, d2);
+  const Pack b = dot3(d1, d2);
+  const Pack c = dot3(d1, r);
+  const Pack f = dot3(d2, r);
+
+  const Pack point1 = ngt(a, zero);
+  const Pack point2 = ngt(e, zero);
+  const Pack denom = sub(mul(a, e), mul(b, b));
+  const Pack parallel =
+      ngt(denom, mul(mul(set1(constants<double>::eps()), a), e));
+  const Pack safe_a = select(point1, one, a);
+  const Pack safe_e = select(point2, one, e);
+  const Pack safe_denom = select(parallel, one, denom);
+  const Pack neg_c = sub(zero, c);
+
+  Pack s = select(parallel, zero, clamp01(
+      div(sub(mul(b, f), mul(c, e)), safe_denom)));
+  Pack t = div(add(mul(b, s), f), safe_e);
+  const Pack s_t0 = clamp01(div(neg_c, safe_a));
+  const Pack s_t1 = clamp01(div(sub(b, c), safe_a));
+  s = select(lt(t, zero), s_t0, select(gt(t, one), s_t1, s));
+  t = clamp01(t);
+
+  s = select(point1, zero, select(point2, s_t0, s));
+  t = select(point2, zero, select(point1, clamp01(div(f, safe_e)), t));
+
+  for(int k = 0; k < 3; ++k)
+  {
+    cp1[k] = add(p1[k], mul(d1[k], s));
+    cp2[k] = add(p2[k], mul(d2[k], t));
+  }
+}
+
+#endif
+
+} // namespace
+
+//==============================================================================
+void sphereSphereIntersectBatch(
+    int n,
+    const double* r1, const double* const c1[3],
+    const double* r2, const double* const c2[3],
+    unsigned char* collide, double* depth,
+    double* const normal[3], double* const pos[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack d[3];
+    for(int k = 0; k < 3; ++k)
+      d[k] = sub(load(c2[k] + i), load(c1[k] + i));
+    const Pack len = norm3(d[0], d[1], d[2]);
+    const Pack radius1 = load(r1 + i);
+    const Pack sum = add(radius1, load(r2 + i));
+    const Pack inv_len = select(gt(len, zero), div(one, len), zero);
+    const Pack w = div(radius1, sum);
+
+    storeMask(collide + i, le(len, sum));
+    store(depth + i, sub(sum, len));
+    for(int k = 0; k < 3; ++k)
+    {
+      store(normal[k] + i, mul(d[k], inv_len));
+      store(pos[k] + i, add(load(c1[k] + i), mul(d[k], w)));
+    }
+  }
+#endif
+
+  const double* c1_tail[3];
+  const double* c2_tail[3];
+  double* normal_tail[3];
+  double* pos_tail[3];
+  offset3(c1, i, c1_tail);
+  offset3(c2, i, c2_tail);
+  offset3(normal, i, normal_tail);
+  offset3(pos, i, pos_tail);
+  sphereSphereIntersectBatch<double>(
+      n - i, r1 + i, c1_tail, r2 + i, c2_tail, collide + i, depth + i,
+      normal_tail, pos_tail);
+}
+
+//==============================================================================
+void sphereSphereDistanceBatch(
+    int n,
+    const double* r1, const double* const c1[3],
+    const double* r2, const double* const c2[3],
+    unsigned char* separated, double* dist,
+    double* const p1[3], double* const p2[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack o1[3], o2[3], d[3];
+    for(int k = 0; k < 3; ++k)
+    {
+      o1[k] = load(c1[k] + i);
+      o2[k] = load(c2[k] + i);
+      d[k] = sub(o1[k], o2[k]);
+    }
+    const Pack len = norm3(d[0], d[1], d[2]);
+    const Pack radius1 = load(r1 + i);
+    const Pack radius2 = load(r2 + i);
+    const Pack sum = add(radius1, radius2);
+    const Pack apart = gt(len, sum);
+    const Pack inv_len = select(gt(len, zero), div(one, len), zero);
+    const Pack w1 = mul(radius1, inv_len);
+    const Pack w2 = mul(radius2, inv_len);
+
+    storeMask(separated + i, apart);
+    store(dist + i, select(apart, sub(len, sum), set1(-1)));
+    for(int k = 0; k < 3; ++k)
+    {
+      store(p1[k] + i, sub(o1[k], mul(d[k], w1)));
+      store(p2[k] + i, add(o2[k], mul(d[k], w2)));
+    }
+  }
+#endif
+
+  const double* c1_tail[3];
+  const double* c2_tail[3];
+  double* p1_tail[3];
+  double* p2_tail[3];
+  offset3(c1, i, c1_tail);
+  offset3(c2, i, c2_tail);
+  offset3(p1, i, p1_tail);
+  offset3(p2, i, p2_tail);
+  sphereSphereDistanceBatch<double>(
+      n - i, r1 + i, c1_tail, r2 + i, c2_tail, separated + i, dist + i,
+      p1_tail, p2_tail);
+}
+
+//==============================================================================
+void sphereBoxIntersectBatch(
+    int n, const double* r, const double* const p_BC[3],
+    const double* const half_size[3], unsigned char* collide, double* depth,
+    double* const n_SB_B[3], double* const p_BP[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const double eps = 16 * constants<double>::eps();
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  const Pack half = set1(0.5);
+  const Pack veps = set1(eps);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack c[3], p_BN[3], p_CN[3], face_distance[3];
+    for(int k = 0; k < 3; ++k)
+    {
+      const Pack h = load(half_size[k] + i);
+      c[k] = load(p_BC[k] + i);
+      p_BN[k] = min(max(c[k], sub(zero, h)), h);
+      p_CN[k] = sub(p_BN[k], c[k]);
+      face_distance[k] = select(ge(c[k], zero), sub(h, c[k]), add(c[k], h));
+    }
+    const Pack squared_distance = dot3(p_CN, p_CN);
+    const Pack radius = load(r + i);
+    const Pack outside = gt(squared_distance, set1(eps * eps));
+
+    const Pack distance = sqrt(squared_distance);
+    const Pack inv_distance = select(outside, div(one, distance), zero);
+    const Pack outside_depth = sub(radius, distance);
+
+    Pack min_distance =
+        set1(std::numeric_limits<double>::infinity());
+    Pack min_axis = zero;
+    for(int k = 0; k < 3; ++k)
+    {
+      const Pack closer = lt(add(face_distance[k], veps), min_distance);
+      min_distance = select(closer, face_distance[k], min_distance);
+      min_axis = select(closer, set1(k), min_axis);
+    }
+    const Pack inside_depth = add(min_distance, radius);
+    const Pack inside_offset = mul(sub(radius, min_distance), half);
+
+    storeMask(collide + i, le(squared_distance, mul(radius, radius)));
+    store(depth + i, select(outside, outside_depth, inside_depth));
+    for(int k = 0; k < 3; ++k)
+    {
+      const Pack inside_normal = select(
+          eq(min_axis, set1(k)),
+          select(ge(c[k], zero), set1(-1), one), zero);
+      const Pack normal =
+          select(outside, mul(p_CN[k], inv_distance), inside_normal);
+      store(n_SB_B[k] + i, normal);
+      store(p_BP[k] + i, select(
+          outside, add(p_BN[k], mul(normal, mul(outside_depth, half))),
+          add(c[k], mul(normal, inside_offset))));
+    }
+  }
+#endif
+
+  const double* p_BC_tail[3];
+  const double* half_size_tail[3];
+  double* n_SB_B_tail[3];
+  double* p_BP_tail[3];
+  offset3(p_BC, i, p_BC_tail);
+  offset3(half_size, i, half_size_tail);
+  offset3(n_SB_B, i, n_SB_B_tail);
+  offset3(p_BP, i, p_BP_tail);
+  sphereBoxIntersectBatch<double>(
+      n - i, r + i, p_BC_tail, half_size_tail, collide + i, depth + i,
+      n_SB_B_tail, p_BP_tail);
+}
+
+//==============================================================================
+void sphereBoxDistanceBatch(
+    int n, const double* r, const double* const p_BC[3],
+    const double* const half_size[3], unsigned char* separated,
+    double* distance, double* const p_BSb[3], double* const p_BBs[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const Pack zero = set1(0);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack p_BN[3], p_NC[3];
+    for(int k = 0; k < 3; ++k)
+    {
+      const Pack h = load(half_size[k] + i);
+      const Pack c = load(p_BC[k] + i);
+      p_BN[k] = min(max(c, sub(zero, h)), h);
+      p_NC[k] = sub(c, p_BN[k]);
+    }
+    const Pack squared_distance = dot3(p_NC, p_NC);
+    const Pack radius = load(r + i);
+    const Pack apart = gt(squared_distance, mul(radius, radius));
+
+    const Pack d = sqrt(squared_distance);
+    const Pack gap = sub(d, radius);
+    const Pack scale = select(apart, div(gap, d), zero);
+
+    storeMask(separated + i, apart);
+    store(distance + i, select(apart, gap, set1(-1)));
+    for(int k = 0; k < 3; ++k)
+    {
+      store(p_BBs[k] + i, p_BN[k]);
+      store(p_BSb[k] + i, add(p_BN[k], mul(p_NC[k], scale)));
+    }
+  }
+#endif
+
+  const double* p_BC_tail[3];
+  const double* half_size_tail[3];
+  double* p_BSb_tail[3];
+  double* p_BBs_tail[3];
+  offset3(p_BC, i, p_BC_tail);
+  offset3(half_size, i, half_size_tail);
+  offset3(p_BSb, i, p_BSb_tail);
+  offset3(p_BBs, i, p_BBs_tail);
+  sphereBoxDistanceBatch<double>(
+      n - i, r + i, p_BC_tail, half_size_tail, separated + i, distance + i,
+      p_BSb_tail, p_BBs_tail);
+}
+
+//==============================================================================
+void capsuleCapsuleIntersectBatch(
+    int n,
+    const double* r1, const double* const c1[3], const double* const u1[3],
+    const double* r2, const double* const c2[3], const double* const u2[3],
+    unsigned char* collide, double* depth,
+    double* const normal[3], double* const pos[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack cp1[3], cp2[3], d[3];
+    closestPtSegmentSegmentPack(i, c1, u1, c2, u2, cp1, cp2);
+    for(int k = 0; k < 3; ++k)
+      d[k] = sub(cp2[k], cp1[k]);
+
+    const Pack len = norm3(d[0], d[1], d[2]);
+    const Pack radius1 = load(r1 + i);
+    const Pack sum = add(radius1, load(r2 + i));
+    const Pack inv_len = select(gt(len, zero), div(one, len), zero);
+    const Pack w = div(radius1, sum);
+
+    storeMask(collide + i, le(len, sum));
+    store(depth + i, sub(sum, len));
+    for(int k = 0; k < 3; ++k)
+    {
+      store(normal[k] + i, mul(d[k], inv_len));
+      store(pos[k] + i, add(cp1[k], mul(d[k], w)));
+    }
+  }
+#endif
+
+  const double* c1_tail[3];
+  const double* u1_tail[3];
+  const double* c2_tail[3];
+  const double* u2_tail[3];
+  double* normal_tail[3];
+  double* pos_tail[3];
+  offset3(c1, i, c1_tail);
+  offset3(u1, i, u1_tail);
+  offset3(c2, i, c2_tail);
+  offset3(u2, i, u2_tail);
+  offset3(normal, i, normal_tail);
+  offset3(pos, i, pos_tail);
+  capsuleCapsuleIntersectBatch<double>(
+      n - i, r1 + i, c1_tail, u1_tail, r2 + i, c2_tail, u2_tail,
+      collide + i, depth + i, normal_tail, pos_tail);
+}
+
+//==============================================================================
+void capsuleCapsuleDistanceBatch(
+    int n,
+    const double* r1, const double* const c1[3], const double* const u1[3],
+    const double* r2, const double* const c2[3], const double* const u2[3],
+    unsigned char* separated, double* dist,
+    double* const p1[3], double* const p2[3])
+{
+  int i = 0;
+#ifdef FCL_PRIMITIVE_BATCH_SIMD
+  const Pack zero = set1(0);
+  const Pack one = set1(1);
+  for(; i + kLanes <= n; i += kLanes)
+  {
+    Pack cp1[3], cp2[3], d[3];
+    closestPtSegmentSegmentPack(i, c1, u1, c2, u2, cp1, cp2);
+    for(int k = 0; k < 3; ++k)
+      d[k] = sub(cp2[k], cp1[k]);
+
+    const Pack len = norm3(d[0], d[1], d[2]);
+    const Pack radius1 = load(r1 + i);
+    const Pack radius2 = load(r2 + i);
+    const Pack sum = add(radius1, radius2);
+    const Pack apart = gt(len, sum);
+    const Pack inv_len = select(gt(len, zero), div(one, len), zero);
+    const Pack w1 = mul(radius1, inv_len);
+    const Pack w2 = mul(radius2, inv_len);
+
+    storeMask(separated + i, apart);
+    store(dist + i, select(apart, sub(len, sum), set1(-1)));
+    for(int k = 0; k < 3; ++k)
+    {
+      store(p1[k] + i, add(cp1[k], mul(d[k], w1)));
+      store(p2[k] + i, sub(cp2[k], mul(d[k], w2)));
+    }
+  }
+#endif
+
+  const double* c1_tail[3];
+  const double* u1_tail[3];
+  const double* c2_tail[3];
+  const double* u2_tail[3];
+  double* p1_tail[3];
+  double* p2_tail[3];
+  offset3(c1, i, c1_tail);
+  offset3(u1, i, u1_tail);
+  offset3(c2, i, c2_tail);
+  offset3(u2, i, u2_tail);
+  offset3(p1, i, p1_tail);
+  offset3(p2, i, p2_tail);
+  capsuleCapsuleDistanceBatch<double>(
+      n - i, r1 + i, c1_tail, u1_tail, r2 + i, c2_tail, u2_tail,
+      separated + i, dist + i, p1_tail, p2_tail);
+}
+
+} // namespace detail
+} // namespace fcl
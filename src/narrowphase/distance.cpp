@@ -48,6 +48,14 @@ double distance(
     const DistanceRequest<double>& request,
     DistanceResult<double>& result);
 
+//==============================================================================
+template
+float distance(
+    const CollisionObject<float>* o1,
+    const CollisionObject<float>* o2,
+    const DistanceRequest<float>& request,
+    DistanceResult<float>& result);
+
 //==============================================================================
 template
 double distance(
@@ -55,4 +63,11 @@ double distance(
     const CollisionGeometry<double>* o2, const Transform3<double>& tf2,
     const DistanceRequest<double>& request, DistanceResult<double>& result);
 
+//==============================================================================
+template
+float distance(
+    const CollisionGeometry<float>* o1, const Transform3<float>& tf1,
+    const CollisionGeometry<float>* o2, const Transform3<float>& tf2,
+    const DistanceRequest<float>& request, DistanceResult<float>& result);
+
 } // namespace fcl
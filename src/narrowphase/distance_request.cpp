@@ -43,4 +43,7 @@ namespace fcl
 template
 struct DistanceRequest<double>;
 
+template
+struct DistanceRequest<float>;
+
 } // namespace fcl
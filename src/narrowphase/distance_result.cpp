@@ -43,4 +43,7 @@ namespace fcl
 template
 struct DistanceResult<double>;
 
+template
+struct DistanceResult<float>;
+
 } // namespace fcl
@@ -0,0 +1,165 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/narrowphase/mixed_precision.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace fcl
+{
+
+namespace
+{
+
+//==============================================================================
+// Single precision distance between the float copies of the geometries.
+float distanceSinglePrecision(
+    const MixedPrecisionGeometry& o1, const Transform3<double>& tf1,
+    const MixedPrecisionGeometry& o2, const Transform3<double>& tf2,
+    const DistanceRequest<float>& request,
+    DistanceResult<float>& result)
+{
+  const Transform3<float> tf1_f = tf1.cast<float>();
+  const Transform3<float> tf2_f = tf2.cast<float>();
+  return distance(o1.geometry_f, tf1_f, o2.geometry_f, tf2_f, request, result);
+}
+
+} // namespace
+
+//==============================================================================
+MixedPrecisionGeometry::MixedPrecisionGeometry(
+    const CollisionGeometry<float>* geometry_f,
+    const CollisionGeometry<double>* geometry_d)
+  : geometry_f(geometry_f), geometry_d(geometry_d)
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::size_t collideMixedPrecision(
+    const MixedPrecisionGeometry& o1, const Transform3<double>& tf1,
+    const MixedPrecisionGeometry& o2, const Transform3<double>& tf2,
+    double tolerance,
+    const CollisionRequest<double>& request,
+    CollisionResult<double>& result)
+{
+  if(request.isSatisfied(result))
+    return result.numContacts();
+
+  // Cost sources are only computed by the double precision query.
+  if(request.enable_cost)
+    return collide(o1.geometry_d, tf1, o2.geometry_d, tf2, request, result);
+
+  CollisionRequest<float> request_f(
+        request.num_max_contacts, true, request.num_max_cost_sources, false,
+        request.use_approximate_cost, request.gjk_solver_type,
+        static_cast<float>(request.gjk_tolerance));
+  request_f.enable_solver_statistics = request.enable_solver_statistics;
+  request_f.security_margin = static_cast<float>(request.security_margin);
+
+  CollisionResult<float> result_f;
+  collide(o1.geometry_f, tf1.cast<float>(), o2.geometry_f, tf2.cast<float>(),
+          request_f, result_f);
+  result.solver_statistics.update(result_f.solver_statistics);
+
+  if(!result_f.isCollision())
+    return result.numContacts();
+
+  float max_pen_depth = 0;
+  for(std::size_t i = 0; i < result_f.numContacts(); ++i)
+    max_pen_depth = std::max(max_pen_depth,
+                             result_f.getContact(i).penetration_depth);
+
+  if(max_pen_depth <= tolerance)
+    return collide(o1.geometry_d, tf1, o2.geometry_d, tf2, request, result);
+
+  for(std::size_t i = 0; i < result_f.numContacts(); ++i)
+  {
+    if(request.isSatisfied(result))
+      break;
+
+    const Contact<float>& contact = result_f.getContact(i);
+    if(request.enable_contact)
+    {
+      result.addContact(Contact<double>(
+          o1.geometry_d, o2.geometry_d, contact.b1, contact.b2,
+          contact.pos.cast<double>(), contact.normal.cast<double>(),
+          contact.penetration_depth));
+    }
+    else
+    {
+      result.addContact(Contact<double>(
+          o1.geometry_d, o2.geometry_d, contact.b1, contact.b2));
+    }
+  }
+
+  return result.numContacts();
+}
+
+//==============================================================================
+double distanceMixedPrecision(
+    const MixedPrecisionGeometry& o1, const Transform3<double>& tf1,
+    const MixedPrecisionGeometry& o2, const Transform3<double>& tf2,
+    double tolerance,
+    const DistanceRequest<double>& request,
+    DistanceResult<double>& result)
+{
+  DistanceRequest<float> request_f(
+        request.enable_nearest_points,
+        request.enable_signed_distance,
+        static_cast<float>(request.rel_err),
+        static_cast<float>(request.abs_err),
+        static_cast<float>(request.distance_tolerance),
+        request.gjk_solver_type);
+  request_f.distance_upper_bound = static_cast<float>(std::min<double>(
+        request.distance_upper_bound, std::numeric_limits<float>::max()));
+  request_f.enable_solver_statistics = request.enable_solver_statistics;
+
+  DistanceResult<float> result_f;
+  const float dist
+      = distanceSinglePrecision(o1, tf1, o2, tf2, request_f, result_f);
+  result.solver_statistics.update(result_f.solver_statistics);
+  if(dist <= tolerance)
+    return distance(o1.geometry_d, tf1, o2.geometry_d, tf2, request, result);
+
+  result.update(result_f.min_distance, o1.geometry_d, o2.geometry_d,
+                result_f.b1, result_f.b2,
+                result_f.nearest_points[0].cast<double>(),
+                result_f.nearest_points[1].cast<double>());
+
+  return dist;
+}
+
+} // namespace fcl
@@ -0,0 +1,98 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/narrowphase/solver_statistics.h"
+
+namespace fcl
+{
+
+//==============================================================================
+SolverStatistics::SolverStatistics()
+{
+  clear();
+}
+
+//==============================================================================
+void SolverStatistics::addGJKRun(unsigned int iterations,
+                                 bool iteration_limit_reached,
+                                 bool upper_bound_reached)
+{
+  ++num_gjk_runs;
+  gjk_iterations += iterations;
+  if(iteration_limit_reached)
+    ++num_gjk_iteration_limit_reached;
+  if(upper_bound_reached)
+    ++num_gjk_upper_bound_reached;
+}
+
+//==============================================================================
+void SolverStatistics::addEPARun(unsigned int iterations,
+                                 bool iteration_limit_reached,
+                                 EPAStatus status)
+{
+  ++num_epa_runs;
+  epa_iterations += iterations;
+  if(iteration_limit_reached)
+    ++num_epa_iteration_limit_reached;
+  last_epa_status = status;
+}
+
+//==============================================================================
+void SolverStatistics::update(const SolverStatistics& other)
+{
+  num_gjk_runs += other.num_gjk_runs;
+  gjk_iterations += other.gjk_iterations;
+  num_gjk_iteration_limit_reached += other.num_gjk_iteration_limit_reached;
+  num_gjk_upper_bound_reached += other.num_gjk_upper_bound_reached;
+  num_epa_runs += other.num_epa_runs;
+  epa_iterations += other.epa_iterations;
+  num_epa_iteration_limit_reached += other.num_epa_iteration_limit_reached;
+  if(other.last_epa_status != EPA_NOT_RUN)
+    last_epa_status = other.last_epa_status;
+}
+
+//==============================================================================
+void SolverStatistics::clear()
+{
+  num_gjk_runs = 0;
+  gjk_iterations = 0;
+  num_gjk_iteration_limit_reached = 0;
+  num_gjk_upper_bound_reached = 0;
+  num_epa_runs = 0;
+  epa_iterations = 0;
+  num_epa_iteration_limit_reached = 0;
+  last_epa_status = EPA_NOT_RUN;
+}
+
+} // namespace fcl
@@ -135,6 +135,10 @@ class Polytope {
     polygons_.push_back(static_cast<int>(indices.size()));
     polygons_.insert(polygons_.end(), indices);
   }
+  void add_face(const std::vector<int>& indices) {
+    polygons_.push_back(static_cast<int>(indices.size()));
+    polygons_.insert(polygons_.end(), indices.begin(), indices.end());
+  }
   // Confirms the number of vertices and number of polygons matches the counts
   // implied by vertex_count() and face_count(), respectively.
   void confirm_data() {
@@ -254,6 +258,67 @@ class Cube : public Polytope<S> {
   }
 };
 
+// A right prism whose cross section is a regular n-gon inscribed in a circle
+// of radius `scale` and whose height is `scale`. With enough sides, it has
+// enough vertices that support queries walk the vertex adjacency graph.
+template <typename S>
+class Prism : public Polytope<S> {
+ public:
+  Prism(S scale, int sides) : Polytope<S>(scale), sides_(sides) {
+    // Prism vertices in the prism's canonical frame P: the bottom ring
+    // followed by the top ring.
+    const S half_height = scale / 2;
+    for (int z = 0; z < 2; ++z) {
+      for (int i = 0; i < sides_; ++i) {
+        const S theta = 2 * constants<S>::pi() * i / sides_;
+        this->add_vertex(Vector3<S>(scale * std::cos(theta),
+                                    scale * std::sin(theta),
+                                    z == 0 ? -half_height : half_height));
+      }
+    }
+
+    // Now add the polygons: one quad per side plus the two n-gon caps.
+    for (int i = 0; i < sides_; ++i) {
+      const int j = (i + 1) % sides_;
+      this->add_face({i, j, sides_ + j, sides_ + i});
+    }
+    add_cap(false);
+    add_cap(true);
+
+    this->confirm_data();
+  }
+
+  // Polytope properties
+  int face_count() const final { return sides_ + 2; }
+  int vertex_count() const final { return 2 * sides_; }
+  virtual S volume() const final {
+    const S s = this->scale();
+    return sides_ * s * s * std::sin(2 * constants<S>::pi() / sides_) / 2 * s;
+  }
+  virtual Vector3<S> com() const final { return Vector3<S>::Zero(); }
+  virtual Matrix3<S> principal_inertia_tensor() const {
+    // TODO(SeanCurtis-TRI): Replace this with a legitimate tensor.
+    throw std::logic_error("Not implemented yet");
+  };
+  std::string description() const final {
+    return "Prism with " + std::to_string(sides_) + " sides and scale: " +
+           std::to_string(this->scale());
+  }
+
+ private:
+  void add_cap(bool top) {
+    std::vector<int> indices;
+    for (int i = 0; i < sides_; ++i) {
+      // The bottom cap is visited clockwise (viewed from above) so that it is
+      // counter-clockwise viewed from outside.
+      indices.push_back(top ? sides_ + i : sides_ - 1 - i);
+    }
+    this->add_face(indices);
+  }
+
+  int sides_{0};
+};
+
 void testConvexConstruction() {
   Cube<double> cube{1};
   // Set the cube at some other location to make sure that the interior point
@@ -503,6 +568,72 @@ GTEST_TEST(ConvexGeometry, CenterOfMass_Tetrahedron) {
   }
 }
 
+// Confirms that the support vertex reported by the convex polytope has the
+// same support value as the vertex found by an exhaustive search, for many
+// directions and from several warm-start vertices.
+template <template <typename> class Shape, typename S>
+void testExtremeVertex(const Shape<S>& model, bool expect_adjacency_walk,
+                       bool vectorized = false) {
+  for (const auto& X_WP : GetPoses<S>()) {
+    Shape<S> shape(model);
+    shape.SetPose(X_WP);
+    Convex<S> convex = shape.MakeConvex();
+    EXPECT_EQ(convex.usesVertexAdjacency(), expect_adjacency_walk)
+        << shape.description();
+    convex.setVectorizedSupport(vectorized);
+    EXPECT_EQ(convex.usesVectorizedSupport(), vectorized);
+
+    const int kDirections = 200;
+    for (int d = 0; d < kDirections; ++d) {
+      // Directions spread over the sphere via the golden spiral.
+      const S z = 1 - (2 * S(d) + 1) / kDirections;
+      const S r = std::sqrt(1 - z * z);
+      const S theta = S(2.399963229728653) * d;
+      const Vector3<S> dir(r * std::cos(theta), r * std::sin(theta), z);
+
+      S expected = -std::numeric_limits<S>::max();
+      for (int i = 0; i < convex.num_vertices; ++i) {
+        expected = max(expected, dir.dot(convex.vertices[i]));
+      }
+
+      const typename constants<S>::Real eps =
+          constants<S>::eps() * 8 * max(shape.scale(), S(1));
+      for (int start : {0, convex.num_vertices / 3, convex.num_vertices - 1}) {
+        const int index = convex.findExtremeVertexIndex(dir, start);
+        EXPECT_NEAR(dir.dot(convex.vertices[index]), expected, eps)
+            << shape.description() << " in direction " << dir.transpose()
+            << " starting at " << start
+            << "\nusing scalar: " << ScalarString<S>::value();
+      }
+      EXPECT_NEAR(dir.dot(convex.findExtremeVertex(dir)), expected, eps);
+    }
+  }
+}
+
+GTEST_TEST(ConvexGeometry, ExtremeVertex_Cube) {
+  for (double scale : get_test_scales()) {
+    testExtremeVertex(Cube<double>(scale), false);
+    testExtremeVertex(Cube<float>(static_cast<float>(scale)), false);
+  }
+}
+
+GTEST_TEST(ConvexGeometry, ExtremeVertex_Prism) {
+  for (double scale : get_test_scales()) {
+    testExtremeVertex(Prism<double>(scale, 64), true);
+    testExtremeVertex(Prism<float>(static_cast<float>(scale), 64), true);
+  }
+}
+
+GTEST_TEST(ConvexGeometry, ExtremeVertex_Vectorized) {
+  for (double scale : get_test_scales()) {
+    testExtremeVertex(Cube<double>(scale), false, true);
+    testExtremeVertex(Cube<float>(static_cast<float>(scale)), false, true);
+    // An odd number of sides leaves a remainder for the scalar tail loop.
+    testExtremeVertex(Prism<double>(scale, 63), true, true);
+    testExtremeVertex(Prism<float>(static_cast<float>(scale), 63), true, true);
+  }
+}
+
 // TODO(SeanCurtis-TRI): Add Tetrahedron inertia unit test.
 
 // TODO(SeanCurtis-TRI): Extend the moment of inertia test.
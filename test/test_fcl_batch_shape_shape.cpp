@@ -0,0 +1,302 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/narrowphase/batch_shape_shape.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+void generateBatchTransforms(
+    std::size_t n, aligned_vector<Transform3<S>>& tf1,
+    aligned_vector<Transform3<S>>& tf2)
+{
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+  test::generateRandomTransforms(extents, tf1, n);
+  test::generateRandomTransforms(extents, tf2, n);
+}
+
+//==============================================================================
+template <typename S>
+S pointSegmentDistance(const Vector3<S>& p, const Vector3<S>& a,
+                       const Vector3<S>& b)
+{
+  const Vector3<S> d = b - a;
+  const S len2 = d.squaredNorm();
+  S t = len2 > 0 ? (p - a).dot(d) / len2 : 0;
+  t = std::max<S>(0, std::min<S>(1, t));
+  return (a + d * t - p).norm();
+}
+
+//==============================================================================
+// Reference distance between the axes of two capsules. The distance from a
+// point sliding along one segment to the other segment is convex, so a
+// ternary search over the first segment converges to the minimum.
+template <typename S>
+S capsuleAxisDistance(const Capsule<S>& s1, const Transform3<S>& tf1,
+                      const Capsule<S>& s2, const Transform3<S>& tf2)
+{
+  const Vector3<S> u1 = tf1.linear().col(2) * (s1.lz / 2);
+  const Vector3<S> u2 = tf2.linear().col(2) * (s2.lz / 2);
+  const Vector3<S> a1 = tf1.translation() - u1;
+  const Vector3<S> a2 = tf2.translation() - u2;
+  const Vector3<S> b2 = tf2.translation() + u2;
+
+  S lo = 0;
+  S hi = 1;
+  for (int i = 0; i < 200; ++i)
+  {
+    const S m1 = lo + (hi - lo) / 3;
+    const S m2 = hi - (hi - lo) / 3;
+    if (pointSegmentDistance<S>(a1 + u1 * (2 * m1), a2, b2)
+        < pointSegmentDistance<S>(a1 + u1 * (2 * m2), a2, b2))
+      hi = m2;
+    else
+      lo = m1;
+  }
+  return pointSegmentDistance<S>(a1 + u1 * (lo + hi), a2, b2);
+}
+
+//==============================================================================
+template <typename S>
+void testSphereSphereBatch()
+{
+  const std::size_t n = 300;
+  const S tol = 1e-12;
+
+  aligned_vector<Transform3<S>> tf1, tf2;
+  generateBatchTransforms(n, tf1, tf2);
+  std::vector<Sphere<S>> s1, s2;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    s1.emplace_back(0.2 + 0.01 * (i % 100));
+    s2.emplace_back(0.5 + 0.005 * (i % 50));
+  }
+  // Coincident centers have a zero normal.
+  tf2[7] = tf1[7];
+
+  BatchCollisionResult<S> collision;
+  const std::size_t num_collisions =
+      collideBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, collision);
+  BatchDistanceResult<S> distance;
+  const std::size_t num_separated =
+      distanceBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, distance);
+
+  EXPECT_EQ(n, collision.size());
+  EXPECT_EQ(n, distance.size());
+  EXPECT_EQ(n, num_collisions + num_separated);
+  EXPECT_GT(num_collisions, 0u);
+  EXPECT_GT(num_separated, 0u);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::vector<ContactPoint<S>> contacts;
+    const bool hit = detail::sphereSphereIntersect(
+          s1[i], tf1[i], s2[i], tf2[i], &contacts);
+    EXPECT_EQ(hit, collision.isCollision(i));
+    if (hit)
+    {
+      const ContactPoint<S> contact = collision.getContact(i);
+      EXPECT_TRUE(contact.normal.isApprox(contacts[0].normal, tol)
+                  || contact.normal.isZero());
+      EXPECT_TRUE(contact.pos.isApprox(contacts[0].pos, tol));
+      EXPECT_NEAR(contacts[0].penetration_depth, contact.penetration_depth,
+                  tol);
+    }
+
+    S dist;
+    Vector3<S> p1, p2;
+    const bool separated = detail::sphereSphereDistance(
+          s1[i], tf1[i], s2[i], tf2[i], &dist, &p1, &p2);
+    EXPECT_EQ(separated, distance.separated[i] != 0);
+    EXPECT_NEAR(dist, distance.min_distance[i], tol);
+    if (separated)
+    {
+      EXPECT_TRUE(distance.getNearestPoint(0, i).isApprox(p1, tol));
+      EXPECT_TRUE(distance.getNearestPoint(1, i).isApprox(p2, tol));
+    }
+  }
+
+  EXPECT_TRUE(collision.getContact(7).normal.isZero());
+}
+
+//==============================================================================
+template <typename S>
+void testSphereBoxBatch()
+{
+  const std::size_t n = 300;
+  const S tol = 1e-10;
+
+  aligned_vector<Transform3<S>> tf1, tf2;
+  generateBatchTransforms(n, tf1, tf2);
+  std::vector<Sphere<S>> s1;
+  std::vector<Box<S>> s2;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    s1.emplace_back(0.2 + 0.01 * (i % 100));
+    s2.emplace_back(0.5 + 0.01 * (i % 30), 1.5 - 0.01 * (i % 40), 1);
+  }
+  // Put a few sphere centers inside their boxes, near different faces.
+  for (std::size_t i = 0; i < n; i += 10)
+  {
+    const Vector3<S> p_BC(0.1 * s2[i].side[0] * (1 + (i / 10) % 3),
+                          -0.2 * s2[i].side[1],
+                          0.05 * s2[i].side[2]);
+    tf1[i].translation() = tf2[i] * p_BC;
+  }
+
+  BatchCollisionResult<S> collision;
+  collideBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, collision);
+  BatchDistanceResult<S> distance;
+  distanceBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, distance);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::vector<ContactPoint<S>> contacts;
+    const bool hit = detail::sphereBoxIntersect(
+          s1[i], tf1[i], s2[i], tf2[i], &contacts);
+    EXPECT_EQ(hit, collision.isCollision(i));
+    if (hit)
+    {
+      const ContactPoint<S> contact = collision.getContact(i);
+      EXPECT_TRUE(contact.normal.isApprox(contacts[0].normal, tol));
+      EXPECT_TRUE(contact.pos.isApprox(contacts[0].pos, tol));
+      EXPECT_NEAR(contacts[0].penetration_depth, contact.penetration_depth,
+                  tol);
+    }
+
+    S dist;
+    Vector3<S> p_FSb, p_FBs;
+    const bool separated = detail::sphereBoxDistance(
+          s1[i], tf1[i], s2[i], tf2[i], &dist, &p_FSb, &p_FBs);
+    EXPECT_EQ(separated, distance.separated[i] != 0);
+    EXPECT_NEAR(dist, distance.min_distance[i], tol);
+    if (separated)
+    {
+      EXPECT_TRUE(distance.getNearestPoint(0, i).isApprox(p_FSb, tol));
+      EXPECT_TRUE(distance.getNearestPoint(1, i).isApprox(p_FBs, tol));
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void testCapsuleCapsuleBatch()
+{
+  const std::size_t n = 300;
+  const S tol = 1e-8;
+
+  aligned_vector<Transform3<S>> tf1, tf2;
+  generateBatchTransforms(n, tf1, tf2);
+  std::vector<Capsule<S>> s1, s2;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    s1.emplace_back(0.1 + 0.005 * (i % 40), 0.5 + 0.01 * (i % 70));
+    s2.emplace_back(0.2 + 0.005 * (i % 30), 1.0 + 0.01 * (i % 90));
+  }
+  // Degenerate (spherical) capsules and parallel axes.
+  s1[3].lz = 0;
+  s2[4].lz = 0;
+  s1[5].lz = 0;
+  s2[5].lz = 0;
+  tf2[6].linear() = tf1[6].linear();
+  tf2[8] = tf1[8];
+  tf2[8].translation() += tf1[8].linear().col(0) * 0.3;
+
+  BatchCollisionResult<S> collision;
+  collideBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, collision);
+  BatchDistanceResult<S> distance;
+  const std::size_t num_separated =
+      distanceBatch(s1.data(), tf1.data(), s2.data(), tf2.data(), n, distance);
+  EXPECT_GT(num_separated, 0u);
+  EXPECT_LT(num_separated, n);
+  EXPECT_FALSE(distance.separated[8]);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const S axis_distance = capsuleAxisDistance(s1[i], tf1[i], s2[i], tf2[i]);
+    const S sum = s1[i].radius + s2[i].radius;
+    EXPECT_EQ(axis_distance <= sum, collision.isCollision(i));
+    EXPECT_EQ(axis_distance > sum, distance.separated[i] != 0);
+
+    if (collision.isCollision(i))
+    {
+      EXPECT_NEAR(sum - axis_distance, collision.penetration_depth[i], tol);
+      EXPECT_NEAR(1, collision.getContact(i).normal.norm(), tol);
+    }
+    else
+    {
+      const Vector3<S> p1 = distance.getNearestPoint(0, i);
+      const Vector3<S> p2 = distance.getNearestPoint(1, i);
+      EXPECT_NEAR(axis_distance - sum, distance.min_distance[i], tol);
+      EXPECT_NEAR(distance.min_distance[i], (p1 - p2).norm(), tol);
+
+      // The nearest points lie on the capsule surfaces.
+      const Vector3<S> u1 = tf1[i].linear().col(2) * (s1[i].lz / 2);
+      const Vector3<S> u2 = tf2[i].linear().col(2) * (s2[i].lz / 2);
+      EXPECT_NEAR(s1[i].radius, pointSegmentDistance<S>(
+          p1, tf1[i].translation() - u1, tf1[i].translation() + u1), tol);
+      EXPECT_NEAR(s2[i].radius, pointSegmentDistance<S>(
+          p2, tf2[i].translation() - u2, tf2[i].translation() + u2), tol);
+    }
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BATCH_SHAPE_SHAPE, sphere_sphere)
+{
+  testSphereSphereBatch<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BATCH_SHAPE_SHAPE, sphere_box)
+{
+  testSphereBoxBatch<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BATCH_SHAPE_SHAPE, capsule_capsule)
+{
+  testCapsuleCapsuleBatch<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,515 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <thread>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_LBVH.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>> sequence;
+  std::size_t num_duplicates = 0;
+  std::size_t max_pairs = std::numeric_limits<std::size_t>::max();
+};
+
+//==============================================================================
+/// Records the pairs whose AABBs overlap, in the order they come, and stops
+/// the query after max_pairs of them. The naive manager hands every object to
+/// the callback for a single object query, so the overlap is checked here.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  auto pair = o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+  if(!cdata->pairs.insert(pair).second)
+    ++cdata->num_duplicates;
+  cdata->sequence.push_back(pair);
+  return cdata->sequence.size() >= cdata->max_pairs;
+}
+
+//==============================================================================
+template <typename S>
+struct MinDistance
+{
+  S min_distance = std::numeric_limits<S>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool minDistanceFunction(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                         void* cdata_, S& dist)
+{
+  auto* cdata = static_cast<MinDistance<S>*>(cdata_);
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  distance(o1, o2, request, result);
+  cdata->min_distance = std::min(cdata->min_distance, result.min_distance);
+  dist = cdata->min_distance;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void moveEnvironment(std::vector<CollisionObject<S>*>& env, S delta)
+{
+  for(auto* obj : env)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+      T[i] += 2 * (rand() / (S)RAND_MAX - 0.5) * delta;
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S env_scale, S box_size)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(box_size, box_size, box_size);
+  for(std::size_t i = 0; i < n; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+}
+
+//==============================================================================
+template <typename S>
+void checkSameSelfPairs(BroadPhaseCollisionManager<S>* manager,
+                        BroadPhaseCollisionManager<S>* reference)
+{
+  PairCollector<S> expected;
+  reference->collide(&expected, collectPairs<S>);
+  PairCollector<S> result;
+  manager->collide(&result, collectPairs<S>);
+
+  EXPECT_EQ(result.num_duplicates, 0u);
+  EXPECT_EQ(result.pairs, expected.pairs);
+}
+
+//==============================================================================
+void test_parallel_radix_sort()
+{
+  std::vector<uint64> keys;
+  std::vector<unsigned int> values;
+  for(unsigned int i = 0; i < 100000; ++i)
+  {
+    keys.push_back((static_cast<uint64>(rand()) << 20) ^ (rand() % 1000));
+    values.push_back(i);
+  }
+
+  std::vector<uint64> sequential_keys = keys;
+  std::vector<unsigned int> sequential_values = values;
+  std::vector<uint64> key_buffer;
+  std::vector<unsigned int> value_buffer;
+  detail::radixSort(sequential_keys, sequential_values, key_buffer,
+                    value_buffer);
+  detail::radixSort(keys, values, key_buffer, value_buffer, 3);
+
+  EXPECT_EQ(keys, sequential_keys);
+  EXPECT_EQ(values, sequential_values);
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+}
+
+//==============================================================================
+template <typename S>
+void test_LBVH_structure()
+{
+  LBVHCollisionManager<S> manager;
+  EXPECT_EQ(manager.getTreeDepth(), 0u);
+
+  std::vector<CollisionObject<S>*> env;
+  generateBoxes(env, 1, S(10), S(1));
+  manager.registerObjects(env);
+  EXPECT_EQ(manager.getTreeDepth(), 1u);
+
+  // Objects sharing a Morton code are told apart by their sorted position,
+  // so a pile of identical objects still makes a balanced tree
+  auto box = std::make_shared<Box<S>>(1, 1, 1);
+  for(int i = 0; i < 1023; ++i)
+    env.push_back(new CollisionObject<S>(box, Transform3<S>::Identity()));
+  manager.clear();
+  manager.registerObjects(env);
+  EXPECT_LE(manager.getTreeDepth(), 12u);
+
+  // Scattered objects
+  manager.clear();
+  for(auto* obj : env)
+    delete obj;
+  env.clear();
+  generateBoxes(env, 4000, S(100), S(1));
+  manager.registerObjects(env);
+  EXPECT_GT(manager.getTreeDepth(), 12u);
+  EXPECT_LT(manager.getTreeDepth(), 64u);
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_LBVH_collision(S margin, unsigned int num_threads)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, S(200), 100);
+  auto* plate = new CollisionObject<S>(
+      std::make_shared<Box<S>>(400, 400, 2), Transform3<S>::Identity());
+  env.push_back(plate);
+  generateBoxes(env, 3000, S(150), S(6));
+
+  NaiveCollisionManager<S> naive;
+  LBVHCollisionManager<S> manager;
+  naive.setSecurityMargin(margin);
+  manager.setSecurityMargin(margin);
+  manager.setNumThreads(num_threads);
+  EXPECT_EQ(manager.getNumThreads(), num_threads);
+  naive.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  manager.setup();
+  EXPECT_EQ(manager.size(), env.size());
+
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  // Every object moves, by small and by large motions
+  for(int frame = 0; frame < 4; ++frame)
+  {
+    moveEnvironment(env, frame < 2 ? S(1) : S(50));
+    naive.update();
+    manager.update();
+    checkSameSelfPairs<S>(&manager, &naive);
+  }
+
+  // The callbacks come in the same order whatever the number of threads,
+  // and the query stops when asked to
+  LBVHCollisionManager<S> sequential;
+  sequential.setSecurityMargin(margin);
+  sequential.registerObjects(env);
+  {
+    PairCollector<S> expected;
+    sequential.collide(&expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.sequence, expected.sequence);
+
+    PairCollector<S> stopped;
+    stopped.max_pairs = expected.sequence.size() / 2;
+    manager.collide(&stopped, collectPairs<S>);
+    EXPECT_EQ(stopped.sequence.size(), stopped.max_pairs);
+  }
+
+  // Objects updated one at a time, or only some of them
+  moveEnvironment(env, S(1));
+  for(auto* obj : env)
+    manager.update(obj);
+  naive.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  std::vector<CollisionObject<S>*> moved;
+  for(std::size_t i = 0; i < env.size(); i += 4)
+  {
+    env[i]->setTranslation(env[i]->getTranslation() + Vector3<S>(2, -1, 1));
+    env[i]->computeAABB();
+    moved.push_back(env[i]);
+  }
+  manager.update(moved);
+  naive.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  // Single object queries
+  std::vector<CollisionObject<S>*> queries;
+  test::generateEnvironments(queries, S(200), 10);
+  for(auto* query : queries)
+  {
+    PairCollector<S> expected;
+    naive.collide(query, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(query, &result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  // Against another manager
+  NaiveCollisionManager<S> naive_queries;
+  LBVHCollisionManager<S> manager_queries;
+  naive_queries.setSecurityMargin(margin);
+  manager_queries.setSecurityMargin(margin);
+  naive_queries.registerObjects(queries);
+  manager_queries.registerObjects(queries);
+  {
+    PairCollector<S> expected;
+    naive.collide(&naive_queries, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(&manager_queries, &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected.pairs);
+    PairCollector<S> swapped;
+    manager_queries.collide(&manager, &swapped, collectPairs<S>);
+    EXPECT_EQ(swapped.pairs, expected.pairs);
+  }
+
+  // Objects added and removed, including the plate
+  for(auto* query : queries)
+  {
+    naive.registerObject(query);
+    manager.registerObject(query);
+  }
+  checkSameSelfPairs<S>(&manager, &naive);
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    naive.unregisterObject(env[i]);
+    manager.unregisterObject(env[i]);
+  }
+  naive.unregisterObject(plate);
+  manager.unregisterObject(plate);
+  EXPECT_EQ(manager.size(), naive.size());
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  std::vector<CollisionObject<S>*> objs;
+  manager.getObjects(objs);
+  EXPECT_EQ(objs.size(), manager.size());
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+  PairCollector<S> none;
+  manager.collide(&none, collectPairs<S>);
+  EXPECT_TRUE(none.pairs.empty());
+
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : queries)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_LBVH_distance()
+{
+  // Spheres on a jittered lattice, none touching, and a plate below them
+  std::vector<CollisionObject<S>*> env;
+  for(int i = 0; i < 8; ++i)
+  {
+    for(int j = 0; j < 8; ++j)
+    {
+      for(int k = 0; k < 4; ++k)
+      {
+        Vector3<S> T(10 * i, 10 * j, 10 * k);
+        for(int a = 0; a < 3; ++a)
+          T[a] += 4 * (rand() / (S)RAND_MAX - 0.5);
+        const S r = 0.5 + 1.5 * rand() / (S)RAND_MAX;
+        env.push_back(new CollisionObject<S>(
+            std::make_shared<Sphere<S>>(r),
+            Transform3<S>(Translation3<S>(T))));
+      }
+    }
+  }
+  env.push_back(new CollisionObject<S>(
+      std::make_shared<Box<S>>(200, 200, 1),
+      Transform3<S>(Translation3<S>(Vector3<S>(35, 35, -20)))));
+
+  NaiveCollisionManager<S> naive;
+  LBVHCollisionManager<S> manager;
+  naive.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  manager.setup();
+
+  MinDistance<S> expected;
+  naive.distance(&expected, minDistanceFunction<S>);
+  MinDistance<S> result;
+  manager.distance(&result, minDistanceFunction<S>);
+  EXPECT_GT(expected.min_distance, 0);
+  EXPECT_NEAR(result.min_distance, expected.min_distance, 1e-6);
+
+  // Probes inside, beside and far away from the scene
+  const Vector3<S> probes[] = {Vector3<S>(33, 47, 12), Vector3<S>(-30, 10, 5),
+                               Vector3<S>(500, -400, 300)};
+  for(const auto& p : probes)
+  {
+    CollisionObject<S> probe(std::make_shared<Sphere<S>>(1),
+                             Transform3<S>(Translation3<S>(p)));
+    MinDistance<S> expected_probe;
+    naive.distance(&probe, &expected_probe, minDistanceFunction<S>);
+    MinDistance<S> result_probe;
+    manager.distance(&probe, &result_probe, minDistanceFunction<S>);
+    EXPECT_NEAR(result_probe.min_distance, expected_probe.min_distance, 1e-6);
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Update and self collision time of the linear BVH against the dynamic AABB
+/// trees, for boxes that all move by several times their size every frame.
+template <typename S>
+void test_LBVH_timing(std::size_t env_size, int num_frames)
+{
+  const S env_scale = std::cbrt(S(env_size)) * 5;
+  const S box_size = 2;
+
+  std::vector<CollisionObject<S>*> env;
+  generateBoxes(env, env_size, env_scale, box_size);
+
+  const unsigned int num_threads
+      = std::max(std::thread::hardware_concurrency(), 1u);
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  names.push_back("DynamicAABBTree");
+  managers.push_back(new DynamicAABBTreeCollisionManager<S>());
+  names.push_back("DynamicAABBTree_Array");
+  managers.push_back(new DynamicAABBTreeCollisionManager_Array<S>());
+  names.push_back("LBVH");
+  managers.push_back(new LBVHCollisionManager<S>());
+  names.push_back("LBVH, " + std::to_string(num_threads) + " threads");
+  auto* parallel = new LBVHCollisionManager<S>();
+  parallel->setNumThreads(num_threads);
+  managers.push_back(parallel);
+
+  std::vector<double> setup_time(managers.size(), 0);
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  test::Timer timer;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    timer.start();
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+    timer.stop();
+    setup_time[i] = timer.getElapsedTime();
+  }
+
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    moveEnvironment(env, 4 * box_size);
+
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] = pairs.pairs.size();
+    }
+
+    for(std::size_t i = 1; i < managers.size(); ++i)
+      EXPECT_EQ(num_pairs[i], num_pairs[0]);
+  }
+
+  std::cout << env_size << " objs, " << num_frames << " frames (ms)"
+            << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(24) << std::left << names[i]
+              << " setup " << std::setw(10) << setup_time[i]
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_LBVH, structure)
+{
+  test_parallel_radix_sort();
+  test_LBVH_structure<double>();
+  test_LBVH_structure<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_LBVH, collision)
+{
+  test_LBVH_collision<double>(0, 1);
+  test_LBVH_collision<double>(0, 4);
+  test_LBVH_collision<double>(5, 3);
+  test_LBVH_collision<float>(0, 2);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_LBVH, distance)
+{
+  test_LBVH_distance<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_LBVH, timing)
+{
+#ifdef NDEBUG
+  test_LBVH_timing<double>(2000, 10);
+  test_LBVH_timing<double>(20000, 10);
+#else
+  test_LBVH_timing<double>(1000, 2);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,283 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <thread>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_SaP_array.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+/// Records the pairs in the order they are reported, and stops after
+/// max_pairs of them.
+template <typename S>
+struct PairRecorder
+{
+  std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t max_pairs = std::numeric_limits<std::size_t>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool recordPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairRecorder<S>*>(cdata_);
+  cdata->pairs.emplace_back(o1, o2);
+  return cdata->pairs.size() >= cdata->max_pairs;
+}
+
+//==============================================================================
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> unorderedPairs(
+    const PairRecorder<S>& recorder)
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  for(const auto& pair : recorder.pairs)
+  {
+    pairs.insert(pair.first < pair.second
+                 ? pair : std::make_pair(pair.second, pair.first));
+  }
+  return pairs;
+}
+
+//==============================================================================
+template <typename S>
+void moveObjects(std::vector<CollisionObject<S>*>& objs, S delta)
+{
+  for(auto* obj : objs)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+      T[i] += 2 * (rand() / (S)RAND_MAX - 0.5) * delta;
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+/// Small boxes of random orientation in a cube.
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S box_size)
+{
+  const S env_scale = std::cbrt(S(n)) * 2.5 * box_size;
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(box_size, box_size, box_size);
+  for(std::size_t i = 0; i < n; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+}
+
+//==============================================================================
+template <typename S>
+void test_SSaP_parallel_collision(std::size_t env_size, S margin)
+{
+  std::vector<CollisionObject<S>*> env;
+  generateBoxes<S>(env, env_size, S(2));
+
+  SaPCollisionManager_Array<S> reference;
+  SSaPCollisionManager<S> sequential;
+  SSaPCollisionManager<S> parallel;
+  parallel.setNumThreads(4);
+  EXPECT_EQ(parallel.getNumThreads(), 4u);
+  reference.setSecurityMargin(margin);
+  sequential.setSecurityMargin(margin);
+  parallel.setSecurityMargin(margin);
+  reference.registerObjects(env);
+  sequential.registerObjects(env);
+  parallel.registerObjects(env);
+  reference.setup();
+  sequential.setup();
+  parallel.setup();
+
+  for(int frame = 0; frame < 4; ++frame)
+  {
+    PairRecorder<S> expected;
+    reference.collide(&expected, recordPairs<S>);
+    PairRecorder<S> result_sequential;
+    sequential.collide(&result_sequential, recordPairs<S>);
+    PairRecorder<S> result_parallel;
+    parallel.collide(&result_parallel, recordPairs<S>);
+
+    EXPECT_EQ(unorderedPairs(result_sequential), unorderedPairs(expected));
+    EXPECT_EQ(result_sequential.pairs.size(), expected.pairs.size());
+
+    // Same pairs, reported in the same order
+    EXPECT_EQ(result_parallel.pairs, result_sequential.pairs);
+
+    // Stopping early stops the parallel sweep at the same pair
+    PairRecorder<S> stopped_sequential;
+    stopped_sequential.max_pairs = expected.pairs.size() / 2 + 1;
+    sequential.collide(&stopped_sequential, recordPairs<S>);
+    PairRecorder<S> stopped_parallel;
+    stopped_parallel.max_pairs = stopped_sequential.max_pairs;
+    parallel.collide(&stopped_parallel, recordPairs<S>);
+    EXPECT_EQ(stopped_parallel.pairs, stopped_sequential.pairs);
+
+    // Small motions first, then a large one that needs a full sort
+    moveObjects(env, frame < 3 ? S(0.5) : S(100));
+    reference.update();
+    sequential.update();
+    parallel.update();
+  }
+
+  // Objects added after setup
+  std::vector<CollisionObject<S>*> more;
+  generateBoxes<S>(more, 100, S(3));
+  for(auto* obj : more)
+  {
+    reference.registerObject(obj);
+    sequential.registerObject(obj);
+    parallel.registerObject(obj);
+  }
+  reference.setup();
+  sequential.setup();
+  parallel.setup();
+  {
+    PairRecorder<S> expected;
+    reference.collide(&expected, recordPairs<S>);
+    PairRecorder<S> result_parallel;
+    parallel.collide(&result_parallel, recordPairs<S>);
+    EXPECT_EQ(unorderedPairs(result_parallel), unorderedPairs(expected));
+  }
+
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : more)
+    delete obj;
+}
+
+//==============================================================================
+/// Update and self collision time with one and several threads, for a scene
+/// of static objects with a fraction of them moving.
+template <typename S>
+void test_SSaP_parallel_timing(std::size_t env_size, std::size_t num_dynamic,
+                               int num_frames)
+{
+  std::vector<CollisionObject<S>*> env;
+  generateBoxes<S>(env, env_size, S(2));
+  std::vector<CollisionObject<S>*> dynamic(env.begin(),
+                                           env.begin() + num_dynamic);
+
+  const unsigned int thread_counts[] = {1, 2, 4};
+  std::vector<SSaPCollisionManager<S>*> managers;
+  for(auto num_threads : thread_counts)
+  {
+    managers.push_back(new SSaPCollisionManager<S>());
+    managers.back()->setNumThreads(num_threads);
+    managers.back()->registerObjects(env);
+    managers.back()->setup();
+  }
+
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  test::Timer timer;
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    moveObjects(dynamic, S(0.5));
+
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairRecorder<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, recordPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] = pairs.pairs.size();
+    }
+
+    for(std::size_t i = 1; i < managers.size(); ++i)
+      EXPECT_EQ(num_pairs[i], num_pairs[0]);
+  }
+
+  std::cout << env_size << " objs, " << num_dynamic << " moving, "
+            << num_frames << " frames (ms), "
+            << std::thread::hardware_concurrency() << " cores" << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(2) << thread_counts[i] << " threads"
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SSAP, parallel_collision)
+{
+  test_SSaP_parallel_collision<double>(500, 0);
+  test_SSaP_parallel_collision<double>(20000, 0);
+  test_SSaP_parallel_collision<double>(20000, 1);
+  test_SSaP_parallel_collision<float>(20000, 0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SSAP, parallel_timing)
+{
+#ifdef NDEBUG
+  test_SSaP_parallel_timing<double>(50000, 5000, 5);
+#else
+  test_SSaP_parallel_timing<double>(5000, 500, 2);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
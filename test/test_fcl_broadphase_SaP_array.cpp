@@ -0,0 +1,507 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SaP_array.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t num_duplicates = 0;
+};
+
+//==============================================================================
+/// Records the pairs whose AABBs overlap. The naive manager hands every object
+/// to the callback for a single object query, so the overlap is checked here.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  auto pair = o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+  if(!cdata->pairs.insert(pair).second)
+    ++cdata->num_duplicates;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+struct MinDistance
+{
+  S min_distance = std::numeric_limits<S>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool minDistanceFunction(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                         void* cdata_, S& dist)
+{
+  auto* cdata = static_cast<MinDistance<S>*>(cdata_);
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  distance(o1, o2, request, result);
+  cdata->min_distance = std::min(cdata->min_distance, result.min_distance);
+  dist = cdata->min_distance;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void moveEnvironment(std::vector<CollisionObject<S>*>& env, S delta)
+{
+  for(auto* obj : env)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+      T[i] += 2 * (rand() / (S)RAND_MAX - 0.5) * delta;
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+template <typename S>
+void checkSameSelfPairs(BroadPhaseCollisionManager<S>* manager,
+                        BroadPhaseCollisionManager<S>* reference)
+{
+  PairCollector<S> expected;
+  reference->collide(&expected, collectPairs<S>);
+  PairCollector<S> result;
+  manager->collide(&result, collectPairs<S>);
+
+  EXPECT_EQ(result.num_duplicates, 0u);
+  EXPECT_EQ(result.pairs, expected.pairs);
+}
+
+//==============================================================================
+template <typename S>
+void test_radix_sort()
+{
+  using Key = typename detail::SortableKey<S>::Type;
+
+  std::vector<S> numbers = {3, -1, 0, -0.0, 2.5, -1e30, 1e30, -2.5, 2.5, 0,
+                            std::numeric_limits<S>::min(), -3};
+  for(int i = 0; i < 1000; ++i)
+    numbers.push_back(1000 * (rand() / (S)RAND_MAX - 0.5));
+
+  std::vector<Key> keys;
+  std::vector<unsigned int> values;
+  for(std::size_t i = 0; i < numbers.size(); ++i)
+  {
+    keys.push_back(detail::SortableKey<S>::encode(numbers[i]));
+    values.push_back(static_cast<unsigned int>(i));
+  }
+  EXPECT_EQ(detail::SortableKey<S>::encode(S(0)),
+            detail::SortableKey<S>::encode(S(-0.0)));
+
+  std::vector<Key> key_buffer;
+  std::vector<unsigned int> value_buffer;
+  detail::radixSort(keys, values, key_buffer, value_buffer);
+
+  // Sorted by number, equal numbers kept in their original order
+  for(std::size_t i = 1; i < values.size(); ++i)
+  {
+    const S a = numbers[values[i - 1]];
+    const S b = numbers[values[i]];
+    EXPECT_LE(a, b);
+    if(a == b)
+    {
+      EXPECT_LT(values[i - 1], values[i]);
+    }
+  }
+}
+
+//==============================================================================
+void test_pair_hash_set()
+{
+  detail::PairHashSet set;
+  std::set<std::pair<unsigned int, unsigned int>> reference;
+
+  for(int i = 0; i < 20000; ++i)
+  {
+    unsigned int a = rand() % 300;
+    unsigned int b = rand() % 300;
+    const auto pair = std::make_pair(std::min(a, b), std::max(a, b));
+    if(rand() % 3)
+    {
+      EXPECT_EQ(set.insert(a, b), reference.insert(pair).second);
+    }
+    else
+    {
+      EXPECT_EQ(set.erase(b, a), reference.erase(pair) == 1);
+    }
+    EXPECT_EQ(set.contains(b, a), reference.count(pair) == 1);
+  }
+  EXPECT_EQ(set.size(), reference.size());
+
+  std::set<std::pair<unsigned int, unsigned int>> visited;
+  auto visitor = [&](unsigned int a, unsigned int b) -> bool
+  {
+    EXPECT_LE(a, b);
+    visited.insert(std::make_pair(a, b));
+    return false;
+  };
+  set.forEach(visitor);
+  EXPECT_EQ(visited, reference);
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(visited.begin()->first, visited.begin()->second));
+}
+
+//==============================================================================
+template <typename S>
+void test_SaP_array_collision(S margin)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, S(200), 100);
+  env.push_back(new CollisionObject<S>(
+      std::make_shared<Box<S>>(400, 400, 2), Transform3<S>::Identity()));
+
+  NaiveCollisionManager<S> naive;
+  SaPCollisionManager<S> sap;
+  SaPCollisionManager_Array<S> manager;
+  naive.setSecurityMargin(margin);
+  sap.setSecurityMargin(margin);
+  manager.setSecurityMargin(margin);
+  naive.registerObjects(env);
+  sap.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  sap.setup();
+  manager.setup();
+  EXPECT_EQ(manager.size(), env.size());
+  EXPECT_EQ(manager.numRebuilds(), 1u);
+
+  checkSameSelfPairs<S>(&manager, &naive);
+  checkSameSelfPairs<S>(&manager, &sap);
+
+  // Small motions are followed by insertion sort
+  for(int frame = 0; frame < 5; ++frame)
+  {
+    moveEnvironment(env, S(1));
+    naive.update();
+    sap.update();
+    manager.update();
+    checkSameSelfPairs<S>(&manager, &naive);
+    checkSameSelfPairs<S>(&manager, &sap);
+  }
+  EXPECT_EQ(manager.numRebuilds(), 1u);
+
+  // Large ones, by sorting from scratch
+  moveEnvironment(env, S(100));
+  naive.update();
+  manager.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+  EXPECT_EQ(manager.numRebuilds(), 2u);
+
+  // Objects updated one at a time, or only some of them
+  moveEnvironment(env, S(1));
+  for(auto* obj : env)
+    manager.update(obj);
+  naive.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  std::vector<CollisionObject<S>*> moved;
+  for(std::size_t i = 0; i < env.size(); i += 4)
+  {
+    env[i]->setTranslation(env[i]->getTranslation() + Vector3<S>(2, -1, 1));
+    env[i]->computeAABB();
+    moved.push_back(env[i]);
+  }
+  manager.update(moved);
+  naive.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  // Single object queries
+  std::vector<CollisionObject<S>*> queries;
+  test::generateEnvironments(queries, S(200), 10);
+  for(auto* query : queries)
+  {
+    PairCollector<S> expected;
+    naive.collide(query, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(query, &result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  // Against another manager
+  NaiveCollisionManager<S> naive_queries;
+  SaPCollisionManager_Array<S> manager_queries;
+  naive_queries.setSecurityMargin(margin);
+  manager_queries.setSecurityMargin(margin);
+  naive_queries.registerObjects(queries);
+  manager_queries.registerObjects(queries);
+  {
+    PairCollector<S> expected;
+    naive.collide(&naive_queries, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(&manager_queries, &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected.pairs);
+    PairCollector<S> swapped;
+    manager_queries.collide(&manager, &swapped, collectPairs<S>);
+    EXPECT_EQ(swapped.pairs, expected.pairs);
+  }
+
+  // Objects added one by one and removed, including the plate
+  for(auto* query : queries)
+  {
+    naive.registerObject(query);
+    manager.registerObject(query);
+  }
+  checkSameSelfPairs<S>(&manager, &naive);
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    naive.unregisterObject(env[i]);
+    manager.unregisterObject(env[i]);
+  }
+  naive.unregisterObject(env.back());
+  manager.unregisterObject(env.back());
+  EXPECT_EQ(manager.size(), naive.size());
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  moveEnvironment(env, S(1));
+  naive.update();
+  manager.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  std::vector<CollisionObject<S>*> objs;
+  manager.getObjects(objs);
+  EXPECT_EQ(objs.size(), manager.size());
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+  PairCollector<S> none;
+  manager.collide(&none, collectPairs<S>);
+  EXPECT_TRUE(none.pairs.empty());
+
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : queries)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_SaP_array_distance()
+{
+  // Spheres on a jittered lattice, none touching, and a plate below them
+  std::vector<CollisionObject<S>*> env;
+  for(int i = 0; i < 8; ++i)
+  {
+    for(int j = 0; j < 8; ++j)
+    {
+      for(int k = 0; k < 4; ++k)
+      {
+        Vector3<S> T(10 * i, 10 * j, 10 * k);
+        for(int a = 0; a < 3; ++a)
+          T[a] += 4 * (rand() / (S)RAND_MAX - 0.5);
+        const S r = 0.5 + 1.5 * rand() / (S)RAND_MAX;
+        env.push_back(new CollisionObject<S>(
+            std::make_shared<Sphere<S>>(r),
+            Transform3<S>(Translation3<S>(T))));
+      }
+    }
+  }
+  env.push_back(new CollisionObject<S>(
+      std::make_shared<Box<S>>(200, 200, 1),
+      Transform3<S>(Translation3<S>(Vector3<S>(35, 35, -20)))));
+
+  NaiveCollisionManager<S> naive;
+  SaPCollisionManager_Array<S> manager;
+  naive.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  manager.setup();
+
+  MinDistance<S> expected;
+  naive.distance(&expected, minDistanceFunction<S>);
+  MinDistance<S> result;
+  manager.distance(&result, minDistanceFunction<S>);
+  EXPECT_GT(expected.min_distance, 0);
+  EXPECT_NEAR(result.min_distance, expected.min_distance, 1e-6);
+
+  // Probes inside, beside and far away from the scene
+  const Vector3<S> probes[] = {Vector3<S>(33, 47, 12), Vector3<S>(-30, 10, 5),
+                               Vector3<S>(500, -400, 300)};
+  for(const auto& p : probes)
+  {
+    CollisionObject<S> probe(std::make_shared<Sphere<S>>(1),
+                             Transform3<S>(Translation3<S>(p)));
+    MinDistance<S> expected_probe;
+    naive.distance(&probe, &expected_probe, minDistanceFunction<S>);
+    MinDistance<S> result_probe;
+    manager.distance(&probe, &result_probe, minDistanceFunction<S>);
+    EXPECT_NEAR(result_probe.min_distance, expected_probe.min_distance, 1e-6);
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Update and self collision time of the array SaP against the linked list
+/// one, for boxes moving coherently in a cube.
+template <typename S>
+void test_SaP_array_timing(std::size_t env_size, int num_frames)
+{
+  const S env_scale = std::cbrt(S(env_size)) * 5;
+  const S box_size = 2;
+
+  std::vector<CollisionObject<S>*> env;
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, env_size);
+  auto box = std::make_shared<Box<S>>(box_size, box_size, box_size);
+  for(std::size_t i = 0; i < env_size; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  names.push_back("SaP");
+  managers.push_back(new SaPCollisionManager<S>());
+  names.push_back("SaP_Array");
+  managers.push_back(new SaPCollisionManager_Array<S>());
+
+  std::vector<double> setup_time(managers.size(), 0);
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  test::Timer timer;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    timer.start();
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+    timer.stop();
+    setup_time[i] = timer.getElapsedTime();
+  }
+
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    moveEnvironment(env, S(0.2));
+
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] = pairs.pairs.size();
+    }
+
+    for(std::size_t i = 1; i < managers.size(); ++i)
+      EXPECT_EQ(num_pairs[i], num_pairs[0]);
+  }
+
+  std::cout << env_size << " objs, " << num_frames << " frames (ms)"
+            << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(12) << std::left << names[i]
+              << " setup " << std::setw(10) << setup_time[i]
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SAP_ARRAY, sort_and_pairs)
+{
+  test_radix_sort<double>();
+  test_radix_sort<float>();
+  test_pair_hash_set();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SAP_ARRAY, collision)
+{
+  test_SaP_array_collision<double>(0);
+  test_SaP_array_collision<double>(5);
+  test_SaP_array_collision<float>(0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SAP_ARRAY, distance)
+{
+  test_SaP_array_distance<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SAP_ARRAY, timing)
+{
+#ifdef NDEBUG
+  test_SaP_array_timing<double>(2000, 10);
+  test_SaP_array_timing<double>(10000, 10);
+#else
+  test_SaP_array_timing<double>(1000, 2);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,468 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/allowed_collision_matrix.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_hierarchical_spatialhash.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_LBVH.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SaP_array.h"
+#include "fcl/broadphase/broadphase_spatialhash.h"
+#include "fcl/broadphase/broadphase_spatialhash_grid.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t num_calls = 0;
+
+  /// The robot objects, for the callback that filters the pairs itself
+  const std::set<CollisionObject<S>*>* robot = nullptr;
+};
+
+//==============================================================================
+/// Records the pairs whose AABBs overlap. The naive manager hands every object
+/// to the callback for a single object query, so the overlap is checked here.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  ++cdata->num_calls;
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  cdata->pairs.insert(o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1));
+  return false;
+}
+
+//==============================================================================
+/// Same as collectPairs, but drops the pairs of two environment objects, as a
+/// callback had to before the managers filtered the pairs themselves
+template <typename S>
+bool collectRobotPairs(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                       void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!cdata->robot->count(o1) && !cdata->robot->count(o2))
+  {
+    ++cdata->num_calls;
+    return false;
+  }
+
+  return collectPairs(o1, o2, cdata_);
+}
+
+//==============================================================================
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S env_scale)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(2, 2, 2);
+  for(std::size_t i = 0; i < n; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+}
+
+//==============================================================================
+/// Every manager, each with the matrix
+template <typename S>
+void createManagers(std::vector<CollisionObject<S>*>& env,
+                    const AllowedCollisionMatrix<S>* matrix,
+                    std::vector<std::string>& names,
+                    std::vector<BroadPhaseCollisionManager<S>*>& managers)
+{
+  Vector3<S> lower_limit, upper_limit;
+  SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
+  const S cell_size = 4;
+
+  names.push_back("SSaP");
+  managers.push_back(new SSaPCollisionManager<S>());
+  names.push_back("SaP");
+  managers.push_back(new SaPCollisionManager<S>());
+  names.push_back("SaP_Array");
+  managers.push_back(new SaPCollisionManager_Array<S>());
+  names.push_back("IntervalTree");
+  managers.push_back(new IntervalTreeCollisionManager<S>());
+  names.push_back("SpatialHashing");
+  managers.push_back(new SpatialHashingCollisionManager<S>(
+      cell_size, lower_limit, upper_limit));
+  names.push_back("SpatialHashGrid");
+  managers.push_back(new SpatialHashGridCollisionManager<S>(cell_size));
+  names.push_back("HierarchicalSpatialHash");
+  managers.push_back(new HierarchicalSpatialHashCollisionManager<S>(cell_size));
+  names.push_back("DynamicAABBTree");
+  managers.push_back(new DynamicAABBTreeCollisionManager<S>());
+  names.push_back("DynamicAABBTree_Array");
+  managers.push_back(new DynamicAABBTreeCollisionManager_Array<S>());
+  names.push_back("LBVH");
+  managers.push_back(new LBVHCollisionManager<S>());
+
+  for(auto* manager : managers)
+    manager->setAllowedCollisionMatrix(matrix);
+}
+
+//==============================================================================
+/// The pairs of objects with overlapping AABBs that the filter lets through
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> expectedPairs(
+    const std::vector<CollisionObject<S>*>& env1,
+    const std::vector<CollisionObject<S>*>& env2,
+    const AllowedCollisionMatrix<S>& matrix)
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  for(auto* o1 : env1)
+  {
+    for(auto* o2 : env2)
+    {
+      if(o1 == o2 || !o1->getAABB().overlap(o2->getAABB()))
+        continue;
+      if(!o1->canCollideWith(*o2) || matrix.isAllowed(o1, o2))
+        continue;
+      pairs.insert(o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1));
+    }
+  }
+  return pairs;
+}
+
+//==============================================================================
+template <typename S>
+void test_object_filter()
+{
+  auto box = std::make_shared<Box<S>>(1, 1, 1);
+  CollisionObject<S> a(box);
+  CollisionObject<S> b(box);
+  EXPECT_EQ(a.getCollisionCategory(), 1u);
+  EXPECT_EQ(a.getCollisionMask(), ~uint32(0));
+  EXPECT_TRUE(a.canCollideWith(b));
+
+  // b ignores the first category: neither object sees the other
+  b.setCollisionCategory(2);
+  b.setCollisionMask(~uint32(1));
+  EXPECT_FALSE(a.canCollideWith(b));
+  EXPECT_FALSE(b.canCollideWith(a));
+
+  b.setCollisionMask(1);
+  EXPECT_TRUE(a.canCollideWith(b));
+  a.setCollisionMask(1);
+  EXPECT_FALSE(a.canCollideWith(b));
+
+  AllowedCollisionMatrix<S> matrix;
+  EXPECT_TRUE(matrix.empty());
+  matrix.allow(&a, &b);
+  matrix.allow(&b, &a);
+  EXPECT_EQ(matrix.size(), 1u);
+  EXPECT_TRUE(matrix.isAllowed(&b, &a));
+  EXPECT_FALSE(matrix.isAllowed(&a, &a));
+  matrix.disallow(&b, &a);
+  EXPECT_FALSE(matrix.isAllowed(&a, &b));
+  EXPECT_TRUE(matrix.empty());
+}
+
+//==============================================================================
+template <typename S>
+void test_collision_filter(std::size_t env_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes(env, env_size, env_scale);
+
+  // Four categories, each ignoring one other, and random allowed pairs
+  AllowedCollisionMatrix<S> matrix;
+  for(std::size_t i = 0; i < env.size(); ++i)
+  {
+    const unsigned int category = rand() % 4;
+    env[i]->setCollisionCategory(1u << category);
+    env[i]->setCollisionMask(~(1u << ((category + 1) % 4)));
+    if(i > 0 && rand() % 2)
+      matrix.allow(env[i], env[rand() % i]);
+  }
+  for(std::size_t i = 0; i < env.size(); ++i)
+  {
+    for(std::size_t j = i + 1; j < env.size(); ++j)
+    {
+      if(env[i]->getAABB().overlap(env[j]->getAABB()) && rand() % 4 == 0)
+        matrix.allow(env[i], env[j]);
+    }
+  }
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  names.push_back("Naive");
+  managers.push_back(new NaiveCollisionManager<S>());
+  managers[0]->setAllowedCollisionMatrix(&matrix);
+  createManagers(env, &matrix, names, managers);
+
+  // Queries with objects outside of the managers
+  std::vector<CollisionObject<S>*> queries;
+  generateBoxes(queries, 50, env_scale);
+  for(auto* query : queries)
+    query->setCollisionMask(~2u);
+
+  const auto expected = expectedPairs(env, env, matrix);
+  const auto expected_queries = expectedPairs(queries, env, matrix);
+  EXPECT_FALSE(expected.empty());
+
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+
+    PairCollector<S> result;
+    managers[i]->collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected) << names[i];
+
+    PairCollector<S> query_result;
+    for(auto* query : queries)
+      managers[i]->collide(query, &query_result, collectPairs<S>);
+    EXPECT_EQ(query_result.pairs, expected_queries) << names[i];
+  }
+
+  // Changed masks take effect at the next update: no object of the first
+  // category collides any more with one of the third
+  for(auto* obj : env)
+  {
+    if(obj->getCollisionCategory() == 1)
+      obj->setCollisionMask(obj->getCollisionMask() & ~4u);
+  }
+  const auto expected_update = expectedPairs(env, env, matrix);
+  EXPECT_LT(expected_update.size(), expected.size());
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    managers[i]->update();
+
+    PairCollector<S> result;
+    managers[i]->collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected_update) << names[i];
+  }
+
+  // Between two managers of the same kind, the filter of the first applies
+  std::vector<std::string> other_names;
+  std::vector<BroadPhaseCollisionManager<S>*> others;
+  others.push_back(new NaiveCollisionManager<S>());
+  other_names.push_back("Naive");
+  createManagers<S>(queries, nullptr, other_names, others);
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    others[i]->registerObjects(queries);
+    others[i]->setup();
+
+    PairCollector<S> result;
+    managers[i]->collide(others[i], &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected_queries) << names[i];
+  }
+
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    delete managers[i];
+    delete others[i];
+  }
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : queries)
+    delete obj;
+}
+
+//==============================================================================
+/// The subtree masks of the tree managers as they are built incrementally,
+/// with objects registered one by one and moved one by one
+template <typename S>
+void test_collision_filter_incremental()
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = 10;
+  generateBoxes(env, 500, env_scale);
+  for(std::size_t i = 0; i < env.size(); ++i)
+  {
+    env[i]->setCollisionCategory(i % 2 ? 1 : 2);
+    env[i]->setCollisionMask(i % 2 ? ~0u : 1);
+  }
+
+  AllowedCollisionMatrix<S> matrix;
+  const auto expected = expectedPairs(env, env, matrix);
+
+  DynamicAABBTreeCollisionManager<S> tree;
+  DynamicAABBTreeCollisionManager_Array<S> tree_array;
+  std::vector<BroadPhaseCollisionManager<S>*> managers = {&tree, &tree_array};
+  for(auto* manager : managers)
+  {
+    for(auto* obj : env)
+      manager->registerObject(obj);
+
+    PairCollector<S> result;
+    manager->collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected);
+  }
+
+  for(std::size_t i = 0; i < 50; ++i)
+  {
+    env[i]->setTranslation(env[i]->getTranslation() + Vector3<S>(1, 0, 0));
+    env[i]->computeAABB();
+    env[i]->setCollisionMask(~0u);
+    for(auto* manager : managers)
+      manager->update(env[i]);
+  }
+
+  const auto expected_update = expectedPairs(env, env, matrix);
+  for(auto* manager : managers)
+  {
+    PairCollector<S> result;
+    manager->collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected_update);
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Time of the self collision of a scene of many environment objects that
+/// ignore each other and a few robot objects, the environment pairs rejected
+/// by the callback or by the managers
+template <typename S>
+void test_collision_filter_timing(std::size_t env_size, std::size_t robot_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes(env, env_size + robot_size, env_scale);
+  const std::set<CollisionObject<S>*> robot(env.begin() + env_size, env.end());
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  createManagers<S>(env, nullptr, names, managers);
+
+  std::cout << env_size << " environment objs, " << robot_size
+            << " robot objs (ms)" << std::endl;
+
+  test::Timer timer;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    for(std::size_t k = 0; k < env_size; ++k)
+    {
+      env[k]->setCollisionCategory(1);
+      env[k]->setCollisionMask(~0u);
+    }
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+
+    PairCollector<S> callback_pairs;
+    callback_pairs.robot = &robot;
+    timer.start();
+    managers[i]->collide(&callback_pairs, collectRobotPairs<S>);
+    timer.stop();
+    const double callback_time = timer.getElapsedTime();
+
+    // The environment objects only see the robot objects
+    for(std::size_t k = 0; k < env_size; ++k)
+    {
+      env[k]->setCollisionCategory(2);
+      env[k]->setCollisionMask(1);
+    }
+    managers[i]->update();
+
+    PairCollector<S> pairs;
+    pairs.robot = &robot;
+    timer.start();
+    managers[i]->collide(&pairs, collectRobotPairs<S>);
+    timer.stop();
+
+    EXPECT_EQ(pairs.pairs, callback_pairs.pairs) << names[i];
+    EXPECT_LT(pairs.num_calls, callback_pairs.num_calls) << names[i];
+
+    std::cout << std::setw(25) << std::left << names[i]
+              << " callback filter " << std::setw(10) << callback_time
+              << " calls " << std::setw(10) << callback_pairs.num_calls
+              << " manager filter " << std::setw(10) << timer.getElapsedTime()
+              << " calls " << pairs.num_calls << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_COLLISION_FILTER, object_filter)
+{
+  test_object_filter<double>();
+  test_object_filter<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_COLLISION_FILTER, collision_filter)
+{
+  test_collision_filter<double>(1000);
+  test_collision_filter<float>(1000);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_COLLISION_FILTER, collision_filter_incremental)
+{
+  test_collision_filter_incremental<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_COLLISION_FILTER, collision_filter_timing)
+{
+#ifdef NDEBUG
+  test_collision_filter_timing<double>(20000, 200);
+#else
+  test_collision_filter_timing<double>(2000, 20);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,304 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_continuous_dynamic_AABB_tree.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/math/motion/interp_motion.h"
+#include "fcl/math/motion/translation_motion.h"
+#include "fcl/narrowphase/continuous_collision.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+template <typename S>
+using ObjectPair
+    = std::pair<ContinuousCollisionObject<S>*, ContinuousCollisionObject<S>*>;
+
+//==============================================================================
+template <typename S>
+ObjectPair<S> makeOrderedPair(ContinuousCollisionObject<S>* o1,
+                              ContinuousCollisionObject<S>* o2)
+{
+  return o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+}
+
+//==============================================================================
+template <typename S>
+struct ContinuousPairCollector
+{
+  ContinuousCollisionRequest<S> request;
+
+  /// The pairs handed to the callback
+  std::set<ObjectPair<S>> candidates;
+
+  /// The candidates found in collision by the continuous collision check
+  std::set<ObjectPair<S>> collisions;
+
+  /// The smallest distance between swept AABBs seen by the distance callback
+  S min_distance = std::numeric_limits<S>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool collectContinuousPairs(ContinuousCollisionObject<S>* o1,
+                            ContinuousCollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<ContinuousPairCollector<S>*>(cdata_);
+  const ObjectPair<S> pair = makeOrderedPair(o1, o2);
+  cdata->candidates.insert(pair);
+
+  ContinuousCollisionResult<S> result;
+  collide(o1, o2, cdata->request, result);
+  if(result.is_collide)
+    cdata->collisions.insert(pair);
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+bool sweptAABBDistance(ContinuousCollisionObject<S>* o1,
+                       ContinuousCollisionObject<S>* o2, void* cdata_,
+                       S& dist)
+{
+  auto* cdata = static_cast<ContinuousPairCollector<S>*>(cdata_);
+  const S d = o1->getAABB().distance(o2->getAABB());
+  if(d < cdata->min_distance)
+    cdata->min_distance = d;
+  dist = cdata->min_distance;
+
+  return false;
+}
+
+//==============================================================================
+/// Random boxes and spheres, half of them translating and half of them moving
+/// along a screw motion
+template <typename S>
+void generateMovingObjects(
+    S env_scale, S delta, std::size_t n,
+    std::vector<std::unique_ptr<ContinuousCollisionObject<S>>>& objs)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale, -env_scale, env_scale};
+  S delta_trans[] = {delta, delta, delta};
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> transforms2;
+  test::generateRandomTransforms(extents, delta_trans, S(0.2) * constants<S>::pi(),
+                           transforms, transforms2, n);
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    std::shared_ptr<CollisionGeometry<S>> geom;
+    if(i % 3 == 0)
+      geom = std::make_shared<Sphere<S>>(2);
+    else
+      geom = std::make_shared<Box<S>>(4, 2, 3);
+
+    std::shared_ptr<MotionBase<S>> motion;
+    if(i % 2 == 0)
+      motion = std::make_shared<TranslationMotion<S>>(transforms[i], transforms2[i]);
+    else
+      motion = std::make_shared<InterpMotion<S>>(transforms[i], transforms2[i]);
+
+    objs.emplace_back(new ContinuousCollisionObject<S>(geom, motion));
+  }
+}
+
+//==============================================================================
+/// The pairs whose swept AABBs overlap, and those of them in collision
+template <typename S>
+void bruteForcePairs(const std::vector<ContinuousCollisionObject<S>*>& objs1,
+                     const std::vector<ContinuousCollisionObject<S>*>& objs2,
+                     ContinuousPairCollector<S>& expected)
+{
+  for(auto* o1 : objs1)
+  {
+    for(auto* o2 : objs2)
+    {
+      if(o1 == o2 || !o1->getAABB().overlap(o2->getAABB()))
+        continue;
+      collectContinuousPairs(o1, o2, &expected);
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void test_continuous_dynamic_AABB_tree(S env_scale, std::size_t n)
+{
+  std::vector<std::unique_ptr<ContinuousCollisionObject<S>>> storage;
+  generateMovingObjects<S>(env_scale, 10, n, storage);
+
+  std::vector<ContinuousCollisionObject<S>*> objs;
+  for(const auto& obj : storage)
+  {
+    obj->computeAABB();
+    objs.push_back(obj.get());
+  }
+
+  ContinuousCollisionRequest<S> request;
+  request.ccd_solver_type = CCDC_NAIVE;
+  request.ccd_motion_type = CCDM_LINEAR;
+
+  // Self collision
+  DynamicAABBTreeContinuousCollisionManager<S> manager;
+  manager.registerObjects(objs);
+  manager.setup();
+  EXPECT_EQ(manager.size(), n);
+
+  ContinuousPairCollector<S> expected;
+  expected.request = request;
+  bruteForcePairs(objs, objs, expected);
+  EXPECT_LT(expected.candidates.size(), n * (n - 1) / 2);
+
+  ContinuousPairCollector<S> self;
+  self.request = request;
+  manager.collide(&self, collectContinuousPairs<S>);
+  EXPECT_TRUE(self.candidates == expected.candidates);
+  EXPECT_TRUE(self.collisions == expected.collisions);
+
+  // Every pair found in collision by checking all the pairs survives the
+  // culling
+  std::set<ObjectPair<S>> all_collisions;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    for(std::size_t j = i + 1; j < n; ++j)
+    {
+      ContinuousCollisionResult<S> result;
+      collide(objs[i], objs[j], request, result);
+      if(result.is_collide)
+        all_collisions.insert(makeOrderedPair(objs[i], objs[j]));
+    }
+  }
+  EXPECT_TRUE(all_collisions == expected.collisions);
+
+  // One manager against another, each holding half of the objects, with the
+  // second filled one object at a time
+  const std::vector<ContinuousCollisionObject<S>*> objs1(objs.begin(), objs.begin() + n / 2);
+  const std::vector<ContinuousCollisionObject<S>*> objs2(objs.begin() + n / 2, objs.end());
+  DynamicAABBTreeContinuousCollisionManager<S> manager1;
+  DynamicAABBTreeContinuousCollisionManager<S> manager2;
+  manager1.registerObjects(objs1);
+  manager1.setup();
+  for(auto* obj : objs2)
+    manager2.registerObject(obj);
+  manager2.setup();
+
+  ContinuousPairCollector<S> cross_expected;
+  cross_expected.request = request;
+  bruteForcePairs(objs1, objs2, cross_expected);
+
+  ContinuousPairCollector<S> cross;
+  cross.request = request;
+  manager1.collide(&manager2, &cross, collectContinuousPairs<S>);
+  EXPECT_TRUE(cross.candidates == cross_expected.candidates);
+  EXPECT_TRUE(cross.collisions == cross_expected.collisions);
+
+  // Objects of the second half against the manager of the first one
+  for(std::size_t i = 0; i < objs2.size(); i += 7)
+  {
+    ContinuousPairCollector<S> single_expected;
+    single_expected.request = request;
+    bruteForcePairs({objs2[i]}, objs1, single_expected);
+
+    ContinuousPairCollector<S> single;
+    single.request = request;
+    manager1.collide(objs2[i], &single, collectContinuousPairs<S>);
+    EXPECT_TRUE(single.candidates == single_expected.candidates);
+    EXPECT_TRUE(single.collisions == single_expected.collisions);
+  }
+
+  // Removing objects removes their pairs
+  for(std::size_t i = 0; i < n; i += 2)
+    manager.unregisterObject(objs[i]);
+  manager.update();
+  EXPECT_EQ(manager.size(), n / 2);
+
+  std::vector<ContinuousCollisionObject<S>*> remaining;
+  manager.getObjects(remaining);
+  ContinuousPairCollector<S> remaining_expected;
+  remaining_expected.request = request;
+  bruteForcePairs(remaining, remaining, remaining_expected);
+
+  ContinuousPairCollector<S> after_removal;
+  after_removal.request = request;
+  manager.collide(&after_removal, collectContinuousPairs<S>);
+  EXPECT_TRUE(after_removal.candidates == remaining_expected.candidates);
+  EXPECT_TRUE(after_removal.collisions == remaining_expected.collisions);
+
+  // Distances between swept AABBs, self and against another manager
+  S expected_min = std::numeric_limits<S>::max();
+  for(auto* o1 : remaining)
+    for(auto* o2 : remaining)
+      if(o1 != o2)
+        expected_min = std::min(expected_min, o1->getAABB().distance(o2->getAABB()));
+
+  ContinuousPairCollector<S> self_distance;
+  manager.distance(&self_distance, sweptAABBDistance<S>);
+  EXPECT_EQ(self_distance.min_distance, expected_min);
+
+  S cross_min = std::numeric_limits<S>::max();
+  for(auto* o1 : objs1)
+    for(auto* o2 : objs2)
+      cross_min = std::min(cross_min, o1->getAABB().distance(o2->getAABB()));
+
+  ContinuousPairCollector<S> cross_distance;
+  manager1.distance(&manager2, &cross_distance, sweptAABBDistance<S>);
+  EXPECT_EQ(cross_distance.min_distance, cross_min);
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_CONTINUOUS_DYNAMIC_AABB_TREE, collide_and_distance)
+{
+  test_continuous_dynamic_AABB_tree<double>(100, 300);
+  test_continuous_dynamic_AABB_tree<double>(400, 300);
+  test_continuous_dynamic_AABB_tree<float>(100, 300);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,300 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_hierarchical_spatialhash.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_LBVH.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SaP_array.h"
+#include "fcl/broadphase/broadphase_spatialhash.h"
+#include "fcl/broadphase/broadphase_spatialhash_grid.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+template <typename S>
+using ObjectPairs
+    = std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>>;
+
+//==============================================================================
+/// Records the pairs whose AABBs overlap. The naive manager hands every pair
+/// to the callback, so the overlap is checked here.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata)
+{
+  if(o1->getAABB().overlap(o2->getAABB()))
+  {
+    static_cast<ObjectPairs<S>*>(cdata)->insert(
+        o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1));
+  }
+  return false;
+}
+
+//==============================================================================
+/// Distance between the AABBs of the objects, which the bounds of the
+/// managers never overestimate
+template <typename S>
+bool aabbDistance(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata,
+                  S& dist)
+{
+  const S d = o1->getAABB().distance(o2->getAABB());
+  if(d < dist)
+  {
+    dist = d;
+    *static_cast<S*>(cdata) = d;
+  }
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S env_scale, const Vector3<S>& offset)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(2, 2, 2);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    transforms[i].translation() += offset;
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+  }
+}
+
+//==============================================================================
+/// Every manager, with the objects registered
+template <typename S>
+void createManagers(const std::vector<CollisionObject<S>*>& env,
+                    std::vector<std::string>& names,
+                    std::vector<BroadPhaseCollisionManager<S>*>& managers)
+{
+  Vector3<S> lower_limit, upper_limit;
+  SpatialHashingCollisionManager<S>::computeBound(
+      const_cast<std::vector<CollisionObject<S>*>&>(env), lower_limit,
+      upper_limit);
+  const S cell_size = 4;
+
+  names.push_back("Naive");
+  managers.push_back(new NaiveCollisionManager<S>());
+  names.push_back("SSaP");
+  managers.push_back(new SSaPCollisionManager<S>());
+  names.push_back("SaP");
+  managers.push_back(new SaPCollisionManager<S>());
+  names.push_back("SaP_Array");
+  managers.push_back(new SaPCollisionManager_Array<S>());
+  names.push_back("IntervalTree");
+  managers.push_back(new IntervalTreeCollisionManager<S>());
+  names.push_back("SpatialHashing");
+  managers.push_back(new SpatialHashingCollisionManager<S>(
+      cell_size, lower_limit, upper_limit));
+  names.push_back("SpatialHashGrid");
+  managers.push_back(new SpatialHashGridCollisionManager<S>(cell_size));
+  names.push_back("HierarchicalSpatialHash");
+  managers.push_back(new HierarchicalSpatialHashCollisionManager<S>(cell_size));
+  names.push_back("DynamicAABBTree");
+  managers.push_back(new DynamicAABBTreeCollisionManager<S>());
+  names.push_back("DynamicAABBTree_Array");
+  managers.push_back(new DynamicAABBTreeCollisionManager_Array<S>());
+  names.push_back("LBVH");
+  managers.push_back(new LBVHCollisionManager<S>());
+
+  for(auto* manager : managers)
+  {
+    manager->registerObjects(env);
+    manager->setup();
+  }
+}
+
+//==============================================================================
+/// Collision and distance between the managers of every pair of types
+template <typename S>
+void test_cross_manager(std::size_t env_size, std::size_t robot_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  std::vector<CollisionObject<S>*> robot;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes<S>(env, env_size, env_scale, Vector3<S>::Zero());
+  generateBoxes<S>(robot, robot_size, env_scale / 2, Vector3<S>::Zero());
+
+  // Robot objects far from the environment, for the distance queries
+  std::vector<CollisionObject<S>*> far_robot;
+  generateBoxes<S>(far_robot, robot_size, env_scale / 2,
+                Vector3<S>(4 * env_scale, 0, 0));
+
+  ObjectPairs<S> expected;
+  for(auto* o1 : env)
+  {
+    for(auto* o2 : robot)
+    {
+      if(o1->getAABB().overlap(o2->getAABB()))
+        expected.insert(o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1));
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+
+  S expected_dist = std::numeric_limits<S>::max();
+  for(auto* o1 : env)
+  {
+    for(auto* o2 : far_robot)
+      expected_dist = std::min(expected_dist, o1->getAABB().distance(o2->getAABB()));
+  }
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> env_managers;
+  std::vector<BroadPhaseCollisionManager<S>*> robot_managers;
+  std::vector<BroadPhaseCollisionManager<S>*> far_robot_managers;
+  createManagers(env, names, env_managers);
+  names.clear();
+  createManagers(robot, names, robot_managers);
+  names.clear();
+  createManagers(far_robot, names, far_robot_managers);
+
+  for(std::size_t i = 0; i < env_managers.size(); ++i)
+  {
+    for(std::size_t j = 0; j < robot_managers.size(); ++j)
+    {
+      ObjectPairs<S> pairs;
+      env_managers[i]->collide(robot_managers[j], &pairs, collectPairs<S>);
+      EXPECT_EQ(pairs, expected) << names[i] << " vs " << names[j];
+
+      S dist = std::numeric_limits<S>::max();
+      env_managers[i]->distance(far_robot_managers[j], &dist, aabbDistance<S>);
+      EXPECT_EQ(dist, expected_dist) << names[i] << " vs " << names[j];
+    }
+  }
+
+  for(std::size_t i = 0; i < env_managers.size(); ++i)
+  {
+    delete env_managers[i];
+    delete robot_managers[i];
+    delete far_robot_managers[i];
+  }
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : robot)
+    delete obj;
+  for(auto* obj : far_robot)
+    delete obj;
+}
+
+//==============================================================================
+/// Time of the collision of a small robot manager with a large environment
+/// manager of another type, against querying the environment with the robot
+/// objects one by one
+template <typename S>
+void test_cross_manager_timing(std::size_t env_size, std::size_t robot_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  std::vector<CollisionObject<S>*> robot;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes<S>(env, env_size, env_scale, Vector3<S>::Zero());
+  generateBoxes<S>(robot, robot_size, env_scale / 4, Vector3<S>::Zero());
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> env_managers;
+  createManagers(env, names, env_managers);
+  DynamicAABBTreeCollisionManager<S> robot_manager;
+  robot_manager.registerObjects(robot);
+  robot_manager.setup();
+
+  std::cout << env_size << " environment objs, " << robot_size
+            << " robot objs in a dynamic AABB tree (ms)" << std::endl;
+
+  test::Timer timer;
+  for(std::size_t i = 1; i < env_managers.size(); ++i)
+  {
+    ObjectPairs<S> query_pairs;
+    timer.start();
+    for(auto* obj : robot)
+      env_managers[i]->collide(obj, &query_pairs, collectPairs<S>);
+    timer.stop();
+    const double query_time = timer.getElapsedTime();
+
+    ObjectPairs<S> pairs;
+    timer.start();
+    env_managers[i]->collide(&robot_manager, &pairs, collectPairs<S>);
+    timer.stop();
+
+    EXPECT_EQ(pairs, query_pairs) << names[i];
+
+    std::cout << std::setw(25) << std::left << names[i]
+              << " object queries " << std::setw(10) << query_time
+              << " manager query " << timer.getElapsedTime() << std::endl;
+  }
+
+  for(auto* manager : env_managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : robot)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_CROSS_MANAGER, cross_manager)
+{
+  test_cross_manager<double>(500, 100);
+  test_cross_manager<float>(500, 100);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_CROSS_MANAGER, cross_manager_timing)
+{
+#ifdef NDEBUG
+  test_cross_manager_timing<double>(20000, 200);
+#else
+  test_cross_manager_timing<double>(2000, 50);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,591 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t num_duplicates = 0;
+};
+
+//==============================================================================
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  auto pair = o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+  if(!cdata->pairs.insert(pair).second)
+    ++cdata->num_duplicates;
+  return false;
+}
+
+//==============================================================================
+/// Boxes in a cube, moved by a bounded random walk: the tree of a manager
+/// that only refits degrades slowly, as it does over a long simulation.
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S env_scale)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(2, 2, 2);
+  for(std::size_t i = 0; i < n; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+}
+
+//==============================================================================
+template <typename S>
+void randomWalk(std::vector<CollisionObject<S>*>& env, S step, S env_scale)
+{
+  for(auto* obj : env)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+    {
+      T[i] += 2 * (rand() / (S)RAND_MAX - 0.5) * step;
+      T[i] = std::max(-env_scale, std::min(env_scale, T[i]));
+    }
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+/// Checks the links and bounding volumes of a subtree, and collects its
+/// leaves
+template <typename BV>
+void checkSubtree(const detail::NodeBase<BV>* node,
+                  std::set<const detail::NodeBase<BV>*>& leaves)
+{
+  if(node->isLeaf())
+  {
+    leaves.insert(node);
+    return;
+  }
+
+  for(int i = 0; i < 2; ++i)
+  {
+    EXPECT_EQ(node->children[i]->parent, node);
+    checkSubtree(node->children[i], leaves);
+  }
+  EXPECT_TRUE(node->bv.equal(node->children[0]->bv + node->children[1]->bv));
+}
+
+//==============================================================================
+template <typename S>
+void test_tree_rotation_and_partial_rebuild()
+{
+  using Tree = detail::HierarchyTree<AABB<S>>;
+
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = 40;
+  generateBoxes(env, 1000, env_scale);
+
+  // Two copies of the same tree, one refitted and one rotated
+  Tree refitted(2, 0);
+  Tree rotated(2, 0);
+  std::vector<typename Tree::NodeType*> refitted_leaves;
+  std::vector<typename Tree::NodeType*> rotated_leaves;
+  for(auto* obj : env)
+  {
+    refitted_leaves.push_back(refitted.insert(obj->getAABB(), obj));
+    rotated_leaves.push_back(rotated.insert(obj->getAABB(), obj));
+  }
+  EXPECT_NEAR(refitted.getCost(), rotated.getCost(), 1e-6);
+
+  randomWalk(env, S(10), env_scale);
+  for(std::size_t i = 0; i < env.size(); ++i)
+  {
+    refitted_leaves[i]->bv = env[i]->getAABB();
+    rotated_leaves[i]->bv = env[i]->getAABB();
+  }
+  refitted.refit();
+  rotated.refitRotate();
+
+  // A rotation leaves the volume of its node as it is and shrinks the one
+  // of a child: the rotated tree costs less
+  EXPECT_LT(rotated.getCost(), refitted.getCost());
+
+  std::set<const typename Tree::NodeType*> leaves;
+  EXPECT_EQ(rotated.getRoot()->parent, nullptr);
+  checkSubtree(rotated.getRoot(), leaves);
+  EXPECT_EQ(leaves.size(), env.size());
+  EXPECT_EQ(rotated.size(), env.size());
+
+  // Rebuilding the costliest quarter lowers the cost further
+  const S cost = rotated.getCost();
+  rotated.rebuildCostliestSubtree(env.size() / 4);
+  EXPECT_LT(rotated.getCost(), cost);
+
+  leaves.clear();
+  EXPECT_EQ(rotated.getRoot()->parent, nullptr);
+  checkSubtree(rotated.getRoot(), leaves);
+  EXPECT_EQ(leaves.size(), env.size());
+
+  // Small trees are rebuilt whole
+  Tree small(2, 0);
+  for(std::size_t i = 0; i < 5; ++i)
+    small.insert(env[i]->getAABB(), env[i]);
+  small.rebuildCostliestSubtree(8);
+  leaves.clear();
+  EXPECT_EQ(small.getRoot()->parent, nullptr);
+  checkSubtree(small.getRoot(), leaves);
+  EXPECT_EQ(leaves.size(), 5u);
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_tree_cost_rebuilds(S margin)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = 50;
+  generateBoxes(env, 2000, env_scale);
+
+  NaiveCollisionManager<S> naive;
+  DynamicAABBTreeCollisionManager<S> manager;
+  DynamicAABBTreeCollisionManager<S> refit_only;
+  refit_only.tree_refit_rotation = false;
+  refit_only.tree_partial_rebuild_ratio = 0;
+  refit_only.tree_full_rebuild_ratio = 0;
+  DynamicAABBTreeCollisionManager<S> full_only;
+  full_only.tree_partial_rebuild_ratio = 0;
+  full_only.tree_full_rebuild_ratio = 1.1;
+
+  std::vector<DynamicAABBTreeCollisionManager<S>*> managers
+      = {&manager, &refit_only, &full_only};
+  naive.setSecurityMargin(margin);
+  naive.registerObjects(env);
+  naive.setup();
+  for(auto* m : managers)
+  {
+    m->setSecurityMargin(margin);
+    m->registerObjects(env);
+    m->setup();
+    EXPECT_GT(m->getTreeReferenceCost(), 0);
+    EXPECT_NEAR(m->getTreeCost(), m->getTreeReferenceCost(), 1e-6);
+  }
+
+  for(int frame = 0; frame < 40; ++frame)
+  {
+    randomWalk(env, S(3), env_scale);
+    naive.update();
+    for(auto* m : managers)
+      m->update();
+
+    if(frame % 10 == 9)
+    {
+      PairCollector<S> expected;
+      naive.collide(&expected, collectPairs<S>);
+      for(auto* m : managers)
+      {
+        PairCollector<S> result;
+        m->collide(&result, collectPairs<S>);
+        EXPECT_EQ(result.num_duplicates, 0u);
+        EXPECT_EQ(result.pairs, expected.pairs);
+      }
+    }
+  }
+
+  EXPECT_EQ(refit_only.getNumPartialRebuilds(), 0u);
+  EXPECT_EQ(refit_only.getNumFullRebuilds(), 0u);
+  EXPECT_GT(manager.getNumPartialRebuilds(), 0u);
+  EXPECT_GT(full_only.getNumFullRebuilds(), 0u);
+  EXPECT_EQ(full_only.getNumPartialRebuilds(), 0u);
+
+  EXPECT_LT(manager.getTreeCost(), refit_only.getTreeCost());
+  EXPECT_LE(full_only.getTreeCost(), 1.1 * full_only.getTreeReferenceCost());
+
+  // Objects registered one by one: the first update takes the reference
+  DynamicAABBTreeCollisionManager<S> incremental;
+  for(auto* obj : env)
+    incremental.registerObject(obj);
+  EXPECT_EQ(incremental.getTreeReferenceCost(), 0);
+  incremental.update();
+  EXPECT_GT(incremental.getTreeReferenceCost(), 0);
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Tree cost and self collision time of a manager that only refits its tree
+/// against one that rotates it and rebuilds it when its cost grows.
+template <typename S>
+void test_tree_cost_timing(std::size_t env_size, int num_frames)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = std::cbrt(S(env_size)) * 5;
+  generateBoxes(env, env_size, env_scale);
+
+  DynamicAABBTreeCollisionManager<S> refit_only;
+  refit_only.tree_refit_rotation = false;
+  refit_only.tree_partial_rebuild_ratio = 0;
+  refit_only.tree_full_rebuild_ratio = 0;
+  DynamicAABBTreeCollisionManager<S> manager;
+
+  std::vector<std::string> names = {"refit", "rotate and rebuild"};
+  std::vector<DynamicAABBTreeCollisionManager<S>*> managers
+      = {&refit_only, &manager};
+  for(auto* m : managers)
+  {
+    m->registerObjects(env);
+    m->setup();
+  }
+
+  std::cout << env_size << " objs, " << num_frames << " frames (ms)"
+            << std::endl;
+
+  test::Timer timer;
+  const int num_reports = 4;
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    randomWalk(env, S(1), env_scale);
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+    }
+
+    if((frame + 1) % (num_frames / num_reports) != 0)
+      continue;
+
+    std::cout << "frame " << frame + 1 << std::endl;
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      std::cout << std::setw(20) << std::left << names[i]
+                << " cost " << std::setw(10) << managers[i]->getTreeCost()
+                << " update " << std::setw(10) << update_time[i]
+                << " self collision " << std::setw(10) << collide_time[i]
+                << " rebuilds " << managers[i]->getNumPartialRebuilds()
+                << " + " << managers[i]->getNumFullRebuilds() << std::endl;
+      update_time[i] = 0;
+      collide_time[i] = 0;
+    }
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// The pairs the naive manager finds, but those of two static objects
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> expectedPairs(
+    const NaiveCollisionManager<S>& naive,
+    const std::set<CollisionObject<S>*>& statics)
+{
+  PairCollector<S> all;
+  naive.collide(&all, collectPairs<S>);
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  for(const auto& pair : all.pairs)
+  {
+    if(!statics.count(pair.first) || !statics.count(pair.second))
+      pairs.insert(pair);
+  }
+  return pairs;
+}
+
+//==============================================================================
+template <typename S>
+void test_static_dynamic(S margin)
+{
+  std::vector<CollisionObject<S>*> static_env;
+  std::vector<CollisionObject<S>*> dynamic_env;
+  const S env_scale = 50;
+  generateBoxes(static_env, 1500, env_scale);
+  generateBoxes(dynamic_env, 300, env_scale);
+  std::set<CollisionObject<S>*> statics(static_env.begin(), static_env.end());
+
+  NaiveCollisionManager<S> naive;
+  naive.setSecurityMargin(margin);
+  naive.registerObjects(static_env);
+  naive.registerObjects(dynamic_env);
+  naive.setup();
+
+  // Half of the static objects in bulk, the others one by one
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.setSecurityMargin(margin);
+  const std::size_t half = static_env.size() / 2;
+  manager.registerStaticObjects(std::vector<CollisionObject<S>*>(
+      static_env.begin(), static_env.begin() + half));
+  for(std::size_t i = half; i < static_env.size(); ++i)
+    manager.registerStaticObject(static_env[i]);
+  manager.registerObjects(dynamic_env);
+  manager.setup();
+
+  EXPECT_EQ(manager.size(), static_env.size() + dynamic_env.size());
+  EXPECT_EQ(manager.numStaticObjects(), static_env.size());
+  EXPECT_EQ(manager.getTree().size(), dynamic_env.size());
+  std::vector<CollisionObject<S>*> objs;
+  manager.getObjects(objs);
+  EXPECT_EQ(std::set<CollisionObject<S>*>(objs.begin(), objs.end()).size(),
+            objs.size());
+  EXPECT_EQ(objs.size(), manager.size());
+
+  for(int frame = 0; frame < 5; ++frame)
+  {
+    randomWalk(dynamic_env, S(3), env_scale);
+    naive.update();
+    manager.update();
+
+    PairCollector<S> result;
+    manager.collide(&result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expectedPairs(naive, statics));
+  }
+
+  // Queries of single objects see both trees
+  for(std::size_t i = 0; i < 20; ++i)
+  {
+    PairCollector<S> expected;
+    PairCollector<S> result;
+    naive.collide(dynamic_env[i], &expected, collectPairs<S>);
+    manager.collide(dynamic_env[i], &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  Transform3<S> far = Transform3<S>::Identity();
+  far.translation() = Vector3<S>(3 * env_scale, 0, 0);
+  CollisionObject<S> query(std::make_shared<Box<S>>(2, 2, 2), far);
+  test::DistanceData<S> expected_distance;
+  test::DistanceData<S> distance;
+  naive.distance(&query, &expected_distance, test::defaultDistanceFunction);
+  manager.distance(&query, &distance, test::defaultDistanceFunction);
+  EXPECT_NEAR(distance.result.min_distance,
+              expected_distance.result.min_distance, 1e-4);
+
+  // Against another manager, the static trees of both included
+  std::vector<CollisionObject<S>*> other_env;
+  generateBoxes(other_env, 100, env_scale);
+  NaiveCollisionManager<S> naive_other;
+  naive_other.setSecurityMargin(margin);
+  naive_other.registerObjects(other_env);
+  naive_other.setup();
+  DynamicAABBTreeCollisionManager<S> other;
+  other.setSecurityMargin(margin);
+  other.registerStaticObjects(std::vector<CollisionObject<S>*>(
+      other_env.begin(), other_env.begin() + 50));
+  other.registerObjects(std::vector<CollisionObject<S>*>(
+      other_env.begin() + 50, other_env.end()));
+  other.setup();
+  {
+    PairCollector<S> expected;
+    PairCollector<S> result;
+    naive.collide(&naive_other, &expected, collectPairs<S>);
+    manager.collide(&other, &result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  // A static object moved by hand, then objects of both kinds removed
+  static_env[0]->setTranslation(dynamic_env[0]->getTranslation());
+  static_env[0]->computeAABB();
+  naive.update();
+  manager.update(static_env[0]);
+  naive.unregisterObject(static_env[1]);
+  manager.unregisterObject(static_env[1]);
+  naive.unregisterObject(dynamic_env[1]);
+  manager.unregisterObject(dynamic_env[1]);
+  statics.erase(static_env[1]);
+  EXPECT_EQ(manager.numStaticObjects(), static_env.size() - 1);
+  {
+    PairCollector<S> result;
+    manager.collide(&result, collectPairs<S>);
+    EXPECT_TRUE(result.pairs.count(static_env[0] < dynamic_env[0]
+        ? std::make_pair(static_env[0], dynamic_env[0])
+        : std::make_pair(dynamic_env[0], static_env[0])));
+    EXPECT_EQ(result.pairs, expectedPairs(naive, statics));
+  }
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+  EXPECT_EQ(manager.numStaticObjects(), 0u);
+
+  for(auto* obj : static_env)
+    delete obj;
+  for(auto* obj : dynamic_env)
+    delete obj;
+  for(auto* obj : other_env)
+    delete obj;
+}
+
+//==============================================================================
+/// Update and self collision time of a scene of many static objects and a
+/// few moving ones, in one tree and with the static objects apart.
+template <typename S>
+void test_static_dynamic_timing(std::size_t num_static, std::size_t num_dynamic,
+                                int num_frames)
+{
+  std::vector<CollisionObject<S>*> static_env;
+  std::vector<CollisionObject<S>*> dynamic_env;
+  const S env_scale = std::cbrt(S(num_static)) * 5;
+  generateBoxes(static_env, num_static, env_scale);
+  generateBoxes(dynamic_env, num_dynamic, env_scale);
+
+  DynamicAABBTreeCollisionManager<S> single;
+  single.registerObjects(static_env);
+  single.registerObjects(dynamic_env);
+  single.setup();
+
+  DynamicAABBTreeCollisionManager<S> split;
+  split.registerStaticObjects(static_env);
+  split.registerObjects(dynamic_env);
+  split.setup();
+
+  std::vector<std::string> names = {"single tree", "static tree apart"};
+  std::vector<DynamicAABBTreeCollisionManager<S>*> managers = {&single, &split};
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  test::Timer timer;
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    randomWalk(dynamic_env, S(1), env_scale);
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] += pairs.pairs.size();
+    }
+  }
+
+  // The single tree also reports the pairs of static objects
+  EXPECT_GE(num_pairs[0], num_pairs[1]);
+
+  std::cout << num_static << " static objs, " << num_dynamic
+            << " moving objs, " << num_frames << " frames (ms)" << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(20) << std::left << names[i]
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* obj : static_env)
+    delete obj;
+  for(auto* obj : dynamic_env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_DYNAMIC_AABB_TREE, rotation_and_partial_rebuild)
+{
+  test_tree_rotation_and_partial_rebuild<double>();
+  test_tree_rotation_and_partial_rebuild<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_DYNAMIC_AABB_TREE, cost_rebuilds)
+{
+  test_tree_cost_rebuilds<double>(0);
+  test_tree_cost_rebuilds<double>(2);
+  test_tree_cost_rebuilds<float>(0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_DYNAMIC_AABB_TREE, cost_timing)
+{
+#ifdef NDEBUG
+  test_tree_cost_timing<double>(10000, 200);
+#else
+  test_tree_cost_timing<double>(1000, 20);
+#endif
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_DYNAMIC_AABB_TREE, static_dynamic)
+{
+  test_static_dynamic<double>(0);
+  test_static_dynamic<double>(2);
+  test_static_dynamic<float>(0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_DYNAMIC_AABB_TREE, static_dynamic_timing)
+{
+#ifdef NDEBUG
+  test_static_dynamic_timing<double>(20000, 200, 100);
+#else
+  test_static_dynamic_timing<double>(2000, 50, 10);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
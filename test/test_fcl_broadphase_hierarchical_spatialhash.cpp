@@ -0,0 +1,429 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_hierarchical_spatialhash.h"
+#include "fcl/broadphase/broadphase_spatialhash_grid.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t num_duplicates = 0;
+};
+
+//==============================================================================
+/// Records the pairs whose AABBs overlap. The naive manager hands every object
+/// to the callback for a single object query, so the overlap is checked here.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  auto pair = o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+  if(!cdata->pairs.insert(pair).second)
+    ++cdata->num_duplicates;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+struct MinDistance
+{
+  S min_distance = std::numeric_limits<S>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool minDistanceFunction(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                         void* cdata_, S& dist)
+{
+  auto* cdata = static_cast<MinDistance<S>*>(cdata_);
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  distance(o1, o2, request, result);
+  cdata->min_distance = std::min(cdata->min_distance, result.min_distance);
+  dist = cdata->min_distance;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+S randomIn(S lower, S upper)
+{
+  return lower + (upper - lower) * (rand() / (S)RAND_MAX);
+}
+
+//==============================================================================
+/// Boxes with sizes spread evenly over [min_size, max_size] on a log scale,
+/// in a cube of the given half extent.
+template <typename S>
+void generateMixedSizeBoxes(std::vector<CollisionObject<S>*>& env,
+                            std::size_t n, S min_size, S max_size, S scale)
+{
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    const S size = min_size
+        * std::pow(max_size / min_size, randomIn<S>(0, 1));
+    auto box = std::make_shared<Box<S>>(size, randomIn<S>(0.2, 1) * size,
+                                        randomIn<S>(0.2, 1) * size);
+    Transform3<S> tf(Translation3<S>(Vector3<S>(randomIn(-scale, scale),
+                                                randomIn(-scale, scale),
+                                                randomIn(-scale, scale))));
+    env.push_back(new CollisionObject<S>(box, tf));
+  }
+}
+
+//==============================================================================
+template <typename S>
+void moveEnvironment(std::vector<CollisionObject<S>*>& env, S delta)
+{
+  for(auto* obj : env)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+      T[i] += randomIn(-delta, delta);
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+template <typename S>
+void checkSameSelfPairs(BroadPhaseCollisionManager<S>* manager,
+                        BroadPhaseCollisionManager<S>* reference)
+{
+  PairCollector<S> expected;
+  reference->collide(&expected, collectPairs<S>);
+  PairCollector<S> result;
+  manager->collide(&result, collectPairs<S>);
+
+  EXPECT_EQ(result.num_duplicates, 0u);
+  EXPECT_EQ(result.pairs, expected.pairs);
+}
+
+//==============================================================================
+template <typename S>
+void test_levels()
+{
+  std::vector<CollisionObject<S>*> env;
+  generateMixedSizeBoxes<S>(env, 300, 0.1, 100, 100);
+
+  HierarchicalSpatialHashCollisionManager<S> manager(0.1, 2);
+  manager.registerObjects(env);
+  manager.setup();
+
+  // Sizes over three orders of magnitude: about ten levels
+  EXPECT_GE(manager.numLevels(), 9u);
+  EXPECT_LE(manager.numLevels(), 12u);
+  std::size_t num_objects = 0;
+  for(std::size_t l = 0; l < manager.numLevels(); ++l)
+    num_objects += manager.numObjectsInLevel(l);
+  EXPECT_EQ(num_objects, env.size());
+
+  for(auto* obj : env)
+    delete obj;
+
+  EXPECT_THROW(HierarchicalSpatialHashCollisionManager<S>(1, 1),
+               std::logic_error);
+}
+
+//==============================================================================
+template <typename S>
+void test_hierarchical_collision(S min_cell_size, S ratio, S margin)
+{
+  std::vector<CollisionObject<S>*> env;
+  generateMixedSizeBoxes<S>(env, 600, 0.1, 100, 150);
+
+  // The scene is unbounded: some objects far away from the others
+  generateMixedSizeBoxes<S>(env, 20, 1, 10, 10);
+  for(std::size_t i = env.size() - 20; i < env.size(); ++i)
+  {
+    env[i]->setTranslation(env[i]->getTranslation()
+                           + Vector3<S>(1e5, -1e5, 0));
+    env[i]->computeAABB();
+  }
+
+  NaiveCollisionManager<S> naive;
+  HierarchicalSpatialHashCollisionManager<S> manager(min_cell_size, ratio);
+  naive.setSecurityMargin(margin);
+  manager.setSecurityMargin(margin);
+  naive.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  manager.setup();
+  EXPECT_EQ(manager.size(), env.size());
+
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  moveEnvironment(env, S(5));
+  naive.update();
+  manager.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  moveEnvironment(env, S(5));
+  for(auto* obj : env)
+    manager.update(obj);
+  naive.update();
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  // Single object queries of all sizes
+  std::vector<CollisionObject<S>*> queries;
+  generateMixedSizeBoxes<S>(queries, 30, 0.1, 300, 150);
+  for(auto* query : queries)
+  {
+    PairCollector<S> expected;
+    naive.collide(query, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(query, &result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  // Against another manager
+  NaiveCollisionManager<S> naive_queries;
+  HierarchicalSpatialHashCollisionManager<S> manager_queries(
+      min_cell_size, ratio);
+  naive_queries.setSecurityMargin(margin);
+  manager_queries.setSecurityMargin(margin);
+  naive_queries.registerObjects(queries);
+  manager_queries.registerObjects(queries);
+  {
+    PairCollector<S> expected;
+    naive.collide(&naive_queries, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    manager.collide(&manager_queries, &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected.pairs);
+    PairCollector<S> swapped;
+    manager_queries.collide(&manager, &swapped, collectPairs<S>);
+    EXPECT_EQ(swapped.pairs, expected.pairs);
+  }
+
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    naive.unregisterObject(env[i]);
+    manager.unregisterObject(env[i]);
+  }
+  EXPECT_EQ(manager.size(), naive.size());
+  checkSameSelfPairs<S>(&manager, &naive);
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+  EXPECT_EQ(manager.numLevels(), 0u);
+
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : queries)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_hierarchical_distance()
+{
+  // Spheres of very different radii on a lattice, none touching
+  std::vector<CollisionObject<S>*> env;
+  for(int i = 0; i < 6; ++i)
+  {
+    for(int j = 0; j < 6; ++j)
+    {
+      for(int k = 0; k < 6; ++k)
+      {
+        const Vector3<S> T(100 * i + randomIn<S>(-10, 10),
+                           100 * j + randomIn<S>(-10, 10),
+                           100 * k + randomIn<S>(-10, 10));
+        const S r = 0.05 * std::pow(S(600), randomIn<S>(0, 1));
+        env.push_back(new CollisionObject<S>(
+            std::make_shared<Sphere<S>>(r), Transform3<S>(Translation3<S>(T))));
+      }
+    }
+  }
+
+  NaiveCollisionManager<S> naive;
+  HierarchicalSpatialHashCollisionManager<S> manager(0.1);
+  naive.registerObjects(env);
+  manager.registerObjects(env);
+  naive.setup();
+  manager.setup();
+
+  MinDistance<S> expected;
+  naive.distance(&expected, minDistanceFunction<S>);
+  MinDistance<S> result;
+  manager.distance(&result, minDistanceFunction<S>);
+  EXPECT_GT(expected.min_distance, 0);
+  EXPECT_NEAR(result.min_distance, expected.min_distance, 1e-6);
+
+  const Vector3<S> probes[] = {Vector3<S>(250, 250, 250),
+                               Vector3<S>(-100, 30, 70),
+                               Vector3<S>(1e4, -1e4, 0)};
+  for(const auto& p : probes)
+  {
+    CollisionObject<S> probe(std::make_shared<Sphere<S>>(0.5),
+                             Transform3<S>(Translation3<S>(p)));
+    MinDistance<S> expected_probe;
+    naive.distance(&probe, &expected_probe, minDistanceFunction<S>);
+    MinDistance<S> result_probe;
+    manager.distance(&probe, &result_probe, minDistanceFunction<S>);
+    EXPECT_NEAR(result_probe.min_distance, expected_probe.min_distance, 1e-6);
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Self collision time on a scene of mostly small parts among a few large
+/// ones, against single level grids tuned to either size and the dynamic
+/// AABB tree.
+template <typename S>
+void test_hierarchical_timing(std::size_t env_size, int num_frames)
+{
+  const S scale = std::cbrt(S(env_size)) * 3;
+
+  std::vector<CollisionObject<S>*> env;
+  generateMixedSizeBoxes<S>(env, env_size, 0.05, 0.5, scale);
+  generateMixedSizeBoxes<S>(env, env_size / 100, 5, 50, scale);
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  names.push_back("Grid (small cells)");
+  managers.push_back(new SpatialHashGridCollisionManager<S>(1));
+  names.push_back("Grid (large cells)");
+  managers.push_back(new SpatialHashGridCollisionManager<S>(50));
+  names.push_back("DynamicAABBTree");
+  managers.push_back(new DynamicAABBTreeCollisionManager<S>());
+  names.push_back("Hierarchical");
+  managers.push_back(new HierarchicalSpatialHashCollisionManager<S>(0.5));
+
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  for(auto* manager : managers)
+  {
+    manager->registerObjects(env);
+    manager->setup();
+  }
+
+  test::Timer timer;
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    moveEnvironment(env, S(0.1));
+
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] = pairs.pairs.size();
+    }
+
+    for(std::size_t i = 1; i < managers.size(); ++i)
+      EXPECT_EQ(num_pairs[i], num_pairs[0]);
+  }
+
+  std::cout << env.size() << " objs, " << num_frames << " frames (ms)"
+            << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(20) << std::left << names[i]
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_HIERARCHICAL_SPATIAL_HASH, levels)
+{
+  test_levels<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_HIERARCHICAL_SPATIAL_HASH, collision)
+{
+  test_hierarchical_collision<double>(0.1, 2, 0);
+  test_hierarchical_collision<double>(0.5, 4, 0);
+  test_hierarchical_collision<double>(0.1, 2, 2);
+  test_hierarchical_collision<float>(0.1, 2, 0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_HIERARCHICAL_SPATIAL_HASH, distance)
+{
+  test_hierarchical_distance<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_HIERARCHICAL_SPATIAL_HASH, timing)
+{
+#ifdef NDEBUG
+  test_hierarchical_timing<double>(50000, 3);
+#else
+  test_hierarchical_timing<double>(2000, 2);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
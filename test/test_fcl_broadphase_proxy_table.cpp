@@ -0,0 +1,325 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/detail/proxy_table.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+using ObjectPairs = std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>>;
+
+//==============================================================================
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata)
+{
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  static_cast<ObjectPairs<S>*>(cdata)->insert(
+      o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1));
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void generateBoxes(std::vector<CollisionObject<S>*>& env, std::size_t n,
+                   S env_scale)
+{
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  auto box = std::make_shared<Box<S>>(2, 2, 2);
+  for(std::size_t i = 0; i < n; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+}
+
+//==============================================================================
+template <typename S>
+void moveObject(CollisionObject<S>* obj, S step)
+{
+  const Vector3<S> delta(step * (rand() / S(RAND_MAX) - S(0.5)),
+                         step * (rand() / S(RAND_MAX) - S(0.5)),
+                         step * (rand() / S(RAND_MAX) - S(0.5)));
+  obj->setTranslation(obj->getTranslation() + delta);
+  obj->computeAABB();
+}
+
+//==============================================================================
+template <typename S>
+ObjectPairs<S> expectedPairs(const std::vector<CollisionObject<S>*>& objs)
+{
+  ObjectPairs<S> pairs;
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    for(std::size_t j = i + 1; j < objs.size(); ++j)
+      collectPairs<S>(objs[i], objs[j], &pairs);
+  }
+  return pairs;
+}
+
+//==============================================================================
+template <typename S>
+void test_proxy_table()
+{
+  auto box = std::make_shared<Box<S>>(1, 1, 1);
+  CollisionObject<S> a(box), b(box), c(box);
+
+  detail::ProxyTable<S, int> table;
+  detail::ProxyTable<S, int> other_table;
+  table.insert(&a, 1);
+  table.insert(&b, 2);
+  table.insert(&c, 3);
+  other_table.insert(&c, 4);
+  EXPECT_EQ(table.size(), 3u);
+  EXPECT_EQ(table.find(&b)->second, 2);
+  EXPECT_EQ(table.find(&c)->second, 3);
+  EXPECT_EQ(other_table.find(&c)->second, 4);
+  EXPECT_TRUE(other_table.find(&a) == other_table.end());
+
+  // The last entry takes the place of the removed one
+  table.erase(table.find(&a));
+  EXPECT_EQ(table.size(), 2u);
+  EXPECT_TRUE(table.find(&a) == table.end());
+  EXPECT_EQ(table.find(&b)->second, 2);
+  EXPECT_EQ(table.find(&c)->second, 3);
+  EXPECT_EQ(other_table.find(&c)->second, 4);
+  EXPECT_EQ(a.getBroadPhaseHandle(&table), std::size_t(-1));
+
+  // A copy carries the handles of the original, but is not in the table
+  CollisionObject<S> copy(c);
+  EXPECT_TRUE(table.find(&copy) == table.end());
+  EXPECT_TRUE(other_table.find(&copy) == other_table.end());
+
+  table.clear();
+  EXPECT_TRUE(table.find(&b) == table.end());
+  table.insert(&b, 5);
+  EXPECT_EQ(table.find(&b)->second, 5);
+}
+
+//==============================================================================
+/// Objects shared by several managers, moved, removed and added back one by
+/// one
+template <typename S>
+void test_incremental_updates(std::size_t env_size, int num_frames)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes(env, env_size, env_scale);
+
+  std::vector<std::string> names = {"SaP", "IntervalTree", "DynamicAABBTree",
+                                    "DynamicAABBTree_Array"};
+  std::vector<BroadPhaseCollisionManager<S>*> managers = {
+      new SaPCollisionManager<S>(), new IntervalTreeCollisionManager<S>(),
+      new DynamicAABBTreeCollisionManager<S>(),
+      new DynamicAABBTreeCollisionManager_Array<S>()};
+  for(auto* manager : managers)
+  {
+    manager->registerObjects(env);
+    manager->setup();
+  }
+
+  std::vector<CollisionObject<S>*> registered = env;
+  std::vector<CollisionObject<S>*> removed;
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    // Move some objects, updated one at a time or all together
+    std::vector<CollisionObject<S>*> moved;
+    for(auto* obj : registered)
+    {
+      if(rand() % 4 == 0)
+      {
+        moveObject<S>(obj, 1);
+        moved.push_back(obj);
+      }
+    }
+    for(auto* manager : managers)
+    {
+      if(frame % 2)
+      {
+        manager->update(moved);
+      }
+      else
+      {
+        for(auto* obj : moved)
+          manager->update(obj);
+      }
+    }
+
+    // Take some objects out, and put back those taken out before
+    std::vector<CollisionObject<S>*> kept;
+    for(auto* obj : registered)
+    {
+      if(rand() % 20 == 0)
+      {
+        for(auto* manager : managers)
+          manager->unregisterObject(obj);
+        removed.push_back(obj);
+      }
+      else
+      {
+        kept.push_back(obj);
+      }
+    }
+    if(frame % 3 == 2)
+    {
+      for(auto* obj : removed)
+      {
+        for(auto* manager : managers)
+          manager->registerObject(obj);
+        kept.push_back(obj);
+      }
+      removed.clear();
+    }
+    registered.swap(kept);
+
+    const auto expected = expectedPairs(registered);
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      managers[i]->setup();
+      EXPECT_EQ(managers[i]->size(), registered.size()) << names[i];
+
+      ObjectPairs<S> pairs;
+      managers[i]->collide(&pairs, collectPairs<S>);
+      EXPECT_EQ(pairs, expected) << names[i] << " frame " << frame;
+
+      std::vector<CollisionObject<S>*> objs;
+      managers[i]->getObjects(objs);
+      EXPECT_EQ(std::set<CollisionObject<S>*>(objs.begin(), objs.end()),
+                std::set<CollisionObject<S>*>(registered.begin(),
+                                              registered.end())) << names[i];
+    }
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Time of the updates of single objects and of removing and adding them back
+template <typename S>
+void test_incremental_update_timing(std::size_t env_size)
+{
+  std::vector<CollisionObject<S>*> env;
+  const S env_scale = std::cbrt(S(env_size)) * 2;
+  generateBoxes(env, env_size, env_scale);
+
+  std::vector<std::string> names = {"DynamicAABBTree",
+                                    "DynamicAABBTree_Array"};
+  std::vector<BroadPhaseCollisionManager<S>*> managers = {
+      new DynamicAABBTreeCollisionManager<S>(),
+      new DynamicAABBTreeCollisionManager_Array<S>()};
+
+  std::cout << env_size << " objs (ms)" << std::endl;
+
+  test::Timer timer;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    managers[i]->registerObjects(env);
+    managers[i]->setup();
+
+    for(auto* obj : env)
+      moveObject<S>(obj, 1);
+    timer.start();
+    managers[i]->update(env);
+    timer.stop();
+    const double update_time = timer.getElapsedTime();
+
+    timer.start();
+    for(auto* obj : env)
+      managers[i]->unregisterObject(obj);
+    for(auto* obj : env)
+      managers[i]->registerObject(obj);
+    managers[i]->setup();
+    timer.stop();
+
+    EXPECT_EQ(managers[i]->size(), env.size()) << names[i];
+
+    std::cout << std::setw(25) << std::left << names[i]
+              << " update " << std::setw(10) << update_time
+              << " unregister and register " << timer.getElapsedTime()
+              << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_PROXY_TABLE, proxy_table)
+{
+  test_proxy_table<double>();
+  test_proxy_table<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_PROXY_TABLE, incremental_updates)
+{
+  test_incremental_updates<double>(500, 10);
+  test_incremental_updates<float>(500, 10);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_PROXY_TABLE, incremental_update_timing)
+{
+#ifdef NDEBUG
+  test_incremental_update_timing<double>(20000);
+#else
+  test_incremental_update_timing<double>(2000);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
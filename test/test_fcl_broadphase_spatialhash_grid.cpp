@@ -0,0 +1,454 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "fcl/config.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_spatialhash.h"
+#include "fcl/broadphase/broadphase_spatialhash_grid.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+struct PairCollector
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t num_duplicates = 0;
+  std::size_t num_overlaps = 0;
+};
+
+//==============================================================================
+/// Records the pairs whose margin-grown AABBs overlap. The spatial hashing
+/// manager reports all the objects sharing a cell, so the overlap is checked
+/// here rather than trusted.
+template <typename S>
+bool collectPairs(CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<PairCollector<S>*>(cdata_);
+  if(!o1->getAABB().overlap(o2->getAABB()))
+    return false;
+
+  ++cdata->num_overlaps;
+  auto pair = o1 < o2 ? std::make_pair(o1, o2) : std::make_pair(o2, o1);
+  if(!cdata->pairs.insert(pair).second)
+    ++cdata->num_duplicates;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+struct MinDistance
+{
+  S min_distance = std::numeric_limits<S>::max();
+};
+
+//==============================================================================
+template <typename S>
+bool minDistanceFunction(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                         void* cdata_, S& dist)
+{
+  auto* cdata = static_cast<MinDistance<S>*>(cdata_);
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  distance(o1, o2, request, result);
+  cdata->min_distance = std::min(cdata->min_distance, result.min_distance);
+  dist = cdata->min_distance;
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void test_grid_cells()
+{
+  using Grid = detail::SpatialHashGrid<S>;
+  Grid grid(1);
+
+  std::vector<typename Grid::CellBox> boxes;
+  boxes.push_back(grid.cellBox(AABB<S>(Vector3<S>(0.5, 0.5, 0.5),
+                                       Vector3<S>(1.5, 0.7, 0.7))));
+  boxes.push_back(grid.cellBox(AABB<S>(Vector3<S>(1.2, 0.2, 0.2),
+                                       Vector3<S>(1.4, 0.4, 0.4))));
+  boxes.push_back(grid.cellBox(AABB<S>(Vector3<S>(-3.5, 0.5, 0.5),
+                                       Vector3<S>(-3.2, 0.7, 0.7))));
+  EXPECT_EQ(Grid::numCells(boxes[0]), 2u);
+  EXPECT_EQ(boxes[2].min[0], -4);
+
+  // Far away coordinates are clamped instead of wrapping around
+  const auto far_box = grid.cellBox(AABB<S>(Vector3<S>(-1e30, 0, 0),
+                                            Vector3<S>(1e30, 0, 0)));
+  EXPECT_LT(far_box.min[0], 0);
+  EXPECT_GT(far_box.max[0], 0);
+
+  for(int round = 0; round < 2; ++round)
+  {
+    grid.build(boxes, {0, 1, 2});
+    EXPECT_EQ(grid.numOccupiedCells(), 3u);
+
+    std::vector<std::vector<unsigned int>> cells;
+    auto visitor = [&](int x, int y, int z,
+                       const unsigned int* begin, const unsigned int* end)
+    {
+      EXPECT_EQ(y, 0);
+      EXPECT_EQ(z, 0);
+      cells.emplace_back(begin, end);
+      if(x == 1)
+        EXPECT_EQ(cells.back(), std::vector<unsigned int>({0, 1}));
+      return false;
+    };
+    grid.forEachOccupiedCell(visitor);
+    EXPECT_EQ(cells.size(), 3u);
+
+    cells.clear();
+    grid.forEachCell(boxes[1], visitor);
+    EXPECT_EQ(cells.size(), 1u);
+
+    EXPECT_TRUE(Grid::isFirstSharedCell(boxes[0], boxes[1], 1, 0, 0));
+    EXPECT_FALSE(Grid::isFirstSharedCell(boxes[0], boxes[0], 1, 0, 0));
+  }
+
+  grid.clear();
+  EXPECT_EQ(grid.numOccupiedCells(), 0u);
+}
+
+//==============================================================================
+template <typename S>
+void moveEnvironment(std::vector<CollisionObject<S>*>& env, S delta)
+{
+  for(auto* obj : env)
+  {
+    Vector3<S> T = obj->getTranslation();
+    for(int i = 0; i < 3; ++i)
+      T[i] += 2 * (rand() / (S)RAND_MAX - 0.5) * delta;
+    obj->setTranslation(T);
+    obj->computeAABB();
+  }
+}
+
+//==============================================================================
+template <typename S>
+void checkSameSelfPairs(BroadPhaseCollisionManager<S>* manager,
+                        BroadPhaseCollisionManager<S>* reference)
+{
+  PairCollector<S> expected;
+  reference->collide(&expected, collectPairs<S>);
+  PairCollector<S> result;
+  manager->collide(&result, collectPairs<S>);
+
+  EXPECT_EQ(result.num_duplicates, 0u);
+  EXPECT_EQ(result.pairs, expected.pairs);
+}
+
+//==============================================================================
+template <typename S>
+void test_grid_collision(S cell_size, unsigned int max_cells, S margin)
+{
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, S(200), 100);
+
+  // A large plate that stays out of the grid
+  env.push_back(new CollisionObject<S>(
+      std::make_shared<Box<S>>(400, 400, 2), Transform3<S>::Identity()));
+
+  NaiveCollisionManager<S> naive;
+  SpatialHashGridCollisionManager<S> grid(cell_size, max_cells);
+  naive.setSecurityMargin(margin);
+  grid.setSecurityMargin(margin);
+  naive.registerObjects(env);
+  grid.registerObjects(env);
+  naive.setup();
+  grid.setup();
+  EXPECT_EQ(grid.size(), env.size());
+
+  checkSameSelfPairs<S>(&grid, &naive);
+
+  // Moved objects, rebuilt by update() or lazily
+  moveEnvironment(env, S(20));
+  naive.update();
+  grid.update();
+  checkSameSelfPairs<S>(&grid, &naive);
+
+  moveEnvironment(env, S(20));
+  for(auto* obj : env)
+    grid.update(obj);
+  naive.update();
+  checkSameSelfPairs<S>(&grid, &naive);
+
+  // Single object queries
+  std::vector<CollisionObject<S>*> queries;
+  test::generateEnvironments(queries, S(200), 10);
+  for(auto* query : queries)
+  {
+    PairCollector<S> expected;
+    naive.collide(query, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    grid.collide(query, &result, collectPairs<S>);
+    EXPECT_EQ(result.num_duplicates, 0u);
+    EXPECT_EQ(result.pairs, expected.pairs);
+  }
+
+  // Against another manager
+  NaiveCollisionManager<S> naive_queries;
+  SpatialHashGridCollisionManager<S> grid_queries(cell_size, max_cells);
+  naive_queries.setSecurityMargin(margin);
+  grid_queries.setSecurityMargin(margin);
+  naive_queries.registerObjects(queries);
+  grid_queries.registerObjects(queries);
+  {
+    PairCollector<S> expected;
+    naive.collide(&naive_queries, &expected, collectPairs<S>);
+    PairCollector<S> result;
+    grid.collide(&grid_queries, &result, collectPairs<S>);
+    EXPECT_EQ(result.pairs, expected.pairs);
+    PairCollector<S> swapped;
+    grid_queries.collide(&grid, &swapped, collectPairs<S>);
+    EXPECT_EQ(swapped.pairs, expected.pairs);
+  }
+
+  // Removing objects, including the plate
+  for(std::size_t i = 0; i < env.size(); i += 3)
+  {
+    naive.unregisterObject(env[i]);
+    grid.unregisterObject(env[i]);
+  }
+  naive.unregisterObject(env.back());
+  grid.unregisterObject(env.back());
+  EXPECT_EQ(grid.size(), naive.size());
+  checkSameSelfPairs<S>(&grid, &naive);
+
+  std::vector<CollisionObject<S>*> objs;
+  grid.getObjects(objs);
+  EXPECT_EQ(objs.size(), grid.size());
+
+  grid.clear();
+  EXPECT_TRUE(grid.empty());
+  PairCollector<S> none;
+  grid.collide(&none, collectPairs<S>);
+  EXPECT_TRUE(none.pairs.empty());
+
+  for(auto* obj : env)
+    delete obj;
+  for(auto* obj : queries)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void test_grid_distance()
+{
+  // Spheres on a jittered lattice, none touching, and a plate below them
+  std::vector<CollisionObject<S>*> env;
+  for(int i = 0; i < 8; ++i)
+  {
+    for(int j = 0; j < 8; ++j)
+    {
+      for(int k = 0; k < 4; ++k)
+      {
+        Vector3<S> T(10 * i, 10 * j, 10 * k);
+        for(int a = 0; a < 3; ++a)
+          T[a] += 4 * (rand() / (S)RAND_MAX - 0.5);
+        const S r = 0.5 + 1.5 * rand() / (S)RAND_MAX;
+        env.push_back(new CollisionObject<S>(
+            std::make_shared<Sphere<S>>(r),
+            Transform3<S>(Translation3<S>(T))));
+      }
+    }
+  }
+  env.push_back(new CollisionObject<S>(
+      std::make_shared<Box<S>>(200, 200, 1),
+      Transform3<S>(Translation3<S>(Vector3<S>(35, 35, -20)))));
+
+  NaiveCollisionManager<S> naive;
+  SpatialHashGridCollisionManager<S> grid(4);
+  naive.registerObjects(env);
+  grid.registerObjects(env);
+  naive.setup();
+  grid.setup();
+
+  MinDistance<S> expected;
+  naive.distance(&expected, minDistanceFunction<S>);
+  MinDistance<S> result;
+  grid.distance(&result, minDistanceFunction<S>);
+  EXPECT_GT(expected.min_distance, 0);
+  EXPECT_NEAR(result.min_distance, expected.min_distance, 1e-6);
+
+  // Probes inside, beside and far away from the scene
+  const Vector3<S> probes[] = {Vector3<S>(33, 47, 12), Vector3<S>(-30, 10, 5),
+                               Vector3<S>(500, -400, 300)};
+  for(const auto& p : probes)
+  {
+    CollisionObject<S> probe(std::make_shared<Sphere<S>>(1),
+                             Transform3<S>(Translation3<S>(p)));
+    MinDistance<S> expected_probe;
+    naive.distance(&probe, &expected_probe, minDistanceFunction<S>);
+    MinDistance<S> result_probe;
+    grid.distance(&probe, &result_probe, minDistanceFunction<S>);
+    EXPECT_NEAR(result_probe.min_distance, expected_probe.min_distance, 1e-6);
+  }
+
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+/// Update and self collision time of the hash grid against the spatial
+/// hashing manager on its two hash tables, for small boxes moving in a cube.
+template <typename S>
+void test_grid_timing(std::size_t env_size, int num_frames)
+{
+  const S env_scale = std::cbrt(S(env_size)) * 5;
+  const S box_size = 2;
+
+  std::vector<CollisionObject<S>*> env;
+  S extents[] = {-env_scale, env_scale, -env_scale, env_scale,
+                 -env_scale, env_scale};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, env_size);
+  auto box = std::make_shared<Box<S>>(box_size, box_size, box_size);
+  for(std::size_t i = 0; i < env_size; ++i)
+    env.push_back(new CollisionObject<S>(box, transforms[i]));
+
+  const Vector3<S> lower_limit = Vector3<S>::Constant(-env_scale - box_size);
+  const Vector3<S> upper_limit = Vector3<S>::Constant(env_scale + box_size);
+  const S cell_size = 2 * box_size;
+
+  std::vector<std::string> names;
+  std::vector<BroadPhaseCollisionManager<S>*> managers;
+  names.push_back("SimpleHashTable");
+  managers.push_back(new SpatialHashingCollisionManager<S>(
+      cell_size, lower_limit, upper_limit, env_size));
+  names.push_back("SparseHashTable");
+  managers.push_back(new SpatialHashingCollisionManager<
+      S, detail::SparseHashTable<AABB<S>, CollisionObject<S>*,
+                                 detail::SpatialHash<S>>>(
+      cell_size, lower_limit, upper_limit, env_size));
+  names.push_back("SpatialHashGrid");
+  managers.push_back(new SpatialHashGridCollisionManager<S>(cell_size));
+
+  std::vector<double> update_time(managers.size(), 0);
+  std::vector<double> collide_time(managers.size(), 0);
+  std::vector<std::size_t> num_pairs(managers.size(), 0);
+
+  for(auto* manager : managers)
+  {
+    manager->registerObjects(env);
+    manager->setup();
+  }
+
+  test::Timer timer;
+  for(int frame = 0; frame < num_frames; ++frame)
+  {
+    moveEnvironment(env, S(0.5));
+
+    for(std::size_t i = 0; i < managers.size(); ++i)
+    {
+      timer.start();
+      managers[i]->update();
+      timer.stop();
+      update_time[i] += timer.getElapsedTime();
+
+      PairCollector<S> pairs;
+      timer.start();
+      managers[i]->collide(&pairs, collectPairs<S>);
+      timer.stop();
+      collide_time[i] += timer.getElapsedTime();
+      num_pairs[i] = pairs.pairs.size();
+    }
+
+    for(std::size_t i = 1; i < managers.size(); ++i)
+      EXPECT_EQ(num_pairs[i], num_pairs[0]);
+  }
+
+  std::cout << env_size << " objs, " << num_frames << " frames (ms)"
+            << std::endl;
+  for(std::size_t i = 0; i < managers.size(); ++i)
+  {
+    std::cout << std::setw(20) << std::left << names[i]
+              << " update " << std::setw(10) << update_time[i]
+              << " self collision " << std::setw(10) << collide_time[i]
+              << " pairs " << num_pairs[i] << std::endl;
+  }
+
+  for(auto* manager : managers)
+    delete manager;
+  for(auto* obj : env)
+    delete obj;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SPATIAL_HASH_GRID, grid_cells)
+{
+  test_grid_cells<double>();
+  test_grid_cells<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SPATIAL_HASH_GRID, collision)
+{
+  test_grid_collision<double>(20, 64, 0);
+  test_grid_collision<double>(20, 8, 0);
+  test_grid_collision<double>(100, 64, 0);
+  test_grid_collision<double>(20, 64, 5);
+  test_grid_collision<float>(20, 64, 0);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SPATIAL_HASH_GRID, distance)
+{
+  test_grid_distance<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BROADPHASE_SPATIAL_HASH_GRID, timing)
+{
+#ifdef NDEBUG
+  test_grid_timing<double>(10000, 5);
+  test_grid_timing<double>(100000, 2);
+#else
+  test_grid_timing<double>(1000, 2);
+#endif
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
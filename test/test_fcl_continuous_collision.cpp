@@ -0,0 +1,672 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fcl/config.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/cone.h"
+#include "fcl/geometry/shape/cylinder.h"
+#include "fcl/geometry/shape/ellipsoid.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/math/motion/aabb_motion_bound_visitor.h"
+#include "fcl/math/motion/interp_motion.h"
+#include "fcl/math/motion/screw_motion.h"
+#include "fcl/math/motion/spline_motion.h"
+#include "fcl/math/motion/tbv_motion_bound_visitor.h"
+#include "fcl/math/motion/translation_motion.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/continuous_collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "eigen_matrix_compare.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+Transform3<S> makeTransform(const Vector3<S>& translation,
+                            S angle = 0,
+                            const Vector3<S>& axis = Vector3<S>::UnitZ())
+{
+  Transform3<S> tf = Transform3<S>::Identity();
+  tf.linear() = AngleAxis<S>(angle, axis).toRotationMatrix();
+  tf.translation() = translation;
+  return tf;
+}
+
+//==============================================================================
+template <typename S>
+ContinuousCollisionResult<S> castShapes(
+    const CollisionGeometry<S>& o1, const Transform3<S>& tf1_beg,
+    const Transform3<S>& tf1_end, const CollisionGeometry<S>& o2,
+    const Transform3<S>& tf2_beg, const Transform3<S>& tf2_end,
+    CCDSolverType solver_type = CCDC_RAY_SHOOTING,
+    CCDMotionType motion_type = CCDM_TRANS)
+{
+  ContinuousCollisionRequest<S> request;
+  request.ccd_motion_type = motion_type;
+  request.ccd_solver_type = solver_type;
+
+  ContinuousCollisionResult<S> result;
+  continuousCollide(&o1, tf1_beg, tf1_end, &o2, tf2_beg, tf2_end, request, result);
+  return result;
+}
+
+//==============================================================================
+template <typename S>
+void test_ray_shooting_analytic()
+{
+  const S tol = 10 * constants<S>::eps_12();
+  const Transform3<S> identity = Transform3<S>::Identity();
+
+  // A sphere moving head-on into a static one touches it when the centers
+  // are 2 apart
+  Sphere<S> sphere(1);
+  auto result = castShapes<S>(
+      sphere, identity, identity, sphere,
+      makeTransform<S>(Vector3<S>(10, 0, 0)), makeTransform<S>(Vector3<S>(-10, 0, 0)));
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_NEAR(result.time_of_contact, 0.4, tol);
+  EXPECT_TRUE(CompareMatrices(result.contact_normal, Vector3<S>(1, 0, 0), tol));
+  EXPECT_TRUE(CompareMatrices(result.contact_tf2.translation(), Vector3<S>(2, 0, 0), 20 * tol));
+
+  // Both moving, the first one faster
+  result = castShapes<S>(
+      sphere, makeTransform<S>(Vector3<S>(0, -10, 0)), makeTransform<S>(Vector3<S>(0, 10, 0)),
+      sphere, makeTransform<S>(Vector3<S>(0, 10, 0)), makeTransform<S>(Vector3<S>(0, 0, 0)));
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_NEAR(result.time_of_contact, 18 / S(30), tol);
+  EXPECT_TRUE(CompareMatrices(result.contact_normal, Vector3<S>(0, 1, 0), tol));
+
+  // A box falling on a box turned by 45 degrees lands on its corner
+  Box<S> box(2, 2, 2);
+  result = castShapes<S>(
+      box, makeTransform<S>(Vector3<S>::Zero(), constants<S>::pi() / 4), makeTransform<S>(Vector3<S>::Zero(), constants<S>::pi() / 4),
+      box, makeTransform<S>(Vector3<S>(0, 5, 0)), makeTransform<S>(Vector3<S>(0, -5, 0)));
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_NEAR(result.time_of_contact, (4 - std::sqrt(S(2))) / 10, tol);
+  EXPECT_NEAR(result.contact_normal[1], 1, tol);
+
+  // Passing by
+  result = castShapes<S>(
+      sphere, identity, identity, sphere,
+      makeTransform<S>(Vector3<S>(10, 2.5, 0)), makeTransform<S>(Vector3<S>(-10, 2.5, 0)));
+  EXPECT_FALSE(result.is_collide);
+  EXPECT_EQ(result.time_of_contact, 1);
+
+  // Stopping short
+  result = castShapes<S>(
+      sphere, identity, identity, sphere,
+      makeTransform<S>(Vector3<S>(10, 0, 0)), makeTransform<S>(Vector3<S>(2.5, 0, 0)));
+  EXPECT_FALSE(result.is_collide);
+
+  // Overlapping from the start
+  result = castShapes<S>(
+      sphere, identity, identity, box,
+      makeTransform<S>(Vector3<S>(1.5, 0, 0)), makeTransform<S>(Vector3<S>(10, 0, 0)));
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_EQ(result.time_of_contact, 0);
+}
+
+//==============================================================================
+template <typename S>
+std::vector<std::shared_ptr<CollisionGeometry<S>>> makeConvexShapes()
+{
+  return {std::make_shared<Box<S>>(1, 2, 3),
+          std::make_shared<Sphere<S>>(1),
+          std::make_shared<Capsule<S>>(0.5, 2),
+          std::make_shared<Cylinder<S>>(1, 2),
+          std::make_shared<Cone<S>>(1, 2),
+          std::make_shared<Ellipsoid<S>>(0.5, 1, 1.5)};
+}
+
+//==============================================================================
+/// The time of contact found by ray shooting lies between the last sample of
+/// the naive solver without contact and the first one with
+template <typename S>
+void test_ray_shooting_against_sampling(std::size_t n)
+{
+  const auto shapes = makeConvexShapes<S>();
+
+  S extents[] = {-5, 5, -5, 5, -5, 5};
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> transforms2;
+  test::generateRandomTransforms(extents, transforms, 2 * n);
+  test::generateRandomTransforms(extents, transforms2, 2 * n);
+
+  ContinuousCollisionRequest<S> naive_request(1001, 0.0001, CCDM_TRANS);
+  const S step = 1 / S(1000);
+
+  std::size_t num_contacts = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    const auto& o1 = *shapes[i % shapes.size()];
+    const auto& o2 = *shapes[(i / shapes.size()) % shapes.size()];
+
+    // The end poses keep the rotations of the start ones
+    Transform3<S> tf1_end = transforms[2 * i];
+    tf1_end.translation() = transforms2[2 * i].translation();
+    Transform3<S> tf2_end = transforms[2 * i + 1];
+    tf2_end.translation() = transforms2[2 * i + 1].translation();
+
+    const auto result = castShapes<S>(
+        o1, transforms[2 * i], tf1_end, o2, transforms[2 * i + 1], tf2_end);
+
+    ContinuousCollisionResult<S> naive_result;
+    continuousCollide(&o1, transforms[2 * i], tf1_end,
+                      &o2, transforms[2 * i + 1], tf2_end,
+                      naive_request, naive_result);
+
+    if(!naive_result.is_collide)
+      continue;
+
+    ++num_contacts;
+    EXPECT_TRUE(result.is_collide);
+    EXPECT_LE(result.time_of_contact, naive_result.time_of_contact + 0.01 * step);
+    EXPECT_GE(result.time_of_contact, naive_result.time_of_contact - 1.01 * step);
+    if(result.time_of_contact > 0)
+      EXPECT_NEAR(result.contact_normal.norm(), 1, constants<S>::eps_12());
+  }
+
+  EXPECT_GT(num_contacts, n / 10);
+}
+
+//==============================================================================
+template <typename S>
+void test_ray_shooting_timing(std::size_t n)
+{
+  // Conservative advancement has no ellipsoid support
+  auto shapes = makeConvexShapes<S>();
+  shapes.pop_back();
+
+  S extents[] = {-5, 5, -5, 5, -5, 5};
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> transforms2;
+  test::generateRandomTransforms(extents, transforms, 2 * n);
+  test::generateRandomTransforms(extents, transforms2, 2 * n);
+
+  const std::vector<CCDSolverType> solvers
+      = {CCDC_NAIVE, CCDC_CONSERVATIVE_ADVANCEMENT, CCDC_RAY_SHOOTING};
+  const std::vector<std::string> names
+      = {"naive", "conservative advancement", "ray shooting"};
+
+  std::cout << n << " translating convex shape pairs (ms)" << std::endl;
+  for(std::size_t s = 0; s < solvers.size(); ++s)
+  {
+    std::size_t num_contacts = 0;
+    test::Timer timer;
+    timer.start();
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      const auto& o1 = *shapes[i % shapes.size()];
+      const auto& o2 = *shapes[(i / shapes.size()) % shapes.size()];
+      Transform3<S> tf1_end = transforms[2 * i];
+      tf1_end.translation() = transforms2[2 * i].translation();
+      Transform3<S> tf2_end = transforms[2 * i + 1];
+      tf2_end.translation() = transforms2[2 * i + 1].translation();
+
+      if(castShapes<S>(o1, transforms[2 * i], tf1_end,
+                       o2, transforms[2 * i + 1], tf2_end, solvers[s]).is_collide)
+        ++num_contacts;
+    }
+    timer.stop();
+    std::cout << "  " << names[s] << ": " << timer.getElapsedTime()
+              << " (" << num_contacts << " contacts)" << std::endl;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void test_adaptive_advancement_analytic()
+{
+  const S tol = 10 * constants<S>::eps_12();
+  const S toc_err = ContinuousCollisionRequest<S>().toc_err;
+  const Transform3<S> identity = Transform3<S>::Identity();
+
+  // Head-on, the objects close in as fast as the motion bound allows, so the
+  // search stops within toc_err before the contact
+  Sphere<S> sphere(1);
+  auto result = castShapes<S>(
+      sphere, identity, identity, sphere,
+      makeTransform<S>(Vector3<S>(10, 0, 0)), makeTransform<S>(Vector3<S>(-10, 0, 0)),
+      CCDC_ADAPTIVE_ADVANCEMENT);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_LE(result.time_of_contact, 0.4 + tol);
+  EXPECT_GE(result.time_of_contact, 0.4 - toc_err);
+
+  // Passing by
+  result = castShapes<S>(
+      sphere, identity, identity, sphere,
+      makeTransform<S>(Vector3<S>(10, 2.5, 0)), makeTransform<S>(Vector3<S>(-10, 2.5, 0)),
+      CCDC_ADAPTIVE_ADVANCEMENT);
+  EXPECT_FALSE(result.is_collide);
+  EXPECT_EQ(result.time_of_contact, 1);
+
+  // Overlapping from the start
+  Box<S> box(2, 2, 2);
+  result = castShapes<S>(
+      sphere, identity, identity, box,
+      makeTransform<S>(Vector3<S>(1.5, 0, 0)), makeTransform<S>(Vector3<S>(10, 0, 0)),
+      CCDC_ADAPTIVE_ADVANCEMENT);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_EQ(result.time_of_contact, 0);
+
+  // Evenly spaced de Boor points on a line make the spline move from 8 to 0
+  // at constant speed
+  const Vector3<S> rotation(0, 0, 0.1);
+  SplineMotion<S> spline(
+      Vector3<S>(16, 0, 0), Vector3<S>(8, 0, 0), Vector3<S>(0, 0, 0), Vector3<S>(-8, 0, 0),
+      rotation, rotation, rotation, rotation);
+  TranslationMotion<S> still(identity, identity);
+
+  ContinuousCollisionRequest<S> request;
+  request.ccd_solver_type = CCDC_ADAPTIVE_ADVANCEMENT;
+  result = ContinuousCollisionResult<S>();
+  continuousCollide(&sphere, &still, &sphere, &spline, request, result);
+  EXPECT_TRUE(result.is_collide);
+  EXPECT_LE(result.time_of_contact, 0.75 + tol);
+  EXPECT_GE(result.time_of_contact, 0.75 - toc_err);
+}
+
+//==============================================================================
+template <typename S>
+std::vector<std::shared_ptr<CollisionGeometry<S>>> makeMeshes()
+{
+  auto box = std::make_shared<BVHModel<OBBRSS<S>>>();
+  generateBVHModel(*box, Box<S>(1, 2, 3), Transform3<S>::Identity());
+  auto sphere = std::make_shared<BVHModel<OBBRSS<S>>>();
+  generateBVHModel(*sphere, Sphere<S>(1), Transform3<S>::Identity(), 16, 16);
+  return {box, sphere};
+}
+
+//==============================================================================
+/// The adaptive search never reports a contact later than the first one found
+/// by sampling, and only stops where the objects are in contact or about to be
+template <typename S>
+void test_adaptive_advancement_against_sampling(
+    CCDMotionType motion_type, std::size_t n)
+{
+  auto shapes = makeConvexShapes<S>();
+  for(const auto& mesh : makeMeshes<S>())
+    shapes.push_back(mesh);
+
+  S extents[] = {-5, 5, -5, 5, -5, 5};
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> transforms2;
+  test::generateRandomTransforms(extents, transforms, 2 * n);
+  test::generateRandomTransforms(extents, transforms2, 2 * n);
+
+  ContinuousCollisionRequest<S> naive_request(1001, 0.0001, motion_type);
+  ContinuousCollisionRequest<S> request(10, 0.0001, motion_type);
+  request.ccd_solver_type = CCDC_ADAPTIVE_ADVANCEMENT;
+
+  std::size_t num_contacts = 0;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    const auto& o1 = *shapes[i % shapes.size()];
+    const auto& o2 = *shapes[(i / shapes.size()) % shapes.size()];
+
+    // The capsule-capsule distance measures the segments from the capsule
+    // origins rather than from their centers, so it disagrees with collide()
+    if(o1.getNodeType() == GEOM_CAPSULE && o2.getNodeType() == GEOM_CAPSULE)
+      continue;
+
+    ContinuousCollisionResult<S> result;
+    continuousCollide(&o1, transforms[2 * i], transforms2[2 * i],
+                      &o2, transforms[2 * i + 1], transforms2[2 * i + 1],
+                      request, result);
+
+    ContinuousCollisionResult<S> naive_result;
+    continuousCollide(&o1, transforms[2 * i], transforms2[2 * i],
+                      &o2, transforms[2 * i + 1], transforms2[2 * i + 1],
+                      naive_request, naive_result);
+
+    if(naive_result.is_collide)
+    {
+      ++num_contacts;
+      EXPECT_TRUE(result.is_collide);
+      EXPECT_LE(result.time_of_contact, naive_result.time_of_contact + constants<S>::eps_12());
+    }
+
+    if(result.is_collide)
+    {
+      DistanceResult<S> distance_result;
+      distance(&o1, result.contact_tf1, &o2, result.contact_tf2,
+               DistanceRequest<S>(), distance_result);
+      EXPECT_LE(distance_result.min_distance, 0.01);
+    }
+  }
+
+  EXPECT_GT(num_contacts, n / 10);
+}
+
+//==============================================================================
+template <typename S>
+void test_adaptive_advancement_timing(
+    const std::vector<std::shared_ptr<CollisionGeometry<S>>>& shapes,
+    const std::string& description, std::size_t n)
+{
+  S extents[] = {-5, 5, -5, 5, -5, 5};
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> transforms2;
+  test::generateRandomTransforms(extents, transforms, 2 * n);
+  test::generateRandomTransforms(extents, transforms2, 2 * n);
+
+  std::vector<ContinuousCollisionRequest<S>> requests
+      = {ContinuousCollisionRequest<S>(10, 0.0001, CCDM_LINEAR),
+         ContinuousCollisionRequest<S>(1000, 0.0001, CCDM_LINEAR),
+         ContinuousCollisionRequest<S>(10, 0.0001, CCDM_LINEAR)};
+  requests[2].ccd_solver_type = CCDC_ADAPTIVE_ADVANCEMENT;
+  const std::vector<std::string> names
+      = {"naive (10 samples)", "naive (1000 samples)", "adaptive advancement"};
+
+  std::cout << n << " interpolated " << description << " pairs (ms)" << std::endl;
+  for(std::size_t s = 0; s < requests.size(); ++s)
+  {
+    std::size_t num_contacts = 0;
+    test::Timer timer;
+    timer.start();
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      const auto& o1 = *shapes[i % shapes.size()];
+      const auto& o2 = *shapes[(i / shapes.size()) % shapes.size()];
+
+      ContinuousCollisionResult<S> result;
+      continuousCollide(&o1, transforms[2 * i], transforms2[2 * i],
+                        &o2, transforms[2 * i + 1], transforms2[2 * i + 1],
+                        requests[s], result);
+      if(result.is_collide)
+        ++num_contacts;
+    }
+    timer.stop();
+    std::cout << "  " << names[s] << ": " << timer.getElapsedTime()
+              << " (" << num_contacts << " contacts)" << std::endl;
+  }
+}
+
+//==============================================================================
+template <typename S>
+std::vector<std::shared_ptr<MotionBase<S>>> makeMotions(
+    const Transform3<S>& tf1, const Transform3<S>& tf2)
+{
+  const Vector3<S> T0 = tf1.translation();
+  const Vector3<S> dT = tf2.translation() - tf1.translation();
+  const Vector3<S> R0 = AngleAxis<S>(tf1.linear()).angle()
+      * AngleAxis<S>(tf1.linear()).axis() + Vector3<S>(0.1, 0.2, 0.3);
+  const Vector3<S> dR(0.3, -0.2, 0.1);
+
+  std::vector<std::shared_ptr<MotionBase<S>>> motions;
+  motions.push_back(std::make_shared<TranslationMotion<S>>(tf1, tf2));
+  motions.push_back(std::make_shared<InterpMotion<S>>(tf1, tf2));
+  motions.push_back(std::make_shared<ScrewMotion<S>>(tf1, tf2));
+  motions.push_back(std::make_shared<SplineMotion<S>>(
+      T0, T0 + dT * 0.3, T0 + dT * 0.5 + Vector3<S>(1, 0, 0), T0 + dT,
+      R0, R0 + dR, R0 + dR * 3, R0 + dR * 4));
+  return motions;
+}
+
+//==============================================================================
+template <typename S>
+void test_motion_transform_at()
+{
+  S extents[] = {-5, 5, -5, 5, -5, 5};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, 20);
+
+  for(std::size_t i = 0; i + 1 < transforms.size(); i += 2)
+  {
+    for(const auto& motion : makeMotions(transforms[i], transforms[i + 1]))
+    {
+      for(S t : {S(0), S(0.25), S(0.6), S(1), S(1.5)})
+      {
+        motion->integrate(t);
+        Transform3<S> tf;
+        motion->getCurrentTransform(tf);
+        EXPECT_TRUE(CompareMatrices(
+            motion->transformAt(t).matrix(), tf.matrix(), 1e-12));
+      }
+
+      // transformAt() leaves the current step alone
+      motion->integrate(0.2);
+      Transform3<S> tf;
+      motion->getCurrentTransform(tf);
+      motion->transformAt(0.9);
+      Transform3<S> tf_after;
+      motion->getCurrentTransform(tf_after);
+      EXPECT_TRUE(CompareMatrices(tf_after.matrix(), tf.matrix()));
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void test_motion_transform_at_concurrent()
+{
+  const auto motions = makeMotions<S>(
+      makeTransform<S>(Vector3<S>(0, 0, 0)),
+      makeTransform<S>(Vector3<S>(4, -2, 1), 2));
+
+  const std::size_t num_samples = 1000;
+  for(const auto& motion : motions)
+  {
+    aligned_vector<Transform3<S>> expected(num_samples);
+    for(std::size_t i = 0; i < num_samples; ++i)
+      expected[i] = motion->transformAt(i / S(num_samples - 1));
+
+    // Every thread evaluates the shared motion at the times in its own order
+    const std::size_t num_threads = 4;
+    std::vector<std::size_t> mismatches(num_threads, 0);
+    std::vector<std::thread> threads;
+    for(std::size_t c = 0; c < num_threads; ++c)
+    {
+      threads.emplace_back([&, c]()
+      {
+        for(std::size_t k = 0; k < num_samples; ++k)
+        {
+          const std::size_t i = (k * (2 * c + 1)) % num_samples;
+          if(!motion->transformAt(i / S(num_samples - 1)).isApprox(expected[i], 0))
+            ++mismatches[c];
+        }
+      });
+    }
+    for(auto& thread : threads)
+      thread.join();
+
+    for(std::size_t c = 0; c < num_threads; ++c)
+      EXPECT_EQ(mismatches[c], 0u);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void test_motion_bound_interval()
+{
+  const AABB<S> aabb(Vector3<S>(-1, -2, -0.5), Vector3<S>(2, 1, 0.5));
+  RSS<S> rss;
+  rss.To = Vector3<S>(-1, -2, 0);
+  rss.axis.setIdentity();
+  rss.l[0] = 3;
+  rss.l[1] = 3;
+  rss.r = 0.5;
+  const Vector3<S> n = Vector3<S>(1, 2, -1).normalized();
+
+  const auto motions = makeMotions<S>(
+      makeTransform<S>(Vector3<S>(1, 0, 0)),
+      makeTransform<S>(Vector3<S>(4, -2, 1), 1.5, Vector3<S>(1, 1, 0).normalized()));
+
+  const std::vector<std::pair<S, S>> intervals
+      = {{S(0), S(1)}, {S(0), S(0.5)}, {S(0.3), S(0.8)}, {S(0.75), S(1)}};
+  for(const auto& motion : motions)
+  {
+    for(const auto& interval : intervals)
+    {
+      const S t0 = interval.first;
+      const S t1 = interval.second;
+
+      // The bounds over [t0, 1] match the ones computed from the current step
+      if(t1 == 1)
+      {
+        motion->integrate(t0);
+        const TBVMotionBoundVisitor<RSS<S>> tbv_visitor(rss, n);
+        EXPECT_NEAR(motion->computeMotionBound(tbv_visitor, t0, t1),
+                    motion->computeMotionBound(tbv_visitor), 1e-12);
+        const TriangleMotionBoundVisitor<S> triangle_visitor(
+            rss.To, rss.To + Vector3<S>(3, 0, 0), rss.To + Vector3<S>(0, 3, 0), n);
+        EXPECT_NEAR(motion->computeMotionBound(triangle_visitor, t0, t1),
+                    motion->computeMotionBound(triangle_visitor), 1e-12);
+      }
+
+      // No corner of the AABB moves faster than the bound within the interval
+      const S bound = motion->computeMotionBound(
+          AABBMotionBoundVisitor<S>(aabb), t0, t1);
+      const std::size_t num_steps = 50;
+      for(std::size_t k = 0; k < num_steps; ++k)
+      {
+        const S ta = t0 + (t1 - t0) * k / num_steps;
+        const S tb = t0 + (t1 - t0) * (k + 1) / num_steps;
+        const Transform3<S> tfa = motion->transformAt(ta);
+        const Transform3<S> tfb = motion->transformAt(tb);
+        for(int i = 0; i < 8; ++i)
+        {
+          const Vector3<S> corner(
+                (i & 1) ? aabb.max_[0] : aabb.min_[0],
+                (i & 2) ? aabb.max_[1] : aabb.min_[1],
+                (i & 4) ? aabb.max_[2] : aabb.min_[2]);
+          EXPECT_LE((tfb * corner - tfa * corner).norm(),
+                    bound * (tb - ta) + 1e-12);
+        }
+      }
+    }
+  }
+
+  // The translation of the spline does not move farther along n within the
+  // interval than its bound
+  const auto& spline = static_cast<const SplineMotion<S>&>(*motions.back());
+  for(const auto& interval : intervals)
+  {
+    const S t0 = interval.first;
+    const S t1 = interval.second;
+    const S T_bound = spline.computeTBound(n, t0, t1);
+    const Vector3<S> T0 = spline.transformAt(t0).translation();
+    for(std::size_t k = 0; k <= 50; ++k)
+    {
+      const S t = t0 + (t1 - t0) * k / 50;
+      EXPECT_LE((spline.transformAt(t).translation() - T0).dot(n), T_bound + 1e-12);
+    }
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, ray_shooting_analytic)
+{
+  test_ray_shooting_analytic<double>();
+  test_ray_shooting_analytic<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, ray_shooting_against_sampling)
+{
+  test_ray_shooting_against_sampling<double>(360);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, ray_shooting_timing)
+{
+#ifdef NDEBUG
+  test_ray_shooting_timing<double>(3600);
+#else
+  test_ray_shooting_timing<double>(360);
+#endif
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, adaptive_advancement_analytic)
+{
+  test_adaptive_advancement_analytic<double>();
+  test_adaptive_advancement_analytic<float>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, adaptive_advancement_against_sampling)
+{
+  test_adaptive_advancement_against_sampling<double>(CCDM_TRANS, 128);
+  test_adaptive_advancement_against_sampling<double>(CCDM_LINEAR, 128);
+  test_adaptive_advancement_against_sampling<double>(CCDM_SCREW, 128);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, adaptive_advancement_timing)
+{
+#ifdef NDEBUG
+  const std::size_t n = 1024;
+#else
+  const std::size_t n = 128;
+#endif
+  test_adaptive_advancement_timing<double>(makeConvexShapes<double>(), "shape", n);
+  test_adaptive_advancement_timing<double>(makeMeshes<double>(), "mesh", n);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, motion_transform_at)
+{
+  test_motion_transform_at<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, motion_transform_at_concurrent)
+{
+  test_motion_transform_at_concurrent<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONTINUOUS_COLLISION, motion_bound_interval)
+{
+  test_motion_bound_interval<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -39,6 +39,8 @@
 #include "fcl/broadphase/detail/morton.h"
 #include "fcl/config.h"
 #include "fcl/math/bv/AABB.h"
+#include "fcl/math/constants.h"
+#include "fcl/math/detail/soa_vertices.h"
 
 using namespace fcl;
 
@@ -129,6 +131,58 @@ GTEST_TEST(FCL_MATH, morton)
   test_morton<double>();
 }
 
+template <typename S>
+void test_argmax_dot()
+{
+  // Every count up to a few vector widths, so that both the vectorized body
+  // and the scalar remainder are exercised.
+  for(int n = 0; n <= 40; ++n)
+  {
+    std::vector<Vector3<S>> points;
+    for(int i = 0; i < n; ++i)
+    {
+      // Deterministic, well spread points; every fifth one is repeated to
+      // exercise the tie breaking.
+      const int k = (i % 5 == 4) ? i - 1 : i;
+      points.emplace_back(std::sin(S(1.3) * k), std::cos(S(2.1) * k),
+                          std::sin(S(0.7) * k + 1));
+    }
+
+    detail::SoAVertices<S> soa;
+    soa.assign(points.data(), n);
+    EXPECT_EQ(soa.size(), n);
+    EXPECT_EQ(soa.empty(), n == 0);
+
+    for(int d = 0; d < 20; ++d)
+    {
+      const Vector3<S> dir(std::cos(S(0.9) * d), std::sin(S(1.7) * d),
+                           std::cos(S(0.4) * d + 2));
+      int expected = -1;
+      for(int i = 0; i < n; ++i)
+      {
+        if(expected < 0 || dir.dot(points[i]) > dir.dot(points[expected]))
+          expected = i;
+      }
+      const int index = soa.argmaxDot(dir);
+      if(expected < 0)
+      {
+        EXPECT_EQ(index, -1);
+        continue;
+      }
+      GTEST_ASSERT_GE(index, 0);
+      GTEST_ASSERT_LT(index, n);
+      EXPECT_NEAR(dir.dot(points[index]), dir.dot(points[expected]),
+                  constants<S>::eps() * 8);
+    }
+  }
+}
+
+GTEST_TEST(FCL_MATH, argmax_dot)
+{
+  test_argmax_dot<float>();
+  test_argmax_dot<double>();
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,322 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/detail/security_margin.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_spatialhash.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+bool collideAlongX(const CollisionGeometry<S>* o1, const CollisionGeometry<S>* o2,
+                   S offset, S margin, GJKSolverType solver_type,
+                   CollisionResult<S>& result)
+{
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << offset, 0, 0;
+
+  CollisionRequest<S> request(4, true);
+  request.gjk_solver_type = solver_type;
+  request.security_margin = margin;
+  result.clear();
+  return collide(o1, tf1, o2, tf2, request, result) > 0;
+}
+
+//==============================================================================
+/// Two geometries separated by a gap of 0.1 along x: disjoint without a
+/// margin, in contact with a margin of 0.2 at a depth of margin - gap, and
+/// disjoint again once the gap exceeds the margin. Depths are compared by
+/// magnitude since the sphere-triangle kernel reports them negated.
+template <typename S>
+void checkMarginAlongX(const CollisionGeometry<S>* o1,
+                       const CollisionGeometry<S>* o2, S touching_offset,
+                       GJKSolverType solver_type, S depth_tol)
+{
+  const S margin = 0.2;
+  CollisionResult<S> result;
+
+  EXPECT_FALSE(collideAlongX(o1, o2, touching_offset + S(0.1), S(0),
+                             solver_type, result));
+
+  EXPECT_TRUE(collideAlongX(o1, o2, touching_offset + S(0.1), margin,
+                            solver_type, result));
+  if (result.numContacts() > 0)
+  {
+    const Contact<S>& contact = result.getContact(0);
+    EXPECT_NEAR(std::abs(contact.penetration_depth), margin - S(0.1), depth_tol);
+    EXPECT_NEAR(std::abs(contact.normal[0]), 1, depth_tol);
+  }
+
+  EXPECT_FALSE(collideAlongX(o1, o2, touching_offset + S(0.3), margin,
+                             solver_type, result));
+
+  // Penetrating pairs report the depths of the plain query grown by the
+  // margin
+  CollisionResult<S> plain_result;
+  EXPECT_TRUE(collideAlongX(o1, o2, touching_offset - S(0.1), S(0),
+                            solver_type, plain_result));
+  EXPECT_TRUE(collideAlongX(o1, o2, touching_offset - S(0.1), margin,
+                            solver_type, result));
+  GTEST_ASSERT_EQ(result.numContacts(), plain_result.numContacts());
+  for (std::size_t i = 0; i < result.numContacts(); ++i)
+  {
+    EXPECT_NEAR(std::abs(result.getContact(i).penetration_depth),
+                std::abs(plain_result.getContact(i).penetration_depth) + margin,
+                depth_tol);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void test_shape_margin(GJKSolverType solver_type)
+{
+  Sphere<S> sphere(1);
+  Capsule<S> capsule(1, 2);
+  Box<S> box(2, 2, 2);
+  Ellipsoid<S> ellipsoid(1, 1.5, 2);
+  Halfspace<S> halfspace(Vector3<S>(-1, 0, 0), 0);
+  Plane<S> plane(Vector3<S>(-1, 0, 0), 0);
+
+  // Inflated kernels are exact
+  checkMarginAlongX<S>(&sphere, &sphere, 2, solver_type, 1e-6);
+  checkMarginAlongX<S>(&sphere, &capsule, 2, solver_type, 1e-6);
+  checkMarginAlongX<S>(&box, &halfspace, 1, solver_type, 1e-6);
+  checkMarginAlongX<S>(&box, &plane, 1, solver_type, 1e-6);
+
+  // General convex pairs go through the GJK distance
+  checkMarginAlongX<S>(&box, &box, 2, solver_type, 1e-3);
+  checkMarginAlongX<S>(&box, &ellipsoid, 2, solver_type, 1e-3);
+}
+
+//==============================================================================
+template <typename BV>
+void test_mesh_margin(GJKSolverType solver_type)
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, Box<S>(2, 2, 2), Transform3<S>::Identity());
+  Box<S> box(2, 2, 2);
+  Sphere<S> sphere(1);
+
+  checkMarginAlongX<S>(&mesh, &mesh, 2, solver_type, 1e-6);
+  checkMarginAlongX<S>(&mesh, &box, 2, solver_type, 1e-3);
+  checkMarginAlongX<S>(&box, &mesh, 2, solver_type, 1e-3);
+  checkMarginAlongX<S>(&sphere, &mesh, 2, solver_type, 1e-6);
+}
+
+//==============================================================================
+template <typename S>
+void test_triangle_margin_contact()
+{
+  const Vector3<S> P1(0, 0, 0), P2(1, 0, 0), P3(0, 1, 0);
+  const Vector3<S> Q1(0, 0, 0.1), Q2(1, 0, 0.1), Q3(0, 1, 0.1);
+
+  Vector3<S> contact;
+  S depth;
+  Vector3<S> normal;
+  EXPECT_FALSE(detail::triangleMarginContact<S>(P1, P2, P3, Q1, Q2, Q3, S(0)));
+  EXPECT_FALSE(detail::triangleMarginContact<S>(P1, P2, P3, Q1, Q2, Q3,
+                                                S(0.05)));
+  EXPECT_TRUE(detail::triangleMarginContact<S>(P1, P2, P3, Q1, Q2, Q3, S(0.2),
+                                               &contact, &depth, &normal));
+  EXPECT_NEAR(depth, 0.1, 1e-6);
+  EXPECT_NEAR(normal[2], 1, 1e-6);
+  EXPECT_NEAR(contact[2], 0.05, 1e-6);
+
+  AABB<S> a(Vector3<S>(0, 0, 0), Vector3<S>(1, 1, 1));
+  AABB<S> b(Vector3<S>(1.1, 0, 0), Vector3<S>(2, 1, 1));
+  EXPECT_FALSE(detail::overlapWithMargin(a, b, S(0)));
+  EXPECT_TRUE(detail::overlapWithMargin(a, b, S(0.2)));
+
+  OBBRSS<S> c, d;
+  c.obb.axis.setIdentity();
+  c.obb.To = Vector3<S>(0, 0, 0);
+  c.obb.extent = Vector3<S>(1, 1, 1);
+  c.rss.To = Vector3<S>(0, 0, 0);
+  c.rss.l[0] = c.rss.l[1] = 0;
+  c.rss.r = 1;
+  d = c;
+  EXPECT_FALSE(detail::overlapWithMargin(Matrix3<S>::Identity().eval(),
+                                         Vector3<S>(2.1, 0, 0), c, d, S(0)));
+  EXPECT_TRUE(detail::overlapWithMargin(Matrix3<S>::Identity().eval(),
+                                        Vector3<S>(2.1, 0, 0), c, d, S(0.2)));
+}
+
+//==============================================================================
+template <typename S>
+struct MarginPairCount
+{
+  CollisionRequest<S> request;
+  std::size_t num_pairs = 0;
+};
+
+template <typename S>
+bool countMarginPairs(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                      void* cdata_)
+{
+  auto* cdata = static_cast<MarginPairCount<S>*>(cdata_);
+  CollisionResult<S> result;
+  if (collide(o1, o2, cdata->request, result) > 0)
+    ++cdata->num_pairs;
+  return false;
+}
+
+//==============================================================================
+/// A 4x4x4 grid of unit spheres with a gap of 0.1 between neighbours. With a
+/// margin of 0.2 every manager has to report the 144 neighbouring pairs, and
+/// only those.
+template <typename S>
+void test_broadphase_margin()
+{
+  const int n = 4;
+  const S spacing = 2.1;
+  auto sphere = std::make_shared<Sphere<S>>(1);
+
+  std::vector<std::unique_ptr<CollisionObject<S>>> objects;
+  std::vector<CollisionObject<S>*> env;
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      for (int k = 0; k < n; ++k)
+      {
+        Transform3<S> tf = Transform3<S>::Identity();
+        tf.translation() << i * spacing, j * spacing, k * spacing;
+        objects.emplace_back(new CollisionObject<S>(sphere, tf));
+        env.push_back(objects.back().get());
+      }
+
+  Vector3<S> lower_limit, upper_limit;
+  SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
+
+  std::vector<std::unique_ptr<BroadPhaseCollisionManager<S>>> managers;
+  managers.emplace_back(new NaiveCollisionManager<S>());
+  managers.emplace_back(new SSaPCollisionManager<S>());
+  managers.emplace_back(new SaPCollisionManager<S>());
+  managers.emplace_back(new IntervalTreeCollisionManager<S>());
+  managers.emplace_back(new SpatialHashingCollisionManager<S>(
+      spacing, lower_limit, upper_limit));
+  managers.emplace_back(new DynamicAABBTreeCollisionManager<S>());
+  managers.emplace_back(new DynamicAABBTreeCollisionManager_Array<S>());
+
+  const std::size_t expected_pairs = 3 * n * n * (n - 1);
+  for (std::size_t m = 0; m < managers.size(); ++m)
+  {
+    SCOPED_TRACE(m);
+    BroadPhaseCollisionManager<S>* manager = managers[m].get();
+    manager->setSecurityMargin(0.2);
+    EXPECT_EQ(manager->getSecurityMargin(), S(0.2));
+    manager->registerObjects(env);
+    manager->setup();
+
+    MarginPairCount<S> without_margin;
+    manager->collide(&without_margin, countMarginPairs<S>);
+    EXPECT_EQ(without_margin.num_pairs, 0u);
+
+    MarginPairCount<S> with_margin;
+    with_margin.request.security_margin = 0.2;
+    manager->collide(&with_margin, countMarginPairs<S>);
+    EXPECT_EQ(with_margin.num_pairs, expected_pairs);
+
+    // Moving an object keeps its stored bounds inflated
+    Transform3<S> tf = env[0]->getTransform();
+    tf.translation()[0] -= 1;
+    env[0]->setTransform(tf);
+    env[0]->computeAABB();
+    manager->update(env[0]);
+    tf.translation()[0] += 1;
+    env[0]->setTransform(tf);
+    env[0]->computeAABB();
+    manager->update(env[0]);
+
+    MarginPairCount<S> after_update;
+    after_update.request.security_margin = 0.2;
+    manager->collide(&after_update, countMarginPairs<S>);
+    EXPECT_EQ(after_update.num_pairs, expected_pairs);
+
+    // Single object queries
+    CollisionObject<S> probe(sphere, Transform3<S>(
+        Translation3<S>(Vector3<S>(-2.05, 0, 0))));
+    MarginPairCount<S> probe_pairs;
+    probe_pairs.request.security_margin = 0.2;
+    manager->collide(&probe, &probe_pairs, countMarginPairs<S>);
+    EXPECT_EQ(probe_pairs.num_pairs, 1u);
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SECURITY_MARGIN, shape_shape)
+{
+  test_shape_margin<double>(GST_LIBCCD);
+  test_shape_margin<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SECURITY_MARGIN, mesh)
+{
+  test_mesh_margin<OBBRSS<double>>(GST_LIBCCD);
+  test_mesh_margin<OBBRSS<double>>(GST_INDEP);
+  test_mesh_margin<AABB<double>>(GST_INDEP);
+  test_mesh_margin<RSS<double>>(GST_INDEP);
+  test_mesh_margin<KDOP<double, 24>>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SECURITY_MARGIN, triangle_and_bv)
+{
+  test_triangle_margin_contact<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SECURITY_MARGIN, broadphase)
+{
+  test_broadphase_margin<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,364 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/broadphase/broadphase_bruteforce.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/broadphase_interval_tree.h"
+#include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_SSaP.h"
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/narrowphase/mixed_precision.h"
+#include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+//==============================================================================
+// Compares single and double precision queries on the same configurations.
+// Pairs within band of contact may legitimately change their verdict between
+// the two precisions and are skipped. GJKSolver_indep stops once a support
+// point repeats, which can happen on a different iteration in each precision,
+// so its distances are only compared loosely.
+template <typename Shape1d, typename Shape2d, typename Shape1f, typename Shape2f>
+void testShapePair(const Shape1d& s1_d, const Shape2d& s2_d,
+                   const Shape1f& s1_f, const Shape2f& s2_f,
+                   GJKSolverType solver_type)
+{
+  aligned_vector<Transform3d> tf1;
+  aligned_vector<Transform3d> tf2;
+  double extents[] = {-2, -2, -2, 2, 2, 2};
+  test::generateRandomTransforms(extents, tf1, 200);
+  test::generateRandomTransforms(extents, tf2, 200);
+
+  const double band = 1e-3;
+  const double dist_tol = (solver_type == GST_INDEP) ? 5e-2 : band;
+
+  for (std::size_t i = 0; i < tf1.size(); ++i)
+  {
+    const Transform3f tf1_f = tf1[i].cast<float>();
+    const Transform3f tf2_f = tf2[i].cast<float>();
+
+    DistanceRequestd dist_request_d;
+    dist_request_d.gjk_solver_type = solver_type;
+    DistanceResultd dist_result_d;
+    const double dist_d
+        = distance(&s1_d, tf1[i], &s2_d, tf2[i], dist_request_d, dist_result_d);
+
+    DistanceRequestf dist_request_f;
+    dist_request_f.gjk_solver_type = solver_type;
+    DistanceResultf dist_result_f;
+    const float dist_f
+        = distance(&s1_f, tf1_f, &s2_f, tf2_f, dist_request_f, dist_result_f);
+
+    if (std::abs(dist_d) <= band)
+      continue;
+
+    if (dist_d > 0)
+      EXPECT_NEAR(dist_d, dist_f, dist_tol);
+
+    CollisionRequestd col_request_d;
+    col_request_d.gjk_solver_type = solver_type;
+    CollisionResultd col_result_d;
+    collide(&s1_d, tf1[i], &s2_d, tf2[i], col_request_d, col_result_d);
+
+    CollisionRequestf col_request_f;
+    col_request_f.gjk_solver_type = solver_type;
+    CollisionResultf col_result_f;
+    collide(&s1_f, tf1_f, &s2_f, tf2_f, col_request_f, col_result_f);
+
+    EXPECT_EQ(col_result_d.isCollision(), col_result_f.isCollision());
+  }
+}
+
+//==============================================================================
+void testShapes(GJKSolverType solver_type)
+{
+  testShapePair(Sphered(0.8), Boxd(1.2, 0.8, 1.6),
+                Spheref(0.8f), Boxf(1.2f, 0.8f, 1.6f), solver_type);
+  testShapePair(Boxd(1.2, 0.8, 1.6), Boxd(0.5, 1.0, 0.7),
+                Boxf(1.2f, 0.8f, 1.6f), Boxf(0.5f, 1.0f, 0.7f), solver_type);
+  testShapePair(Capsuled(0.4, 1.5), Cylinderd(0.5, 1.2),
+                Capsulef(0.4f, 1.5f), Cylinderf(0.5f, 1.2f), solver_type);
+  testShapePair(Ellipsoidd(0.4, 0.7, 1.0), Coned(0.6, 1.4),
+                Ellipsoidf(0.4f, 0.7f, 1.0f), Conef(0.6f, 1.4f), solver_type);
+}
+
+//==============================================================================
+template <typename S>
+std::shared_ptr<BVHModel<OBBRSS<S>>> loadModel(const char* filename)
+{
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> triangles;
+  test::loadOBJFile(filename, points, triangles);
+
+  auto model = std::make_shared<BVHModel<OBBRSS<S>>>();
+  model->beginModel();
+  model->addSubModel(points, triangles);
+  model->endModel();
+  return model;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SINGLE_PRECISION, shapes_libccd)
+{
+  testShapes(GST_LIBCCD);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SINGLE_PRECISION, shapes_indep)
+{
+  testShapes(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SINGLE_PRECISION, mesh_mesh)
+{
+  const auto env_d = loadModel<double>(TEST_RESOURCES_DIR"/env.obj");
+  const auto rob_d = loadModel<double>(TEST_RESOURCES_DIR"/rob.obj");
+  const auto env_f = loadModel<float>(TEST_RESOURCES_DIR"/env.obj");
+  const auto rob_f = loadModel<float>(TEST_RESOURCES_DIR"/rob.obj");
+
+  aligned_vector<Transform3d> transforms;
+  double extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  const std::size_t n = 100;
+#else
+  const std::size_t n = 10;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  // The models span a few thousand units, where single precision rounding is
+  // of the order of 1e-3.
+  const double band = 1.0;
+
+  std::size_t num_collisions = 0;
+  for (const auto& tf : transforms)
+  {
+    const Transform3f tf_f = tf.cast<float>();
+
+    DistanceRequestd dist_request_d;
+    DistanceResultd dist_result_d;
+    const double dist_d = distance(env_d.get(), Transform3d::Identity(),
+                                   rob_d.get(), tf, dist_request_d,
+                                   dist_result_d);
+
+    DistanceRequestf dist_request_f;
+    DistanceResultf dist_result_f;
+    const float dist_f = distance(env_f.get(), Transform3f::Identity(),
+                                  rob_f.get(), tf_f, dist_request_f,
+                                  dist_result_f);
+    EXPECT_NEAR(dist_d, dist_f, band);
+
+    CollisionRequestd col_request_d;
+    CollisionResultd col_result_d;
+    collide(env_d.get(), Transform3d::Identity(), rob_d.get(), tf,
+            col_request_d, col_result_d);
+
+    CollisionRequestf col_request_f;
+    CollisionResultf col_result_f;
+    collide(env_f.get(), Transform3f::Identity(), rob_f.get(), tf_f,
+            col_request_f, col_result_f);
+
+    if (col_result_d.isCollision())
+      ++num_collisions;
+    if (dist_d > band || col_result_d.isCollision())
+      EXPECT_EQ(col_result_d.isCollision(), col_result_f.isCollision());
+  }
+
+  EXPECT_GT(num_collisions, 0u);
+}
+
+//==============================================================================
+template <typename S>
+bool countCollisionFunction(CollisionObject<S>* o1, CollisionObject<S>* o2,
+                            void* cdata)
+{
+  CollisionRequest<S> request;
+  CollisionResult<S> result;
+  if (collide(o1, o2, request, result) > 0)
+    ++*static_cast<std::size_t*>(cdata);
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t countSelfCollisions(BroadPhaseCollisionManager<S>& manager,
+                                const aligned_vector<Transform3d>& transforms,
+                                const std::vector<double>& radii)
+{
+  std::vector<std::unique_ptr<CollisionObject<S>>> objects;
+  for (std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    auto sphere = std::make_shared<Sphere<S>>(static_cast<S>(radii[i]));
+    objects.emplace_back(new CollisionObject<S>(
+        sphere, Transform3<S>(transforms[i].cast<S>())));
+    manager.registerObject(objects.back().get());
+  }
+  manager.setup();
+
+  std::size_t count = 0;
+  manager.collide(&count, countCollisionFunction<S>);
+  manager.clear();
+  return count;
+}
+
+//==============================================================================
+template <template <typename> class Manager>
+void testManagerPair(const aligned_vector<Transform3d>& transforms,
+                     const std::vector<double>& radii)
+{
+  Manager<double> manager_d;
+  Manager<float> manager_f;
+  const std::size_t count_d = countSelfCollisions(manager_d, transforms, radii);
+  const std::size_t count_f = countSelfCollisions(manager_f, transforms, radii);
+  EXPECT_GT(count_d, 0u);
+  EXPECT_EQ(count_d, count_f);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SINGLE_PRECISION, broadphase)
+{
+  aligned_vector<Transform3d> transforms;
+  double extents[] = {-20, -20, -20, 20, 20, 20};
+  test::generateRandomTransforms(extents, transforms, 500);
+
+  std::vector<double> radii(transforms.size());
+  for (auto& radius : radii)
+    radius = test::rand_interval(0.5, 2.0);
+
+  // Each manager is compared with its own double precision instantiation.
+  testManagerPair<NaiveCollisionManager>(transforms, radii);
+  testManagerPair<SaPCollisionManager>(transforms, radii);
+  testManagerPair<SSaPCollisionManager>(transforms, radii);
+  testManagerPair<IntervalTreeCollisionManager>(transforms, radii);
+  testManagerPair<DynamicAABBTreeCollisionManager>(transforms, radii);
+  testManagerPair<DynamicAABBTreeCollisionManager_Array>(transforms, radii);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SINGLE_PRECISION, mixed_precision)
+{
+  const auto env_d = loadModel<double>(TEST_RESOURCES_DIR"/env.obj");
+  const auto rob_d = loadModel<double>(TEST_RESOURCES_DIR"/rob.obj");
+  const auto env_f = loadModel<float>(TEST_RESOURCES_DIR"/env.obj");
+  const auto rob_f = loadModel<float>(TEST_RESOURCES_DIR"/rob.obj");
+  const MixedPrecisionGeometry env(env_f.get(), env_d.get());
+  const MixedPrecisionGeometry rob(rob_f.get(), rob_d.get());
+
+  aligned_vector<Transform3d> transforms;
+  double extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  const std::size_t n = 100;
+#else
+  const std::size_t n = 10;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  const double tolerance = 1.0;
+  const Transform3d identity = Transform3d::Identity();
+
+  double col_time_double = 0;
+  double col_time_mixed = 0;
+  double dist_time_double = 0;
+  double dist_time_mixed = 0;
+  for (const auto& tf : transforms)
+  {
+    DistanceRequestd dist_request(true);
+    DistanceResultd dist_result_d;
+    DistanceResultd dist_result_m;
+
+    test::Timer dist_timer_double;
+    dist_timer_double.start();
+    const double dist_d = distance(env_d.get(), identity, rob_d.get(), tf,
+                                   dist_request, dist_result_d);
+    dist_timer_double.stop();
+    dist_time_double += dist_timer_double.getElapsedTimeInSec();
+
+    test::Timer dist_timer_mixed;
+    dist_timer_mixed.start();
+    const double dist_m = distanceMixedPrecision(
+          env, identity, rob, tf, tolerance, dist_request, dist_result_m);
+    dist_timer_mixed.stop();
+    dist_time_mixed += dist_timer_mixed.getElapsedTimeInSec();
+
+    EXPECT_NEAR(dist_d, dist_m, tolerance);
+    EXPECT_NEAR(dist_result_d.min_distance, dist_result_m.min_distance,
+                tolerance);
+    EXPECT_EQ(dist_result_m.o1, env_d.get());
+    EXPECT_EQ(dist_result_m.o2, rob_d.get());
+    if (dist_d <= tolerance)
+      EXPECT_EQ(dist_d, dist_m);
+
+    CollisionRequestd col_request;
+    CollisionResultd col_result_d;
+    CollisionResultd col_result_m;
+
+    test::Timer col_timer_double;
+    col_timer_double.start();
+    collide(env_d.get(), identity, rob_d.get(), tf, col_request, col_result_d);
+    col_timer_double.stop();
+    col_time_double += col_timer_double.getElapsedTimeInSec();
+
+    test::Timer col_timer_mixed;
+    col_timer_mixed.start();
+    collideMixedPrecision(env, identity, rob, tf, tolerance, col_request,
+                          col_result_m);
+    col_timer_mixed.stop();
+    col_time_mixed += col_timer_mixed.getElapsedTimeInSec();
+
+    if (dist_d > tolerance || col_result_d.isCollision())
+      EXPECT_EQ(col_result_d.isCollision(), col_result_m.isCollision());
+    for (std::size_t i = 0; i < col_result_m.numContacts(); ++i)
+    {
+      EXPECT_EQ(col_result_m.getContact(i).o1, env_d.get());
+      EXPECT_EQ(col_result_m.getContact(i).o2, rob_d.get());
+    }
+  }
+
+  std::cout << "mesh-mesh collide: double " << col_time_double
+            << " s, mixed " << col_time_mixed << " s" << std::endl;
+  std::cout << "mesh-mesh distance: double " << dist_time_double
+            << " s, mixed " << dist_time_mixed << " s" << std::endl;
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,265 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/math/bv/OBBRSS.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+void test_statistics_disabled(GJKSolverType solver_type)
+{
+  Ellipsoid<S> s1(1, 2, 3);
+  Ellipsoid<S> s2(2, 1, 1);
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << 1.5, 0.5, 0;
+
+  CollisionRequest<S> request(1, true);
+  request.gjk_solver_type = solver_type;
+  CollisionResult<S> result;
+  collide(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_TRUE(result.isCollision());
+  EXPECT_EQ(result.solver_statistics.num_gjk_runs, 0u);
+  EXPECT_EQ(result.solver_statistics.num_epa_runs, 0u);
+
+  DistanceRequest<S> dist_request;
+  dist_request.gjk_solver_type = solver_type;
+  DistanceResult<S> dist_result;
+  tf2.translation() << 10, 0, 0;
+  distance(&s1, tf1, &s2, tf2, dist_request, dist_result);
+  EXPECT_EQ(dist_result.solver_statistics.num_gjk_runs, 0u);
+}
+
+//==============================================================================
+template <typename S>
+void test_collision_statistics_indep()
+{
+  Ellipsoid<S> s1(1, 2, 3);
+  Ellipsoid<S> s2(2, 1, 1);
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << 1.5, 0.5, 0;
+
+  CollisionRequest<S> request(4, true);
+  request.gjk_solver_type = GST_INDEP;
+  request.enable_solver_statistics = true;
+  CollisionResult<S> result;
+  collide(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_TRUE(result.isCollision());
+
+  const SolverStatistics& stats = result.solver_statistics;
+  EXPECT_EQ(stats.num_gjk_runs, 1u);
+  EXPECT_GT(stats.gjk_iterations, 0u);
+  EXPECT_EQ(stats.num_gjk_iteration_limit_reached, 0u);
+  EXPECT_EQ(stats.num_epa_runs, 1u);
+  EXPECT_GT(stats.epa_iterations, 0u);
+  EXPECT_NE(stats.last_epa_status, SolverStatistics::EPA_NOT_RUN);
+
+  // The statically dispatched query reports the same runs
+  CollisionResult<S> static_result;
+  collide(s1, tf1, s2, tf2, request, static_result);
+  EXPECT_EQ(static_result.solver_statistics.gjk_iterations,
+            stats.gjk_iterations);
+  EXPECT_EQ(static_result.solver_statistics.epa_iterations,
+            stats.epa_iterations);
+
+  // Statistics accumulate until the result is cleared
+  collide(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_EQ(result.solver_statistics.num_gjk_runs, 2u);
+  result.clear();
+  EXPECT_EQ(result.solver_statistics.num_gjk_runs, 0u);
+}
+
+//==============================================================================
+template <typename S>
+void test_distance_statistics(GJKSolverType solver_type)
+{
+  Ellipsoid<S> s1(1, 2, 3);
+  Ellipsoid<S> s2(2, 1, 1);
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << 5, 1, 0;
+
+  DistanceRequest<S> request;
+  request.gjk_solver_type = solver_type;
+  request.enable_solver_statistics = true;
+  DistanceResult<S> result;
+  distance(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_GT(result.min_distance, 0);
+  EXPECT_EQ(result.solver_statistics.num_gjk_runs, 1u);
+  EXPECT_GT(result.solver_statistics.gjk_iterations, 0u);
+  EXPECT_EQ(result.solver_statistics.num_gjk_upper_bound_reached, 0u);
+
+  // Penetrating signed distance runs EPA
+  tf2.translation() << 1.5, 0.5, 0;
+  request.enable_signed_distance = true;
+  result.clear();
+  distance(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_LT(result.min_distance, 0);
+  EXPECT_EQ(result.solver_statistics.num_epa_runs, 1u);
+}
+
+//==============================================================================
+template <typename S>
+void test_distance_upper_bound(GJKSolverType solver_type)
+{
+  Ellipsoid<S> s1(1, 2, 3);
+  Cone<S> s2(1, 3);
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << 8, 3, 2;
+  tf2.linear() = AngleAxis<S>(0.3, Vector3<S>(1, 1, 0).normalized())
+      .toRotationMatrix();
+
+  DistanceRequest<S> request;
+  request.gjk_solver_type = solver_type;
+  request.enable_solver_statistics = true;
+
+  DistanceResult<S> exact;
+  distance(&s1, tf1, &s2, tf2, request, exact);
+  const S d = exact.min_distance;
+  GTEST_ASSERT_GT(d, 1);
+
+  // Bound above the distance: same answer
+  request.distance_upper_bound = 2 * d;
+  DistanceResult<S> above;
+  distance(&s1, tf1, &s2, tf2, request, above);
+  EXPECT_EQ(above.min_distance, d);
+  EXPECT_EQ(above.solver_statistics.num_gjk_upper_bound_reached, 0u);
+
+  // Bound below the distance: stops early with a distance above the bound
+  request.distance_upper_bound = d / 2;
+  DistanceResult<S> below;
+  distance(&s1, tf1, &s2, tf2, request, below);
+  EXPECT_GE(below.min_distance, request.distance_upper_bound);
+  EXPECT_EQ(below.solver_statistics.num_gjk_upper_bound_reached, 1u);
+  EXPECT_LT(below.solver_statistics.gjk_iterations,
+            exact.solver_statistics.gjk_iterations);
+
+  DistanceResult<S> static_below;
+  distance(s1, tf1, s2, tf2, request, static_below);
+  EXPECT_EQ(static_below.min_distance, below.min_distance);
+}
+
+//==============================================================================
+template <typename S>
+void test_mesh_distance_upper_bound()
+{
+  using BV = OBBRSS<S>;
+  auto m1 = std::make_shared<BVHModel<BV>>();
+  auto m2 = std::make_shared<BVHModel<BV>>();
+  generateBVHModel(*m1, Sphere<S>(1), Transform3<S>::Identity(), 16, 16);
+  generateBVHModel(*m2, Box<S>(1, 2, 3), Transform3<S>::Identity());
+
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() << 6, 1, 0;
+
+  for (GJKSolverType solver_type : {GST_LIBCCD, GST_INDEP})
+  {
+    DistanceRequest<S> request;
+    request.gjk_solver_type = solver_type;
+
+    DistanceResult<S> exact;
+    distance(m1.get(), tf1, m2.get(), tf2, request, exact);
+    const S d = exact.min_distance;
+    GTEST_ASSERT_GT(d, 1);
+
+    request.distance_upper_bound = 2 * d;
+    DistanceResult<S> above;
+    distance(m1.get(), tf1, m2.get(), tf2, request, above);
+    EXPECT_EQ(above.min_distance, d);
+
+    request.distance_upper_bound = d / 2;
+    DistanceResult<S> below;
+    distance(m1.get(), tf1, m2.get(), tf2, request, below);
+    EXPECT_GE(below.min_distance, request.distance_upper_bound);
+
+    // Mesh-shape distance prunes too, and forwards the bound to the solver
+    Ellipsoid<S> e(1, 1, 2);
+    DistanceResult<S> shape_exact;
+    request.distance_upper_bound = std::numeric_limits<S>::max();
+    distance(m1.get(), tf1, &e, tf2, request, shape_exact);
+    request.distance_upper_bound = shape_exact.min_distance / 2;
+    DistanceResult<S> shape_below;
+    distance(m1.get(), tf1, &e, tf2, request, shape_below);
+    EXPECT_GE(shape_below.min_distance, request.distance_upper_bound);
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SOLVER_STATISTICS, disabled_by_default)
+{
+  test_statistics_disabled<double>(GST_LIBCCD);
+  test_statistics_disabled<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SOLVER_STATISTICS, collision_indep)
+{
+  test_collision_statistics_indep<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SOLVER_STATISTICS, distance)
+{
+  test_distance_statistics<double>(GST_LIBCCD);
+  test_distance_statistics<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SOLVER_STATISTICS, distance_upper_bound)
+{
+  test_distance_upper_bound<double>(GST_LIBCCD);
+  test_distance_upper_bound<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_SOLVER_STATISTICS, mesh_distance_upper_bound)
+{
+  test_mesh_distance_upper_bound<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
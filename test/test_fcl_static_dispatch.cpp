@@ -0,0 +1,216 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+template <typename S>
+void checkSameContacts(const CollisionResult<S>& expected,
+                       const CollisionResult<S>& actual)
+{
+  GTEST_ASSERT_EQ(expected.numContacts(), actual.numContacts());
+  for (std::size_t i = 0; i < expected.numContacts(); ++i)
+  {
+    const Contact<S>& c1 = expected.getContact(i);
+    const Contact<S>& c2 = actual.getContact(i);
+    EXPECT_EQ(c1.o1, c2.o1);
+    EXPECT_EQ(c1.o2, c2.o2);
+    EXPECT_EQ(c1.penetration_depth, c2.penetration_depth);
+    EXPECT_TRUE(c1.normal == c2.normal);
+    EXPECT_TRUE(c1.pos == c2.pos);
+  }
+}
+
+//==============================================================================
+// Runs both the function matrix path and the statically dispatched path on
+// the same queries; they call the same solver routines and so must agree
+// exactly.
+template <typename Shape1, typename Shape2>
+void testStaticDispatch(const Shape1& s1, const Shape2& s2,
+                        GJKSolverType solver_type)
+{
+  using S = typename Shape1::S;
+
+  aligned_vector<Transform3<S>> tf1;
+  aligned_vector<Transform3<S>> tf2;
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+  test::generateRandomTransforms(extents, tf1, 200);
+  test::generateRandomTransforms(extents, tf2, 200);
+
+  CollisionRequest<S> col_request(4, true);
+  col_request.gjk_solver_type = solver_type;
+
+  DistanceRequest<S> dist_request(true);
+  dist_request.enable_signed_distance = true;
+  dist_request.gjk_solver_type = solver_type;
+
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < tf1.size(); ++i)
+  {
+    CollisionResult<S> col_dynamic;
+    CollisionResult<S> col_static;
+    const std::size_t n_dynamic
+        = collide(&s1, tf1[i], &s2, tf2[i], col_request, col_dynamic);
+    const std::size_t n_static
+        = collide(s1, tf1[i], s2, tf2[i], col_request, col_static);
+    EXPECT_EQ(n_dynamic, n_static);
+    checkSameContacts(col_dynamic, col_static);
+    if (n_static > 0)
+      ++num_collisions;
+
+    DistanceResult<S> dist_dynamic;
+    DistanceResult<S> dist_static;
+    const S d_dynamic
+        = distance(&s1, tf1[i], &s2, tf2[i], dist_request, dist_dynamic);
+    const S d_static
+        = distance(s1, tf1[i], s2, tf2[i], dist_request, dist_static);
+    EXPECT_EQ(d_dynamic, d_static);
+    EXPECT_EQ(dist_dynamic.min_distance, dist_static.min_distance);
+    EXPECT_TRUE(dist_dynamic.nearest_points[0] == dist_static.nearest_points[0]);
+    EXPECT_TRUE(dist_dynamic.nearest_points[1] == dist_static.nearest_points[1]);
+    EXPECT_EQ(dist_dynamic.o1, dist_static.o1);
+    EXPECT_EQ(dist_dynamic.o2, dist_static.o2);
+  }
+
+  // Make sure both colliding and separated configurations are exercised.
+  EXPECT_GT(num_collisions, 0u);
+  EXPECT_LT(num_collisions, tf1.size());
+}
+
+//==============================================================================
+template <typename S>
+void testStaticDispatchShapes(GJKSolverType solver_type)
+{
+  Sphere<S> sphere(0.8);
+  Box<S> box(1.2, 0.8, 1.6);
+  Capsule<S> capsule(0.4, 1.5);
+  Cylinder<S> cylinder(0.5, 1.2);
+  Cone<S> cone(0.6, 1.4);
+  Ellipsoid<S> ellipsoid(0.4, 0.7, 1.0);
+
+  testStaticDispatch(sphere, sphere, solver_type);
+  testStaticDispatch(sphere, box, solver_type);
+  testStaticDispatch(box, box, solver_type);
+  testStaticDispatch(sphere, capsule, solver_type);
+  testStaticDispatch(cylinder, sphere, solver_type);
+  testStaticDispatch(cone, box, solver_type);
+  testStaticDispatch(ellipsoid, capsule, solver_type);
+}
+
+//==============================================================================
+template <typename Shape1, typename Shape2>
+void timeStaticDispatch(const Shape1& s1, const Shape2& s2, const char* name)
+{
+  using S = typename Shape1::S;
+
+  aligned_vector<Transform3<S>> tf1;
+  aligned_vector<Transform3<S>> tf2;
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+#ifdef NDEBUG
+  const std::size_t n = 100000;
+#else
+  const std::size_t n = 1000;
+#endif
+  test::generateRandomTransforms(extents, tf1, n);
+  test::generateRandomTransforms(extents, tf2, n);
+
+  CollisionRequest<S> col_request;
+  DistanceRequest<S> dist_request;
+
+  std::size_t n_dynamic = 0;
+  test::Timer timer_dynamic;
+  timer_dynamic.start();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    CollisionResult<S> col_result;
+    n_dynamic += collide(&s1, tf1[i], &s2, tf2[i], col_request, col_result);
+    DistanceResult<S> dist_result;
+    distance(&s1, tf1[i], &s2, tf2[i], dist_request, dist_result);
+  }
+  timer_dynamic.stop();
+
+  std::size_t n_static = 0;
+  test::Timer timer_static;
+  timer_static.start();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    CollisionResult<S> col_result;
+    n_static += collide(s1, tf1[i], s2, tf2[i], col_request, col_result);
+    DistanceResult<S> dist_result;
+    distance(s1, tf1[i], s2, tf2[i], dist_request, dist_result);
+  }
+  timer_static.stop();
+
+  EXPECT_EQ(n_dynamic, n_static);
+
+  std::cout << name << ": dynamic dispatch "
+            << timer_dynamic.getElapsedTimeInSec() << " s, static dispatch "
+            << timer_static.getElapsedTimeInSec() << " s (" << n
+            << " collide + distance queries)" << std::endl;
+}
+
+//==============================================================================
+GTEST_TEST(FCL_STATIC_DISPATCH, shapes_libccd)
+{
+  testStaticDispatchShapes<double>(GST_LIBCCD);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_STATIC_DISPATCH, shapes_indep)
+{
+  testStaticDispatchShapes<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_STATIC_DISPATCH, timing)
+{
+  timeStaticDispatch(Sphere<double>(0.8), Sphere<double>(0.8), "sphere-sphere");
+  timeStaticDispatch(Sphere<double>(0.8), Box<double>(1.2, 0.8, 1.6),
+                     "sphere-box");
+  timeStaticDispatch(Box<double>(1.2, 0.8, 1.6), Box<double>(1.2, 0.8, 1.6),
+                     "box-box");
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}